@@ -35,7 +35,7 @@ class Configure(config.base.Configure):
 
 
   def configureLibraryOptions(self):
-    '''Sets PETSC_USE_DEBUG, PETSC_USE_INFO, PETSC_USE_LOG, PETSC_USE_CTABLE, PETSC_USE_FORTRAN_KERNELS, and PETSC_USE_AVX512_KERNELS'''
+    '''Sets PETSC_USE_DEBUG, PETSC_USE_INFO, PETSC_USE_LOG, PETSC_USE_CTABLE, PETSC_USE_FORTRAN_KERNELS, PETSC_USE_AVX512_KERNELS, and PETSC_HAVE_AVX2_FMA'''
     '''Also sets PETSC_AssertAlignx() in Fortran and PETSC_Alignx() in C for IBM BG/P compiler '''
     if self.framework.argDB['with-threadsafety']:
       self.addDefine('HAVE_THREADSAFETY',1)
@@ -86,6 +86,10 @@ class Configure(config.base.Configure):
     if self.useAVX512Kernels:
       self.addDefine('USE_AVX512_KERNELS', 1)
 
+    # the compiler flags enable AVX2 and FMA (also implied by AVX-512), used by the vectorized SeqBAIJ kernels
+    if self.checkCompile('','#if !(defined(__AVX2__) && defined(__FMA__))\n#error "AVX2 and FMA are not enabled"\n#endif\n'):
+      self.addDefine('HAVE_AVX2_FMA', 1)
+
     if self.libraries.isBGL():
       self.addDefine('Alignx(a,b)','__alignx(a,b)')
     else:
@@ -14,6 +14,7 @@
 #define KSPGuessType character*(80)
 #define KSPCGType PetscEnum
 #define KSPFCDTruncationType PetscEnum
+#define KSPCABasisType PetscEnum
 #define KSPConvergedReason PetscEnum
 #define KSPNormType PetscEnum
 #define KSPGMRESCGSRefinementType PetscEnum
@@ -30,6 +31,7 @@
 #define KSPPIPECG 'pipecg'
 #define KSPPIPECGRR 'pipecgrr'
 #define KSPPIPELCG 'pipelcg'
+#define KSPCACG 'cacg'
 #define KSPCGNE 'cgne'
 #define KSPNASH 'nash'
 #define KSPSTCG 'stcg'
@@ -42,6 +44,7 @@
 #define KSPLGMRES 'lgmres'
 #define KSPDGMRES 'dgmres'
 #define KSPPGMRES 'pgmres'
+#define KSPCAGMRES 'cagmres'
 #define KSPTCQMR 'tcqmr'
 #define KSPBCGS 'bcgs'
 #define KSPIBCGS 'ibcgs'
@@ -188,6 +188,9 @@ PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP,PetscBool,KSPNormType*,PCS
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP,PetscInt,const PetscReal*,const PetscReal*);
 
+PETSC_INTERN PetscErrorCode KSPCABasisComputeRitz_Private(PetscInt,const PetscScalar*,PetscInt,PetscReal*,PetscReal*);
+PETSC_INTERN PetscErrorCode KSPCABasisSetUp_Private(KSPCABasisType,PetscInt,PetscInt,PetscReal*,PetscReal*,PetscReal,PetscReal,PetscScalar*);
+
 typedef struct _p_DMKSP *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
 struct _DMKSPOps {
@@ -86,6 +86,8 @@ PETSC_EXTERN PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent, int, Petsc
 PETSC_EXTERN PetscErrorCode PetscLogEventEndComplete(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventBeginTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventEndTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventBeginSample(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventEndSample(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 
 /* Creation and destruction functions */
 PETSC_EXTERN PetscErrorCode PetscClassRegLogCreate(PetscClassRegLog *);
@@ -125,4 +127,17 @@ PETSC_EXTERN PetscErrorCode PetscEventRegLogGetEvent(PetscEventRegLog, const cha
 
 PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
 PETSC_INTERN PetscErrorCode PetscLogNestedEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogTimelineEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogView_Sample(PetscViewer);
+PETSC_INTERN PetscErrorCode PetscLogSampleEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogTimelineStage_Private(PetscLogStage,PetscBool);
+PETSC_INTERN const char *const PetscLogHWCounterNames[];
+PETSC_INTERN PetscBool      PetscLogHWCounterAvailable[];
+PETSC_INTERN PetscErrorCode PetscLogHWCountersStart(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersStop(const PetscLogDouble[],PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersEnd(void);
+PETSC_INTERN PetscErrorCode PetscLogMallocUsageEventBegin(PetscLogEvent);
+PETSC_INTERN PetscErrorCode PetscLogMallocUsageEventEnd(PetscLogEvent);
+PETSC_INTERN PetscErrorCode PetscLogView_MallocUsage(PetscViewer);
+PETSC_INTERN PetscErrorCode PetscLogMallocUsageEnd(void);
 #endif /* PETSC_USE_LOG */
@@ -346,6 +346,15 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used when BTS reuses its communication pattern with persistent requests */
+  PetscBool      persistent;      /* Use persistent requests once the pattern is reused (MAT_SUBSET_OFF_PROC_ENTRIES) */
+  PetscBool      persistent_setup;/* Have the persistent requests been created? */
+  PetscInt       *psendcap;       /* Capacity, in blocks, of the persistent send buffer of each rank */
+  PetscMPIInt    *psendcount;     /* Count the persistent send to each rank was initialized with, -1 if none */
+  char           *psendbuf;       /* Buffers the persistent requests are bound to */
+  char           *precvbuf;
+  MatStashFrame  *precvframes;
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -1665,6 +1674,7 @@ PETSC_EXTERN PetscLogEvent MAT_MultMatrixFree;
 PETSC_EXTERN PetscLogEvent MAT_Mults;
 PETSC_EXTERN PetscLogEvent MAT_MultConstrained;
 PETSC_EXTERN PetscLogEvent MAT_MultAdd;
+PETSC_EXTERN PetscLogEvent MAT_MultPowers;
 PETSC_EXTERN PetscLogEvent MAT_MultTranspose;
 PETSC_EXTERN PetscLogEvent MAT_MultTransposeConstrained;
 PETSC_EXTERN PetscLogEvent MAT_MultTransposeAdd;
@@ -1744,6 +1754,8 @@ PETSC_EXTERN PetscLogEvent MATMFFD_Mult;
 PETSC_EXTERN PetscLogEvent MAT_GetMultiProcBlock;
 PETSC_EXTERN PetscLogEvent MAT_CUSPARSECopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_SetValuesBatch;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MAT_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyFromGPU;
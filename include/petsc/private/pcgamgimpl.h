@@ -16,6 +16,22 @@ struct _PCGAMGOps {
   PetscErrorCode (*destroy)(PC);
   PetscErrorCode (*view)(PC,PetscViewer);
 };
+
+/* phases of the setup of a level reported by -pc_gamg_log_view */
+typedef enum {PCGAMG_PHASE_GRAPH,PCGAMG_PHASE_COARSEN,PCGAMG_PHASE_PROL,PCGAMG_PHASE_OPTPROL,PCGAMG_PHASE_PTAP,PCGAMG_PHASE_REPART,PCGAMG_NUM_PHASES} PCGAMGPhase;
+
+typedef struct {
+  PetscLogDouble time,flops,messages,bytes,reductions; /* on this process */
+} PCGAMGLogCounters;
+
+typedef struct {
+  PetscInt          rows;
+  PetscMPIInt       nactive;
+  PetscLogDouble    nnz,mem;   /* of the operator, summed over processes */
+  PetscLogDouble    pnnz,pmem; /* of the interpolation from the next coarser level */
+  PCGAMGLogCounters phase[PCGAMG_NUM_PHASES];
+} PCGAMGLogLevel;
+
 /* Private context for the GAMG preconditioner */
 typedef struct gamg_TAG {
   PCGAMGType type;
@@ -27,6 +43,7 @@ typedef struct gamg_TAG {
   PetscBool use_parallel_coarse_grid_solver;
   PCGAMGLayoutType layout_type;
   PetscBool cpu_pin_coarse_grids;
+  PetscBool use_single_precision; /* coarse grid operators, interpolation and coarse factors applied in single precision */
   PetscInt  min_eq_proc;
   PetscInt  coarse_eq_limit;
   PetscReal threshold_scale;
@@ -51,6 +68,13 @@ typedef struct gamg_TAG {
   PetscInt   esteig_max_it;
   PetscInt   use_sa_esteig;
   PetscReal  emin,emax;
+
+  /* -pc_gamg_log_view */
+  PetscViewer       log_viewer;
+  PetscViewerFormat log_format;
+  PCGAMGLogLevel    log_levels[PETSC_MG_MAXLEVELS];
+  PCGAMGLogCounters log_start[2]; /* counters at the beginning of the current phase and of the one it is nested in */
+  PetscInt          log_depth;
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
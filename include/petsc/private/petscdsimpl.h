@@ -49,6 +49,8 @@ struct _p_PetscDS {
   PetscPointJac        *g;             /* Weak form integrands for J = dF/du, g_0, g_1, g_2, g_3 */
   PetscPointJac        *gp;            /* Weak form integrands for preconditioner for J, g_0, g_1, g_2, g_3 */
   PetscPointJac        *gt;            /* Weak form integrands for dF/du_t, g_0, g_1, g_2, g_3 */
+  PetscPointFuncBatch  *fBatch;        /* Batched weak form integrands for F, f_0, f_1 */
+  PetscPointJacBatch   *gBatch;        /* Batched weak form integrands for J = dF/du, g_0, g_1, g_2, g_3 */
   PetscBdPointFunc     *fBd;           /* Weak form boundary integrands F_bd, f_0, f_1 */
   PetscBdPointJac      *gBd;           /* Weak form boundary integrands J_bd = dF_bd/du, g_0, g_1, g_2, g_3 */
   PetscRiemannFunc     *r;             /* Riemann solvers */
@@ -184,6 +184,7 @@ PETSC_EXTERN PetscErrorCode PetscObjectGetFortranCallback(PetscObject,PetscFortr
 
 PETSC_INTERN PetscErrorCode PetscCitationsInitialize(void);
 PETSC_INTERN PetscErrorCode PetscFreeMPIResources(void);
+PETSC_INTERN PetscErrorCode PetscMallocPoolEnd(void);
 
 
 
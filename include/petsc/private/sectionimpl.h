@@ -29,6 +29,9 @@ struct _p_PetscSection {
   PetscInt                      clSize;       /* The size of a dof closure of a cell, when it is uniform */
   PetscInt                     *clPerm;       /* A permutation of the cell dof closure, of size clSize */
   PetscInt                     *clInvPerm;    /* The inverse of clPerm */
+  PetscInt                      clDofStart, clDofEnd; /* The points with cached closure dof indices */
+  PetscInt                     *clDofOff;     /* Offsets into clDofs for each point in [clDofStart, clDofEnd], or NULL */
+  PetscInt                     *clDofs;       /* Dof indices of each closure, with symmetries and the closure permutation applied */
   PetscSectionSym               sym;          /* Symmetries of the data */
 };
 
@@ -58,6 +61,25 @@ struct _p_PetscSectionSym {
 PETSC_EXTERN PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscCopyMode, PetscInt *);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt *, const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosureInversePermutation_Internal(PetscSection, PetscObject, PetscInt *, const PetscInt *[]);
+PETSC_EXTERN PetscErrorCode PetscSectionSetClosureDofs_Internal(PetscSection, PetscObject, PetscInt, PetscInt, PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscSectionHasClosureDofs_Internal(PetscSection, PetscObject, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscSectionResetClosureDofs_Internal(PetscSection);
+
+/* Returns the cached dof indices for the closure of point, or NULL if they are not cached */
+PETSC_STATIC_INLINE PetscErrorCode PetscSectionGetClosureDofs_Internal(PetscSection section, PetscObject obj, PetscInt point, PetscInt *numDofs, const PetscInt *dofs[])
+{
+  PetscFunctionBegin;
+  if (section->clDofOff && section->clObj == obj && point >= section->clDofStart && point < section->clDofEnd) {
+    const PetscInt p = point - section->clDofStart;
+
+    *numDofs = section->clDofOff[p+1] - section->clDofOff[p];
+    *dofs    = &section->clDofs[section->clDofOff[p]];
+  } else {
+    *numDofs = 0;
+    *dofs    = NULL;
+  }
+  PetscFunctionReturn(0);
+}
 PETSC_EXTERN PetscErrorCode ISIntersect_Caching_Internal(IS, IS, IS *);
 
 #endif
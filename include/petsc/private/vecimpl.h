@@ -96,6 +96,7 @@ struct _VecOps {
   PetscErrorCode (*bindtocpu)(Vec,PetscBool);
   PetscErrorCode (*getarraywrite)(Vec,PetscScalar**);
   PetscErrorCode (*restorearraywrite)(Vec,PetscScalar**);
+  PetscErrorCode (*maxpymdot)(Vec,PetscInt,const PetscScalar*,Vec*,PetscScalar*,PetscReal*); /* x += sum alpha y, then y'x and x'x */
 };
 
 /*
@@ -166,6 +167,7 @@ PETSC_EXTERN PetscLogEvent VEC_AXPY;
 PETSC_EXTERN PetscLogEvent VEC_AYPX;
 PETSC_EXTERN PetscLogEvent VEC_WAXPY;
 PETSC_EXTERN PetscLogEvent VEC_MAXPY;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYMDot;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent VEC_PointwiseMult;
 PETSC_EXTERN PetscLogEvent VEC_SetValues;
@@ -284,6 +286,10 @@ PETSC_INTERN PetscErrorCode VecStrideScatter_Default(Vec,PetscInt,Vec,InsertMode
 PETSC_INTERN PetscErrorCode VecReciprocal_Default(Vec);
 PETSC_INTERN PetscErrorCode VecStrideSubSetGather_Default(Vec,PetscInt,const PetscInt[],const PetscInt[],Vec,InsertMode);
 PETSC_INTERN PetscErrorCode VecStrideSubSetScatter_Default(Vec,PetscInt,const PetscInt[],const PetscInt[],Vec,InsertMode);
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscInt VecOMPThreads;
+PETSC_INTERN PetscErrorCode VecFirstTouch_OpenMP_Private(PetscInt,PetscScalar*);
+#endif
 
 #if defined(PETSC_HAVE_MATLAB_ENGINE)
 PETSC_EXTERN PetscErrorCode VecMatlabEnginePut_Default(PetscObject,void*);
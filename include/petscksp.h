@@ -37,6 +37,7 @@ typedef const char* KSPType;
 #define KSPPIPECGRR   "pipecgrr"
 #define KSPPIPELCG     "pipelcg"
 #define KSPPIPEPRCG    "pipeprcg"
+#define KSPCACG       "cacg"
 #define   KSPCGNE       "cgne"
 #define   KSPNASH       "nash"
 #define   KSPSTCG       "stcg"
@@ -52,6 +53,7 @@ typedef const char* KSPType;
 #define   KSPLGMRES     "lgmres"
 #define   KSPDGMRES     "dgmres"
 #define   KSPPGMRES     "pgmres"
+#define   KSPCAGMRES    "cagmres"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define   KSPIBCGS      "ibcgs"
@@ -224,6 +226,29 @@ PETSC_EXTERN PetscErrorCode KSPGCRSetRestart(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGCRGetRestart(KSP,PetscInt*);
 PETSC_EXTERN PetscErrorCode KSPGCRSetModifyPC(KSP,PetscErrorCode (*)(KSP,PetscInt,PetscReal,void*),void*,PetscErrorCode(*)(void*));
 
+/*E
+    KSPCABasisType - The polynomial basis used by the s-step (communication-avoiding) Krylov methods to generate s Krylov vectors at once
+
+$  KSP_CA_BASIS_MONOMIAL  - scaled monomial basis, only numerically useful for small s
+$  KSP_CA_BASIS_NEWTON    - Newton basis with Leja ordered shifts (the default)
+$  KSP_CA_BASIS_CHEBYSHEV - Chebyshev basis of the interval containing the (real parts of the) eigenvalues
+
+   Level: advanced
+
+.seealso: KSPCACG, KSPCAGMRES, KSPCACGSetBasisType(), KSPCAGMRESSetBasisType()
+E*/
+typedef enum {KSP_CA_BASIS_MONOMIAL,KSP_CA_BASIS_NEWTON,KSP_CA_BASIS_CHEBYSHEV} KSPCABasisType;
+PETSC_EXTERN const char *const KSPCABasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPCACGSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCACGGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPCACGSetBasisType(KSP,KSPCABasisType);
+PETSC_EXTERN PetscErrorCode KSPCACGGetBasisType(KSP,KSPCABasisType*);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESSetBasisType(KSP,KSPCABasisType);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESGetBasisType(KSP,KSPCABasisType*);
+
 PETSC_EXTERN PetscErrorCode KSPFETIDPGetInnerBDDC(KSP,PC*);
 PETSC_EXTERN PetscErrorCode KSPFETIDPSetInnerBDDC(KSP,PC);
 PETSC_EXTERN PetscErrorCode KSPFETIDPGetInnerKSP(KSP,KSP*);
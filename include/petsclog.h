@@ -163,6 +163,8 @@ typedef struct {
 #endif
 } PetscEventRegInfo;
 
+#define PETSC_LOG_NUM_HWCOUNTERS 5 /* cycles, instructions, last level cache references and misses, page faults */
+
 typedef struct {
   int            id;            /* The integer identifying this event */
   PetscBool      active;        /* The flag to activate logging */
@@ -181,6 +183,8 @@ typedef struct {
   PetscLogDouble mallocIncrease;/* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;   /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent;  /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  PetscLogDouble hwCounters[PETSC_LOG_NUM_HWCOUNTERS]; /* The hardware counters read with -log_view_hwcounters */
+  PetscLogDouble hwStart[PETSC_LOG_NUM_HWCOUNTERS+2]; /* The raw counters, time enabled and time running at the beginning */
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -342,6 +346,10 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineBegin(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscLogSampleBegin(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscLogHWCountersBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogMallocUsageBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble,PetscLogDouble*);
@@ -352,6 +360,7 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineDump(const char[]);
 
 /* Stage functions */
 PETSC_EXTERN PetscErrorCode PetscLogStageRegister(const char[],PetscLogStage*);
@@ -375,6 +384,7 @@ PETSC_EXTERN PetscErrorCode PetscLogEventActivateClass(PetscClassId);
 PETSC_EXTERN PetscErrorCode PetscLogEventDeactivateClass(PetscClassId);
 PETSC_EXTERN PetscErrorCode PetscLogEventGetId(const char[],PetscLogEvent*);
 PETSC_EXTERN PetscErrorCode PetscLogEventGetPerfInfo(int,PetscLogEvent,PetscEventPerfInfo*);
+PETSC_EXTERN PetscErrorCode PetscLogEventGetMallocUsage(PetscLogEvent,PetscLogDouble*,PetscLogDouble*);
 PETSC_EXTERN PetscErrorCode PetscLogEventSetDof(PetscLogEvent, PetscInt, PetscLogDouble);
 PETSC_EXTERN PetscErrorCode PetscLogEventSetError(PetscLogEvent, PetscInt, PetscLogDouble);
 
@@ -396,6 +406,8 @@ PETSC_EXTERN PetscLogDouble petsc_wait_all_ct;
 PETSC_EXTERN PetscLogDouble petsc_sum_of_waits_ct;
 
 PETSC_EXTERN PetscBool      PetscLogMemory;
+PETSC_EXTERN PetscBool      PetscLogHWCounters;
+PETSC_EXTERN PetscBool      PetscLogMallocUsage;
 
 PETSC_EXTERN PetscBool PetscLogSyncOn;  /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -573,6 +585,9 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   ((petsc_isend_ct += (PetscLogDouble)(outdegree),0) || (petsc_irecv_ct += (PetscLogDouble)(indegree),0) || PetscMPITypeSizeCount((outdegree),(sendcnts),(sendtype),(&petsc_isend_len)) || PetscMPITypeSizeCount((indegree),(recvcnts),(recvtype),(&petsc_irecv_len)) || (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm))))
 
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  ((petsc_isend_ct += (PetscLogDouble)(outdegree),0) || (petsc_irecv_ct += (PetscLogDouble)(indegree),0) || PetscMPITypeSizeCount((outdegree),(sendcnts),(sendtype),(&petsc_isend_len)) || PetscMPITypeSizeCount((indegree),(recvcnts),(recvtype),(&petsc_irecv_len)) || MPI_Start((request)))
+
 #else
 
 #define MPI_Startall_irecv(count,datatype,number,requests) \
@@ -589,11 +604,16 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm)))
+
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  (MPI_Start((request)))
 #endif /* !MPIUNI_H && ! PETSC_HAVE_BROKEN_RECURSIVE_MACRO */
 
 #else  /* ---Logging is turned off --------------------------------------------*/
 
 #define PetscLogMemory                     PETSC_FALSE
+#define PetscLogHWCounters                 PETSC_FALSE
+#define PetscLogMallocUsage                PETSC_FALSE
 
 #define PetscLogFlops(n)                   0
 #define PetscGetFlops(a)                   (*(a) = 0.0,0)
@@ -618,6 +638,7 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #define PetscLogEventSetActiveAll(a,b)     0
 #define PetscLogEventGetId(a,b)            (*(b)=0,0)
 #define PetscLogEventGetPerfInfo(a,b,c)    0
+#define PetscLogEventGetMallocUsage(a,b,c) 0
 #define PetscLogEventSetDof(a,b,c)         0
 #define PetscLogEventSetError(a,b,c)       0
 
@@ -635,6 +656,10 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogAllBegin()                 0
 #define PetscLogNestedBegin()              0
 #define PetscLogTraceBegin(file)           0
+#define PetscLogTimelineBegin(n)           0
+#define PetscLogSampleBegin(n)             0
+#define PetscLogHWCountersBegin()          0
+#define PetscLogMallocUsageBegin()         0
 #define PetscLogActions(a)                 0
 #define PetscLogObjects(a)                 0
 #define PetscLogSetThreshold(a,b)          0
@@ -643,6 +668,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogView(viewer)               0
 #define PetscLogViewFromOptions()          0
 #define PetscLogDump(c)                    0
+#define PetscLogTimelineDump(c)            0
 
 #define PetscLogEventSync(e,comm)          0
 #define PetscLogEventBegin(e,o1,o2,o3,o4)  0
@@ -664,6 +690,9 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define MPI_Start_neighbor_alltoallv(outdegree,indegree,sendbuf,sendcnts,sdispls,sendtype,recvbuf,recvcnts,rdispls,recvtype,comm) \
   (((outdegree) || (indegree)) && MPI_Neighbor_alltoallv((sendbuf),(sendcnts),(sdispls),(sendtype),(recvbuf),(recvcnts),(rdispls),(recvtype),(comm)))
 
+#define MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcnts,sendtype,recvcnts,recvtype,request) \
+  (MPI_Start((request)))
+
 #endif   /* PETSC_USE_LOG */
 
 #define PetscPreLoadBegin(flag,name) \
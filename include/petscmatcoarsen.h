@@ -27,6 +27,7 @@ J*/
 typedef const char* MatCoarsenType;
 #define MATCOARSENMIS  "mis"
 #define MATCOARSENHEM  "hem"
+#define MATCOARSENLUBY "luby"
 
 /* linked list for aggregates */
 typedef struct _PetscCDIntNd{
@@ -1201,6 +1201,9 @@ PETSC_EXTERN PetscErrorCode (*PetscTrRealloc)(size_t,int,const char[],const char
 PETSC_EXTERN PetscErrorCode PetscMallocSetCoalesce(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscMallocSet(PetscErrorCode (*)(size_t,PetscBool,int,const char[],const char[],void**),PetscErrorCode (*)(void*,int,const char[],const char[]),PetscErrorCode (*)(size_t,int,const char[],const char[], void **));
 PETSC_EXTERN PetscErrorCode PetscMallocClear(void);
+PETSC_EXTERN PetscErrorCode PetscMallocSetPool(void);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolSetMaxCached(size_t);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolRelease(void);
 
 /*
   Unlike PetscMallocSet and PetscMallocClear which overwrite the existing settings, these two functions save the previous choice of allocator, and should be used in pair.
@@ -1395,6 +1398,7 @@ PETSC_EXTERN PetscErrorCode PetscObjectsListGetGlobalNumbering(MPI_Comm,PetscInt
 
 PETSC_EXTERN PetscErrorCode PetscMemoryShowUsage(PetscViewer,const char[]);
 PETSC_EXTERN PetscErrorCode PetscMemoryView(PetscViewer,const char[]);
+PETSC_EXTERN PetscErrorCode PetscMallocPoolView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscObjectPrintClassNamePrefixType(PetscObject,PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscObjectView(PetscObject,PetscViewer);
 #define PetscObjectQueryFunction(obj,name,fptr) PetscObjectQueryFunction_Private((obj),(name),(PetscVoidFunction*)(fptr))
@@ -2589,6 +2593,13 @@ PETSC_EXTERN PetscErrorCode PetscSegBufferExtractInPlace(PetscSegBuffer,void*);
 PETSC_EXTERN PetscErrorCode PetscSegBufferGetSize(PetscSegBuffer,size_t*);
 PETSC_EXTERN PetscErrorCode PetscSegBufferUnuse(PetscSegBuffer,size_t);
 
+PETSC_EXTERN PetscErrorCode PetscArenaCreate(size_t,PetscArena*);
+PETSC_EXTERN PetscErrorCode PetscArenaDestroy(PetscArena*);
+PETSC_EXTERN PetscErrorCode PetscArenaGet(PetscArena,size_t,void*);
+PETSC_EXTERN PetscErrorCode PetscArenaBegin(PetscArena);
+PETSC_EXTERN PetscErrorCode PetscArenaEnd(PetscArena);
+PETSC_EXTERN PetscErrorCode PetscArenaView(PetscArena,PetscViewer);
+
 
 /* Type-safe wrapper to encourage use of PETSC_RESTRICT. Does not use PetscFunctionBegin because the error handling
  * prevents the compiler from completely erasing the stub. This is called in inner loops so it has to be as fast as
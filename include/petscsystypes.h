@@ -636,6 +636,15 @@ typedef struct _n_PetscOmpCtrl* PetscOmpCtrl;
 S*/
 typedef struct _n_PetscSegBuffer *PetscSegBuffer;
 
+/*S
+   PetscArena - a region of scratch memory from which allocations are released together at the end of a scope
+
+   Level: developer
+
+.seealso: PetscArenaCreate(), PetscArenaGet(), PetscArenaBegin(), PetscArenaEnd(), PetscArenaDestroy()
+S*/
+typedef struct _n_PetscArena *PetscArena;
+
 typedef struct _n_PetscOptionsHelpPrinted *PetscOptionsHelpPrinted;
 
 #endif
@@ -0,0 +1,53 @@
+#include <petscsys.h>
+#include <petsctime.h>
+
+/*
+   Measures the cost of a PetscLogEventBegin()/PetscLogEventEnd() pair around a tiny kernel, as in MatSetValues() or
+   VecDot() on small subdomains, for the logging mode selected with the options (none, -log_view, -log_view -log_sample).
+*/
+int main(int argc,char **argv)
+{
+  PetscLogDouble x,y,tkernel,tevent;
+  PetscLogEvent  e1;
+  PetscErrorCode ierr;
+  PetscInt       i,j,n = 1000000,m = 8;
+  PetscScalar    a[64],sum = 0.0;
+  PetscBool      flg;
+
+  ierr = PetscInitialize(&argc,&argv,0,0);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  m    = PetscMin(PetscMax(m,1),64);
+  for (j=0; j<m; j++) a[j] = 1.0/(j+1);
+  ierr = PetscLogEventRegister("*DummyEvent",0,&e1);CHKERRQ(ierr);
+
+  /* the kernel alone */
+  ierr = PetscTime(&x);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (j=0; j<m; j++) sum += a[j]*a[j];
+    a[i%m] += 1.e-12;
+  }
+  ierr = PetscTime(&y);CHKERRQ(ierr);
+  tkernel = y-x;
+
+  /* the kernel inside an event */
+  ierr = PetscTime(&x);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(e1,0,0,0,0);CHKERRQ(ierr);
+    for (j=0; j<m; j++) sum += a[j]*a[j];
+    a[i%m] += 1.e-12;
+    ierr = PetscLogEventEnd(e1,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&y);CHKERRQ(ierr);
+  tevent = y-x;
+
+  fprintf(stderr,"%-15s : %e sec per pair, kernel %e sec, overhead %5.1f%% (checksum %g), with options : ","PetscLogEvent",(tevent-tkernel)/n,tkernel/n,100.0*(tevent-tkernel)/tkernel,(double)PetscRealPart(sum));
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_view",&flg);CHKERRQ(ierr);
+  if (flg) fprintf(stderr,"-log_view ");
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_sample",&flg);CHKERRQ(ierr);
+  if (flg) fprintf(stderr,"-log_sample ");
+  fprintf(stderr,"\n");
+
+  ierr = PetscFinalize();
+  return ierr;
+}
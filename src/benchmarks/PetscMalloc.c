@@ -7,7 +7,9 @@ int main(int argc,char **argv)
   PetscLogDouble x,y;
   double         value;
   void           *arr[1000],*dummy;
-  int            i,rand1[1000],rand2[1000];
+  int            i,rand1[1000],rand2[1000],len;
+  PetscInt       *idx;
+  PetscScalar    *val;
   PetscErrorCode ierr;
   PetscRandom    r;
   PetscBool      flg;
@@ -50,10 +52,23 @@ int main(int argc,char **argv)
   }
 
   fprintf(stdout,"%-15s : %e sec, with options : ","PetscMalloc",(y-x)/500.0);
-  ierr = PetscOptionsHasName(NULL,"-malloc",&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsHasName(NULL,NULL,"-malloc",&flg);CHKERRQ(ierr);
   if (flg) fprintf(stdout,"-malloc ");
+  ierr = PetscOptionsHasName(NULL,NULL,"-malloc_pool",&flg);CHKERRQ(ierr);
+  if (flg) fprintf(stdout,"-malloc_pool ");
   fprintf(stdout,"\n");
 
+  /* Short-lived work arrays, as for each row in an inner loop */
+  ierr = PetscTime(&x);CHKERRQ(ierr);
+  for (i=0; i<100000; i++) {
+    len  = rand1[i%1000]%200+1;
+    ierr = PetscMalloc2(len,&idx,len,&val);CHKERRQ(ierr);
+    idx[0] = len; val[len-1] = 1.0;
+    ierr = PetscFree2(idx,val);CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&y);CHKERRQ(ierr);
+  fprintf(stdout,"%-15s : %e sec\n","PetscMalloc2",(y-x)/100000.0);
+
   ierr = PetscRandomDestroy(&r);CHKERRQ(ierr);
   ierr = PetscFinalize();
   return ierr;
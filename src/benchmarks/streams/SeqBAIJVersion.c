@@ -0,0 +1,122 @@
+
+static char help[] = "Measures the memory bandwidth achieved by MatMult() and MatSolve() for SeqBAIJ matrices and compares it to STREAM.\n\
+Run after MPIVersion on one process (make baijstreams) so its triad rate, saved in the file flops, can be used as the reference.\n\
+  -bs <bs>             : block size\n\
+  -n <n>               : the matrix is the block structure of a 7 point stencil on an n x n x n grid\n\
+  -nrep <nrep>         : number of times each operation is timed, the best time is used\n\
+  -stream_rate <MB/s>  : STREAM triad rate to compare against, instead of the one in the file flops\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+/*
+   Bytes moved by one block sparse matrix-vector product with nb nonzero blocks and mbs block rows:
+   the blocks and their column indices, the row offsets, and one read of x and write of y
+   (the cache reuse of x is ignored, as in STREAM)
+*/
+static PetscLogDouble BAIJBytes(PetscInt bs,PetscInt mbs,PetscInt nb)
+{
+  return (PetscLogDouble)nb*(bs*bs*sizeof(MatScalar) + sizeof(PetscInt)) + (mbs+1)*sizeof(PetscInt) + 2.0*bs*mbs*sizeof(PetscScalar);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,F;
+  Vec            x,y;
+  IS             rperm,cperm;
+  MatFactorInfo  info;
+  MatInfo        ainfo;
+  PetscInt       bs = 4,n = 32,nrep = 20,mbs,i,j,k,l,r,c,cols[7],ncols;
+  PetscScalar    *vals;
+  PetscLogDouble t,tmult = PETSC_MAX_REAL,tsolve = PETSC_MAX_REAL,bytes,stream = 0.0;
+  PetscBool      flg;
+  FILE           *fd;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nrep",&nrep,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-stream_rate",&stream,&flg);CHKERRQ(ierr);
+  if (!flg) {
+    fd = fopen("flops","r");
+    if (fd) {
+      if (fscanf(fd,"%lg",&stream) != 1) stream = 0.0;
+      fclose(fd);
+    }
+  }
+  mbs  = n*n*n;
+
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,bs*mbs,bs*mbs,7,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_ROW_ORIENTED,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscMalloc1(7*bs*bs,&vals);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    for (j=0; j<n; j++) {
+      for (i=0; i<n; i++) {
+        r = i + n*(j + n*k);
+        ncols = 0;
+        if (k > 0)   cols[ncols++] = r - n*n;
+        if (j > 0)   cols[ncols++] = r - n;
+        if (i > 0)   cols[ncols++] = r - 1;
+        cols[ncols++] = r;
+        if (i < n-1) cols[ncols++] = r + 1;
+        if (j < n-1) cols[ncols++] = r + n;
+        if (k < n-1) cols[ncols++] = r + n*n;
+        /* diagonally dominant blocks so the ILU(0) factorization below is stable */
+        for (c=0; c<ncols; c++) {
+          for (l=0; l<bs*bs; l++) vals[c*bs*bs+l] = (cols[c] == r) ? ((l % (bs+1)) ? 0.1 : 8.0*bs) : -1.0/(1+l);
+        }
+        ierr = MatSetValuesBlocked(A,1,&r,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+
+  /* the first product is not timed, it touches the pages of the matrix and vectors */
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  for (i=0; i<nrep; i++) {
+    ierr  = PetscTime(&t);CHKERRQ(ierr);
+    ierr  = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr  = PetscTimeSubtract(&t);CHKERRQ(ierr);
+    tmult = PetscMin(tmult,-t);
+  }
+  ierr  = MatGetInfo(A,MAT_LOCAL,&ainfo);CHKERRQ(ierr);
+  bytes = BAIJBytes(bs,mbs,(PetscInt)(ainfo.nz_used/(bs*bs)));
+  ierr  = PetscPrintf(PETSC_COMM_SELF,"bs %D MatMult  %11.4f Rate (MB/s)",bs,1.e-6*bytes/tmult);CHKERRQ(ierr);
+  if (stream > 0.0) {ierr = PetscPrintf(PETSC_COMM_SELF," %5.2f of STREAM triad",1.e-6*bytes/tmult/stream);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_SELF,"\n");CHKERRQ(ierr);
+
+  /* ILU(0) in the natural ordering, as used by PCILU and PCBJACOBI */
+  ierr = MatGetOrdering(A,MATORDERINGNATURAL,&rperm,&cperm);CHKERRQ(ierr);
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill   = 1.0;
+  info.levels = 0;
+  ierr = MatILUFactorSymbolic(F,A,rperm,cperm,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+  ierr = MatSolve(F,x,y);CHKERRQ(ierr);
+  for (i=0; i<nrep; i++) {
+    ierr   = PetscTime(&t);CHKERRQ(ierr);
+    ierr   = MatSolve(F,x,y);CHKERRQ(ierr);
+    ierr   = PetscTimeSubtract(&t);CHKERRQ(ierr);
+    tsolve = PetscMin(tsolve,-t);
+  }
+  ierr  = MatGetInfo(F,MAT_LOCAL,&ainfo);CHKERRQ(ierr);
+  bytes = BAIJBytes(bs,mbs,(PetscInt)(ainfo.nz_used/(bs*bs)));
+  ierr  = PetscPrintf(PETSC_COMM_SELF,"bs %D MatSolve %11.4f Rate (MB/s)",bs,1.e-6*bytes/tsolve);CHKERRQ(ierr);
+  if (stream > 0.0) {ierr = PetscPrintf(PETSC_COMM_SELF," %5.2f of STREAM triad",1.e-6*bytes/tsolve/stream);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_SELF,"\n");CHKERRQ(ierr);
+
+  ierr = ISDestroy(&rperm);CHKERRQ(ierr);
+  ierr = ISDestroy(&cperm);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
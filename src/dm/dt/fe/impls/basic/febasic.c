@@ -165,8 +165,8 @@ PetscErrorCode PetscFECreateTabulation_Basic(PetscFE fem, PetscInt npoints, cons
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
-                                             const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
+PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                      const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
 {
   const PetscInt     debug = 0;
   PetscFE            fe;
@@ -253,9 +253,9 @@ static PetscErrorCode PetscFEIntegrate_Basic(PetscDS ds, PetscInt field, PetscIn
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
-                                               PetscBdPointFunc obj_func,
-                                               PetscInt Ne, PetscFEGeom *fgeom, const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
+PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
+                                        PetscBdPointFunc obj_func,
+                                        PetscInt Ne, PetscFEGeom *fgeom, const PetscScalar coefficients[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscScalar integral[])
 {
   const PetscInt     debug = 0;
   PetscFE            fe;
@@ -357,6 +357,280 @@ static PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
   PetscFunctionReturn(0);
 }
 
+/* Structure of arrays storage for the field jets at the points of a batch of cells, point index fastest */
+typedef struct {
+  PetscInt     maxNe;                 /* Maximum number of cells in a batch */
+  PetscInt     Ne;                    /* Number of cells in the current batch */
+  PetscInt     Np;                    /* Number of points in the current batch */
+  PetscScalar *u, *u_t, *u_x;         /* Field values, time derivatives and gradients */
+  PetscScalar *a, *a_x;               /* Auxiliary field values and gradients */
+  PetscReal   *x;                     /* Point coordinates */
+  PetscReal   *w;                     /* Quadrature weights times the Jacobian determinant */
+} PetscFEBatch_Basic;
+
+static PetscErrorCode PetscFEBatchCreate_Basic(PetscFE fe, PetscDS ds, PetscDS dsAux, PetscInt Ne, PetscInt Nq, PetscInt dE, PetscBool hasU_t, PetscFEBatch_Basic *batch)
+{
+  PetscInt      *uOff, *uOff_x, *aOff, *aOff_x, Nf, NfAux, Np;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  /* The element batch size of the tile sizes sets the number of cells evaluated together */
+  batch->maxNe = fe->batchSize > 0 ? fe->batchSize : PetscMax(1, 128/PetscMax(Nq, 1));
+  batch->maxNe = PetscMin(batch->maxNe, PetscMax(Ne, 1));
+  batch->Ne    = 0;
+  batch->Np    = 0;
+  Np           = batch->maxNe*Nq;
+  ierr = PetscMalloc5(uOff[Nf]*Np, &batch->u, hasU_t ? uOff[Nf]*Np : 0, &batch->u_t, uOff_x[Nf]*Np, &batch->u_x, dE*Np, &batch->x, Np, &batch->w);CHKERRQ(ierr);
+  if (!hasU_t) batch->u_t = NULL;
+  batch->a = batch->a_x = NULL;
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscMalloc2(aOff[NfAux]*Np, &batch->a, aOff_x[NfAux]*Np, &batch->a_x);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEBatchDestroy_Basic(PetscFEBatch_Basic *batch)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree5(batch->u, batch->u_t, batch->u_x, batch->x, batch->w);CHKERRQ(ierr);
+  ierr = PetscFree2(batch->a, batch->a_x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Setup the cell geometry at quadrature point q of cell e, as the pointwise integration loops do */
+PETSC_STATIC_INLINE void PetscFEGeomGetPoint_Basic(PetscFEGeom *cgeom, PetscInt dim, PetscInt e, PetscInt q, const PetscReal quadPoints[], PetscReal x[], PetscFEGeom *fegeom)
+{
+  const PetscInt dE = cgeom->dimEmbed, Np = cgeom->numPoints;
+
+  if (cgeom->isAffine) {
+    fegeom->v    = x;
+    fegeom->xi   = cgeom->xi;
+    fegeom->J    = &cgeom->J[e*dE*dE];
+    fegeom->invJ = &cgeom->invJ[e*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e];
+    CoordinatesRefToReal(dE, dim, fegeom->xi, &cgeom->v[e*dE], fegeom->J, &quadPoints[q*dim], x);
+  } else {
+    fegeom->v    = &cgeom->v[(e*Np+q)*dE];
+    fegeom->J    = &cgeom->J[(e*Np+q)*dE*dE];
+    fegeom->invJ = &cgeom->invJ[(e*Np+q)*dE*dE];
+    fegeom->detJ = &cgeom->detJ[e*Np+q];
+  }
+}
+
+/* Evaluate the field jets at all quadrature points of cells [eStart, eStart+Ne) and transpose them into the batch */
+static PetscErrorCode PetscFEBatchEvaluate_Basic(PetscDS ds, PetscDS dsAux, PetscInt eStart, PetscInt Ne, PetscFEGeom *cgeom, PetscQuadrature quad,
+                                                 const PetscScalar coefficients[], const PetscScalar coefficients_t[], const PetscScalar coefficientsAux[], PetscFEBatch_Basic *batch)
+{
+  const PetscReal *quadPoints, *quadWeights;
+  PetscTabulation *T, *TAux = NULL;
+  PetscScalar     *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL;
+  PetscReal       *x;
+  PetscInt        *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt         dim, Nf, NfAux = 0, totDim, totDimAux = 0, Nq, Np, dE = cgeom->dimEmbed, e, q, i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetSpatialDimension(ds, &dim);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetEvaluationArrays(ds, &u, batch->u_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(dsAux, &a, NULL, &a_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &TAux);CHKERRQ(ierr);
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  batch->Ne = Ne;
+  batch->Np = Np = Ne*Nq;
+  if (!coefficients) {
+    ierr = PetscArrayzero(batch->u, uOff[Nf]*Np);CHKERRQ(ierr);
+    ierr = PetscArrayzero(batch->u_x, uOff_x[Nf]*Np);CHKERRQ(ierr);
+    if (batch->u_t) {ierr = PetscArrayzero(batch->u_t, uOff[Nf]*Np);CHKERRQ(ierr);}
+  }
+  for (e = 0; e < Ne; ++e) {
+    const PetscInt cOffset    = (eStart+e)*totDim;
+    const PetscInt cOffsetAux = (eStart+e)*totDimAux;
+
+    for (q = 0; q < Nq; ++q) {
+      const PetscInt p = e*Nq+q;
+      PetscFEGeom    fegeom;
+
+      PetscFEGeomGetPoint_Basic(cgeom, dim, eStart+e, q, quadPoints, x, &fegeom);
+      batch->w[p] = fegeom.detJ[0]*quadWeights[q];
+      for (i = 0; i < dE; ++i) batch->x[i*Np+p] = fegeom.v[i];
+      if (coefficients) {
+        ierr = PetscFEEvaluateFieldJets_Internal(ds, Nf, 0, q, T, &fegeom, &coefficients[cOffset], coefficients_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);
+        for (i = 0; i < uOff[Nf];   ++i) batch->u[i*Np+p]   = u[i];
+        for (i = 0; i < uOff_x[Nf]; ++i) batch->u_x[i*Np+p] = u_x[i];
+        if (u_t) {for (i = 0; i < uOff[Nf]; ++i) batch->u_t[i*Np+p] = u_t[i];}
+      }
+      if (dsAux) {
+        ierr = PetscFEEvaluateFieldJets_Internal(dsAux, NfAux, 0, q, TAux, &fegeom, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);
+        for (i = 0; i < aOff[NfAux];   ++i) batch->a[i*Np+p]   = a[i];
+        for (i = 0; i < aOff_x[NfAux]; ++i) batch->a_x[i*Np+p] = a_x[i];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateResidualBatch_Basic(PetscDS ds, PetscInt field, PetscPointFuncBatch f0_func, PetscPointFuncBatch f1_func, PetscInt Ne, PetscFEGeom *cgeom,
+                                                          const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscFE             fe;
+  PetscQuadrature     quad;
+  PetscTabulation    *T;
+  PetscFEBatch_Basic  batch;
+  PetscScalar        *f0, *f1, *f0b, *f1b, *basisReal, *basisDerReal;
+  const PetscScalar  *constants;
+  const PetscReal    *quadPoints;
+  PetscReal          *x;
+  PetscInt           *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt            dim, numConstants, Nf, NfAux = 0, totDim, fOffset, NcI, Nq, eStart, e, q, c, d;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, NULL);CHKERRQ(ierr);
+  NcI  = T[field]->Nc;
+  ierr = PetscFEBatchCreate_Basic(fe, ds, dsAux, Ne, Nq, cgeom->dimEmbed, coefficients_t ? PETSC_TRUE : PETSC_FALSE, &batch);CHKERRQ(ierr);
+  ierr = PetscMalloc2(NcI*batch.maxNe*Nq, &f0b, NcI*dim*batch.maxNe*Nq, &f1b);CHKERRQ(ierr);
+  for (eStart = 0; eStart < Ne; eStart += batch.maxNe) {
+    PetscInt Np;
+
+    ierr = PetscFEBatchEvaluate_Basic(ds, dsAux, eStart, PetscMin(batch.maxNe, Ne-eStart), cgeom, quad, coefficients, coefficients_t, coefficientsAux, &batch);CHKERRQ(ierr);
+    Np   = batch.Np;
+    ierr = PetscArrayzero(f0b, NcI*Np);CHKERRQ(ierr);
+    ierr = PetscArrayzero(f1b, NcI*dim*Np);CHKERRQ(ierr);
+    if (f0_func) f0_func(dim, Nf, NfAux, Np, uOff, uOff_x, batch.u, batch.u_t, batch.u_x, aOff, aOff_x, batch.a, NULL, batch.a_x, t, batch.x, numConstants, constants, f0b);
+    if (f1_func) f1_func(dim, Nf, NfAux, Np, uOff, uOff_x, batch.u, batch.u_t, batch.u_x, aOff, aOff_x, batch.a, NULL, batch.a_x, t, batch.x, numConstants, constants, f1b);
+    for (e = 0; e < batch.Ne; ++e) {
+      PetscFEGeom fegeom;
+
+      for (q = 0; q < Nq; ++q) {
+        const PetscInt  p = e*Nq+q;
+        const PetscReal w = batch.w[p];
+
+        for (c = 0; c < NcI; ++c) {
+          f0[q*NcI+c] = f0b[c*Np+p]*w;
+          for (d = 0; d < dim; ++d) f1[(q*NcI+c)*dim+d] = f1b[(c*dim+d)*Np+p]*w;
+        }
+        PetscFEGeomGetPoint_Basic(cgeom, dim, eStart+e, q, quadPoints, x, &fegeom);
+      }
+      ierr = PetscFEUpdateElementVec_Internal(fe, T[field], 0, basisReal, basisDerReal, &fegeom, f0, f1, &elemVec[(eStart+e)*totDim+fOffset]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree2(f0b, f1b);CHKERRQ(ierr);
+  ierr = PetscFEBatchDestroy_Basic(&batch);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateJacobianBatch_Basic(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscPointJacBatch g_func[], PetscInt Ne, PetscFEGeom *cgeom,
+                                                          const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  PetscFE             feI, feJ;
+  PetscQuadrature     quad;
+  PetscTabulation    *T;
+  PetscFEBatch_Basic  batch;
+  PetscScalar        *g[4], *gb[4], *basisReal, *basisDerReal, *testReal, *testDerReal;
+  const PetscScalar  *constants;
+  const PetscReal    *quadPoints;
+  PetscReal          *x;
+  PetscInt           *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt            dim, numConstants, Nf, NfAux = 0, totDim, offsetI, offsetJ, NcI, NcJ, Nq, gSize[4], eStart, e, q, i, k;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetDiscretization(ds, fieldI, (PetscObject *) &feI);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(ds, fieldJ, (PetscObject *) &feJ);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(feI, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(feI, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, &testReal, &testDerReal);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, NULL, NULL, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldJ, &offsetJ);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, NULL);CHKERRQ(ierr);
+  NcI = T[fieldI]->Nc, NcJ = T[fieldJ]->Nc;
+  gSize[0] = NcI*NcJ;
+  gSize[1] = gSize[2] = NcI*NcJ*dim;
+  gSize[3] = NcI*NcJ*dim*dim;
+  for (k = 0; k < 4; ++k) {ierr = PetscArrayzero(g[k], gSize[k]);CHKERRQ(ierr);}
+  ierr = PetscFEBatchCreate_Basic(feI, ds, dsAux, Ne, Nq, cgeom->dimEmbed, coefficients_t ? PETSC_TRUE : PETSC_FALSE, &batch);CHKERRQ(ierr);
+  ierr = PetscMalloc4(gSize[0]*batch.maxNe*Nq, &gb[0], gSize[1]*batch.maxNe*Nq, &gb[1], gSize[2]*batch.maxNe*Nq, &gb[2], gSize[3]*batch.maxNe*Nq, &gb[3]);CHKERRQ(ierr);
+  for (eStart = 0; eStart < Ne; eStart += batch.maxNe) {
+    PetscInt Np;
+
+    ierr = PetscFEBatchEvaluate_Basic(ds, dsAux, eStart, PetscMin(batch.maxNe, Ne-eStart), cgeom, quad, coefficients, coefficients_t, coefficientsAux, &batch);CHKERRQ(ierr);
+    Np   = batch.Np;
+    for (k = 0; k < 4; ++k) {
+      if (!g_func[k]) continue;
+      ierr = PetscArrayzero(gb[k], gSize[k]*Np);CHKERRQ(ierr);
+      g_func[k](dim, Nf, NfAux, Np, uOff, uOff_x, batch.u, batch.u_t, batch.u_x, aOff, aOff_x, batch.a, NULL, batch.a_x, t, u_tshift, batch.x, numConstants, constants, gb[k]);
+    }
+    for (e = 0; e < batch.Ne; ++e) {
+      const PetscInt eOffset = (eStart+e)*totDim*totDim;
+
+      for (q = 0; q < Nq; ++q) {
+        const PetscInt  p = e*Nq+q;
+        const PetscReal w = batch.w[p];
+        PetscFEGeom     fegeom;
+
+        for (k = 0; k < 4; ++k) {
+          if (!g_func[k]) continue;
+          for (i = 0; i < gSize[k]; ++i) g[k][i] = gb[k][i*Np+p]*w;
+        }
+        PetscFEGeomGetPoint_Basic(cgeom, dim, eStart+e, q, quadPoints, x, &fegeom);
+        ierr = PetscFEUpdateElementMat_Internal(feI, feJ, 0, q, T[fieldI], basisReal, basisDerReal, T[fieldJ], testReal, testDerReal, &fegeom, g[0], g[1], g[2], g[3], eOffset, totDim, offsetI, offsetJ, elemMat);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscFree4(gb[0], gb[1], gb[2], gb[3]);CHKERRQ(ierr);
+  ierr = PetscFEBatchDestroy_Basic(&batch);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
                                               const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
@@ -364,6 +638,7 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscI
   PetscFE            fe;
   PetscPointFunc     f0_func;
   PetscPointFunc     f1_func;
+  PetscPointFuncBatch f0_batch, f1_batch;
   PetscQuadrature    quad;
   PetscTabulation   *T, *TAux = NULL;
   PetscScalar       *f0, *f1, *u, *u_t = NULL, *u_x, *a, *a_x, *basisReal, *basisDerReal;
@@ -386,6 +661,11 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscInt field, PetscI
   ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
   ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
   ierr = PetscDSGetResidual(ds, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetResidualBatch(ds, field, &f0_batch, &f1_batch);CHKERRQ(ierr);
+  if (f0_batch || f1_batch) {
+    ierr = PetscFEIntegrateResidualBatch_Basic(ds, field, f0_batch, f1_batch, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
   ierr = PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, NULL, NULL);CHKERRQ(ierr);
   ierr = PetscDSGetWeakFormArrays(ds, &f0, &f1, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
@@ -577,6 +857,7 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   const PetscInt     debug      = 0;
   PetscFE            feI, feJ;
   PetscPointJac      g0_func, g1_func, g2_func, g3_func;
+  PetscPointJacBatch g_batch[4] = {NULL, NULL, NULL, NULL};
   PetscInt           cOffset    = 0; /* Offset into coefficients[] for element e */
   PetscInt           cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
   PetscInt           eOffset    = 0; /* Offset into elemMat[] for element e */
@@ -608,7 +889,14 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   switch(jtype) {
   case PETSCFE_JACOBIAN_DYN: ierr = PetscDSGetDynamicJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
   case PETSCFE_JACOBIAN_PRE: ierr = PetscDSGetJacobianPreconditioner(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
-  case PETSCFE_JACOBIAN:     ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);break;
+  case PETSCFE_JACOBIAN:
+    ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+    ierr = PetscDSGetJacobianBatch(ds, fieldI, fieldJ, &g_batch[0], &g_batch[1], &g_batch[2], &g_batch[3]);CHKERRQ(ierr);
+    break;
+  }
+  if (g_batch[0] || g_batch[1] || g_batch[2] || g_batch[3]) {
+    ierr = PetscFEIntegrateJacobianBatch_Basic(ds, fieldI, fieldJ, g_batch, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, u_tshift, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
   }
   if (!g0_func && !g1_func && !g2_func && !g3_func) PetscFunctionReturn(0);
   ierr = PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x);CHKERRQ(ierr);
@@ -710,8 +998,8 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *fgeom,
-                                                       const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscDS ds, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFEGeom *fgeom,
+                                                const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
 {
   const PetscInt     debug      = 0;
   PetscFE            feI, feJ;
@@ -0,0 +1,870 @@
+#include <petsc/private/petscfeimpl.h> /*I "petscfe.h" I*/
+
+/*
+  Sum factorization for tensor product elements
+
+  When the nodal basis is a tensor product of 1D Lagrange polynomials and the quadrature is a tensor product of 1D
+  rules, the interpolation of a field to the quadrature points, and the integration against the basis functions, are
+  products of 1D operators, one per direction. With P nodes and Q quadrature points in each direction, applying them
+  one direction at a time costs O(dim Q P^dim) per element instead of O(Q^dim P^dim) with the full tabulation.
+
+  We do not assume any particular ordering of the dual space functionals or the quadrature points. The lexicographic
+  numbering is recovered from the coordinates of the nodes and points, and the 1D tabulation is checked against the full
+  tabulation of the element, so that any element without this structure simply uses the basic kernels.
+*/
+
+static PetscErrorCode PetscFETensorReset_Private(PetscFE_Tensor *t)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscQuadratureDestroy(&t->quad);CHKERRQ(ierr);
+  ierr = PetscFree2(t->lexToBasis, t->qperm);CHKERRQ(ierr);
+  ierr = PetscFree2(t->B, t->D);CHKERRQ(ierr);
+  ierr = PetscFree(t->work);CHKERRQ(ierr);
+  t->isTensor = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEDestroy_Tensor(PetscFE fem)
+{
+  PetscFE_Tensor *t = (PetscFE_Tensor *) fem->data;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFETensorReset_Private(t);CHKERRQ(ierr);
+  ierr = PetscFree(t);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Collect the distinct values of coordinate d of the n points in increasing order */
+static PetscErrorCode PetscFETensorGetCoordinates_Private(PetscInt n, PetscInt dim, const PetscReal points[], PetscInt d, PetscInt *m, PetscReal x[])
+{
+  PetscInt       i, k = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i = 0; i < n; ++i) x[i] = points[i*dim+d];
+  ierr = PetscSortReal(n, x);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) if (!k || x[i] - x[k-1] > PETSC_SMALL) x[k++] = x[i];
+  *m = k;
+  PetscFunctionReturn(0);
+}
+
+/* The lexicographic index, with the first direction varying fastest, of a point whose coordinates belong to the 1D set x */
+static PetscInt PetscFETensorLexIndex_Private(PetscInt dim, PetscInt m, const PetscReal x[], const PetscReal point[])
+{
+  PetscInt d, i, l = 0, stride = 1;
+
+  for (d = 0; d < dim; ++d, stride *= m) {
+    for (i = 0; i < m; ++i) if (PetscAbsReal(point[d] - x[i]) <= PETSC_SMALL) break;
+    if (i == m) return -1;
+    l += i*stride;
+  }
+  return l;
+}
+
+/* Values B[j] and derivatives D[j] at y of the Lagrange polynomials on the nodes x[0..P-1] */
+static void PetscFETensorLagrange_Private(PetscInt P, const PetscReal x[], PetscReal y, PetscReal B[], PetscReal D[])
+{
+  PetscInt j, k, m;
+
+  for (j = 0; j < P; ++j) {
+    B[j] = 1.0;
+    D[j] = 0.0;
+    for (m = 0; m < P; ++m) if (m != j) B[j] *= (y - x[m])/(x[j] - x[m]);
+    for (k = 0; k < P; ++k) {
+      PetscReal p;
+
+      if (k == j) continue;
+      p = 1.0/(x[j] - x[k]);
+      for (m = 0; m < P; ++m) if (m != j && m != k) p *= (y - x[m])/(x[j] - x[m]);
+      D[j] += p;
+    }
+  }
+}
+
+/* Detect the tensor product structure of the element and its quadrature, and build the 1D tabulation */
+static PetscErrorCode PetscFETensorSetUpKernels_Private(PetscFE fem)
+{
+  PetscFE_Tensor  *t = (PetscFE_Tensor *) fem->data;
+  PetscDualSpace   dsp;
+  PetscTabulation  T;
+  const PetscReal *qpoints;
+  PetscReal       *nodes, *x, *x1, *q1, err = 0.0, scale = 1.0;
+  PetscInt        *comp, *blex, *mark;
+  PetscInt         dim, Nc, Nb, Nq, qdim, qNc, trans, P = 0, Q = 0, Pd = 1, Qd = 1, M, m, b, c, d, e, q, l;
+  PetscBool        isTensor = PETSC_TRUE;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (t->quad == fem->quadrature) PetscFunctionReturn(0);
+  ierr = PetscFETensorReset_Private(t);CHKERRQ(ierr);
+  if (!fem->quadrature) PetscFunctionReturn(0);
+  ierr = PetscObjectReference((PetscObject) fem->quadrature);CHKERRQ(ierr);
+  t->quad = fem->quadrature;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fem, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fem, &Nb);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fem, &dsp);CHKERRQ(ierr);
+  ierr = PetscDualSpaceGetDeRahm(dsp, &trans);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(fem->quadrature, &qdim, &qNc, &Nq, &qpoints, NULL);CHKERRQ(ierr);
+  if (trans != IDENTITY_TRANSFORM || qdim != dim || qNc != 1 || dim < 1 || dim > 3) {
+    ierr = PetscInfo(fem, "No tensor product structure: only scalar quadrature of H^1 elements in 1, 2 and 3 dimensions is supported\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc6(Nb*dim, &nodes, Nb, &comp, Nb, &blex, PetscMax(Nb, Nq), &x, Nb, &x1, Nq, &q1);CHKERRQ(ierr);
+  /* The nodes and components of the point evaluation functionals */
+  for (b = 0; b < Nb && isTensor; ++b) {
+    PetscQuadrature  f;
+    const PetscReal *fpoints, *fweights;
+    PetscInt         fNc, fNq;
+
+    ierr = PetscDualSpaceGetFunctional(dsp, b, &f);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(f, NULL, &fNc, &fNq, &fpoints, &fweights);CHKERRQ(ierr);
+    if (fNq != 1 || fNc != Nc) {isTensor = PETSC_FALSE; break;}
+    for (d = 0; d < dim; ++d) nodes[b*dim+d] = fpoints[d];
+    for (comp[b] = -1, c = 0; c < Nc; ++c) {
+      if (fweights[c] == 0.0) continue;
+      if (comp[b] >= 0) isTensor = PETSC_FALSE;
+      comp[b] = c;
+    }
+    if (comp[b] < 0) isTensor = PETSC_FALSE;
+  }
+  /* The 1D nodes and quadrature points must be the same in every direction */
+  for (d = 0; d < dim && isTensor; ++d) {
+    ierr = PetscFETensorGetCoordinates_Private(Nb, dim, nodes, d, &m, x);CHKERRQ(ierr);
+    if (!d) {P = m; ierr = PetscArraycpy(x1, x, m);CHKERRQ(ierr);}
+    else if (m != P) isTensor = PETSC_FALSE;
+    else for (l = 0; l < m; ++l) if (PetscAbsReal(x[l] - x1[l]) > PETSC_SMALL) isTensor = PETSC_FALSE;
+    ierr = PetscFETensorGetCoordinates_Private(Nq, dim, qpoints, d, &m, x);CHKERRQ(ierr);
+    if (!d) {Q = m; ierr = PetscArraycpy(q1, x, m);CHKERRQ(ierr);}
+    else if (m != Q) isTensor = PETSC_FALSE;
+    else for (l = 0; l < m; ++l) if (PetscAbsReal(x[l] - q1[l]) > PETSC_SMALL) isTensor = PETSC_FALSE;
+  }
+  if (isTensor) {
+    for (d = 0; d < dim; ++d) {Pd *= P; Qd *= Q;}
+    if (Nb != Nc*Pd || Nq != Qd) isTensor = PETSC_FALSE;
+  }
+  /* The lexicographic numbering must be a bijection */
+  if (isTensor) {
+    ierr = PetscMalloc2(Nb, &t->lexToBasis, Nq, &t->qperm);CHKERRQ(ierr);
+    ierr = PetscCalloc1(PetscMax(Nb, Nq), &mark);CHKERRQ(ierr);
+    for (b = 0; b < Nb && isTensor; ++b) {
+      l = PetscFETensorLexIndex_Private(dim, P, x1, &nodes[b*dim]);
+      if (l < 0 || mark[comp[b]*Pd+l]) {isTensor = PETSC_FALSE; break;}
+      blex[b] = comp[b]*Pd+l;
+      mark[blex[b]] = 1;
+      t->lexToBasis[blex[b]] = b;
+    }
+    ierr = PetscArrayzero(mark, PetscMax(Nb, Nq));CHKERRQ(ierr);
+    for (q = 0; q < Nq && isTensor; ++q) {
+      l = PetscFETensorLexIndex_Private(dim, Q, q1, &qpoints[q*dim]);
+      if (l < 0 || mark[l]) {isTensor = PETSC_FALSE; break;}
+      mark[l] = 1;
+      t->qperm[q] = l;
+    }
+    ierr = PetscFree(mark);CHKERRQ(ierr);
+  }
+  /* The 1D tabulation must reproduce the full tabulation of the element */
+  if (isTensor) {
+    ierr = PetscMalloc2(Q*P, &t->B, Q*P, &t->D);CHKERRQ(ierr);
+    for (q = 0; q < Q; ++q) PetscFETensorLagrange_Private(P, x1, q1[q], &t->B[q*P], &t->D[q*P]);
+    ierr = PetscFEGetCellTabulation(fem, &T);CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      for (b = 0; b < Nb; ++b) {
+        for (c = 0; c < Nc; ++c) {
+          const PetscInt bidx = (q*Nb+b)*Nc+c;
+          PetscReal      val = 0.0, der[3] = {0.0, 0.0, 0.0};
+
+          if (c == blex[b]/Pd) {
+            PetscInt ql = t->qperm[q], bl = blex[b]%Pd;
+
+            val = 1.0;
+            for (e = 0; e < dim; ++e) der[e] = 1.0;
+            for (d = 0; d < dim; ++d, ql /= Q, bl /= P) {
+              val *= t->B[(ql%Q)*P+bl%P];
+              for (e = 0; e < dim; ++e) der[e] *= e == d ? t->D[(ql%Q)*P+bl%P] : t->B[(ql%Q)*P+bl%P];
+            }
+          }
+          scale = PetscMax(scale, PetscAbsReal(T->T[0][bidx]));
+          err   = PetscMax(err, PetscAbsReal(T->T[0][bidx] - val));
+          for (e = 0; e < dim; ++e) {
+            scale = PetscMax(scale, PetscAbsReal(T->T[1][bidx*dim+e]));
+            err   = PetscMax(err, PetscAbsReal(T->T[1][bidx*dim+e] - der[e]));
+          }
+        }
+      }
+    }
+    if (err > 1.0e3*PETSC_SQRT_MACHINE_EPSILON*scale) isTensor = PETSC_FALSE;
+  }
+  ierr = PetscFree6(nodes, comp, blex, x, x1, q1);CHKERRQ(ierr);
+  if (!isTensor) {
+    ierr = PetscFETensorReset_Private(t);CHKERRQ(ierr);
+    ierr = PetscObjectReference((PetscObject) fem->quadrature);CHKERRQ(ierr);
+    t->quad = fem->quadrature;
+    ierr = PetscInfo(fem, "No tensor product structure, using the full tabulation\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (M = 1, d = 0; d < dim; ++d) M *= PetscMax(P, Q);
+  ierr = PetscMalloc1(4*M, &t->work);CHKERRQ(ierr);
+  t->isTensor = PETSC_TRUE;
+  t->dim      = dim;
+  t->Nc       = Nc;
+  t->P        = P;
+  t->Q        = Q;
+  ierr = PetscInfo4(fem, "Sum factorization with %D nodes and %D quadrature points in each of %D directions, 1D tabulation error %g\n", P, Q, dim, (double) err);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEView_Tensor_Ascii(PetscFE fe, PetscViewer v)
+{
+  PetscFE_Tensor  *t = (PetscFE_Tensor *) fe->data;
+  PetscInt         dim, Nc;
+  PetscSpace       basis = NULL;
+  PetscDualSpace   dual = NULL;
+  PetscQuadrature  quad = NULL;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetBasisSpace(fe, &basis);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe, &dual);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  if (fe->setupcalled) {ierr = PetscFETensorSetUpKernels_Private(fe);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPushTab(v);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(v, "Tensor product Finite Element in %D dimensions with %D components\n",dim,Nc);CHKERRQ(ierr);
+  if (t->isTensor) {ierr = PetscViewerASCIIPrintf(v, "Sum factorization with %D nodes and %D quadrature points in each direction\n",t->P,t->Q);CHKERRQ(ierr);}
+  else             {ierr = PetscViewerASCIIPrintf(v, "No tensor product structure, using the full tabulation\n");CHKERRQ(ierr);}
+  if (basis) {ierr = PetscSpaceView(basis, v);CHKERRQ(ierr);}
+  if (dual)  {ierr = PetscDualSpaceView(dual, v);CHKERRQ(ierr);}
+  if (quad)  {ierr = PetscQuadratureView(quad, v);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPopTab(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEView_Tensor(PetscFE fe, PetscViewer v)
+{
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject) v, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {ierr = PetscFEView_Tensor_Ascii(fe, v);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* Whether the sum factorized kernels can be used for this element with Nq quadrature points */
+static PetscErrorCode PetscFETensorUsable_Private(PetscFE fe, PetscInt Nq, PetscBool *flg)
+{
+  PetscFE_Tensor *t;
+  PetscInt        d, Qd = 1;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject) fe, PETSCFETENSOR, flg);CHKERRQ(ierr);
+  if (!*flg) PetscFunctionReturn(0);
+  ierr = PetscFETensorSetUpKernels_Private(fe);CHKERRQ(ierr);
+  t = (PetscFE_Tensor *) fe->data;
+  for (d = 0; d < t->dim; ++d) Qd *= t->Q;
+  *flg = t->isTensor && Qd == Nq ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* Whether the test field, and the fields of ds and dsAux, can be integrated with the tensor kernels */
+static PetscErrorCode PetscFETensorCanIntegrate_Private(PetscDS ds, PetscInt field, PetscDS dsAux, PetscFEGeom *cgeom, PetscBool *flg)
+{
+  PetscDS        dss[2];
+  PetscFE        fe;
+  PetscInt       dim, Nq, Nf, i, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  /* Batched pointwise functions are only evaluated by the basic implementation */
+  {
+    PetscPointFuncBatch f0, f1;
+    PetscPointJacBatch  g[4];
+
+    ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+    ierr = PetscDSGetResidualBatch(ds, field, &f0, &f1);CHKERRQ(ierr);
+    if (f0 || f1) PetscFunctionReturn(0);
+    for (f = 0; f < Nf; ++f) {
+      ierr = PetscDSGetJacobianBatch(ds, field, f, &g[0], &g[1], &g[2], &g[3]);CHKERRQ(ierr);
+      if (g[0] || g[1] || g[2] || g[3]) PetscFunctionReturn(0);
+    }
+  }
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(fe->quadrature, NULL, NULL, &Nq, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscFETensorUsable_Private(fe, Nq, flg);CHKERRQ(ierr);
+  if (!*flg) PetscFunctionReturn(0);
+  if (cgeom->dimEmbed != dim) {*flg = PETSC_FALSE; PetscFunctionReturn(0);}
+  dss[0] = ds; dss[1] = dsAux;
+  for (i = 0; i < 2; ++i) {
+    PetscTabulation *T;
+
+    if (!dss[i]) continue;
+    ierr = PetscDSGetNumFields(dss[i], &Nf);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dss[i], &T);CHKERRQ(ierr);
+    for (f = 0; f < Nf; ++f) {
+      PetscObject  obj;
+      PetscClassId id;
+
+      ierr = PetscDSGetDiscretization(dss[i], f, &obj);CHKERRQ(ierr);
+      ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+      if (id != PETSCFE_CLASSID || T[f]->Np != Nq) {*flg = PETSC_FALSE; PetscFunctionReturn(0);}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  Apply the 1D matrix M (m x n) to the middle index of a tensor stored as [post][n][pre], giving [post][m][pre],
+  or apply M^T to a tensor stored as [post][m][pre], giving [post][n][pre]
+*/
+static PetscErrorCode PetscFETensorContract_Private(PetscInt pre, PetscInt post, PetscInt m, PetscInt n, const PetscReal M[], PetscBool transpose, const PetscScalar in[], PetscScalar out[])
+{
+  PetscInt       o, a, j, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!transpose) {
+    for (o = 0; o < post; ++o) {
+      for (a = 0; a < m; ++a) {
+        PetscScalar *y = &out[(o*m+a)*pre];
+
+        for (i = 0; i < pre; ++i) y[i] = 0.0;
+        for (j = 0; j < n; ++j) {
+          const PetscReal    Maj = M[a*n+j];
+          const PetscScalar *x   = &in[(o*n+j)*pre];
+
+          for (i = 0; i < pre; ++i) y[i] += Maj*x[i];
+        }
+      }
+    }
+  } else {
+    for (o = 0; o < post; ++o) {
+      for (j = 0; j < n; ++j) {
+        PetscScalar *y = &out[(o*n+j)*pre];
+
+        for (i = 0; i < pre; ++i) y[i] = 0.0;
+        for (a = 0; a < m; ++a) {
+          const PetscReal    Maj = M[a*n+j];
+          const PetscScalar *x   = &in[(o*m+a)*pre];
+
+          for (i = 0; i < pre; ++i) y[i] += Maj*x[i];
+        }
+      }
+    }
+  }
+  ierr = PetscLogFlops(2.0*pre*post*m*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Apply M_{dim-1} x ... x M_0, where M_k is the derivative tabulation D for k == deriv and B otherwise, to one component
+  given at the nodes, giving its values at the quadrature points, or apply the transpose to values at the quadrature
+  points, giving the integrals against the basis functions. Both are in lexicographic order, and out is w0 or w1.
+*/
+static PetscErrorCode PetscFETensorApply_Private(PetscFE_Tensor *t, PetscInt deriv, PetscBool transpose, const PetscScalar in[], PetscScalar w0[], PetscScalar w1[], const PetscScalar **out)
+{
+  const PetscScalar *x = in;
+  PetscInt           k, pre = 1, post = 1;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  for (k = 1; k < t->dim; ++k) post *= transpose ? t->Q : t->P;
+  for (k = 0; k < t->dim; ++k) {
+    PetscScalar *y = k%2 ? w1 : w0;
+
+    ierr = PetscFETensorContract_Private(pre, post, t->Q, t->P, k == deriv ? t->D : t->B, transpose, x, y);CHKERRQ(ierr);
+    x    = y;
+    pre *= transpose ? t->P : t->Q;
+    if (k < t->dim-1) post /= transpose ? t->Q : t->P;
+  }
+  *out = x;
+  PetscFunctionReturn(0);
+}
+
+/* Evaluate the field with coefficients coef, and its reference gradient, at all quadrature points: u[q*ldu+c] and u_x[(q*ldu+c)*dim+d] */
+static PetscErrorCode PetscFETensorInterpolate_Private(PetscFE fe, const PetscScalar coef[], PetscInt ldu, PetscScalar u[], PetscScalar u_x[])
+{
+  PetscFE_Tensor    *t = (PetscFE_Tensor *) fe->data;
+  const PetscInt     dim = t->dim;
+  const PetscScalar *y;
+  PetscScalar       *x, *w0, *w1;
+  PetscInt           Pd = 1, Nq = 1, M = 1, c, d, l, q;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  for (d = 0; d < dim; ++d) {Pd *= t->P; Nq *= t->Q; M *= PetscMax(t->P, t->Q);}
+  x  = t->work;
+  w0 = x + M;
+  w1 = w0 + M;
+  for (c = 0; c < t->Nc; ++c) {
+    for (l = 0; l < Pd; ++l) x[l] = coef[t->lexToBasis[c*Pd+l]];
+    ierr = PetscFETensorApply_Private(t, -1, PETSC_FALSE, x, w0, w1, &y);CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) u[q*ldu+c] = y[t->qperm[q]];
+    if (!u_x) continue;
+    for (d = 0; d < dim; ++d) {
+      ierr = PetscFETensorApply_Private(t, d, PETSC_FALSE, x, w0, w1, &y);CHKERRQ(ierr);
+      for (q = 0; q < Nq; ++q) u_x[(q*ldu+c)*dim+d] = y[t->qperm[q]];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Integrate against the basis functions, elemVec[b] = \sum_q \psi_b(q) f0[q*Nc+c] + \hat\nabla\psi_b(q) . f1[(q*Nc+c)*dim+d], with reference gradients */
+static PetscErrorCode PetscFETensorIntegrate_Private(PetscFE fe, const PetscScalar f0[], const PetscScalar f1[], PetscScalar elemVec[])
+{
+  PetscFE_Tensor    *t = (PetscFE_Tensor *) fe->data;
+  const PetscInt     dim = t->dim, Nc = t->Nc;
+  const PetscScalar *y;
+  PetscScalar       *x, *w0, *w1, *acc;
+  PetscInt           Pd = 1, Nq = 1, M = 1, c, d, l, q;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  for (d = 0; d < dim; ++d) {Pd *= t->P; Nq *= t->Q; M *= PetscMax(t->P, t->Q);}
+  x   = t->work;
+  w0  = x + M;
+  w1  = w0 + M;
+  acc = w1 + M;
+  for (c = 0; c < Nc; ++c) {
+    for (l = 0; l < Pd; ++l) acc[l] = 0.0;
+    if (f0) {
+      for (q = 0; q < Nq; ++q) x[t->qperm[q]] = f0[q*Nc+c];
+      ierr = PetscFETensorApply_Private(t, -1, PETSC_TRUE, x, w0, w1, &y);CHKERRQ(ierr);
+      for (l = 0; l < Pd; ++l) acc[l] += y[l];
+    }
+    if (f1) {
+      for (d = 0; d < dim; ++d) {
+        for (q = 0; q < Nq; ++q) x[t->qperm[q]] = f1[(q*Nc+c)*dim+d];
+        ierr = PetscFETensorApply_Private(t, d, PETSC_TRUE, x, w0, w1, &y);CHKERRQ(ierr);
+        for (l = 0; l < Pd; ++l) acc[l] += y[l];
+      }
+    }
+    for (l = 0; l < Pd; ++l) elemVec[t->lexToBasis[c*Pd+l]] = acc[l];
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Evaluate all fields of ds, and their reference gradients, at all Nq quadrature points of one element */
+static PetscErrorCode PetscFETensorEvaluateFields_Private(PetscDS ds, PetscTabulation T[], PetscInt Nq, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt       Nf, totComp, dOffset = 0, fOffset = 0, f, q, b, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &totComp);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscFE        fe;
+    const PetscInt cdim = T[f]->cdim;
+    const PetscInt Nbf  = T[f]->Nb;
+    const PetscInt Ncf  = T[f]->Nc;
+    PetscBool      isTensor;
+
+    ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFETensorUsable_Private(fe, Nq, &isTensor);CHKERRQ(ierr);
+    if (isTensor) {
+      ierr = PetscFETensorInterpolate_Private(fe, &coefficients[dOffset], totComp, &u[fOffset], &u_x[fOffset*cdim]);CHKERRQ(ierr);
+      if (u_t) {ierr = PetscFETensorInterpolate_Private(fe, &coefficients_t[dOffset], totComp, &u_t[fOffset], NULL);CHKERRQ(ierr);}
+    } else {
+      for (q = 0; q < Nq; ++q) {
+        const PetscReal *Bq = &T[f]->T[0][q*Nbf*Ncf];
+        const PetscReal *Dq = &T[f]->T[1][q*Nbf*Ncf*cdim];
+        PetscScalar     *uq = &u[q*totComp+fOffset], *u_xq = &u_x[(q*totComp+fOffset)*cdim];
+
+        for (c = 0; c < Ncf; ++c) uq[c] = 0.0;
+        for (d = 0; d < cdim*Ncf; ++d) u_xq[d] = 0.0;
+        for (b = 0; b < Nbf; ++b) {
+          for (c = 0; c < Ncf; ++c) {
+            const PetscInt cidx = b*Ncf+c;
+
+            uq[c] += Bq[cidx]*coefficients[dOffset+b];
+            for (d = 0; d < cdim; ++d) u_xq[c*cdim+d] += Dq[cidx*cdim+d]*coefficients[dOffset+b];
+          }
+        }
+        if (u_t) {
+          PetscScalar *u_tq = &u_t[q*totComp+fOffset];
+
+          for (c = 0; c < Ncf; ++c) u_tq[c] = 0.0;
+          for (b = 0; b < Nbf; ++b) for (c = 0; c < Ncf; ++c) u_tq[c] += Bq[b*Ncf+c]*coefficients_t[dOffset+b];
+        }
+      }
+    }
+    fOffset += Ncf;
+    dOffset += Nbf;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Map the field values and gradients of all fields at one quadrature point to real space */
+static PetscErrorCode PetscFETensorPushforward_Private(PetscDS ds, PetscFEGeom *fegeom, const PetscInt uOff[], const PetscInt uOff_x[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[])
+{
+  PetscInt       Nf, f;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscFE fe;
+
+    ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEPushforward(fe, fegeom, 1, &u[uOff[f]]);CHKERRQ(ierr);
+    ierr = PetscFEPushforwardGradient(fe, fegeom, 1, &u_x[uOff_x[f]]);CHKERRQ(ierr);
+    if (u_t) {ierr = PetscFEPushforward(fe, fegeom, 1, &u_t[uOff[f]]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Scale the pointwise f0 and f1 by the quadrature weight, and pull f1 back to the reference element so that it pairs with reference gradients */
+PETSC_STATIC_INLINE void PetscFETensorPullback_Private(PetscInt dim, PetscInt Nc, PetscReal w, const PetscReal invJ[], PetscScalar f0[], PetscScalar f1[])
+{
+  PetscInt c, d, e;
+
+  for (c = 0; c < Nc; ++c) {
+    PetscScalar tmp[3];
+
+    f0[c] *= w;
+    for (d = 0; d < dim; ++d) tmp[d] = f1[c*dim+d];
+    for (e = 0; e < dim; ++e) {
+      f1[c*dim+e] = 0.0;
+      for (d = 0; d < dim; ++d) f1[c*dim+e] += invJ[e*dim+d]*tmp[d];
+      f1[c*dim+e] *= w;
+    }
+  }
+}
+
+static PetscErrorCode PetscFEIntegrateResidual_Tensor(PetscDS ds, PetscInt field, PetscInt Ne, PetscFEGeom *cgeom,
+                                                      const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscFE            fe;
+  PetscPointFunc     f0_func;
+  PetscPointFunc     f1_func;
+  PetscQuadrature    quad;
+  PetscTabulation   *T, *TAux = NULL;
+  PetscScalar       *f0, *f1, *u, *u_t, *u_x, *a = NULL, *a_x = NULL;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, totComp, totCompAux = 0, cOffset = 0, cOffsetAux = 0, fOffset, NcI, e;
+  PetscBool          isAffine, isTensor;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           Nq, q, Np, dE;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFETensorCanIntegrate_Private(ds, field, dsAux, cgeom, &isTensor);CHKERRQ(ierr);
+  if (!isTensor) {
+    ierr = PetscFEIntegrateResidual_Basic(ds, field, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscDSGetResidual(ds, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  if (!f0_func && !f1_func) PetscFunctionReturn(0);
+  ierr = PetscDSGetDiscretization(ds, field, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &totComp);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &totCompAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &TAux);CHKERRQ(ierr);
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  NcI = T[field]->Nc;
+  ierr = PetscMalloc6(Nq*totComp, &u, coefficients_t ? Nq*totComp : 0, &u_t, Nq*totComp*dim, &u_x, Nq*totCompAux, &a, Nq*totCompAux*dim, &a_x, Nq*NcI*(dim+1), &f0);CHKERRQ(ierr);
+  if (!coefficients_t) u_t = NULL;
+  f1 = f0 + Nq*NcI;
+  Np = cgeom->numPoints;
+  dE = cgeom->dimEmbed;
+  isAffine = cgeom->isAffine;
+  for (e = 0; e < Ne; ++e) {
+    PetscFEGeom fegeom;
+
+    if (isAffine) {
+      fegeom.v    = x;
+      fegeom.xi   = cgeom->xi;
+      fegeom.J    = &cgeom->J[e*dE*dE];
+      fegeom.invJ = &cgeom->invJ[e*dE*dE];
+      fegeom.detJ = &cgeom->detJ[e];
+    }
+    ierr = PetscFETensorEvaluateFields_Private(ds, T, Nq, &coefficients[cOffset], u_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);
+    if (dsAux) {ierr = PetscFETensorEvaluateFields_Private(dsAux, TAux, Nq, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);}
+    ierr = PetscArrayzero(f0, Nq*NcI*(dim+1));CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      PetscScalar *uq   = &u[q*totComp], *u_xq = &u_x[q*totComp*dim], *u_tq = u_t ? &u_t[q*totComp] : NULL;
+      PetscScalar *aq   = dsAux ? &a[q*totCompAux] : NULL, *a_xq = dsAux ? &a_x[q*totCompAux*dim] : NULL;
+
+      if (isAffine) {
+        CoordinatesRefToReal(dE, dim, fegeom.xi, &cgeom->v[e*dE], fegeom.J, &quadPoints[q*dim], x);
+      } else {
+        fegeom.v    = &cgeom->v[(e*Np+q)*dE];
+        fegeom.J    = &cgeom->J[(e*Np+q)*dE*dE];
+        fegeom.invJ = &cgeom->invJ[(e*Np+q)*dE*dE];
+        fegeom.detJ = &cgeom->detJ[e*Np+q];
+      }
+      ierr = PetscFETensorPushforward_Private(ds, &fegeom, uOff, uOff_x, uq, u_xq, u_tq);CHKERRQ(ierr);
+      if (dsAux) {ierr = PetscFETensorPushforward_Private(dsAux, &fegeom, aOff, aOff_x, aq, a_xq, NULL);CHKERRQ(ierr);}
+      if (f0_func) f0_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, fegeom.v, numConstants, constants, &f0[q*NcI]);
+      if (f1_func) f1_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, fegeom.v, numConstants, constants, &f1[q*NcI*dim]);
+      PetscFETensorPullback_Private(dim, NcI, fegeom.detJ[0]*quadWeights[q], fegeom.invJ, &f0[q*NcI], &f1[q*NcI*dim]);
+    }
+    ierr = PetscFETensorIntegrate_Private(fe, f0_func ? f0 : NULL, f1_func ? f1 : NULL, &elemVec[cOffset+fOffset]);CHKERRQ(ierr);
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+  }
+  ierr = PetscFree6(u, u_t, u_x, a, a_x, f0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The Jacobian action from the assembled element matrices, for elements without tensor product structure */
+static PetscErrorCode PetscFEIntegrateJacobianAction_Assembled_Private(PetscDS ds, PetscInt fieldI, PetscInt Ne, PetscFEGeom *cgeom,
+                                                                       const PetscScalar coefficients[], const PetscScalar coefficients_t[], const PetscScalar coefficientsY[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemVec[])
+{
+  PetscScalar   *elemMat, *elemMatD;
+  PetscInt       Nf, totDim, totDimAux = 0, offsetI, NbI, fieldJ, e, i, j;
+  PetscBool      hasDyn;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldSize(ds, fieldI, &NbI);CHKERRQ(ierr);
+  ierr = PetscDSHasDynamicJacobian(ds, &hasDyn);CHKERRQ(ierr);
+  hasDyn = hasDyn && (u_tshift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
+  if (dsAux) {ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);}
+  ierr = PetscMalloc2(totDim*totDim, &elemMat, hasDyn ? totDim*totDim : 0, &elemMatD);CHKERRQ(ierr);
+  for (e = 0; e < Ne; ++e) {
+    PetscFEGeom       *geom = NULL;
+    const PetscScalar *u_t  = coefficients_t ? &coefficients_t[e*totDim] : NULL;
+    const PetscScalar *a    = dsAux ? &coefficientsAux[e*totDimAux] : NULL;
+
+    ierr = PetscFEGeomGetChunk(cgeom, e, e+1, &geom);CHKERRQ(ierr);
+    ierr = PetscArrayzero(elemMat, totDim*totDim);CHKERRQ(ierr);
+    if (hasDyn) {ierr = PetscArrayzero(elemMatD, totDim*totDim);CHKERRQ(ierr);}
+    for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+      ierr = PetscFEIntegrateJacobian_Basic(ds, PETSCFE_JACOBIAN, fieldI, fieldJ, 1, geom, &coefficients[e*totDim], u_t, dsAux, a, t, u_tshift, elemMat);CHKERRQ(ierr);
+      if (hasDyn) {ierr = PetscFEIntegrateJacobian_Basic(ds, PETSCFE_JACOBIAN_DYN, fieldI, fieldJ, 1, geom, &coefficients[e*totDim], u_t, dsAux, a, t, u_tshift, elemMatD);CHKERRQ(ierr);}
+    }
+    ierr = PetscFEGeomRestoreChunk(cgeom, e, e+1, &geom);CHKERRQ(ierr);
+    if (hasDyn) {for (i = 0; i < totDim*totDim; ++i) elemMat[i] += u_tshift*elemMatD[i];}
+    for (i = offsetI; i < offsetI+NbI; ++i) {
+      elemVec[e*totDim+i] = 0.0;
+      for (j = 0; j < totDim; ++j) elemVec[e*totDim+i] += elemMat[i*totDim+j]*coefficientsY[e*totDim+j];
+    }
+  }
+  ierr = PetscFree2(elemMat, elemMatD);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEIntegrateJacobianAction_Tensor(PetscDS ds, PetscInt fieldI, PetscInt Ne, PetscFEGeom *cgeom,
+                                                            const PetscScalar coefficients[], const PetscScalar coefficients_t[], const PetscScalar coefficientsY[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemVec[])
+{
+  PetscFE            fe;
+  PetscQuadrature    quad;
+  PetscTabulation   *T, *TAux = NULL;
+  PetscScalar       *f0, *f1, *g0, *g1, *g2, *g3, *u, *u_t, *u_x, *y, *y_x, *a = NULL, *a_x = NULL;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, totComp, totCompAux = 0, cOffset = 0, cOffsetAux = 0, offsetI, NcI, e;
+  PetscBool          isAffine, isTensor, hasDyn, hasF0 = PETSC_FALSE, hasF1 = PETSC_FALSE;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           Nq, q, Np, dE, fieldJ, k;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFETensorCanIntegrate_Private(ds, fieldI, dsAux, cgeom, &isTensor);CHKERRQ(ierr);
+  if (!isTensor) {
+    ierr = PetscFEIntegrateJacobianAction_Assembled_Private(ds, fieldI, Ne, cgeom, coefficients, coefficients_t, coefficientsY, dsAux, coefficientsAux, t, u_tshift, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscDSGetDiscretization(ds, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &totComp);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(ds, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(ds, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(ds, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetWorkspace(ds, &x, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscDSGetWeakFormArrays(ds, NULL, NULL, &g0, &g1, &g2, &g3);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(ds, &T);CHKERRQ(ierr);
+  ierr = PetscDSGetConstants(ds, &numConstants, &constants);CHKERRQ(ierr);
+  ierr = PetscDSHasDynamicJacobian(ds, &hasDyn);CHKERRQ(ierr);
+  hasDyn = hasDyn && (u_tshift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
+  if (dsAux) {
+    ierr = PetscDSGetNumFields(dsAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(dsAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(dsAux, &totCompAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(dsAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetTabulation(dsAux, &TAux);CHKERRQ(ierr);
+  }
+  for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+    for (k = 0; k < (hasDyn ? 2 : 1); ++k) {
+      PetscPointJac g0_func, g1_func, g2_func, g3_func;
+
+      if (!k) {ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);}
+      else    {ierr = PetscDSGetDynamicJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);}
+      if (g0_func || g1_func) hasF0 = PETSC_TRUE;
+      if (g2_func || g3_func) hasF1 = PETSC_TRUE;
+    }
+  }
+  ierr = PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  NcI = T[fieldI]->Nc;
+  ierr = PetscMalloc6(Nq*totComp, &u, coefficients_t ? Nq*totComp : 0, &u_t, Nq*totComp*dim, &u_x, Nq*totCompAux, &a, Nq*totCompAux*dim, &a_x, Nq*NcI*(dim+1), &f0);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Nq*totComp, &y, Nq*totComp*dim, &y_x);CHKERRQ(ierr);
+  if (!coefficients_t) u_t = NULL;
+  f1 = f0 + Nq*NcI;
+  Np = cgeom->numPoints;
+  dE = cgeom->dimEmbed;
+  isAffine = cgeom->isAffine;
+  for (e = 0; e < Ne; ++e) {
+    PetscFEGeom fegeom;
+
+    if (isAffine) {
+      fegeom.v    = x;
+      fegeom.xi   = cgeom->xi;
+      fegeom.J    = &cgeom->J[e*dE*dE];
+      fegeom.invJ = &cgeom->invJ[e*dE*dE];
+      fegeom.detJ = &cgeom->detJ[e];
+    }
+    ierr = PetscFETensorEvaluateFields_Private(ds, T, Nq, &coefficients[cOffset], u_t ? &coefficients_t[cOffset] : NULL, u, u_x, u_t);CHKERRQ(ierr);
+    ierr = PetscFETensorEvaluateFields_Private(ds, T, Nq, &coefficientsY[cOffset], NULL, y, y_x, NULL);CHKERRQ(ierr);
+    if (dsAux) {ierr = PetscFETensorEvaluateFields_Private(dsAux, TAux, Nq, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL);CHKERRQ(ierr);}
+    ierr = PetscArrayzero(f0, Nq*NcI*(dim+1));CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      PetscScalar *uq  = &u[q*totComp], *u_xq = &u_x[q*totComp*dim], *u_tq = u_t ? &u_t[q*totComp] : NULL;
+      PetscScalar *yq  = &y[q*totComp], *y_xq = &y_x[q*totComp*dim];
+      PetscScalar *aq  = dsAux ? &a[q*totCompAux] : NULL, *a_xq = dsAux ? &a_x[q*totCompAux*dim] : NULL;
+      PetscScalar *f0q = &f0[q*NcI], *f1q = &f1[q*NcI*dim];
+
+      if (isAffine) {
+        CoordinatesRefToReal(dE, dim, fegeom.xi, &cgeom->v[e*dE], fegeom.J, &quadPoints[q*dim], x);
+      } else {
+        fegeom.v    = &cgeom->v[(e*Np+q)*dE];
+        fegeom.J    = &cgeom->J[(e*Np+q)*dE*dE];
+        fegeom.invJ = &cgeom->invJ[(e*Np+q)*dE*dE];
+        fegeom.detJ = &cgeom->detJ[e*Np+q];
+      }
+      ierr = PetscFETensorPushforward_Private(ds, &fegeom, uOff, uOff_x, uq, u_xq, u_tq);CHKERRQ(ierr);
+      ierr = PetscFETensorPushforward_Private(ds, &fegeom, uOff, uOff_x, yq, y_xq, NULL);CHKERRQ(ierr);
+      if (dsAux) {ierr = PetscFETensorPushforward_Private(dsAux, &fegeom, aOff, aOff_x, aq, a_xq, NULL);CHKERRQ(ierr);}
+      /* Contract the pointwise Jacobian with the trial direction, f0 = g0 y + g1 . grad y and f1 = g2 y + g3 . grad y */
+      for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+        const PetscInt     NcJ  = T[fieldJ]->Nc;
+        const PetscScalar *yJ   = &yq[uOff[fieldJ]];
+        const PetscScalar *yJ_x = &y_xq[uOff_x[fieldJ]];
+        PetscInt           fc, gc, df, dg;
+
+        for (k = 0; k < (hasDyn ? 2 : 1); ++k) {
+          PetscPointJac   g0_func, g1_func, g2_func, g3_func;
+          const PetscReal s = k ? u_tshift : 1.0;
+
+          if (!k) {ierr = PetscDSGetJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);}
+          else    {ierr = PetscDSGetDynamicJacobian(ds, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);}
+          if (g0_func) {
+            ierr = PetscArrayzero(g0, NcI*NcJ);CHKERRQ(ierr);
+            g0_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, fegeom.v, numConstants, constants, g0);
+            for (fc = 0; fc < NcI; ++fc) for (gc = 0; gc < NcJ; ++gc) f0q[fc] += s*g0[fc*NcJ+gc]*yJ[gc];
+          }
+          if (g1_func) {
+            ierr = PetscArrayzero(g1, NcI*NcJ*dim);CHKERRQ(ierr);
+            g1_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, fegeom.v, numConstants, constants, g1);
+            for (fc = 0; fc < NcI; ++fc) for (gc = 0; gc < NcJ; ++gc) for (dg = 0; dg < dim; ++dg) f0q[fc] += s*g1[(fc*NcJ+gc)*dim+dg]*yJ_x[gc*dim+dg];
+          }
+          if (g2_func) {
+            ierr = PetscArrayzero(g2, NcI*NcJ*dim);CHKERRQ(ierr);
+            g2_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, fegeom.v, numConstants, constants, g2);
+            for (fc = 0; fc < NcI; ++fc) for (gc = 0; gc < NcJ; ++gc) for (df = 0; df < dim; ++df) f1q[fc*dim+df] += s*g2[(fc*NcJ+gc)*dim+df]*yJ[gc];
+          }
+          if (g3_func) {
+            ierr = PetscArrayzero(g3, NcI*NcJ*dim*dim);CHKERRQ(ierr);
+            g3_func(dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, aq, NULL, a_xq, t, u_tshift, fegeom.v, numConstants, constants, g3);
+            for (fc = 0; fc < NcI; ++fc) for (gc = 0; gc < NcJ; ++gc) for (df = 0; df < dim; ++df) for (dg = 0; dg < dim; ++dg) f1q[fc*dim+df] += s*g3[((fc*NcJ+gc)*dim+df)*dim+dg]*yJ_x[gc*dim+dg];
+          }
+        }
+      }
+      PetscFETensorPullback_Private(dim, NcI, fegeom.detJ[0]*quadWeights[q], fegeom.invJ, f0q, f1q);
+    }
+    ierr = PetscFETensorIntegrate_Private(fe, hasF0 ? f0 : NULL, hasF1 ? f1 : NULL, &elemVec[cOffset+offsetI]);CHKERRQ(ierr);
+    cOffset    += totDim;
+    cOffsetAux += totDimAux;
+  }
+  ierr = PetscFree6(u, u_t, u_x, a, a_x, f0);CHKERRQ(ierr);
+  ierr = PetscFree2(y, y_x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscFEInitialize_Tensor(PetscFE fem)
+{
+  PetscFunctionBegin;
+  fem->ops->setfromoptions          = NULL;
+  fem->ops->setup                   = PetscFESetUp_Basic;
+  fem->ops->view                    = PetscFEView_Tensor;
+  fem->ops->destroy                 = PetscFEDestroy_Tensor;
+  fem->ops->getdimension            = PetscFEGetDimension_Basic;
+  fem->ops->createtabulation        = PetscFECreateTabulation_Basic;
+  fem->ops->integrate               = PetscFEIntegrate_Basic;
+  fem->ops->integratebd             = PetscFEIntegrateBd_Basic;
+  fem->ops->integrateresidual       = PetscFEIntegrateResidual_Tensor;
+  fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Tensor;
+  fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
+  fem->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCFETENSOR = "tensor" - A PetscFE object that applies tensor product elements with sum factorization
+
+  Notes:
+  When the nodal basis is a tensor product of 1D Lagrange polynomials and the quadrature is a tensor product of 1D
+  rules, as for PetscFECreateDefault() on quadrilaterals and hexahedra, the residual and the action of the Jacobian are
+  computed by applying the 1D tabulations one direction at a time. This costs O(dim (k+1)^(dim+1)) per element and
+  field component for degree k, instead of O((k+1)^(2 dim)) with the full tabulation. The action of the Jacobian,
+  PetscFEIntegrateJacobianAction(), never forms the element matrix, and it is used by DMPlexComputeJacobianAction() and
+  DMSNESCreateJacobianMF() to apply high order operators without assembling them.
+
+  Elements without this structure, such as simplices, use the same kernels as PETSCFEBASIC. The Jacobian matrix and the
+  boundary integrals always use the PETSCFEBASIC kernels.
+
+  Options Database:
+. -petscfe_type tensor - select this type, for example with PetscFECreateDefault()
+
+  Level: intermediate
+
+.seealso: PetscFEType, PetscFECreate(), PetscFESetType(), PETSCFEBASIC, PetscFEIntegrateJacobianAction(), DMSNESCreateJacobianMF()
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscFECreate_Tensor(PetscFE fem)
+{
+  PetscFE_Tensor *t;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fem, PETSCFE_CLASSID, 1);
+  ierr      = PetscNewLog(fem, &t);CHKERRQ(ierr);
+  fem->data = t;
+
+  ierr = PetscFEInitialize_Tensor(fem);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
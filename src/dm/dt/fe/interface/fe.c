@@ -1522,6 +1522,55 @@ PetscErrorCode PetscFEIntegrateJacobian(PetscDS prob, PetscFEJacobianType jtype,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscFEIntegrateJacobianAction - Produce the action of the element Jacobian on a vector for a chunk of elements by quadrature integration, without forming the element matrix
+
+  Not collective
+
+  Input Parameters:
++ prob         - The PetscDS specifying the discretizations and continuum functions
+. fieldI       - The test field being integrated
+. Ne           - The number of elements in the chunk
+. cgeom        - The cell geometry for each cell in the chunk
+. coefficients - The array of FEM basis coefficients for the elements for the Jacobian evaluation point
+. coefficients_t - The array of FEM basis time derivative coefficients for the elements
+. coefficientsY - The array of FEM basis coefficients for the elements of the vector the Jacobian is applied to
+. probAux      - The PetscDS specifying the auxiliary discretizations
+. coefficientsAux - The array of FEM auxiliary basis coefficients for the elements
+. t            - The time
+- u_tShift     - A multiplier for the dF/du_t term (as opposed to the dF/du term)
+
+  Output Parameter:
+. elemVec      - the element vectors for the Jacobian action from each element, only the entries of fieldI are set
+
+  Note:
+$ Loop over batch of elements (e):
+$   Loop over quadrature points (q):
+$     Make u_q and gradU_q, and y_q and gradY_q (loops over fields,Nb,Ncomp)
+$     Call g_0, g_1, g_2 and g_3 for each basis field, with the dynamic ones scaled by u_tShift, and contract them with y_q and gradY_q
+$   Loop over element vector entries (f,fc --> i):
+$     elemVec[i] += \psi^{fc}_f(q) (g0_{fc,gc} y_{gc} + g1_{fc,gc,dg} \partial_{dg} y_{gc}) + \nabla\psi^{fc}_f(q) \cdot (g2_{fc,gc,df} y_{gc} + g3_{fc,gc,df,dg} \partial_{dg} y_{gc})
+
+  This is only available for PetscFE types that implement it, such as PETSCFETENSOR.
+
+  Level: intermediate
+
+.seealso: PetscFEIntegrateJacobian(), PetscFEIntegrateResidual(), DMPlexComputeJacobianAction()
+@*/
+PetscErrorCode PetscFEIntegrateJacobianAction(PetscDS prob, PetscInt fieldI, PetscInt Ne, PetscFEGeom *cgeom,
+                                              const PetscScalar coefficients[], const PetscScalar coefficients_t[], const PetscScalar coefficientsY[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemVec[])
+{
+  PetscFE        fe;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  ierr = PetscDSGetDiscretization(prob, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
+  if (!fe->ops->integratejacobianaction) SETERRQ1(PetscObjectComm((PetscObject) fe), PETSC_ERR_SUP, "PetscFE type %s does not support the Jacobian action", ((PetscObject) fe)->type_name);
+  ierr = (*fe->ops->integratejacobianaction)(prob, fieldI, Ne, cgeom, coefficients, coefficients_t, coefficientsY, probAux, coefficientsAux, t, u_tshift, elemVec);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscFEIntegrateBdJacobian - Produce the boundary element Jacobian for a chunk of elements by quadrature integration
 
@@ -449,6 +449,8 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   PetscBool        *tmpi;
   PetscPointFunc   *tmpobj, *tmpf, *tmpup;
   PetscPointJac    *tmpg, *tmpgp, *tmpgt;
+  PetscPointFuncBatch *tmpfbatch;
+  PetscPointJacBatch  *tmpgbatch;
   PetscBdPointFunc *tmpfbd;
   PetscBdPointJac  *tmpgbd;
   PetscRiemannFunc *tmpr;
@@ -496,6 +498,12 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   prob->r   = tmpr;
   prob->update = tmpup;
   prob->ctx = tmpctx;
+  ierr = PetscCalloc2(NfNew*2, &tmpfbatch, NfNew*NfNew*4, &tmpgbatch);CHKERRQ(ierr);
+  for (f = 0; f < Nf*2; ++f) tmpfbatch[f] = prob->fBatch[f];
+  for (f = 0; f < Nf*Nf*4; ++f) tmpgbatch[f] = prob->gBatch[f];
+  ierr = PetscFree2(prob->fBatch, prob->gBatch);CHKERRQ(ierr);
+  prob->fBatch = tmpfbatch;
+  prob->gBatch = tmpgbatch;
   ierr = PetscCalloc4(NfNew*2, &tmpfbd, NfNew*NfNew*4, &tmpgbd, NfNew, &tmpexactSol, NfNew, &tmpexactCtx);CHKERRQ(ierr);
   for (f = 0; f < Nf*2; ++f) tmpfbd[f] = prob->fBd[f];
   for (f = 0; f < Nf*Nf*4; ++f) tmpgbd[f] = prob->gBd[f];
@@ -551,6 +559,7 @@ PetscErrorCode PetscDSDestroy(PetscDS *prob)
   ierr = PetscFree2((*prob)->disc, (*prob)->implicit);CHKERRQ(ierr);
   ierr = PetscFree7((*prob)->obj,(*prob)->f,(*prob)->g,(*prob)->gp,(*prob)->gt,(*prob)->r,(*prob)->ctx);CHKERRQ(ierr);
   ierr = PetscFree((*prob)->update);CHKERRQ(ierr);
+  ierr = PetscFree2((*prob)->fBatch,(*prob)->gBatch);CHKERRQ(ierr);
   ierr = PetscFree4((*prob)->fBd,(*prob)->gBd,(*prob)->exactSol,(*prob)->exactCtx);CHKERRQ(ierr);
   if ((*prob)->ops->destroy) {ierr = (*(*prob)->ops->destroy)(*prob);CHKERRQ(ierr);}
   next = (*prob)->boundary;
@@ -1111,6 +1120,80 @@ PetscErrorCode PetscDSSetResidual(PetscDS prob, PetscInt f,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetResidualBatch - Get the batched pointwise residual function for a given test field
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+- f    - The test field number
+
+  Output Parameters:
++ f0 - batched integrand for the test function term
+- f1 - batched integrand for the test function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetResidualBatch(), PetscDSGetResidual()
+@*/
+PetscErrorCode PetscDSGetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch *f0, PetscPointFuncBatch *f1)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if (f0) {PetscValidPointer(f0, 3); *f0 = prob->fBatch[f*2+0];}
+  if (f1) {PetscValidPointer(f1, 4); *f1 = prob->fBatch[f*2+1];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetResidualBatch - Set the batched pointwise residual function for a given test field
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. f0 - batched integrand for the test function term
+- f1 - batched integrand for the test function gradient term
+
+  Note: A batched function evaluates the integrand at Np points at once, so that the loop over points lives inside the
+  callback and can be vectorized by the compiler. Its calling sequence is given by:
+
+$ f0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+
+  where the arguments are those of the pointwise function from PetscDSSetResidual(), except that every point array is
+  stored with the point index running fastest (structure of arrays). Component c of the field values at point p is
+  u[c*Np+p], derivative d of component c is u_x[(c*dim+d)*Np+p], coordinate d is x[d*Np+p], and the outputs are
+  f0[c*Np+p] and f1[(c*dim+d)*Np+p]. The points of a batch may belong to several cells.
+
+  The PETSCFEBASIC integrator uses the batched functions for a field in place of those set with PetscDSSetResidual()
+  whenever one of them is given, while other integrators keep calling the pointwise functions, so both should usually be set.
+  The batch size can be controlled with PetscFESetTileSizes().
+
+  Level: intermediate
+
+.seealso: PetscDSGetResidualBatch(), PetscDSSetResidual(), PetscDSSetJacobianBatch()
+@*/
+PetscErrorCode PetscDSSetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch f0, PetscPointFuncBatch f1)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (f0) PetscValidFunction(f0, 3);
+  if (f1) PetscValidFunction(f1, 4);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  ierr = PetscDSEnlarge_Static(prob, f+1);CHKERRQ(ierr);
+  prob->fBatch[f*2+0] = f0;
+  prob->fBatch[f*2+1] = f1;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSHasJacobian - Signals that Jacobian functions have been set
 
@@ -1136,7 +1219,7 @@ PetscErrorCode PetscDSHasJacobian(PetscDS prob, PetscBool *hasJac)
   for (f = 0; f < prob->Nf; ++f) {
     for (g = 0; g < prob->Nf; ++g) {
       for (h = 0; h < 4; ++h) {
-        if (prob->g[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
+        if (prob->g[(f*prob->Nf + g)*4+h] || prob->gBatch[(f*prob->Nf + g)*4+h]) *hasJac = PETSC_TRUE;
       }
     }
   }
@@ -1306,6 +1389,91 @@ PetscErrorCode PetscDSSetJacobian(PetscDS prob, PetscInt f, PetscInt g,
   PetscFunctionReturn(0);
 }
 
+/*@C
+  PetscDSGetJacobianBatch - Get the batched pointwise Jacobian function for given test and basis fields
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+- g    - The field number
+
+  Output Parameters:
++ g0 - batched integrand for the test and basis function term
+. g1 - batched integrand for the test function and basis function gradient term
+. g2 - batched integrand for the test function gradient and basis function term
+- g3 - batched integrand for the test function gradient and basis function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetJacobianBatch(), PetscDSGetJacobian()
+@*/
+PetscErrorCode PetscDSGetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch *g0, PetscPointJacBatch *g1, PetscPointJacBatch *g2, PetscPointJacBatch *g3)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if ((g < 0) || (g >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", g, prob->Nf);
+  if (g0) {PetscValidPointer(g0, 4); *g0 = prob->gBatch[(f*prob->Nf + g)*4+0];}
+  if (g1) {PetscValidPointer(g1, 5); *g1 = prob->gBatch[(f*prob->Nf + g)*4+1];}
+  if (g2) {PetscValidPointer(g2, 6); *g2 = prob->gBatch[(f*prob->Nf + g)*4+2];}
+  if (g3) {PetscValidPointer(g3, 7); *g3 = prob->gBatch[(f*prob->Nf + g)*4+3];}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscDSSetJacobianBatch - Set the batched pointwise Jacobian function for given test and basis fields
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. g    - The field number
+. g0 - batched integrand for the test and basis function term
+. g1 - batched integrand for the test function and basis function gradient term
+. g2 - batched integrand for the test function gradient and basis function term
+- g3 - batched integrand for the test function gradient and basis function gradient term
+
+  Note: The calling sequence for the callbacks is given by:
+
+$ g0(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g0[])
+
+  with the inputs laid out as in PetscDSSetResidualBatch(). Entry i of the output of the pointwise function from
+  PetscDSSetJacobian() at point p is stored in g0[i*Np+p], and similarly for g1, g2 and g3.
+
+  The PETSCFEBASIC integrator uses the batched functions for a pair of fields in place of those set with
+  PetscDSSetJacobian() whenever one of them is given. They are not used for the Jacobian preconditioner or the
+  dynamic Jacobian.
+
+  Level: intermediate
+
+.seealso: PetscDSGetJacobianBatch(), PetscDSSetJacobian(), PetscDSSetResidualBatch()
+@*/
+PetscErrorCode PetscDSSetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch g0, PetscPointJacBatch g1, PetscPointJacBatch g2, PetscPointJacBatch g3)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (g0) PetscValidFunction(g0, 4);
+  if (g1) PetscValidFunction(g1, 5);
+  if (g2) PetscValidFunction(g2, 6);
+  if (g3) PetscValidFunction(g3, 7);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  if (g < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", g);
+  ierr = PetscDSEnlarge_Static(prob, PetscMax(f, g)+1);CHKERRQ(ierr);
+  prob->gBatch[(f*prob->Nf + g)*4+0] = g0;
+  prob->gBatch[(f*prob->Nf + g)*4+1] = g1;
+  prob->gBatch[(f*prob->Nf + g)*4+2] = g2;
+  prob->gBatch[(f*prob->Nf + g)*4+3] = g3;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscDSUseJacobianPreconditioner - Whether to construct a Jacobian preconditioner
 
@@ -3002,6 +3170,7 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
     const PetscInt   f = fields ? fields[fn] : fn;
     PetscPointFunc   obj;
     PetscPointFunc   f0, f1;
+    PetscPointFuncBatch f0b, f1b;
     PetscBdPointFunc f0Bd, f1Bd;
     PetscRiemannFunc r;
 
@@ -3012,12 +3181,15 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
     ierr = PetscDSGetRiemannSolver(prob, f, &r);CHKERRQ(ierr);
     ierr = PetscDSSetObjective(newprob, fn, obj);CHKERRQ(ierr);
     ierr = PetscDSSetResidual(newprob, fn, f0, f1);CHKERRQ(ierr);
+    ierr = PetscDSGetResidualBatch(prob, f, &f0b, &f1b);CHKERRQ(ierr);
+    ierr = PetscDSSetResidualBatch(newprob, fn, f0b, f1b);CHKERRQ(ierr);
     ierr = PetscDSSetBdResidual(newprob, fn, f0Bd, f1Bd);CHKERRQ(ierr);
     ierr = PetscDSSetRiemannSolver(newprob, fn, r);CHKERRQ(ierr);
     for (gn = 0; gn < numFields; ++gn) {
       const PetscInt  g = fields ? fields[gn] : gn;
       PetscPointJac   g0, g1, g2, g3;
       PetscPointJac   g0p, g1p, g2p, g3p;
+      PetscPointJacBatch g0b, g1b, g2b, g3b;
       PetscBdPointJac g0Bd, g1Bd, g2Bd, g3Bd;
 
       if (g >= Nf) continue;
@@ -3025,6 +3197,8 @@ PetscErrorCode PetscDSSelectEquations(PetscDS prob, PetscInt numFields, const Pe
       ierr = PetscDSGetJacobianPreconditioner(prob, f, g, &g0p, &g1p, &g2p, &g3p);CHKERRQ(ierr);
       ierr = PetscDSGetBdJacobian(prob, f, g, &g0Bd, &g1Bd, &g2Bd, &g3Bd);CHKERRQ(ierr);
       ierr = PetscDSSetJacobian(newprob, fn, gn, g0, g1, g2, g3);CHKERRQ(ierr);
+      ierr = PetscDSGetJacobianBatch(prob, f, g, &g0b, &g1b, &g2b, &g3b);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianBatch(newprob, fn, gn, g0b, g1b, g2b, g3b);CHKERRQ(ierr);
       ierr = PetscDSSetJacobianPreconditioner(prob, fn, gn, g0p, g1p, g2p, g3p);CHKERRQ(ierr);
       ierr = PetscDSSetBdJacobian(newprob, fn, gn, g0Bd, g1Bd, g2Bd, g3Bd);CHKERRQ(ierr);
     }
@@ -0,0 +1,364 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+#include <petsc/private/hashseti.h>
+
+typedef struct {
+  PetscPartitioner fallback;    /* Partitioner used when diffusion cannot balance the load */
+  PetscBool        useFallback; /* Flag to call the fallback partitioner, otherwise the diffusive partition is kept */
+  PetscReal        imbalance;   /* The admissible load excess of a part, relative to its target */
+  PetscReal        rtol;        /* The relative tolerance for the diffusion solve */
+  PetscInt         maxIts;      /* The maximum number of diffusion iterations */
+  PetscInt         numMoved;    /* The number of graph vertices moved by the last partition */
+} PetscPartitioner_Diffusive;
+
+static PetscErrorCode PetscPartitionerDiffusiveGetFallback_Private(PetscPartitioner part, PetscPartitioner *fallback)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  if (!p->fallback) {
+    MatPartitioning mp;
+    const char     *prefix;
+
+    ierr = PetscPartitionerCreate(PetscObjectComm((PetscObject) part), &p->fallback);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject) part, (PetscObject) p->fallback);CHKERRQ(ierr);
+    ierr = PetscObjectGetOptionsPrefix((PetscObject) part, &prefix);CHKERRQ(ierr);
+    ierr = PetscObjectSetOptionsPrefix((PetscObject) p->fallback, prefix);CHKERRQ(ierr);
+    ierr = PetscObjectAppendOptionsPrefix((PetscObject) p->fallback, "diffusive_fallback_");CHKERRQ(ierr);
+    ierr = PetscPartitionerSetType(p->fallback, PETSCPARTITIONERMATPARTITIONING);CHKERRQ(ierr);
+    ierr = PetscPartitionerMatPartitioningGetMatPartitioning(p->fallback, &mp);CHKERRQ(ierr);
+    ierr = MatPartitioningSetType(mp, MATPARTITIONINGHIERARCH);CHKERRQ(ierr);
+  }
+  *fallback = p->fallback;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerDestroy_Diffusive(PetscPartitioner part)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscPartitionerDestroy(&p->fallback);CHKERRQ(ierr);
+  ierr = PetscFree(p);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusive_Ascii(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "load imbalance tolerance %g\n", (double) p->imbalance);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "diffusion tolerance %g, max iterations %D\n", (double) p->rtol, p->maxIts);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "vertices moved by the last partition %D\n", p->numMoved);CHKERRQ(ierr);
+  if (p->useFallback && p->fallback) {
+    ierr = PetscViewerASCIIPrintf(viewer, "Fallback partitioner:\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    ierr = PetscPartitionerView(p->fallback, viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  } else if (!p->useFallback) {
+    ierr = PetscViewerASCIIPrintf(viewer, "no fallback partitioner\n");CHKERRQ(ierr);
+  }
+  ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerView_Diffusive(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {ierr = PetscPartitionerView_Diffusive_Ascii(part, viewer);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerSetFromOptions_Diffusive(PetscOptionItems *PetscOptionsObject, PetscPartitioner part)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject, "PetscPartitioner Diffusive Options");CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-petscpartitioner_diffusive_imbalance", "Admissible load excess of a part, relative to its target", "", p->imbalance, &p->imbalance, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-petscpartitioner_diffusive_rtol", "Relative tolerance for the diffusion solve", "", p->rtol, &p->rtol, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-petscpartitioner_diffusive_max_it", "Maximum number of diffusion iterations", "", p->maxIts, &p->maxIts, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-petscpartitioner_diffusive_fallback", "Repartition with the fallback partitioner when diffusion fails", "", p->useFallback, &p->useFallback, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (p->useFallback) {
+    PetscPartitioner fallback;
+
+    ierr = PetscPartitionerDiffusiveGetFallback_Private(part, &fallback);CHKERRQ(ierr);
+    ierr = PetscPartitionerSetFromOptions(fallback);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* The load of every part is within the tolerance, up to the granularity of one vertex */
+static PetscBool PetscPartitionerDiffusiveBalanced_Private(PetscInt nparts, const PetscInt loads[], const PetscReal targets[], PetscReal imbalance, PetscInt maxWeight)
+{
+  PetscInt q;
+
+  for (q = 0; q < nparts; ++q) if (loads[q] > (1.0 + imbalance)*targets[q] + maxWeight) return PETSC_FALSE;
+  return PETSC_TRUE;
+}
+
+/*
+  Each process starts with its own vertices. The load excess b is diffused over the graph of processes by solving
+  L x = b with CG, where L is the graph Laplacian, so that the flow x_r - x_s from process r to its neighbor s has
+  minimal 2-norm among all flows balancing the load. The process then sends to each neighbor with a positive flow
+  the vertices on their common boundary, growing the moved region layer by layer into its interior.
+*/
+static PetscErrorCode PetscPartitionerDiffuse_Private(PetscPartitioner part, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection vertSection, PetscSection targetSection, PetscSection partSection, IS *partition, PetscBool *success)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  MPI_Comm                    comm;
+  PetscLayout                 map;
+  PetscHSetI                  ht;
+  PetscSF                     rankSF;
+  PetscSFNode                *remote;
+  PetscReal                  *targets, *xn, sumt = 0.0, x = 0.0, r, d, Ad, dAd, rr, rrNew, bnorm, alpha;
+  PetscInt                   *vwgt, *assign, *mark, *queue, *neighbors, *loads, *points, *offsets;
+  PetscInt                    numNeighbors, flags[2] = {0, 0}, load = 0, total = 0, off = 0, i, v, e, q, it;
+  PetscBool                   balanced, converged = PETSC_FALSE;
+  PetscMPIInt                 size, rank;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = PetscMalloc4(numVertices, &vwgt, numVertices, &assign, numVertices, &mark, numVertices, &queue);CHKERRQ(ierr);
+  for (v = 0; v < numVertices; ++v) {
+    vwgt[v] = 1;
+    if (vertSection) {ierr = PetscSectionGetDof(vertSection, v, &vwgt[v]);CHKERRQ(ierr);}
+    load     += vwgt[v];
+    flags[0]  = PetscMax(flags[0], vwgt[v]);
+    assign[v] = rank;
+    mark[v]   = -1;
+  }
+  /* The processes owning a neighbor of our vertices, using the contiguous global numbering of the graph */
+  ierr = PetscLayoutCreate(comm, &map);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(map, numVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(map);CHKERRQ(ierr);
+  ierr = PetscHSetICreate(&ht);CHKERRQ(ierr);
+  for (e = 0; e < (numVertices ? start[numVertices] : 0); ++e) {
+    if (adjacency[e] < map->rstart || adjacency[e] >= map->rend) {
+      PetscMPIInt owner;
+
+      ierr = PetscLayoutFindOwner(map, adjacency[e], &owner);CHKERRQ(ierr);
+      ierr = PetscHSetIAdd(ht, owner);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscHSetIGetSize(ht, &numNeighbors);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numNeighbors, &remote);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numNeighbors, &neighbors, numNeighbors, &xn);CHKERRQ(ierr);
+  ierr = PetscHSetIGetElems(ht, &off, neighbors);CHKERRQ(ierr);
+  ierr = PetscHSetIDestroy(&ht);CHKERRQ(ierr);
+  ierr = PetscSortInt(numNeighbors, neighbors);CHKERRQ(ierr);
+  for (i = 0; i < numNeighbors; ++i) {
+    remote[i].rank  = neighbors[i];
+    remote[i].index = 0;
+  }
+  ierr = PetscSFCreate(comm, &rankSF);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(rankSF, 1, numNeighbors, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* The current and target loads of every part */
+  flags[1] = numNeighbors ? 0 : 1;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, flags, 2, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = PetscMalloc3(size, &loads, size, &targets, size+1, &offsets);CHKERRQ(ierr);
+  ierr = MPI_Allgather(&load, 1, MPIU_INT, loads, 1, MPIU_INT, comm);CHKERRQ(ierr);
+  for (q = 0; q < size; ++q) {
+    PetscInt tw = 0;
+
+    if (targetSection) {ierr = PetscSectionGetDof(targetSection, q, &tw);CHKERRQ(ierr);}
+    total     += loads[q];
+    targets[q] = tw;
+    sumt      += tw;
+  }
+  for (q = 0; q < size; ++q) targets[q] = sumt > 0.0 ? total*targets[q]/sumt : total/(PetscReal) size;
+  balanced = PetscPartitionerDiffusiveBalanced_Private(size, loads, targets, p->imbalance, flags[0]);
+  if (balanced) {
+    ierr = PetscInfo(part, "The load is already balanced, no vertex is moved\n");CHKERRQ(ierr);
+  } else if (flags[1] && p->useFallback) {
+    ierr = PetscInfo(part, "Some process has no neighbor, the load cannot be diffused\n");CHKERRQ(ierr);
+  } else {
+    /* CG for the singular but consistent system L x = b */
+    r     = load - targets[rank];
+    d     = r;
+    rr    = r*r;
+    ierr  = MPIU_Allreduce(MPI_IN_PLACE, &rr, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+    bnorm = PetscSqrtReal(rr);
+    for (it = 0; it < p->maxIts; ++it) {
+      ierr = PetscSFBcastBegin(rankSF, MPIU_REAL, &d, xn);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(rankSF, MPIU_REAL, &d, xn);CHKERRQ(ierr);
+      for (i = 0, Ad = numNeighbors*d; i < numNeighbors; ++i) Ad -= xn[i];
+      dAd  = d*Ad;
+      ierr = MPIU_Allreduce(MPI_IN_PLACE, &dAd, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+      if (dAd <= 0.0) break;
+      alpha = rr/dAd;
+      x    += alpha*d;
+      r    -= alpha*Ad;
+      rrNew = r*r;
+      ierr  = MPIU_Allreduce(MPI_IN_PLACE, &rrNew, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+      if (PetscSqrtReal(rrNew) <= p->rtol*bnorm) {converged = PETSC_TRUE; ++it; break;}
+      d  = r + (rrNew/rr)*d;
+      rr = rrNew;
+    }
+    ierr = PetscInfo2(part, "Diffusion %s in %D iterations\n", converged ? "converged" : "did not converge", it);CHKERRQ(ierr);
+    if (converged || !p->useFallback) {
+      ierr = PetscSFBcastBegin(rankSF, MPIU_REAL, &x, xn);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(rankSF, MPIU_REAL, &x, xn);CHKERRQ(ierr);
+      for (i = 0; i < numNeighbors; ++i) {
+        const PetscInt  nb   = neighbors[i];
+        const PetscReal flow = x - xn[i];
+        PetscInt        head = 0, tail = 0, sent = 0;
+
+        if (flow <= 0.0) continue;
+        for (v = 0; v < numVertices; ++v) {
+          if (assign[v] != rank) continue;
+          for (e = start[v]; e < start[v+1]; ++e) {
+            if (adjacency[e] >= map->range[nb] && adjacency[e] < map->range[nb+1]) {
+              mark[v] = i;
+              queue[tail++] = v;
+              break;
+            }
+          }
+        }
+        while (head < tail) {
+          const PetscInt u = queue[head++];
+
+          if (sent + 0.5*vwgt[u] > flow) break;
+          assign[u] = nb;
+          sent     += vwgt[u];
+          for (e = start[u]; e < start[u+1]; ++e) {
+            const PetscInt w = adjacency[e] - map->rstart;
+
+            if (w < 0 || w >= numVertices || assign[w] != rank || mark[w] == i) continue;
+            mark[w] = i;
+            queue[tail++] = w;
+          }
+        }
+      }
+      ierr = PetscArrayzero(loads, size);CHKERRQ(ierr);
+      for (v = 0; v < numVertices; ++v) loads[assign[v]] += vwgt[v];
+      ierr = MPIU_Allreduce(MPI_IN_PLACE, loads, size, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+      balanced = PetscPartitionerDiffusiveBalanced_Private(size, loads, targets, p->imbalance, flags[0]);
+      if (!balanced) {ierr = PetscInfo(part, "The moved vertices do not balance the load within the tolerance\n");CHKERRQ(ierr);}
+    }
+  }
+  *success = (balanced || !p->useFallback) ? PETSC_TRUE : PETSC_FALSE;
+  if (*success) {
+    ierr = PetscArrayzero(offsets, size+1);CHKERRQ(ierr);
+    for (v = 0; v < numVertices; ++v) {
+      ierr = PetscSectionAddDof(partSection, assign[v], 1);CHKERRQ(ierr);
+      ++offsets[assign[v]+1];
+    }
+    for (q = 0; q < size; ++q) offsets[q+1] += offsets[q];
+    ierr = PetscMalloc1(numVertices, &points);CHKERRQ(ierr);
+    for (v = 0; v < numVertices; ++v) points[offsets[assign[v]]++] = v;
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, numVertices, points, PETSC_OWN_POINTER, partition);CHKERRQ(ierr);
+  }
+  ierr = PetscSFDestroy(&rankSF);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&map);CHKERRQ(ierr);
+  ierr = PetscFree3(loads, targets, offsets);CHKERRQ(ierr);
+  ierr = PetscFree2(neighbors, xn);CHKERRQ(ierr);
+  ierr = PetscFree4(vwgt, assign, mark, queue);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerPartition_Diffusive(PetscPartitioner part, PetscInt nparts, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection vertSection, PetscSection targetSection, PetscSection partSection, IS *partition)
+{
+  PetscPartitioner_Diffusive *p = (PetscPartitioner_Diffusive *) part->data;
+  MPI_Comm                    comm;
+  PetscBool                   success = PETSC_FALSE;
+  PetscInt                    moved = 0, q;
+  PetscMPIInt                 size, rank;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  if (nparts == size) {
+    ierr = PetscPartitionerDiffuse_Private(part, numVertices, start, adjacency, vertSection, targetSection, partSection, partition, &success);CHKERRQ(ierr);
+  } else {
+    if (!p->useFallback) SETERRQ2(comm, PETSC_ERR_SUP, "Diffusion needs one part per process, not %D parts on %d processes", nparts, size);
+    ierr = PetscInfo2(part, "Diffusion needs one part per process, not %D parts on %d processes\n", nparts, size);CHKERRQ(ierr);
+  }
+  if (!success) {
+    PetscPartitioner fallback;
+
+    ierr = PetscInfo(part, "Repartitioning with the fallback partitioner\n");CHKERRQ(ierr);
+    ierr = PetscPartitionerDiffusiveGetFallback_Private(part, &fallback);CHKERRQ(ierr);
+    ierr = PetscPartitionerPartition(fallback, nparts, numVertices, start, adjacency, vertSection, targetSection, partSection, partition);CHKERRQ(ierr);
+  }
+  for (q = 0; q < nparts; ++q) {
+    PetscInt dof;
+
+    if (q == rank) continue;
+    ierr   = PetscSectionGetDof(partSection, q, &dof);CHKERRQ(ierr);
+    moved += dof;
+  }
+  ierr = MPIU_Allreduce(&moved, &p->numMoved, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscInfo1(part, "Moved %D graph vertices\n", p->numMoved);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerInitialize_Diffusive(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  part->ops->view           = PetscPartitionerView_Diffusive;
+  part->ops->setfromoptions = PetscPartitionerSetFromOptions_Diffusive;
+  part->ops->destroy        = PetscPartitionerDestroy_Diffusive;
+  part->ops->partition      = PetscPartitionerPartition_Diffusive;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCPARTITIONERDIFFUSIVE = "diffusive" - A PetscPartitioner object which rebalances an existing distribution with minimal migration
+
+  Options Database Keys:
++ -petscpartitioner_diffusive_imbalance <0.05> - The admissible load excess of a part, relative to its target
+. -petscpartitioner_diffusive_rtol <1e-6> - The relative tolerance for the diffusion solve
+. -petscpartitioner_diffusive_max_it <100> - The maximum number of diffusion iterations
+- -petscpartitioner_diffusive_fallback <true> - Repartition with the fallback partitioner when diffusion fails
+
+  Notes:
+  The current owner of each cell is the starting partition, so this partitioner is meant to rebalance a distributed mesh, for
+  example after adaptive refinement, with DMPlexDistribute() or DMPlexRedistribute(). The load excess of each process is
+  diffused over the graph of neighboring processes, which gives the flow of load between neighbors with the smallest
+  migration volume, and each process sends the cells closest to the shared boundary. When the imbalance is small, only a
+  thin layer of cells moves.
+
+  If a process has no neighbor, if the diffusion does not converge, or if the moved cells do not meet the tolerance, the
+  mesh is repartitioned from scratch with a PETSCPARTITIONERMATPARTITIONING partitioner of type MATPARTITIONINGHIERARCH,
+  whose options are prefixed by diffusive_fallback_.
+
+  Level: intermediate
+
+.seealso: PetscPartitionerType, PetscPartitionerCreate(), PetscPartitionerSetType(), DMPlexRedistribute()
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Diffusive(PetscPartitioner part)
+{
+  PetscPartitioner_Diffusive *p;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  ierr       = PetscNewLog(part, &p);CHKERRQ(ierr);
+  part->data = p;
+
+  ierr = PetscPartitionerInitialize_Diffusive(part);CHKERRQ(ierr);
+  p->useFallback = PETSC_TRUE;
+  p->imbalance   = 0.05;
+  p->rtol        = 1.0e-6;
+  p->maxIts      = 100;
+  PetscFunctionReturn(0);
+}
@@ -1237,7 +1237,7 @@ static PetscErrorCode DMPlexView_Draw(DM dm, PetscViewer viewer)
 
 PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
 {
-  PetscBool      iascii, ishdf5, isvtk, isdraw, flg, isglvis, isexodus;
+  PetscBool      iascii, ishdf5, isvtk, isdraw, flg, isglvis, isexodus, isbinary;
   char           name[PETSC_MAX_PATH_LEN];
   PetscErrorCode ierr;
 
@@ -1250,6 +1250,7 @@ PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERDRAW,     &isdraw);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERGLVIS,    &isglvis);CHKERRQ(ierr);
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWEREXODUSII, &isexodus);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERBINARY,   &isbinary);CHKERRQ(ierr);
   if (iascii) {
     PetscViewerFormat format;
     ierr = PetscViewerGetFormat(viewer, &format);CHKERRQ(ierr);
@@ -1264,6 +1265,8 @@ PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
 #else
     SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "HDF5 not supported in this build.\nPlease reconfigure using --download-hdf5");
 #endif
+  } else if (isbinary) {
+    ierr = DMPlexView_Binary_Internal(dm, viewer);CHKERRQ(ierr);
   } else if (isvtk) {
     ierr = DMPlexVTKWriteAll((PetscObject) dm,viewer);CHKERRQ(ierr);
   } else if (isdraw) {
@@ -1309,14 +1312,17 @@ PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer)
 
 PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer)
 {
-  PetscBool      ishdf5;
+  PetscBool      ishdf5, isbinary;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
   ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERHDF5,   &ishdf5);CHKERRQ(ierr);
-  if (ishdf5) {
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERBINARY, &isbinary);CHKERRQ(ierr);
+  if (isbinary) {
+    ierr = DMPlexLoad_Binary_Internal(dm, viewer);CHKERRQ(ierr);
+  } else if (ishdf5) {
 #if defined(PETSC_HAVE_HDF5)
     PetscViewerFormat format;
     ierr = PetscViewerGetFormat(viewer, &format);CHKERRQ(ierr);
@@ -4631,6 +4637,41 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Fields_Static(DM dm, Pets
   PetscFunctionReturn(0);
 }
 
+/* Constrained dofs carry the involution -(idx+1) of their local index */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Dofs_Static(DM dm, Vec v, PetscInt numDofs, const PetscInt dofs[], PetscInt *csize, PetscScalar *values[])
+{
+  PetscScalar       *array;
+  const PetscScalar *vArray;
+  PetscInt           d;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBeginHot;
+  if (!values) {
+    if (csize) *csize = numDofs;
+    PetscFunctionReturn(0);
+  }
+  if (!*values) {
+    ierr = DMGetWorkArray(dm, numDofs, MPIU_SCALAR, &array);CHKERRQ(ierr);
+  } else {
+    if (numDofs > *csize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Size of input array %D < actual size %D", *csize, numDofs);
+    array = *values;
+  }
+  ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+  for (d = 0; d < numDofs; ++d) {
+    const PetscInt idx = dofs[d];
+
+    array[d] = vArray[idx < 0 ? -(idx+1) : idx];
+  }
+  ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+  if (!*values) {
+    if (csize) *csize = numDofs;
+    *values = array;
+  } else {
+    *csize = numDofs;
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexVecGetClosure - Get an array of the values on the closure of 'point'
 
@@ -4705,6 +4746,12 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecGetClosure_Depth1_Static(dm, section, v, point, csize, values);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use cached dof indices */
+  ierr = PetscSectionGetClosureDofs_Internal(section, (PetscObject) dm, point, &size, &clp);CHKERRQ(ierr);
+  if (clp) {
+    ierr = DMPlexVecGetClosure_Dofs_Static(dm, v, size, clp, csize, values);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Get points */
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
   ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &perm);CHKERRQ(ierr);
@@ -5087,6 +5134,41 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Depth1_Static(DM dm, Pets
   PetscFunctionReturn(0);
 }
 
+/* Constrained dofs carry the involution -(idx+1) of their local index */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Dofs_Static(DM dm, Vec v, PetscInt numDofs, const PetscInt dofs[], const PetscScalar values[], InsertMode mode)
+{
+  PetscScalar    *array;
+  PetscInt        d;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginHot;
+  ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+  switch (mode) {
+  case INSERT_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] >= 0) array[dofs[d]] = values[d];
+    break;
+  case INSERT_ALL_VALUES:
+    for (d = 0; d < numDofs; ++d) array[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]] = values[d];
+    break;
+  case INSERT_BC_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] < 0) array[-(dofs[d]+1)] = values[d];
+    break;
+  case ADD_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] >= 0) array[dofs[d]] += values[d];
+    break;
+  case ADD_ALL_VALUES:
+    for (d = 0; d < numDofs; ++d) array[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]] += values[d];
+    break;
+  case ADD_BC_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] < 0) array[-(dofs[d]+1)] += values[d];
+    break;
+  default:
+    SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+  }
+  ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexVecSetClosure - Set an array of the values on the closure of 'point'
 
@@ -5129,6 +5211,17 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
     ierr = DMPlexVecSetClosure_Depth1_Static(dm, section, v, point, values, mode);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  /* Use cached dof indices */
+  {
+    const PetscInt *dofs;
+    PetscInt        numDofs;
+
+    ierr = PetscSectionGetClosureDofs_Internal(section, (PetscObject) dm, point, &numDofs, &dofs);CHKERRQ(ierr);
+    if (dofs) {
+      ierr = DMPlexVecSetClosure_Dofs_Static(dm, v, numDofs, dofs, values, mode);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
   /* Get points */
   ierr = PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject) dm, NULL, &clperm);CHKERRQ(ierr);
   ierr = DMPlexGetCompressedClosure(dm,section,point,&numPoints,&points,&clSection,&clPoints,&clp);CHKERRQ(ierr);
@@ -6282,6 +6375,17 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   if (!globalSection) {ierr = DMGetGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
+  /* Use cached dof indices, which are only computed from the default sections */
+  if (section == dm->localSection && globalSection == dm->globalSection) {
+    const PetscInt *dofs;
+
+    ierr = PetscSectionGetClosureDofs_Internal(globalSection, (PetscObject) dm, point, &numIndices, &dofs);CHKERRQ(ierr);
+    if (dofs) {
+      if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, dofs, 0, NULL, values);CHKERRQ(ierr);}
+      ierr = MatSetValues(A, numIndices, dofs, numIndices, dofs, values, mode);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (numFields > 31) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", numFields);
   ierr = PetscArrayzero(offsets, 32);CHKERRQ(ierr);
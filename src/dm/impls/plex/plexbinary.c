@@ -0,0 +1,244 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+
+/*
+  The binary format stores the mesh as a cell-vertex list, which can be read in contiguous chunks by each process:
+
+    classid dim spatialDim numCorners numCells numVertices numLabels   (PetscInt)
+    cells[numCells*numCorners]                                          (PetscInt, global vertex numbers)
+    coordinates[numVertices*spatialDim]                                 (PetscReal)
+    for each label:
+      name[256]                                                         (char)
+      cellValues[numCells]                                              (PetscInt, -1 for no value)
+      vertexValues[numVertices]                                         (PetscInt, -1 for no value)
+
+  Only meshes with a single cell shape and coordinates on the vertices can be stored. Labels keep one value for each
+  cell and vertex, the values on faces and edges are dropped.
+*/
+/* The depth and cell type labels are rebuilt on load, and labels marked with DMSetLabelOutput() as not output are skipped */
+static PetscErrorCode DMPlexGetLabelOutput_Binary_Static(DM dm, PetscInt l, const char **name, PetscBool *output)
+{
+  PetscBool      isDepth, isCellType;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetLabelName(dm, l, name);CHKERRQ(ierr);
+  ierr = DMGetLabelOutput(dm, *name, output);CHKERRQ(ierr);
+  ierr = PetscStrcmp(*name, "depth", &isDepth);CHKERRQ(ierr);
+  ierr = PetscStrcmp(*name, "celltype", &isCellType);CHKERRQ(ierr);
+  if (isDepth || isCellType) *output = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexWriteLabels_Binary_Static(DM dm, PetscInt NCells, PetscInt NVertices, PetscViewer viewer)
+{
+  IS              cellNumbering, vertexNumbering;
+  const PetscInt *gcell, *gvertex;
+  PetscInt       *values, numLabels, cStart, cEnd, vStart, vEnd, numValues, p, l, val;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+  ierr = DMPlexGetVertexNumbering(dm, &vertexNumbering);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISGetIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  ierr = PetscMalloc1(PetscMax(cEnd-cStart, vEnd-vStart), &values);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel     label;
+    const char *name;
+    char        lname[256];
+    PetscBool   output, dropped = PETSC_FALSE;
+    PetscInt    pStart, pEnd;
+
+    ierr = DMPlexGetLabelOutput_Binary_Static(dm, l, &name, &output);CHKERRQ(ierr);
+    if (!output) continue;
+    ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+    ierr = PetscArrayzero(lname, 256);CHKERRQ(ierr);
+    ierr = PetscStrncpy(lname, name, 256);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryWrite(viewer, lname, 256, PETSC_CHAR);CHKERRQ(ierr);
+    for (p = cStart, numValues = 0; p < cEnd; ++p) if (gcell[p-cStart] >= 0) {ierr = DMLabelGetValue(label, p, &values[numValues++]);CHKERRQ(ierr);}
+    ierr = PetscViewerBinaryWriteAll(viewer, values, numValues, PETSC_DETERMINE, NCells, PETSC_INT);CHKERRQ(ierr);
+    for (p = vStart, numValues = 0; p < vEnd; ++p) if (gvertex[p-vStart] >= 0) {ierr = DMLabelGetValue(label, p, &values[numValues++]);CHKERRQ(ierr);}
+    ierr = PetscViewerBinaryWriteAll(viewer, values, numValues, PETSC_DETERMINE, NVertices, PETSC_INT);CHKERRQ(ierr);
+    ierr = DMLabelGetBounds(label, &pStart, &pEnd);CHKERRQ(ierr);
+    for (p = pStart; p < pEnd; ++p) {
+      if ((p >= cStart && p < cEnd) || (p >= vStart && p < vEnd)) continue;
+      ierr = DMLabelGetValue(label, p, &val);CHKERRQ(ierr);
+      if (val != -1) {dropped = PETSC_TRUE; break;}
+    }
+    if (dropped) {ierr = PetscInfo1(dm, "Label %s has values on faces or edges, which are not stored in the binary file\n", name);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree(values);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMPlexView_Binary_Internal(DM dm, PetscViewer viewer)
+{
+  MPI_Comm           comm;
+  Vec                coordinates;
+  PetscSection       coordSection;
+  IS                 cellNumbering, vertexNumbering;
+  const PetscInt    *gcell, *gvertex;
+  const PetscScalar *coords;
+  PetscReal         *rcoords, lengthScale;
+  PetscInt          *vertices, header[7], counts[2], numLabels, numOutputLabels = 0, l;
+  PetscInt           dim, spatialDim, cStart, cEnd, vStart, vEnd, pStart, pEnd, c, v, p, dof, numCells = 0, numVertices = 0, numCornersLocal = 0, numCorners, n, i;
+  PetscBool          localized;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocalized(dm, &localized);CHKERRQ(ierr);
+  if (localized) SETERRQ(comm, PETSC_ERR_SUP, "Binary output does not support localized coordinates");
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &spatialDim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  /* The coordinates must live on the vertices only, cell or discontinuous coordinates cannot be stored */
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(coordSection, &pStart, &pEnd);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {
+    ierr = PetscSectionGetDof(coordSection, p, &dof);CHKERRQ(ierr);
+    if ((p < vStart || p >= vEnd) && dof) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_SUP, "Binary output only supports coordinates on vertices, point %D has coordinates", p);
+    if (p >= vStart && p < vEnd && dof != spatialDim) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_SUP, "Binary output only supports %D coordinates per vertex, vertex %D has %D", spatialDim, p, dof);
+  }
+  ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+  ierr = DMPlexGetVertexNumbering(dm, &vertexNumbering);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISGetIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  /* Only owned cells are written, and they must all have the same number of vertices */
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *closure = NULL;
+    PetscInt  closureSize, Nc = 0;
+
+    if (gcell[c-cStart] < 0) continue;
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    for (p = 0; p < closureSize*2; p += 2) if ((closure[p] >= vStart) && (closure[p] < vEnd)) ++Nc;
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    if (!numCornersLocal)           numCornersLocal = Nc;
+    else if (numCornersLocal != Nc) numCornersLocal = -1;
+    ++numCells;
+  }
+  for (v = vStart; v < vEnd; ++v) if (gvertex[v-vStart] >= 0) ++numVertices;
+  ierr = MPIU_Allreduce(&numCornersLocal, &numCorners, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  if (numCornersLocal && numCornersLocal != numCorners) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Binary output only supports identical cell shapes");
+  ierr = PetscMalloc1(numCells*numCorners, &vertices);CHKERRQ(ierr);
+  for (c = cStart, i = 0; c < cEnd; ++c) {
+    PetscInt *closure = NULL;
+    PetscInt  closureSize, Nc = 0;
+
+    if (gcell[c-cStart] < 0) continue;
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    for (p = 0; p < closureSize*2; p += 2) if ((closure[p] >= vStart) && (closure[p] < vEnd)) closure[Nc++] = closure[p];
+    ierr = DMPlexReorderCell(dm, c, closure);CHKERRQ(ierr);
+    for (p = 0; p < Nc; ++p) {
+      const PetscInt gv = gvertex[closure[p]-vStart];
+
+      vertices[i++] = gv < 0 ? -(gv+1) : gv;
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    const char *name;
+    PetscBool   output;
+
+    ierr = DMPlexGetLabelOutput_Binary_Static(dm, l, &name, &output);CHKERRQ(ierr);
+    if (output) ++numOutputLabels;
+  }
+  counts[0] = numCells;
+  counts[1] = numVertices;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, counts, 2, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  header[0] = DM_FILE_CLASSID;
+  header[1] = dim;
+  header[2] = spatialDim;
+  header[3] = numCorners;
+  header[4] = counts[0];
+  header[5] = counts[1];
+  header[6] = numOutputLabels;
+  ierr = PetscViewerBinaryWrite(viewer, header, 7, PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryWriteAll(viewer, vertices, numCells*numCorners, PETSC_DETERMINE, header[4]*numCorners, PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscFree(vertices);CHKERRQ(ierr);
+  /* The global coordinate vector holds the owned vertices in the order of the vertex numbering */
+  ierr = DMGetCoordinates(dm, &coordinates);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(coordinates, &n);CHKERRQ(ierr);
+  if (n != numVertices*spatialDim) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Coordinate vector size %D should be %D", n, numVertices*spatialDim);
+  ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n, &rcoords);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) rcoords[i] = PetscRealPart(coords[i])*lengthScale;
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryWriteAll(viewer, rcoords, n, PETSC_DETERMINE, header[5]*spatialDim, PETSC_REAL);CHKERRQ(ierr);
+  ierr = PetscFree(rcoords);CHKERRQ(ierr);
+  ierr = DMPlexWriteLabels_Binary_Static(dm, header[4], header[5], viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Each process reads a contiguous chunk of cells and of vertex coordinates, so that the mesh is never gathered on a
+  single process. The result is a naively distributed mesh, which should be rebalanced with DMPlexDistribute().
+*/
+PetscErrorCode DMPlexLoad_Binary_Internal(DM dm, PetscViewer viewer)
+{
+  MPI_Comm       comm;
+  PetscSF        sfVert = NULL;
+  PetscReal     *coords, lengthScale;
+  PetscInt      *cells, *values, *vertexValues, header[7];
+  PetscInt       dim, spatialDim, numCorners, NCells, NVertices, numLabels, numCells = PETSC_DECIDE, numVertices = PETSC_DECIDE, numVerticesAdj, cStart, vStart, i, l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer, header, 7, NULL, PETSC_INT);CHKERRQ(ierr);
+  if (header[0] != DM_FILE_CLASSID) SETERRQ1(comm, PETSC_ERR_FILE_UNEXPECTED, "Not a DMPlex next in file, classid found %D", header[0]);
+  dim        = header[1];
+  spatialDim = header[2];
+  numCorners = header[3];
+  NCells     = header[4];
+  NVertices  = header[5];
+  numLabels  = header[6];
+  if (dim < 0 || spatialDim < dim || numCorners < 1 || NCells < 0 || NVertices < 0 || numLabels < 0) SETERRQ(comm, PETSC_ERR_FILE_UNEXPECTED, "Invalid DMPlex header in binary file");
+  ierr = PetscInfo4(dm, "Loading mesh with %D cells of %D vertices and %D vertices in %D dimensions\n", NCells, numCorners, NVertices, spatialDim);CHKERRQ(ierr);
+  ierr = PetscSplitOwnership(comm, &numCells, &NCells);CHKERRQ(ierr);
+  ierr = PetscSplitOwnership(comm, &numVertices, &NVertices);CHKERRQ(ierr);
+  ierr = MPI_Scan(&numCells, &cStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = MPI_Scan(&numVertices, &vStart, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  cStart -= numCells;
+  vStart -= numVertices;
+  ierr = PetscMalloc2(numCells*numCorners, &cells, numVertices*spatialDim, &coords);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryReadAll(viewer, cells, numCells*numCorners, cStart*numCorners, NCells*numCorners, PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryReadAll(viewer, coords, numVertices*spatialDim, vStart*spatialDim, NVertices*spatialDim, PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMPlexGetScale(dm, PETSC_UNIT_LENGTH, &lengthScale);CHKERRQ(ierr);
+  for (i = 0; i < numVertices*spatialDim; ++i) coords[i] /= lengthScale;
+  ierr = DMSetDimension(dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellList_Parallel_Internal(dm, dim, numCells, numVertices, numCorners, cells, PETSC_TRUE, &sfVert);CHKERRQ(ierr);
+  ierr = DMPlexBuildCoordinates_Parallel_Internal(dm, spatialDim, numCells, numVertices, sfVert, coords);CHKERRQ(ierr);
+  ierr = PetscFree2(cells, coords);CHKERRQ(ierr);
+  /* The local cells are the points [0, numCells), the vertex values are sent to the local vertices [numCells, numCells+numVerticesAdj) */
+  ierr = PetscSFGetGraph(sfVert, NULL, &numVerticesAdj, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(PetscMax(numCells, numVertices), &values, numVerticesAdj, &vertexValues);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel label;
+    char    name[256];
+
+    ierr = PetscViewerBinaryRead(viewer, name, 256, NULL, PETSC_CHAR);CHKERRQ(ierr);
+    name[255] = '\0';
+    ierr = DMCreateLabel(dm, name);CHKERRQ(ierr);
+    ierr = DMGetLabel(dm, name, &label);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryReadAll(viewer, values, numCells, cStart, NCells, PETSC_INT);CHKERRQ(ierr);
+    for (i = 0; i < numCells; ++i) if (values[i] != -1) {ierr = DMLabelSetValue(label, i, values[i]);CHKERRQ(ierr);}
+    ierr = PetscViewerBinaryReadAll(viewer, values, numVertices, vStart, NVertices, PETSC_INT);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfVert, MPIU_INT, values, vertexValues);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfVert, MPIU_INT, values, vertexValues);CHKERRQ(ierr);
+    for (i = 0; i < numVerticesAdj; ++i) if (vertexValues[i] != -1) {ierr = DMLabelSetValue(label, numCells+i, vertexValues[i]);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree2(values, vertexValues);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
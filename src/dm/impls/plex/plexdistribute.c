@@ -1739,6 +1739,106 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   PetscFunctionReturn(0);
 }
 
+/*@C
+  DMPlexRedistribute - Rebalances a distributed mesh, and migrates its section and local vectors with it
+
+  Collective on dm
+
+  Input Parameters:
++ dm      - The distributed DMPlex object
+. overlap - The overlap of partitions, 0 is the default
+. numVecs - The number of vectors to migrate
+- vecs    - The local vectors, laid out by the local section of dm
+
+  Output Parameters:
++ sf         - The PetscSF used for point distribution, or NULL if not needed
+. dmParallel - The rebalanced DMPlex object, whose local section is the migrated local section of dm
+- newVecs    - The migrated local vectors
+
+  Notes:
+  If the mesh was not distributed, the outputs dmParallel and newVecs will be NULL.
+
+  All vectors are migrated in a single communication over the PetscSF of the section dofs, instead of one
+  DMPlexDistributeField() call for each vector. Use the PETSCPARTITIONERDIFFUSIVE partitioner to move only a few cells
+  when the mesh is slightly unbalanced, for instance after adaptive refinement.
+
+  Level: intermediate
+
+.seealso: DMPlexDistribute(), DMPlexDistributeField(), DMPlexSetPartitioner(), PETSCPARTITIONERDIFFUSIVE
+@*/
+PetscErrorCode DMPlexRedistribute(DM dm, PetscInt overlap, PetscInt numVecs, Vec vecs[], PetscSF *sf, DM *dmParallel, Vec newVecs[])
+{
+  MPI_Datatype   unit;
+  PetscSection   section, newSection;
+  PetscSF        sfMigration, fieldSF;
+  PetscScalar   *values, *newValues;
+  PetscInt      *remoteOffsets, n, newN, i, k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(dm, overlap, 2);
+  PetscValidLogicalCollectiveInt(dm, numVecs, 3);
+  if (numVecs) PetscValidPointer(vecs, 4);
+  if (sf) PetscValidPointer(sf, 5);
+  PetscValidPointer(dmParallel, 6);
+  if (numVecs) PetscValidPointer(newVecs, 7);
+  for (k = 0; k < numVecs; ++k) newVecs[k] = NULL;
+  if (sf) *sf = NULL;
+  ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  if (numVecs && !section) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_WRONGSTATE, "The DM must have a local section to migrate vectors");
+  ierr = DMPlexDistribute(dm, overlap, &sfMigration, dmParallel);CHKERRQ(ierr);
+  if (!*dmParallel) PetscFunctionReturn(0);
+  if (section) {
+    ierr = PetscLogEventBegin(DMPLEX_DistributeField,dm,0,0,0);CHKERRQ(ierr);
+    ierr = PetscSectionCreate(PetscObjectComm((PetscObject) *dmParallel), &newSection);CHKERRQ(ierr);
+    ierr = PetscSFDistributeSection(sfMigration, section, &remoteOffsets, newSection);CHKERRQ(ierr);
+    ierr = DMSetLocalSection(*dmParallel, newSection);CHKERRQ(ierr);
+    if (numVecs) {
+      /* Interlace the vectors, so that the dofs of a point travel together in one message */
+      ierr = PetscSFCreateSectionSF(sfMigration, section, remoteOffsets, newSection, &fieldSF);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(section, &n);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(newSection, &newN);CHKERRQ(ierr);
+      ierr = PetscMalloc2(n*numVecs, &values, newN*numVecs, &newValues);CHKERRQ(ierr);
+      for (k = 0; k < numVecs; ++k) {
+        const PetscScalar *a;
+        PetscInt           vn;
+
+        PetscValidHeaderSpecific(vecs[k], VEC_CLASSID, 4);
+        ierr = VecGetLocalSize(vecs[k], &vn);CHKERRQ(ierr);
+        if (vn != n) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Local size %D of vector %D does not match the local section storage size %D", vn, k, n);
+        ierr = VecGetArrayRead(vecs[k], &a);CHKERRQ(ierr);
+        for (i = 0; i < n; ++i) values[i*numVecs+k] = a[i];
+        ierr = VecRestoreArrayRead(vecs[k], &a);CHKERRQ(ierr);
+      }
+      ierr = MPI_Type_contiguous(numVecs, MPIU_SCALAR, &unit);CHKERRQ(ierr);
+      ierr = MPI_Type_commit(&unit);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(fieldSF, unit, values, newValues);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(fieldSF, unit, values, newValues);CHKERRQ(ierr);
+      ierr = MPI_Type_free(&unit);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&fieldSF);CHKERRQ(ierr);
+      for (k = 0; k < numVecs; ++k) {
+        PetscScalar *a;
+        const char  *name;
+
+        ierr = DMCreateLocalVector(*dmParallel, &newVecs[k]);CHKERRQ(ierr);
+        ierr = PetscObjectGetName((PetscObject) vecs[k], &name);CHKERRQ(ierr);
+        ierr = PetscObjectSetName((PetscObject) newVecs[k], name);CHKERRQ(ierr);
+        ierr = VecGetArray(newVecs[k], &a);CHKERRQ(ierr);
+        for (i = 0; i < newN; ++i) a[i] = newValues[i*numVecs+k];
+        ierr = VecRestoreArray(newVecs[k], &a);CHKERRQ(ierr);
+      }
+      ierr = PetscFree2(values, newValues);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(remoteOffsets);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&newSection);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(DMPLEX_DistributeField,dm,0,0,0);CHKERRQ(ierr);
+  }
+  if (sf) {*sf = sfMigration;}
+  else    {ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexDistributeOverlap - Add partition overlap to a distributed non-overlapping DM.
 
@@ -73,3 +73,92 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*@
+  DMPlexCreateClosureDofIndex - Calculate the dof indices of the closure of each cell, which are then used by the closure operations
+
+  Not collective
+
+  Input Parameters:
++ dm         - The DM
+. section    - The section describing the layout in the local vector, or NULL to use the default section
+- idxSection - The section in which indices are computed, either section for local indices, or the global section of the DM
+
+  Notes:
+  The indices are stored contiguously for each cell with the dual space symmetries and the closure permutation applied,
+  so that DMPlexVecGetClosure() and DMPlexVecSetClosure() with local indices, and DMPlexMatSetClosure() with global
+  indices, become a gather or scatter without traversing the closure. The index is attached to idxSection, and is
+  discarded when the section is reset or the closure permutation changes. No index is stored for meshes with anchors,
+  or for sections with sign changes in their symmetries, for which the closure operations take the usual path.
+
+  This is called automatically by DMPlexComputeResidual_Internal() and DMPlexComputeJacobian_Internal().
+
+  Level: intermediate
+
+.seealso DMPlexCreateClosureIndex(), DMPlexVecGetClosure(), DMPlexVecSetClosure(), DMPlexMatSetClosure()
+@*/
+PetscErrorCode DMPlexCreateClosureDofIndex(DM dm, PetscSection section, PetscSection idxSection)
+{
+  PetscSection   aSec;
+  PetscSegBuffer dofBuffer;
+  PetscInt      *offsets, *dofs = NULL;
+  PetscInt       Nf, cStart, cEnd, c, f;
+  PetscBool      has, pointMajor, useFieldOffsets = PETSC_FALSE, cache;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(idxSection, PETSC_SECTION_CLASSID, 3);
+  ierr = PetscSectionHasClosureDofs_Internal(idxSection, (PetscObject) dm, &has);CHKERRQ(ierr);
+  if (has) PetscFunctionReturn(0);
+  ierr = PetscSectionGetNumFields(section, &Nf);CHKERRQ(ierr);
+  ierr = PetscSectionGetPointMajor(section, &pointMajor);CHKERRQ(ierr);
+  if (Nf && idxSection != section) {ierr = PetscSectionGetUseFieldOffsets(idxSection, &useFieldOffsets);CHKERRQ(ierr);}
+  ierr = DMPlexGetAnchors(dm, &aSec, NULL);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  cache = (!aSec && pointMajor && !useFieldOffsets) ? PETSC_TRUE : PETSC_FALSE;
+  /* Sign changes from the symmetries would have to be applied to the values, so they cannot be stored in the index */
+  for (c = cStart; cache && c < cEnd; ++c) {
+    PetscSection        clSection;
+    IS                  clPoints;
+    const PetscInt     *clp;
+    const PetscScalar **flips;
+    PetscInt           *points = NULL, numPoints, p;
+
+    ierr = DMPlexGetCompressedClosure(dm, section, c, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+    for (f = 0; f < PetscMax(1, Nf); ++f) {
+      flips = NULL;
+      if (Nf) {ierr = PetscSectionGetFieldPointSyms(section, f, numPoints, points, NULL, &flips);CHKERRQ(ierr);}
+      else    {ierr = PetscSectionGetPointSyms(section, numPoints, points, NULL, &flips);CHKERRQ(ierr);}
+      for (p = 0; flips && p < numPoints; ++p) if (flips[p]) cache = PETSC_FALSE;
+      if (Nf) {ierr = PetscSectionRestoreFieldPointSyms(section, f, numPoints, points, NULL, &flips);CHKERRQ(ierr);}
+      else    {ierr = PetscSectionRestorePointSyms(section, numPoints, points, NULL, &flips);CHKERRQ(ierr);}
+    }
+    ierr = DMPlexRestoreCompressedClosure(dm, section, c, &numPoints, &points, &clSection, &clPoints, &clp);CHKERRQ(ierr);
+  }
+  if (!cache) {
+    ierr = PetscInfo(dm, "Closure dof indices cannot be cached for this section\n");CHKERRQ(ierr);
+    ierr = PetscCalloc1(1, &offsets);CHKERRQ(ierr);
+    ierr = PetscSectionSetClosureDofs_Internal(idxSection, (PetscObject) dm, 0, 0, offsets, NULL);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc1(cEnd-cStart+1, &offsets);CHKERRQ(ierr);
+  ierr = PetscSegBufferCreate(sizeof(PetscInt), 1024, &dofBuffer);CHKERRQ(ierr);
+  offsets[0] = 0;
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *indices, *buf, numIndices;
+
+    ierr = DMPlexGetClosureIndices(dm, section, idxSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    ierr = PetscSegBufferGetInts(dofBuffer, numIndices, &buf);CHKERRQ(ierr);
+    ierr = PetscArraycpy(buf, indices, numIndices);CHKERRQ(ierr);
+    ierr = DMPlexRestoreClosureIndices(dm, section, idxSection, c, &numIndices, &indices, NULL);CHKERRQ(ierr);
+    offsets[c-cStart+1] = offsets[c-cStart] + numIndices;
+  }
+  ierr = PetscSegBufferExtractAlloc(dofBuffer, &dofs);CHKERRQ(ierr);
+  ierr = PetscSegBufferDestroy(&dofBuffer);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject) dm, (cEnd-cStart+1+offsets[cEnd-cStart])*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSectionSetClosureDofs_Internal(idxSection, (PetscObject) dm, cStart, cEnd, offsets, dofs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
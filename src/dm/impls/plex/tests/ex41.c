@@ -0,0 +1,134 @@
+static const char help[] = "Tests parallel loading of a DMPlex from a PETSc binary file\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt  dim;                          /* The topological dimension */
+  PetscBool simplex;                      /* Flag for simplices */
+  PetscBool distribute;                   /* Rebalance the loaded mesh */
+  char      filename[PETSC_MAX_PATH_LEN]; /* The binary mesh file */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim        = 2;
+  options->simplex    = PETSC_TRUE;
+  options->distribute = PETSC_TRUE;
+  ierr = PetscStrcpy(options->filename, "ex41.bin");CHKERRQ(ierr);
+
+  ierr = PetscOptionsBegin(comm, "", "Binary Mesh Loading Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim", "The topological dimension", "ex41.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex", "Flag for simplices", "ex41.c", options->simplex, &options->simplex, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-distribute", "Rebalance the loaded mesh", "ex41.c", options->distribute, &options->distribute, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsString("-filename", "The binary mesh file", "ex41.c", options->filename, options->filename, sizeof(options->filename), NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ReportMesh(DM dm, const char name[])
+{
+  DMLabel         marker;
+  IS              cellNumbering, vertexNumbering;
+  const PetscInt *gcell, *gvertex;
+  PetscReal       vol, volume = 0.0;
+  PetscInt        counts[3] = {0, 0, 0}, cStart, cEnd, vStart, vEnd, c, v, val;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+  ierr = DMPlexGetVertexNumbering(dm, &vertexNumbering);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISGetIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    if (gcell[c-cStart] < 0) continue;
+    ierr = DMPlexComputeCellGeometryFVM(dm, c, &vol, NULL, NULL);CHKERRQ(ierr);
+    volume += vol;
+    ++counts[0];
+  }
+  /* The boundary marker is kept on the vertices */
+  ierr = DMGetLabel(dm, "marker", &marker);CHKERRQ(ierr);
+  if (!marker) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Mesh has no marker label");
+  for (v = vStart; v < vEnd; ++v) {
+    if (gvertex[v-vStart] < 0) continue;
+    ++counts[1];
+    ierr = DMLabelGetValue(marker, v, &val);CHKERRQ(ierr);
+    if (val == 1) ++counts[2];
+  }
+  ierr = ISRestoreIndices(cellNumbering, &gcell);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(vertexNumbering, &gvertex);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, counts, 3, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, &volume, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "%s mesh: %D cells, %D vertices, %D marked vertices, volume %g\n", name, counts[0], counts[1], counts[2], (double) volume);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, dmLoad, dmDist;
+  PetscViewer    viewer;
+  AppCtx         ctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &ctx);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, ctx.dim, ctx.simplex, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = dmDist;
+  }
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-orig_dm_view");CHKERRQ(ierr);
+  ierr = ReportMesh(dm, "Original");CHKERRQ(ierr);
+  /* Write the distributed mesh */
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD, ctx.filename, FILE_MODE_WRITE, &viewer);CHKERRQ(ierr);
+  ierr = DMView(dm, viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  /* Each process reads its own chunk of the mesh */
+  ierr = DMPlexCreateFromFile(PETSC_COMM_WORLD, ctx.filename, PETSC_TRUE, &dmLoad);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) dmLoad, "Loaded Mesh");CHKERRQ(ierr);
+  ierr = DMPlexCheckSymmetry(dmLoad);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dmLoad, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(dmLoad, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckGeometry(dmLoad);CHKERRQ(ierr);
+  ierr = ReportMesh(dmLoad, "Loaded");CHKERRQ(ierr);
+  if (ctx.distribute) {
+    ierr = DMPlexDistribute(dmLoad, 0, NULL, &dmDist);CHKERRQ(ierr);
+    if (dmDist) {
+      ierr = DMDestroy(&dmLoad);CHKERRQ(ierr);
+      dmLoad = dmDist;
+    }
+    ierr = DMPlexCheckSymmetry(dmLoad);CHKERRQ(ierr);
+    ierr = DMPlexCheckSkeleton(dmLoad, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckFaces(dmLoad, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckGeometry(dmLoad);CHKERRQ(ierr);
+    ierr = DMPlexCheckPointSF(dmLoad);CHKERRQ(ierr);
+    ierr = ReportMesh(dmLoad, "Rebalanced");CHKERRQ(ierr);
+  }
+  ierr = DMViewFromOptions(dmLoad, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = DMDestroy(&dmLoad);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: quad
+    nsize: {{1 2 3}}
+    args: -simplex 0 -dm_plex_box_faces 3,4
+    output_file: output/ex41_quad.out
+
+  test:
+    suffix: hex
+    nsize: {{1 2}}
+    args: -dim 3 -simplex 0 -dm_plex_box_faces 2,3,2
+    output_file: output/ex41_hex.out
+
+TEST*/
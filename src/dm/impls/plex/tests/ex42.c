@@ -0,0 +1,198 @@
+static const char help[] = "Tests the cached closure dof index against the standard closure operations\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt  dim;       /* The topological dimension */
+  PetscInt  numFields; /* The number of section fields */
+  PetscInt  order;     /* The number of dofs on each edge */
+  PetscBool bc;        /* Constrain the dofs on the boundary */
+  PetscBool tensor;    /* Use the tensor product closure permutation */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim       = 2;
+  options->numFields = 1;
+  options->order     = 1;
+  options->bc        = PETSC_FALSE;
+  options->tensor    = PETSC_FALSE;
+
+  ierr = PetscOptionsBegin(comm, "", "Closure Dof Index Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim", "The topological dimension", "ex42.c", options->dim, &options->dim, NULL, 2, 3);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-num_fields", "The number of section fields", "ex42.c", options->numFields, &options->numFields, NULL, 0, 2);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-order", "The number of dofs on each edge, or the order minus one", "ex42.c", options->order, &options->order, NULL, 0, 2);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-bc", "Constrain the dofs on the boundary", "ex42.c", options->bc, &options->bc, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-tensor", "Use the tensor product closure permutation", "ex42.c", options->tensor, &options->tensor, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Field f has f+1 components, with order^d dofs per component on each point of dimension d */
+static PetscErrorCode CreateSection(DM dm, AppCtx *user)
+{
+  PetscSection   s;
+  IS             bcPoints[2];
+  PetscInt       numComp[2], numDof[8], bcField[2], Nf = PetscMax(1, user->numFields), numBC = 0, f, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  for (f = 0; f < Nf; ++f) {
+    numComp[f] = f+1;
+    for (d = 0; d <= user->dim; ++d) numDof[f*(user->dim+1)+d] = (d ? (PetscInt) PetscPowInt(user->order, d) : 1)*numComp[f];
+  }
+  if (user->bc) {
+    for (f = 0; f < Nf; ++f) {
+      bcField[f] = f;
+      ierr = DMGetStratumIS(dm, "marker", 1, &bcPoints[f]);CHKERRQ(ierr);
+    }
+    numBC = Nf;
+  }
+  ierr = DMSetNumFields(dm, user->numFields);CHKERRQ(ierr);
+  ierr = DMPlexCreateSection(dm, NULL, numComp, numDof, numBC, bcField, NULL, bcPoints, NULL, &s);CHKERRQ(ierr);
+  ierr = DMSetLocalSection(dm, s);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  for (f = 0; f < numBC; ++f) {ierr = ISDestroy(&bcPoints[f]);CHKERRQ(ierr);}
+  if (user->tensor) {ierr = DMPlexSetClosurePermutationTensor(dm, PETSC_DETERMINE, NULL);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* Gather every closure, set it with every insert mode, and assemble random element matrices */
+static PetscErrorCode ApplyClosures(DM dm, Vec u, PetscScalar closures[], Vec v[], Mat A)
+{
+  const InsertMode modes[6] = {INSERT_VALUES, INSERT_ALL_VALUES, INSERT_BC_VALUES, ADD_VALUES, ADD_ALL_VALUES, ADD_BC_VALUES};
+  PetscSection     s;
+  PetscScalar     *elemMat;
+  PetscInt         cStart, cEnd, c, off = 0, maxSize = 0, i, m;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalSection(dm, &s);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt size;
+
+    ierr = DMPlexVecGetClosure(dm, s, u, c, &size, NULL);CHKERRQ(ierr);
+    maxSize = PetscMax(maxSize, size);
+  }
+  ierr = PetscMalloc1(maxSize*maxSize, &elemMat);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *x = NULL;
+    PetscInt     size;
+
+    ierr = DMPlexVecGetClosure(dm, s, u, c, &size, &x);CHKERRQ(ierr);
+    for (i = 0; i < size; ++i) closures[off+i] = x[i];
+    for (m = 0; m < 6; ++m) {ierr = DMPlexVecSetClosure(dm, s, v[m], c, x, modes[m]);CHKERRQ(ierr);}
+    for (i = 0; i < size*size; ++i) elemMat[i] = x[i%size] + 10.0*(i/size) + c;
+    ierr = DMPlexMatSetClosure(dm, NULL, NULL, A, c, elemMat, ADD_VALUES);CHKERRQ(ierr);
+    ierr = DMPlexVecRestoreClosure(dm, s, u, c, &size, &x);CHKERRQ(ierr);
+    off += size;
+  }
+  ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(elemMat);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TestClosureDofIndex(DM dm)
+{
+  PetscSection   s, gs;
+  Vec            u, v[6], w[6];
+  Mat            A, B;
+  PetscScalar   *closures, *closuresIndex;
+  PetscReal      norm;
+  PetscInt       n, cStart, cEnd, c, size, total = 0, i, m;
+  PetscBool      equal;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalSection(dm, &s);CHKERRQ(ierr);
+  ierr = DMGetGlobalSection(dm, &gs);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &u);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(u, &n);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {ierr = VecSetValue(u, i, (PetscScalar) i, INSERT_VALUES);CHKERRQ(ierr);}
+  for (c = cStart; c < cEnd; ++c) {
+    ierr = DMPlexVecGetClosure(dm, s, u, c, &size, NULL);CHKERRQ(ierr);
+    total += size;
+  }
+  ierr = PetscMalloc2(total, &closures, total, &closuresIndex);CHKERRQ(ierr);
+  for (m = 0; m < 6; ++m) {
+    ierr = VecDuplicate(u, &v[m]);CHKERRQ(ierr);
+    ierr = VecDuplicate(u, &w[m]);CHKERRQ(ierr);
+    ierr = VecSet(v[m], -1.0);CHKERRQ(ierr);
+    ierr = VecSet(w[m], -1.0);CHKERRQ(ierr);
+  }
+  ierr = DMCreateMatrix(dm, &A);CHKERRQ(ierr);
+  ierr = MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &B);CHKERRQ(ierr);
+  ierr = ApplyClosures(dm, u, closures, v, A);CHKERRQ(ierr);
+  ierr = DMPlexCreateClosureDofIndex(dm, s, s);CHKERRQ(ierr);
+  ierr = DMPlexCreateClosureDofIndex(dm, s, gs);CHKERRQ(ierr);
+  ierr = ApplyClosures(dm, u, closuresIndex, w, B);CHKERRQ(ierr);
+  for (i = 0; i < total; ++i) if (closures[i] != closuresIndex[i]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure value %D is %g with the index, should be %g", i, (double) PetscRealPart(closuresIndex[i]), (double) PetscRealPart(closures[i]));
+  for (m = 0; m < 6; ++m) {
+    ierr = VecAXPY(w[m], -1.0, v[m]);CHKERRQ(ierr);
+    ierr = VecNorm(w[m], NORM_INFINITY, &norm);CHKERRQ(ierr);
+    if (norm != 0.0) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "DMPlexVecSetClosure() with insert mode %D differs by %g with the index", m, (double) norm);
+  }
+  ierr = MatEqual(A, B, &equal);CHKERRQ(ierr);
+  if (!equal) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "DMPlexMatSetClosure() differs with the index");
+  ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Closures agree with the dof index\n");CHKERRQ(ierr);
+  for (m = 0; m < 6; ++m) {
+    ierr = VecDestroy(&v[m]);CHKERRQ(ierr);
+    ierr = VecDestroy(&w[m]);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFree2(closures, closuresIndex);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &u);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM             dm, dmDist;
+  AppCtx         user;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(PETSC_COMM_WORLD, user.dim, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, &dm);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(&dm);CHKERRQ(ierr);
+    dm   = dmDist;
+  }
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMViewFromOptions(dm, NULL, "-dm_view");CHKERRQ(ierr);
+  ierr = CreateSection(dm, &user);CHKERRQ(ierr);
+  ierr = TestClosureDofIndex(dm);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: {{1 2}}
+    args: -dm_plex_box_faces 3,3 -num_fields {{0 1 2}} -order {{0 2}} -bc {{0 1}}
+    output_file: output/ex42_0.out
+
+  test:
+    suffix: tensor
+    args: -dm_plex_box_faces 3,3 -num_fields {{0 2}} -order 2 -bc -tensor
+    output_file: output/ex42_0.out
+
+  test:
+    suffix: 3d
+    nsize: 2
+    args: -dim 3 -dm_plex_box_faces 2,2,2 -num_fields 2 -order 1 -bc
+    output_file: output/ex42_0.out
+
+TEST*/
@@ -0,0 +1,193 @@
+static const char help[] = "Tests the rebalancing of an unbalanced mesh with the diffusive partitioner\n\n";
+
+#include <petscdmplex.h>
+
+typedef struct {
+  PetscInt dim; /* The topological dimension */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim = 2;
+
+  ierr = PetscOptionsBegin(comm, "", "Diffusive Repartitioning Options", "DMPLEX");CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim", "The topological dimension", "ex43.c", options->dim, &options->dim, NULL, 2, 3);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();
+  PetscFunctionReturn(0);
+}
+
+/* Process q gets a share of the cells proportional to size - q, in strips of the box */
+static PetscErrorCode CreateUnbalancedMesh(MPI_Comm comm, AppCtx *user, DM *dm)
+{
+  DM               dmDist;
+  PetscPartitioner part;
+  PetscInt        *sizes, *points, cStart, cEnd, c, q, off = 0;
+  PetscMPIInt      size, rank;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = DMPlexCreateBoxMesh(comm, user->dim, PETSC_FALSE, NULL, NULL, NULL, NULL, PETSC_TRUE, dm);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc2(size, &sizes, cEnd-cStart, &points);CHKERRQ(ierr);
+  for (q = 0; q < size; ++q) {
+    sizes[q] = (2*(size-q)*(cEnd-cStart))/(size*(size+1));
+    off     += sizes[q];
+  }
+  sizes[0] += cEnd-cStart-off;
+  for (c = cStart; c < cEnd; ++c) points[c-cStart] = c;
+  ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetType(part, PETSCPARTITIONERSHELL);CHKERRQ(ierr);
+  ierr = PetscPartitionerShellSetPartition(part, size, rank ? NULL : sizes, rank ? NULL : points);CHKERRQ(ierr);
+  ierr = PetscFree2(sizes, points);CHKERRQ(ierr);
+  ierr = DMPlexDistribute(*dm, 0, NULL, &dmDist);CHKERRQ(ierr);
+  if (dmDist) {
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmDist;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ReportCells(DM dm, const char name[])
+{
+  MPI_Comm       comm;
+  PetscInt       cStart, cEnd;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm, "%s mesh:\n", name);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(comm, "  [%d] %D cells\n", rank, cEnd-cStart);CHKERRQ(ierr);
+  ierr = PetscSynchronizedFlush(comm, NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscScalar Field(PetscInt dim, const PetscReal x[], PetscInt k)
+{
+  PetscReal f = 1.0;
+  PetscInt  d;
+
+  for (d = 0; d < dim; ++d) f += PetscPowInt(10, d)*x[d];
+  return (k+1)*f;
+}
+
+/* Vertices carry the field, and cells carry the field and its double evaluated at the centroid */
+static PetscErrorCode ProcessFields(DM dm, Vec u, PetscBool check)
+{
+  PetscSection       s, cs;
+  Vec                coordinates;
+  const PetscScalar *coords;
+  PetscScalar       *a;
+  PetscReal          centroid[3], x[3];
+  PetscInt           dim, cStart, cEnd, vStart, vEnd, p, off, coff, d, k;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(dm, &s);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &cs);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(u, &a);CHKERRQ(ierr);
+  for (p = vStart; p < vEnd; ++p) {
+    ierr = PetscSectionGetOffset(s, p, &off);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(cs, p, &coff);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) x[d] = PetscRealPart(coords[coff+d]);
+    if (!check) a[off] = Field(dim, x, 0);
+    else if (PetscAbsScalar(a[off] - Field(dim, x, 0)) > PETSC_SMALL) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Wrong value %g at vertex %D", (double) PetscRealPart(a[off]), p);
+  }
+  for (p = cStart; p < cEnd; ++p) {
+    ierr = DMPlexComputeCellGeometryFVM(dm, p, NULL, centroid, NULL);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(s, p, &off);CHKERRQ(ierr);
+    for (k = 0; k < 2; ++k) {
+      if (!check) a[off+k] = Field(dim, centroid, k);
+      else if (PetscAbsScalar(a[off+k] - Field(dim, centroid, k)) > PETSC_SMALL) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Wrong value %g at cell %D", (double) PetscRealPart(a[off+k]), p);
+    }
+  }
+  ierr = VecRestoreArray(u, &a);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc, char **argv)
+{
+  DM               dm, dmNew;
+  PetscPartitioner part;
+  PetscSection     s;
+  Vec              vecs[2], newVecs[2];
+  PetscInt         numDof[4] = {0, 0, 0, 0}, numComp = 1, k;
+  AppCtx           user;
+  PetscErrorCode   ierr;
+
+  ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD, &user);CHKERRQ(ierr);
+  ierr = CreateUnbalancedMesh(PETSC_COMM_WORLD, &user, &dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = ReportCells(dm, "Unbalanced");CHKERRQ(ierr);
+  numDof[0]        = 1;
+  numDof[user.dim] = 2;
+  ierr = DMSetNumFields(dm, 1);CHKERRQ(ierr);
+  ierr = DMPlexCreateSection(dm, NULL, &numComp, numDof, 0, NULL, NULL, NULL, NULL, &s);CHKERRQ(ierr);
+  ierr = DMSetLocalSection(dm, s);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  for (k = 0; k < 2; ++k) {
+    ierr = DMCreateLocalVector(dm, &vecs[k]);CHKERRQ(ierr);
+    ierr = ProcessFields(dm, vecs[k], PETSC_FALSE);CHKERRQ(ierr);
+  }
+  ierr = VecScale(vecs[1], 2.0);CHKERRQ(ierr);
+  ierr = DMPlexGetPartitioner(dm, &part);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetType(part, PETSCPARTITIONERDIFFUSIVE);CHKERRQ(ierr);
+  ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+  ierr = DMPlexRedistribute(dm, 0, 2, vecs, NULL, &dmNew, newVecs);CHKERRQ(ierr);
+  ierr = PetscObjectViewFromOptions((PetscObject) part, NULL, "-part_view");CHKERRQ(ierr);
+  if (dmNew) {
+    ierr = DMPlexCheckSymmetry(dmNew);CHKERRQ(ierr);
+    ierr = DMPlexCheckSkeleton(dmNew, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckFaces(dmNew, 0);CHKERRQ(ierr);
+    ierr = DMPlexCheckPointSF(dmNew);CHKERRQ(ierr);
+    ierr = ReportCells(dmNew, "Rebalanced");CHKERRQ(ierr);
+    ierr = VecScale(newVecs[1], 0.5);CHKERRQ(ierr);
+    for (k = 0; k < 2; ++k) {ierr = ProcessFields(dmNew, newVecs[k], PETSC_TRUE);CHKERRQ(ierr);}
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "Migrated fields agree\n");CHKERRQ(ierr);
+    ierr = DMViewFromOptions(dmNew, NULL, "-dm_view");CHKERRQ(ierr);
+    for (k = 0; k < 2; ++k) {ierr = VecDestroy(&newVecs[k]);CHKERRQ(ierr);}
+    ierr = DMDestroy(&dmNew);CHKERRQ(ierr);
+  }
+  for (k = 0; k < 2; ++k) {ierr = VecDestroy(&vecs[k]);CHKERRQ(ierr);}
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+    nsize: 2
+    args: -dm_plex_box_faces 6,6 -part_view -petscpartitioner_diffusive_fallback 0
+
+  test:
+    suffix: 1
+    nsize: 3
+    args: -dm_plex_box_faces 8,6 -part_view -petscpartitioner_diffusive_fallback 0
+
+  test:
+    suffix: 3d
+    nsize: 3
+    args: -dim 3 -dm_plex_box_faces 3,3,4 -part_view -petscpartitioner_diffusive_fallback 0
+
+  test:
+    suffix: fallback
+    nsize: 3
+    args: -dm_plex_box_faces 8,6 -petscpartitioner_diffusive_max_it 0 -diffusive_fallback_mat_partitioning_hierarchical_coarseparttype average -diffusive_fallback_mat_partitioning_hierarchical_fineparttype average
+
+TEST*/
@@ -25,6 +25,10 @@
       PetscEnum, parameter :: KSP_FCD_TRUNC_TYPE_STANDARD=0
       PetscEnum, parameter :: KSP_FCD_TRUNC_TYPE_NOTAY=1
 
+      PetscEnum, parameter :: KSP_CA_BASIS_MONOMIAL=0
+      PetscEnum, parameter :: KSP_CA_BASIS_NEWTON=1
+      PetscEnum, parameter :: KSP_CA_BASIS_CHEBYSHEV=2
+
       PetscEnum, parameter :: KSP_CONVERGED_RTOL            = 2
       PetscEnum, parameter :: KSP_CONVERGED_ATOL            = 3
       PetscEnum, parameter :: KSP_CONVERGED_ITS             = 4
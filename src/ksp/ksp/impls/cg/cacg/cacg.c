@@ -0,0 +1,601 @@
+
+/*
+    This file implements an s-step (communication-avoiding) preconditioned conjugate gradient method.
+
+    Each outer iteration computes the bases of the Krylov spaces K_{s+1}(M^{-1}A,p) and K_s(M^{-1}A,z) with
+    s applications of the matrix and preconditioner, forms all their inner products with a single global
+    reduction, and then performs s CG iterations on the short coefficient vectors in these bases.
+
+    Reference: Carson, Communication-avoiding Krylov subspace methods in theory and practice, PhD thesis, 2015.
+*/
+#include <petsc/private/kspimpl.h>  /*I "petscksp.h" I*/
+
+typedef struct {
+  PetscInt       s;              /* number of CG iterations per global reduction */
+  KSPCABasisType basis;
+  PetscReal      emin,emax;      /* user provided eigenvalue estimates, used if emax > emin */
+  PetscBool      nopc;           /* the preconditioner is the identity so the two bases coincide */
+  Vec            *Yh,*Yt;        /* basis of the preconditioned vectors and Yt = M Yh */
+  PetscScalar    *Bs;            /* (s+1) x s change of basis matrix */
+  PetscScalar    *B;             /* block change of basis matrix for [P R] */
+  PetscScalar    *G,*Gn;         /* Gram matrix Yh^H Yt, and the Gram matrix used for the residual norm */
+  PetscScalar    *pc,*rc,*xc,*wc; /* coordinates of p, r, the update of x and A p in the basis */
+  PetscScalar    *T;             /* Lanczos tridiagonal matrix from the first s iterations */
+  PetscReal      *er,*ei;        /* its eigenvalues */
+} KSP_CACG;
+
+static PetscErrorCode KSPSetUp_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       s = cacg->s,n = 2*s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetWorkVecs(ksp,4);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)ksp->pc,PCNONE,&cacg->nopc);CHKERRQ(ierr);
+  ierr = KSPCreateVecs(ksp,n,&cacg->Yh,0,NULL);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,n,cacg->Yh);CHKERRQ(ierr);
+  if (cacg->nopc) cacg->Yt = cacg->Yh;
+  else {
+    ierr = KSPCreateVecs(ksp,n,&cacg->Yt,0,NULL);CHKERRQ(ierr);
+    ierr = PetscLogObjectParents(ksp,n,cacg->Yt);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc7((s+1)*s,&cacg->Bs,n*n,&cacg->B,n*n,&cacg->G,n*n,&cacg->Gn,s*s,&cacg->T,s,&cacg->er,s,&cacg->ei);CHKERRQ(ierr);
+  ierr = PetscMalloc1(4*n,&cacg->pc);CHKERRQ(ierr);
+  cacg->rc = cacg->pc + n;
+  cacg->xc = cacg->rc + n;
+  cacg->wc = cacg->xc + n;
+  ierr = PetscLogObjectMemory((PetscObject)ksp,((s+1)*s + 3*n*n + s*s + 4*n)*sizeof(PetscScalar) + 2*s*sizeof(PetscReal));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes Yt[i+1] = (A Yh[i] - sum_k B(k,i) Yt[k])/B(i+1,i) and Yh[i+1] = M^{-1} Yt[i+1]
+*/
+static PetscErrorCode KSPCACGExtendBasis_Private(KSP ksp,Mat Amat,Vec *Yh,Vec *Yt,PetscInt i,const PetscScalar *Bs,PetscInt ld)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscScalar    alpha[2];
+  PetscInt       k,k0 = PetscMax(0,i-1);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSP_MatMult(ksp,Amat,Yh[i],Yt[i+1]);CHKERRQ(ierr);
+  for (k=k0; k<=i; k++) alpha[k-k0] = -Bs[k+i*ld];
+  ierr = VecMAXPY(Yt[i+1],i-k0+1,alpha,Yt+k0);CHKERRQ(ierr);
+  ierr = VecScale(Yt[i+1],1.0/Bs[i+1+i*ld]);CHKERRQ(ierr);
+  if (!cacg->nopc) {
+    ierr = KSP_PCApply(ksp,Yt[i+1],Yh[i+1]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* (Yh u, Yt v) computed from the Gram matrix G(i,j) = (Yh[i],Yt[j]) stored by rows */
+PETSC_STATIC_INLINE PetscScalar KSPCACGDot_Private(PetscInt n,const PetscScalar *G,const PetscScalar *u,const PetscScalar *v)
+{
+  PetscScalar sum = 0.0,t;
+  PetscInt    i,j;
+
+  for (i=0; i<n; i++) {
+    if (u[i] == 0.0) continue;
+    for (t=0.0,j=0; j<n; j++) t += PetscConj(v[j])*G[i*n+j];
+    sum += u[i]*t;
+  }
+  return sum;
+}
+
+/* Computes the Hermitian matrix G(i,j) = (X[i],Y[j]) of size n, assuming it is Hermitian, without completing the reduction */
+static PetscErrorCode KSPCACGGramBegin_Private(PetscInt n,Vec *X,Vec *Y,PetscScalar *G)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {ierr = VecMDotBegin(X[i],n-i,Y+i,G+i*n+i);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGGramEnd_Private(PetscInt n,Vec *X,Vec *Y,PetscScalar *G)
+{
+  PetscInt       i,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {ierr = VecMDotEnd(X[i],n-i,Y+i,G+i*n+i);CHKERRQ(ierr);}
+  for (i=0; i<n; i++) {
+    for (j=0; j<i; j++) G[i*n+j] = PetscConj(G[j*n+i]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       s = cacg->s,sb,nb,i,j,ned = 0;
+  PetscScalar    beta = 0.0,betaold = 1.0,dpi = 0.0,dpiold = 0.0,a = 1.0,aold = 1.0,b = 0.0,*G,*Gn,*B,*pc,*rc,*xc,*wc;
+  PetscReal      dp = 0.0;
+  Vec            X,RHS,R,Z,P,PT,*Yh = cacg->Yh,*Yt = cacg->Yt;
+  Mat            Amat,Pmat;
+  PetscBool      diagonalscale,estimate;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+
+  X   = ksp->vec_sol;
+  RHS = ksp->vec_rhs;
+  R   = ksp->work[0];
+  Z   = ksp->work[1];
+  P   = ksp->work[2];
+  PT  = ksp->work[3];
+  G   = cacg->G; Gn = cacg->Gn; B = cacg->B;
+  pc  = cacg->pc; rc = cacg->rc; xc = cacg->xc; wc = cacg->wc;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+
+  /* without user provided eigenvalue estimates the first s iterations are one step iterations whose Lanczos coefficients give them */
+  estimate = (cacg->emax > cacg->emin) ? PETSC_FALSE : PETSC_TRUE;
+  if (!estimate) {
+    ierr = KSPCABasisSetUp_Private(cacg->basis,s,0,NULL,NULL,cacg->emin,cacg->emax,cacg->Bs);CHKERRQ(ierr);
+  } else {
+    ierr = PetscArrayzero(cacg->T,s*s);CHKERRQ(ierr);
+    ierr = PetscArrayzero(cacg->Bs,(s+1)*s);CHKERRQ(ierr);
+    cacg->Bs[1] = 1.0;
+  }
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,X,R);CHKERRQ(ierr);            /*    r <- b - Ax                       */
+    ierr = VecAYPX(R,-1.0,RHS);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(RHS,R);CHKERRQ(ierr);                       /*    r <- b (x is 0)                   */
+  }
+  if (cacg->nopc) {
+    ierr = VecCopy(R,Z);CHKERRQ(ierr);
+  } else {
+    ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                 /*    z <- Br                           */
+  }
+  switch (ksp->normtype) {
+  case KSP_NORM_PRECONDITIONED:
+    ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);
+    KSPCheckNorm(ksp,dp);
+    break;
+  case KSP_NORM_UNPRECONDITIONED:
+    ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
+    KSPCheckNorm(ksp,dp);
+    break;
+  case KSP_NORM_NATURAL:
+    ierr = VecDot(Z,R,&beta);CHKERRQ(ierr);
+    KSPCheckDot(ksp,beta);
+    dp   = PetscSqrtReal(PetscAbsScalar(beta));
+    break;
+  case KSP_NORM_NONE:
+    dp = 0.0;
+    break;
+  default: SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"%s",KSPNormTypes[ksp->normtype]);
+  }
+  ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+  ierr       = KSPMonitor(ksp,0,dp);CHKERRQ(ierr);
+  ksp->rnorm = dp;
+  ierr = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  if (ksp->reason) PetscFunctionReturn(0);
+
+  ierr = VecCopy(Z,P);CHKERRQ(ierr);                           /*    p <- z, pt <- M p = r             */
+  ierr = VecCopy(R,PT);CHKERRQ(ierr);
+
+  while (!ksp->reason) {
+    sb = estimate ? 1 : s;
+    nb = 2*sb+1;
+
+    /* matrix powers: Yh = [P_0 .. P_sb, R_0 .. R_{sb-1}] with P_0 = p, R_0 = z */
+    ierr = VecCopy(P,Yh[0]);CHKERRQ(ierr);
+    ierr = VecCopy(Z,Yh[sb+1]);CHKERRQ(ierr);
+    if (!cacg->nopc) {
+      ierr = VecCopy(PT,Yt[0]);CHKERRQ(ierr);
+      ierr = VecCopy(R,Yt[sb+1]);CHKERRQ(ierr);
+    }
+    for (i=0; i<sb; i++) {ierr = KSPCACGExtendBasis_Private(ksp,Amat,Yh,Yt,i,cacg->Bs,s+1);CHKERRQ(ierr);}
+    for (i=0; i<sb-1; i++) {ierr = KSPCACGExtendBasis_Private(ksp,Amat,Yh+sb+1,Yt+sb+1,i,cacg->Bs,s+1);CHKERRQ(ierr);}
+
+    /* all the inner products of the next sb iterations with a single reduction */
+    ierr = KSPCACGGramBegin_Private(nb,Yh,Yt,G);CHKERRQ(ierr);
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && !cacg->nopc) {ierr = KSPCACGGramBegin_Private(nb,Yt,Yt,Gn);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_PRECONDITIONED && !cacg->nopc) {ierr = KSPCACGGramBegin_Private(nb,Yh,Yh,Gn);CHKERRQ(ierr);}
+    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+    ierr = KSPCACGGramEnd_Private(nb,Yh,Yt,G);CHKERRQ(ierr);
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && !cacg->nopc) {ierr = KSPCACGGramEnd_Private(nb,Yt,Yt,Gn);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_PRECONDITIONED && !cacg->nopc) {ierr = KSPCACGGramEnd_Private(nb,Yh,Yh,Gn);CHKERRQ(ierr);}
+    else Gn = G;
+
+    /* block diagonal change of basis matrix of [P R], its last column in each block is never used */
+    ierr = PetscArrayzero(B,nb*nb);CHKERRQ(ierr);
+    for (j=0; j<sb; j++) {
+      for (i=PetscMax(0,j-1); i<=j+1; i++) {
+        B[i+j*nb] = cacg->Bs[i+j*(s+1)];
+        if (j < sb-1) B[sb+1+i+(sb+1+j)*nb] = cacg->Bs[i+j*(s+1)];
+      }
+    }
+
+    ierr = PetscArrayzero(pc,3*(2*s+1));CHKERRQ(ierr);     /* pc, rc and xc */
+    pc[0]    = 1.0;
+    rc[sb+1] = 1.0;
+    beta     = KSPCACGDot_Private(nb,G,rc,rc);                 /*     beta <- z'*r                     */
+    KSPCheckDot(ksp,beta);
+    for (j=0; j<sb; j++) {
+      if (beta == 0.0) {
+        ksp->reason = KSP_CONVERGED_ATOL;
+        ierr        = PetscInfo(ksp,"converged due to beta = 0\n");CHKERRQ(ierr);
+        break;
+#if !defined(PETSC_USE_COMPLEX)
+      } else if (ksp->its && (beta*betaold < 0.0)) {
+        if (ksp->errorifnotconverged) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite preconditioner, beta %g, betaold %g",(double)beta,(double)betaold);
+        ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+        ierr        = PetscInfo(ksp,"diverging due to indefinite preconditioner\n");CHKERRQ(ierr);
+        break;
+#endif
+      }
+      if (j) {
+        b = beta/betaold;
+        for (i=0; i<nb; i++) pc[i] = rc[i] + b*pc[i];           /*     p <- z + b* p                    */
+      }
+      for (i=0; i<nb; i++) {                                   /*     w <- Ap                          */
+        PetscInt k;
+        wc[i] = 0.0;
+        for (k=PetscMax(0,i-1); k<PetscMin(nb,i+2); k++) wc[i] += B[i+k*nb]*pc[k];
+      }
+      dpiold = dpi;
+      dpi    = KSPCACGDot_Private(nb,G,pc,wc);                 /*     dpi <- p'w                       */
+      KSPCheckDot(ksp,dpi);
+      if ((dpi == 0.0) || (ksp->its && ((PetscSign(PetscRealPart(dpi))*PetscSign(PetscRealPart(dpiold))) < 0.0))) {
+        if (ksp->errorifnotconverged) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite matrix, dpi %g, dpiold %g",(double)PetscRealPart(dpi),(double)PetscRealPart(dpiold));
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        ierr        = PetscInfo(ksp,"diverging due to indefinite or negative definite matrix\n");CHKERRQ(ierr);
+        break;
+      }
+      a = beta/dpi;                                            /*     a = beta/p'w                     */
+      if (estimate) {
+        if (ned) {
+          cacg->T[ned+(ned-1)*s] = cacg->T[ned-1+ned*s] = PetscSqrtReal(PetscAbsScalar(b))/aold;
+          cacg->T[ned*(s+1)]     = PetscAbsScalar(b)/aold + 1.0/a;
+        } else cacg->T[0] = 1.0/a;
+        ned++;
+      }
+      aold = a;
+      for (i=0; i<nb; i++) {
+        xc[i] += a*pc[i];                                      /*     x <- x + ap                      */
+        rc[i] -= a*wc[i];                                      /*     r <- r - aw                      */
+      }
+      betaold = beta;
+      beta    = KSPCACGDot_Private(nb,G,rc,rc);                /*     beta <- r'*z                     */
+      KSPCheckDot(ksp,beta);
+      switch (ksp->normtype) {
+      case KSP_NORM_PRECONDITIONED:
+      case KSP_NORM_UNPRECONDITIONED:
+        dp = PetscSqrtReal(PetscAbsScalar(KSPCACGDot_Private(nb,Gn,rc,rc)));
+        break;
+      case KSP_NORM_NATURAL:
+        dp = PetscSqrtReal(PetscAbsScalar(beta));
+        break;
+      default:
+        dp = 0.0;
+      }
+      ksp->its++;
+      ksp->rnorm = dp;
+      ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (!ksp->reason && ksp->its >= ksp->max_it) ksp->reason = KSP_DIVERGED_ITS;
+      if (ksp->reason) {j++; break;}
+    }
+    if (j) {
+      ierr = VecMAXPY(X,nb,xc,Yh);CHKERRQ(ierr);               /*    x <- x + Yh xc                    */
+    }
+    if (ksp->reason) break;
+
+    /* new residual and direction from the basis */
+    ierr = VecSet(R,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(R,nb,rc,Yt);CHKERRQ(ierr);
+    ierr = VecSet(P,0.0);CHKERRQ(ierr);
+    ierr = VecMAXPY(P,nb,pc,Yh);CHKERRQ(ierr);
+    if (cacg->nopc) {
+      ierr = VecCopy(R,Z);CHKERRQ(ierr);
+      ierr = VecCopy(P,PT);CHKERRQ(ierr);
+    } else {
+      ierr = VecSet(Z,0.0);CHKERRQ(ierr);
+      ierr = VecMAXPY(Z,nb,rc,Yh);CHKERRQ(ierr);
+      ierr = VecSet(PT,0.0);CHKERRQ(ierr);
+      ierr = VecMAXPY(PT,nb,pc,Yt);CHKERRQ(ierr);
+    }
+    /* the direction for the next iteration has not been formed yet */
+    b = beta/betaold;
+    ierr = VecAYPX(P,b,Z);CHKERRQ(ierr);                       /*     p <- z + b* p                    */
+    ierr = VecAYPX(PT,b,R);CHKERRQ(ierr);
+
+    if (estimate && ned == s) {
+      ierr = KSPCABasisComputeRitz_Private(ned,cacg->T,s,cacg->er,cacg->ei);CHKERRQ(ierr);
+      ierr = KSPCABasisSetUp_Private(cacg->basis,s,ned,cacg->er,cacg->ei,0.0,0.0,cacg->Bs);CHKERRQ(ierr);
+      ierr = PetscInfo3(ksp,"Set up the %s basis from %D Ritz values with leading shift %g\n",KSPCABasisTypes[cacg->basis],ned,(double)cacg->er[0]);CHKERRQ(ierr);
+      estimate = PETSC_FALSE;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       n = 2*cacg->s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (cacg->Yt != cacg->Yh) {ierr = VecDestroyVecs(n,&cacg->Yt);CHKERRQ(ierr);}
+  ierr = VecDestroyVecs(n,&cacg->Yh);CHKERRQ(ierr);
+  cacg->Yt = NULL;
+  ierr = PetscFree7(cacg->Bs,cacg->B,cacg->G,cacg->Gn,cacg->T,cacg->er,cacg->ei);CHKERRQ(ierr);
+  ierr = PetscFree(cacg->pc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_CACG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_CACG(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_CACG(KSP ksp,PetscViewer viewer)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per reduction %D, %s basis\n",cacg->s,KSPCABasisTypes[cacg->basis]);CHKERRQ(ierr);
+    if (cacg->emax > cacg->emin) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates: min = %g, max = %g\n",(double)cacg->emin,(double)cacg->emax);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates from the first %D iterations\n",cacg->s);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_CACG(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       s,neig = 2;
+  PetscReal      eig[2];
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP CACG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_cacg_s","Number of iterations per global reduction","KSPCACGSetSteps",cacg->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCACGSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_cacg_basis","Polynomial basis of the Krylov space","KSPCACGSetBasisType",KSPCABasisTypes,(PetscEnum)cacg->basis,(PetscEnum*)&cacg->basis,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRealArray("-ksp_cacg_eigenvalues","Estimates of the smallest and largest eigenvalues of the preconditioned operator","",eig,&neig,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (neig != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_cacg_eigenvalues: must specify emin,emax");
+    cacg->emin = eig[0];
+    cacg->emax = eig[1];
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGSetSteps_CACG(KSP ksp,PetscInt s)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D must be positive",s);
+  if (s != cacg->s && ksp->setupstage) {
+    ierr = KSPReset_CACG(ksp);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(ksp->nwork,&ksp->work);CHKERRQ(ierr);
+    ksp->nwork      = 0;
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  cacg->s = s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGGetSteps_CACG(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_CACG*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGSetBasisType_CACG(KSP ksp,KSPCABasisType basis)
+{
+  PetscFunctionBegin;
+  ((KSP_CACG*)ksp->data)->basis = basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGGetBasisType_CACG(KSP ksp,KSPCABasisType *basis)
+{
+  PetscFunctionBegin;
+  *basis = ((KSP_CACG*)ksp->data)->basis;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGSetSteps - Sets the number of iterations KSPCACG performs per global reduction
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the iterative context
+-  s - the number of steps
+
+   Options Database Key:
+.  -ksp_cacg_s <s> - number of steps
+
+   Level: intermediate
+
+   Notes:
+   Each group of s iterations costs 2s-1 applications of the matrix and preconditioner, one more than s CG iterations
+   on average, and a single global reduction. Values much larger than 10 lead to an ill-conditioned basis and loss of convergence.
+
+.seealso: KSPCACG, KSPCACGGetSteps(), KSPCACGSetBasisType()
+@*/
+PetscErrorCode KSPCACGSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPCACGSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGGetSteps - Gets the number of iterations KSPCACG performs per global reduction
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the iterative context
+
+   Output Parameter:
+.  s - the number of steps
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCACGSetSteps()
+@*/
+PetscErrorCode KSPCACGGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPCACGGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGSetBasisType - Sets the polynomial basis KSPCACG uses to generate its Krylov vectors
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the iterative context
+-  basis - the basis, one of KSP_CA_BASIS_MONOMIAL, KSP_CA_BASIS_NEWTON (default) or KSP_CA_BASIS_CHEBYSHEV
+
+   Options Database Key:
+.  -ksp_cacg_basis <monomial,newton,chebyshev> - the basis
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCACGGetBasisType(), KSPCABasisType, KSPCACGSetSteps()
+@*/
+PetscErrorCode KSPCACGSetBasisType(KSP ksp,KSPCABasisType basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,basis,2);
+  ierr = PetscTryMethod(ksp,"KSPCACGSetBasisType_C",(KSP,KSPCABasisType),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGGetBasisType - Gets the polynomial basis KSPCACG uses to generate its Krylov vectors
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the iterative context
+
+   Output Parameter:
+.  basis - the basis
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCACGSetBasisType(), KSPCABasisType
+@*/
+PetscErrorCode KSPCACGGetBasisType(KSP ksp,KSPCABasisType *basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(basis,2);
+  ierr = PetscUseMethod(ksp,"KSPCACGGetBasisType_C",(KSP,KSPCABasisType*),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPCACG - s-step (communication-avoiding) preconditioned conjugate gradient method
+
+   Options Database Keys:
++  -ksp_cacg_s <s> - number of iterations per global reduction (default 4), see KSPCACGSetSteps()
+.  -ksp_cacg_basis <monomial,newton,chebyshev> - polynomial basis used to generate the Krylov vectors (default newton), see KSPCACGSetBasisType()
+-  -ksp_cacg_eigenvalues <emin,emax> - estimates of the extreme eigenvalues of the preconditioned operator used to set up the basis
+
+   Level: intermediate
+
+   Notes:
+   The method is mathematically equivalent to KSPCG. Every s iterations it applies the matrix and preconditioner 2s-1 times
+   to build a basis of the next Krylov vectors and computes all the inner products of the s iterations with a single MPI_Allreduce(),
+   instead of the 2s reductions of KSPCG. Like KSPCG it requires a symmetric positive definite matrix and preconditioner and
+   supports only left preconditioning.
+
+   The Newton and Chebyshev bases need estimates of the spectrum of the preconditioned operator. Unless they are given with
+   -ksp_cacg_eigenvalues, the first s iterations are performed one at a time (still with a single reduction each) and the eigenvalues of
+   the Lanczos matrix they produce are used: as Leja ordered shifts for the Newton basis, or to define the interval of the Chebyshev basis.
+
+   In finite precision the convergence may be slower than KSPCG, especially for large s and the monomial basis.
+
+   References:
+.  1. - Erin Carson, Communication-avoiding Krylov subspace methods in theory and practice, PhD thesis, UC Berkeley, 2015.
+
+.seealso: KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPCG, KSPPIPECG, KSPPIPELCG, KSPCAGMRES,
+          KSPCACGSetSteps(), KSPCACGSetBasisType(), KSPCABasisType
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cacg);CHKERRQ(ierr);
+  cacg->s     = 4;
+  cacg->basis = KSP_CA_BASIS_NEWTON;
+  ksp->data   = (void*)cacg;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_CACG;
+  ksp->ops->solve          = KSPSolve_CACG;
+  ksp->ops->reset          = KSPReset_CACG;
+  ksp->ops->destroy        = KSPDestroy_CACG;
+  ksp->ops->view           = KSPView_CACG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CACG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetSteps_C",KSPCACGSetSteps_CACG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetSteps_C",KSPCACGGetSteps_CACG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetBasisType_C",KSPCACGSetBasisType_CACG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetBasisType_C",KSPCACGGetBasisType_CACG);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -26,10 +26,13 @@
     Notes:
     Use KSPGMRESSetCGSRefinementType() to determine if iterative refinement is to be used
 
+    With iterative refinement the projection, the inner products of the refinement and the norm used to decide on it are
+    computed with VecMAXPYMDot(), in one pass over the Krylov vectors and with a single reduction
+
    Level: intermediate
 
 .seelaso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESSetCGSRefinementType(),
-           KSPGMRESGetCGSRefinementType(), KSPGMRESGetOrthogonalization()
+           KSPGMRESGetCGSRefinementType(), KSPGMRESGetOrthogonalization(), VecMAXPYMDot()
 
 @*/
 PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt it)
@@ -52,11 +55,8 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   hh  = HH(0,it);
   hes = HES(0,it);
 
-  /* Clear hh and hes since we will accumulate values into them */
-  for (j=0; j<=it; j++) {
-    hh[j]  = 0.0;
-    hes[j] = 0.0;
-  }
+  /* Clear hh since we will accumulate values into it */
+  for (j=0; j<=it; j++) hh[j] = 0.0;
 
   /*
      This is really a matrix-vector product, with the matrix stored
@@ -72,39 +72,39 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
          This is really a matrix vector product:
          [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
   */
-  ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
   /* note lhh[j] is -<v,vnew> , hence the subtraction */
-  for (j=0; j<=it; j++) {
-    hh[j]  -= lhh[j];     /* hh += <v,vnew> */
-    hes[j] -= lhh[j];     /* hes += <v,vnew> */
-  }
+  for (j=0; j<=it; j++) hh[j] -= lhh[j];     /* hh += <v,vnew> */
 
   /*
    *  the second step classical Gram-Schmidt is only necessary
    *  when a simple test criteria is not passed
    */
-  if (gmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED) {
-    hnrm = 0.0;
-    for (j=0; j<=it; j++) hnrm +=  PetscRealPart(lhh[j] * PetscConj(lhh[j]));
-
-    hnrm = PetscSqrtReal(hnrm);
-    ierr = VecNorm(VEC_VV(it+1),NORM_2, &wnrm);CHKERRQ(ierr);
-    if (wnrm < hnrm) {
-      refine = PETSC_TRUE;
-      ierr   = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)wnrm,(double)hnrm);CHKERRQ(ierr);
-    }
-  }
-
-  if (refine) {
-    ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
-    for (j=0; j<=it; j++) lhh[j] = -lhh[j];
+  if (gmres->cgstype == KSP_GMRES_CGS_REFINE_NEVER) {
     ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
-    /* note lhh[j] is -<v,vnew> , hence the subtraction */
-    for (j=0; j<=it; j++) {
-      hh[j]  -= lhh[j];     /* hh += <v,vnew> */
-      hes[j] -= lhh[j];     /* hes += <v,vnew> */
+  } else {
+    /*
+       The update, the inner products <v,vnew> of the refinement and the norm used by the test are computed in one pass over
+       the Krylov vectors with a single reduction; hes holds the new inner products until the end
+    */
+    ierr = VecMAXPYMDot(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),hes,refine ? NULL : &wnrm);CHKERRQ(ierr);
+    if (!refine) {
+      hnrm = 0.0;
+      for (j=0; j<=it; j++) hnrm +=  PetscRealPart(lhh[j] * PetscConj(lhh[j]));
+
+      hnrm = PetscSqrtReal(hnrm);
+      if (wnrm < hnrm) {
+        refine = PETSC_TRUE;
+        ierr   = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)wnrm,(double)hnrm);CHKERRQ(ierr);
+      }
+    }
+    if (refine) {
+      for (j=0; j<=it; j++) lhh[j] = -hes[j];
+      ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+      /* note lhh[j] is -<v,vnew> , hence the subtraction */
+      for (j=0; j<=it; j++) hh[j] -= lhh[j];     /* hh += <v,vnew> */
     }
   }
+  for (j=0; j<=it; j++) hes[j] = hh[j];
   ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,774 @@
+
+/*
+    This file implements CAGMRES, an s-step (communication-avoiding) GMRES.
+
+    Each block of s iterations generates s new Krylov vectors from the last basis vector with a Newton, Chebyshev or
+    monomial recurrence, orthogonalizes them against the previous basis with block classical Gram-Schmidt and among
+    themselves with a Cholesky QR factorization, using a single global reduction for both, and recovers the s new
+    columns of the Hessenberg matrix from the change of basis.
+
+    Reference: Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, 2010.
+*/
+
+#include <../src/ksp/ksp/impls/gmres/cagmres/cagmresimpl.h>       /*I  "petscksp.h"  I*/
+#define CAGMRES_DELTA_DIRECTIONS 10
+#define CAGMRES_DEFAULT_MAXK     30
+
+static PetscErrorCode KSPCAGMRESUpdateHessenberg(KSP,PetscInt,PetscBool*,PetscReal*);
+static PetscErrorCode KSPCAGMRESBuildSoln(PetscScalar*,Vec,Vec,KSP,PetscInt);
+
+static PetscErrorCode KSPSetUp_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s,max_k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr  = KSPSetUp_GMRES(ksp);CHKERRQ(ierr);
+  /* the restart may have changed since the last set up */
+  ierr  = PetscFree6(cagmres->Bs,cagmres->C,cagmres->R,cagmres->Hb,cagmres->er,cagmres->ei);CHKERRQ(ierr);
+  max_k = cagmres->max_k;
+  if (cagmres->s > max_k) {
+    ierr       = PetscInfo2(ksp,"Reducing the number of steps %D to the restart %D\n",cagmres->s,max_k);CHKERRQ(ierr);
+    cagmres->s = max_k;
+  }
+  s     = cagmres->s;
+  ierr  = PetscMalloc6((s+1)*s,&cagmres->Bs,(max_k+1)*s,&cagmres->C,s*s,&cagmres->R,(max_k+2)*s,&cagmres->Hb,s,&cagmres->er,s,&cagmres->ei);CHKERRQ(ierr);
+  ierr  = PetscLogObjectMemory((PetscObject)ksp,((s+1)*s + (2*max_k+3)*s + s*s)*sizeof(PetscScalar) + 2*s*sizeof(PetscReal));CHKERRQ(ierr);
+  if (!cagmres->orthogwork) {ierr = PetscMalloc1(max_k + 2,&cagmres->orthogwork);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   Completes column it of the Hessenberg matrix, which has been stored in HH(:,it): applies the rotations,
+   monitors and tests for convergence.
+*/
+static PetscErrorCode KSPCAGMRESColumnEnd_Private(KSP ksp,PetscInt it,PetscReal *res)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscBool      hapend   = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr        = KSPCAGMRESUpdateHessenberg(ksp,it,&hapend,res);CHKERRQ(ierr);
+  cagmres->it = it;
+  ksp->its++;
+  ksp->rnorm  = *res;
+  if (ksp->reason) PetscFunctionReturn(0);
+  ierr = (*ksp->converged)(ksp,ksp->its,*res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  if (it+1 < cagmres->max_k || ksp->reason || ksp->its >= ksp->max_it) {  /* Monitor if we are done or still iterating, but not before a restart. */
+    ierr = KSPLogResidualHistory(ksp,*res);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,ksp->its,*res);CHKERRQ(ierr);
+  }
+  /* Catch error in happy breakdown and signal convergence and break from loop */
+  if (hapend) {
+    if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+      ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+    } else if (!ksp->reason) {
+      if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)*res);
+      else ksp->reason = KSP_DIVERGED_BREAKDOWN;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   One standard GMRES iteration using the orthogonalization routine of KSPGMRES, used until the basis is set up
+   and when the s-step basis cannot provide a single new vector
+*/
+static PetscErrorCode KSPCAGMRESArnoldiStep_Private(KSP ksp,PetscInt it,PetscReal *res)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscReal      tt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(it),VEC_VV(1+it),VEC_TEMP_MATOP);CHKERRQ(ierr);
+  ierr = (*cagmres->orthog)(ksp,it);CHKERRQ(ierr);
+  if (ksp->reason) PetscFunctionReturn(0);
+  ierr = VecNormalize(VEC_VV(it+1),&tt);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,tt);
+  *HH(it+1,it) = tt;
+  ierr = KSPCAGMRESColumnEnd_Private(ksp,it,res);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Generates the vectors VEC_VV(it+1),...,VEC_VV(it+sb) from VEC_VV(it), orthonormalizes them with a single reduction
+   and computes the corresponding columns of the Hessenberg matrix. Returns the number of columns computed, 0 if
+   the first new vector is numerically in the span of the previous ones.
+*/
+static PetscErrorCode KSPCAGMRESBlock_Private(KSP ksp,PetscInt it,PetscInt sb,PetscInt *ncols)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s = cagmres->s,ldc = cagmres->max_k+1,ldh = cagmres->max_k+2,i,j,k,l,q,nc;
+  PetscScalar    *Bs = cagmres->Bs,*C = cagmres->C,*R = cagmres->R,*Hb = cagmres->Hb,*work = cagmres->orthogwork,alpha[2],sum,rf,rt;
+  PetscReal      d,*g0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* matrix powers kernel: v_{i+1} = (A v_i - sum_k B(k,i) v_k)/B(i+1,i) */
+  for (i=0; i<sb; i++) {
+    PetscInt k0 = PetscMax(0,i-1);
+    ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(it+i),VEC_VV(it+i+1),VEC_TEMP_MATOP);CHKERRQ(ierr);
+    for (k=k0; k<=i; k++) alpha[k-k0] = -Bs[k+i*(s+1)];
+    ierr = VecMAXPY(VEC_VV(it+i+1),i-k0+1,alpha,&VEC_VV(it+k0));CHKERRQ(ierr);
+    ierr = VecScale(VEC_VV(it+i+1),1.0/Bs[i+1+i*(s+1)]);CHKERRQ(ierr);
+  }
+
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  /* C = Q^H W and the upper triangle of W^H W with a single reduction */
+  for (j=0; j<sb; j++) {
+    ierr = VecMDotBegin(VEC_VV(it+1+j),it+1,&VEC_VV(0),C+j*ldc);CHKERRQ(ierr);
+    ierr = VecMDotBegin(VEC_VV(it+1+j),j+1,&VEC_VV(it+1),R+j*s);CHKERRQ(ierr);
+  }
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(0)));CHKERRQ(ierr);
+  for (j=0; j<sb; j++) {
+    ierr = VecMDotEnd(VEC_VV(it+1+j),it+1,&VEC_VV(0),C+j*ldc);CHKERRQ(ierr);
+    ierr = VecMDotEnd(VEC_VV(it+1+j),j+1,&VEC_VV(it+1),R+j*s);CHKERRQ(ierr);
+  }
+
+  /* W <- W - Q C and its Gram matrix W^H W - C^H C */
+  g0 = (PetscReal*)work;
+  for (j=0; j<sb; j++) {
+    for (i=0; i<=it; i++) work[i] = -C[i+j*ldc];
+    ierr = VecMAXPY(VEC_VV(it+1+j),it+1,work,&VEC_VV(0));CHKERRQ(ierr);
+  }
+  for (j=0; j<sb; j++) {
+    g0[j] = PetscRealPart(R[j+j*s]);
+    for (k=0; k<=j; k++) {
+      for (sum=0.0,i=0; i<=it; i++) sum += PetscConj(C[i+k*ldc])*C[i+j*ldc];
+      R[k+j*s] -= sum;
+    }
+  }
+
+  /* Cholesky factorization R^H R of the Gram matrix, stopping at the first numerically dependent vector */
+  for (nc=0; nc<sb; nc++) {
+    j = nc;
+    for (k=0; k<j; k++) {
+      for (sum=R[k+j*s],l=0; l<k; l++) sum -= PetscConj(R[l+k*s])*R[l+j*s];
+      R[k+j*s] = sum/R[k+k*s];
+    }
+    for (d=PetscRealPart(R[j+j*s]),l=0; l<j; l++) d -= PetscRealPart(PetscConj(R[l+j*s])*R[l+j*s]);
+    if (d <= PETSC_SQRT_MACHINE_EPSILON*g0[j]) break;
+    R[j+j*s] = PetscSqrtReal(d);
+  }
+  *ncols = nc;
+  if (nc < sb) {ierr = PetscInfo3(ksp,"New vector %D of %D is numerically dependent, using %D columns\n",nc,sb,nc);CHKERRQ(ierr);}
+
+  /* Q_new = W R^{-1} */
+  for (j=0; j<nc; j++) {
+    for (l=0; l<j; l++) work[l] = -R[l+j*s];
+    ierr = VecMAXPY(VEC_VV(it+1+j),j,work,&VEC_VV(it+1));CHKERRQ(ierr);
+    ierr = VecScale(VEC_VV(it+1+j),1.0/R[j+j*s]);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  if (!nc) PetscFunctionReturn(0);
+
+  /*
+     With V = [v_0 ... v_nc] = Q Rf, where Rf(:,0) = e_it and Rf(:,c) = [C(:,c-1); R(:,c-1)], and A V(:,0:nc-1) = V B,
+     the new columns of the Hessenberg matrix are H(:,it:it+nc-1) = (Rf B - [H_prev X; 0]) Rt^{-1} where X are the
+     first it rows and Rt the next nc rows of Rf(:,0:nc-1).
+  */
+#define RF(r,c) ((c) == 0 ? (PetscScalar)((r) == it ? 1.0 : 0.0) : ((r) <= it ? C[(r)+((c)-1)*ldc] : ((r)-it-1 <= (c)-1 ? R[(r)-it-1+((c)-1)*s] : 0.0)))
+  for (j=0; j<nc; j++) {
+    for (i=0; i<=it+nc; i++) {
+      for (sum=0.0,k=PetscMax(0,j-1); k<=j+1; k++) sum += RF(i,k)*Bs[k+j*(s+1)];
+      if (j && i <= it) {
+        for (q=PetscMax(0,i-1); q<it; q++) sum -= *HES(i,q)*C[q+(j-1)*ldc];
+      }
+      Hb[i+j*ldh] = sum;
+    }
+    for (l=0; l<j; l++) {
+      rf = RF(it+l,j);
+      for (i=0; i<=it+nc; i++) Hb[i+j*ldh] -= Hb[i+l*ldh]*rf;
+    }
+    rt = RF(it+j,j);
+    for (i=0; i<=it+nc; i++) Hb[i+j*ldh] /= rt;
+  }
+#undef RF
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPCAGMRESCycle - Run cagmres, possibly with restart.
+
+    Notes:
+    On entry, the value in vector VEC_VV(0) should be the initial residual.
+ */
+static PetscErrorCode KSPCAGMRESCycle(PetscInt *itcount,KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)(ksp->data);
+  PetscReal      res_norm,res;
+  PetscErrorCode ierr;
+  PetscInt       it = 0,max_k = cagmres->max_k,s = cagmres->s,sb,nc,i,j;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  ierr   = VecNormalize(VEC_VV(0),&res_norm);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,res_norm);
+  res    = res_norm;
+  *RS(0) = res_norm;
+
+  /* check for the convergence */
+  ierr        = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm  = res;
+  ierr        = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  cagmres->it = it-1;
+  ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    sb = cagmres->basisready ? PetscMin(s,max_k-it) : 1;
+    while (cagmres->vv_allocated <= it + sb + VEC_OFFSET) {
+      PetscInt nalloc = cagmres->vv_allocated;
+      ierr = KSPGMRESGetNewVectors(ksp,cagmres->vv_allocated-VEC_OFFSET);CHKERRQ(ierr);
+      if (cagmres->vv_allocated == nalloc) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Could not allocate the Krylov vectors");
+    }
+    if (!cagmres->basisready) {
+      ierr = KSPCAGMRESArnoldiStep_Private(ksp,it,&res);CHKERRQ(ierr);
+      it++;
+      if (it == s) {
+        /* the Ritz values of the first s iterations define the basis */
+        ierr = KSPCABasisComputeRitz_Private(s,HES(0,0),max_k+1,cagmres->er,cagmres->ei);CHKERRQ(ierr);
+        ierr = KSPCABasisSetUp_Private(cagmres->basis,s,s,cagmres->er,cagmres->ei,0.0,0.0,cagmres->Bs);CHKERRQ(ierr);
+        ierr = PetscInfo3(ksp,"Set up the %s basis from %D Ritz values with leading shift %g\n",KSPCABasisTypes[cagmres->basis],s,(double)cagmres->er[0]);CHKERRQ(ierr);
+        cagmres->basisready = PETSC_TRUE;
+      }
+      continue;
+    }
+    ierr = KSPCAGMRESBlock_Private(ksp,it,sb,&nc);CHKERRQ(ierr);
+    if (!nc) {
+      ierr = KSPCAGMRESArnoldiStep_Private(ksp,it,&res);CHKERRQ(ierr);
+      it++;
+      continue;
+    }
+    for (j=0; j<nc && !ksp->reason && ksp->its < ksp->max_it; j++) {
+      for (i=0; i<=it+1; i++) *HH(i,it) = cagmres->Hb[i+j*(max_k+2)];
+      ierr = KSPCAGMRESColumnEnd_Private(ksp,it,&res);CHKERRQ(ierr);
+      it++;
+    }
+  }
+
+  if (itcount) *itcount = it;
+
+  /*
+    Down here we have to solve for the "best" coefficients of the Krylov
+    columns, add the solution values together, and possibly unwind the
+    preconditioning from the solution
+   */
+  /* Form the solution (or the solution so far) */
+  ierr = KSPCAGMRESBuildSoln(RS(0),ksp->vec_sol,ksp->vec_sol,ksp,it-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_CAGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+  PetscInt       its,itcount;
+  KSP_CAGMRES    *cagmres   = (KSP_CAGMRES*)ksp->data;
+  PetscBool      guess_zero = ksp->guess_zero;
+
+  PetscFunctionBegin;
+  if (ksp->calc_sings && !cagmres->Rsvd) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ORDER,"Must call KSPSetComputeSingularValues() before KSPSetUp() is called");
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  /* without user provided eigenvalue estimates the basis is set up from the first iterations of each solve */
+  cagmres->basisready = PETSC_FALSE;
+  if (cagmres->emax > cagmres->emin) {
+    ierr = KSPCABasisSetUp_Private(cagmres->basis,cagmres->s,0,NULL,NULL,cagmres->emin,cagmres->emax,cagmres->Bs);CHKERRQ(ierr);
+    cagmres->basisready = PETSC_TRUE;
+  }
+
+  itcount     = 0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  while (!ksp->reason) {
+    ierr     = KSPInitialResidual(ksp,ksp->vec_sol,VEC_TEMP,VEC_TEMP_MATOP,VEC_VV(0),ksp->vec_rhs);CHKERRQ(ierr);
+    ierr     = KSPCAGMRESCycle(&its,ksp);CHKERRQ(ierr);
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree6(cagmres->Bs,cagmres->C,cagmres->R,cagmres->Hb,cagmres->er,cagmres->ei);CHKERRQ(ierr);
+  ierr = KSPReset_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree6(cagmres->Bs,cagmres->C,cagmres->R,cagmres->Hb,cagmres->er,cagmres->ei);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroy_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPCAGMRESBuildSoln - create the solution from the starting vector and the
+                      current iterates.
+
+    Input parameters:
+        nrs - work area of size it + 1.
+        vguess  - index of initial guess
+        vdest - index of result.  Note that vguess may == vdest (replace
+                guess with the solution).
+        it - HH upper triangular part is a block of size (it+1) x (it+1)
+
+     This is an internal routine that knows about the CAGMRES internals.
+ */
+static PetscErrorCode KSPCAGMRESBuildSoln(PetscScalar *nrs,Vec vguess,Vec vdest,KSP ksp,PetscInt it)
+{
+  PetscScalar    tt;
+  PetscErrorCode ierr;
+  PetscInt       k,j;
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)(ksp->data);
+
+  PetscFunctionBegin;
+  /* Solve for solution vector that minimizes the residual */
+
+  if (it < 0) {                                 /* no cagmres steps have been performed */
+    ierr = VecCopy(vguess,vdest);CHKERRQ(ierr); /* VecCopy() is smart, exits immediately if vguess == vdest */
+    PetscFunctionReturn(0);
+  }
+
+  /* solve the upper triangular system - RS is the right side and HH is
+     the upper triangular matrix  - put soln in nrs */
+  if (*HH(it,it) != 0.0) nrs[it] = *RS(it) / *HH(it,it);
+  else nrs[it] = 0.0;
+
+  for (k=it-1; k>=0; k--) {
+    tt = *RS(k);
+    for (j=k+1; j<=it; j++) tt -= *HH(k,j) * nrs[j];
+    nrs[k] = tt / *HH(k,k);
+  }
+
+  /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
+  ierr = VecZeroEntries(VEC_TEMP);CHKERRQ(ierr);
+  ierr = VecMAXPY(VEC_TEMP,it+1,nrs,&VEC_VV(0));CHKERRQ(ierr);
+  ierr = KSPUnwindPreconditioner(ksp,VEC_TEMP,VEC_TEMP_MATOP);CHKERRQ(ierr);
+  /* add solution to previous solution */
+  if (vdest == vguess) {
+    ierr = VecAXPY(vdest,1.0,VEC_TEMP);CHKERRQ(ierr);
+  } else {
+    ierr = VecWAXPY(vdest,1.0,VEC_TEMP,vguess);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+
+    KSPCAGMRESUpdateHessenberg - Do the scalar work for the orthogonalization.
+                            Return new residual.
+
+    input parameters:
+
+.        ksp -    Krylov space object
+.        it  -    plane rotations are applied to the (it+1)th column of the
+                  modified hessenberg (i.e. HH(:,it))
+.        hapend - PETSC_FALSE not happy breakdown ending.
+
+    output parameters:
+.        res - the new residual
+
+ */
+static PetscErrorCode KSPCAGMRESUpdateHessenberg(KSP ksp,PetscInt it,PetscBool *hapend,PetscReal *res)
+{
+  PetscScalar    *hh,*cc,*ss,*rs;
+  PetscInt       j;
+  PetscReal      hapbnd;
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)(ksp->data);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  hh = HH(0,it);   /* pointer to beginning of column to update */
+  cc = CC(0);      /* beginning of cosine rotations */
+  ss = SS(0);      /* beginning of sine rotations */
+  rs = RS(0);      /* right hand side of least squares system */
+
+  /* The Hessenberg matrix is now correct through column it, save that form for the next blocks and for spectral analysis */
+  for (j=0; j<=it+1; j++) *HES(j,it) = hh[j];
+
+  /* check for the happy breakdown */
+  hapbnd = PetscMin(PetscAbsScalar(hh[it+1] / rs[it]),cagmres->haptol);
+  if (PetscAbsScalar(hh[it+1]) < hapbnd) {
+    ierr    = PetscInfo4(ksp,"Detected happy breakdown, current hapbnd = %14.12e H(%D,%D) = %14.12e\n",(double)hapbnd,it+1,it,(double)PetscAbsScalar(*HH(it+1,it)));CHKERRQ(ierr);
+    *hapend = PETSC_TRUE;
+  }
+
+  /* Apply all the previously computed plane rotations to the new column
+     of the Hessenberg matrix */
+  /* Note: this uses the rotation [conj(c)  s ; -s   c], c= cos(theta), s= sin(theta),
+     and some refs have [c   s ; -conj(s)  c] (don't be confused!) */
+
+  for (j=0; j<it; j++) {
+    PetscScalar hhj = hh[j];
+    hh[j]   = PetscConj(cc[j])*hhj + ss[j]*hh[j+1];
+    hh[j+1] =          -ss[j] *hhj + cc[j]*hh[j+1];
+  }
+
+  /*
+    compute the new plane rotation, and apply it to:
+     1) the right-hand-side of the Hessenberg system (RS)
+        note: it affects RS(it) and RS(it+1)
+     2) the new column of the Hessenberg matrix
+        note: it affects HH(it,it) which is currently pointed to
+        by hh and HH(it+1, it) (*(hh+1))
+    thus obtaining the updated value of the residual...
+  */
+
+  /* compute new plane rotation */
+
+  if (!*hapend) {
+    PetscReal delta = PetscSqrtReal(PetscSqr(PetscAbsScalar(hh[it])) + PetscSqr(PetscAbsScalar(hh[it+1])));
+    if (delta == 0.0) {
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(0);
+    }
+
+    cc[it] = hh[it] / delta;    /* new cosine value */
+    ss[it] = hh[it+1] / delta;  /* new sine value */
+
+    hh[it]   = PetscConj(cc[it])*hh[it] + ss[it]*hh[it+1];
+    rs[it+1] = -ss[it]*rs[it];
+    rs[it]   = PetscConj(cc[it])*rs[it];
+    *res     = PetscAbsScalar(rs[it+1]);
+  } else { /* happy breakdown: HH(it+1, it) = 0, therefore we don't need to apply
+            another rotation matrix (so RH doesn't change).  The new residual is
+            always the new sine term times the residual from last time (RS(it)),
+            but now the new sine rotation would be zero...so the residual should
+            be zero...so we will multiply "zero" by the last residual.  This might
+            not be exactly what we want to do here -could just return "zero". */
+
+    *res = 0.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPBuildSolution_CAGMRES(KSP ksp,Vec ptr,Vec *result)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!cagmres->sol_temp) {
+      ierr = VecDuplicate(ksp->vec_sol,&cagmres->sol_temp);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cagmres->sol_temp);CHKERRQ(ierr);
+    }
+    ptr = cagmres->sol_temp;
+  }
+  if (!cagmres->nrs) {
+    /* allocate the work area */
+    ierr = PetscMalloc1(cagmres->max_k,&cagmres->nrs);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)ksp,cagmres->max_k*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+
+  ierr = KSPCAGMRESBuildSoln(cagmres->nrs,ksp->vec_sol,ptr,ksp,cagmres->it);CHKERRQ(ierr);
+  if (result) *result = ptr;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_CAGMRES(KSP ksp,PetscViewer viewer)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = KSPView_GMRES(ksp,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per reduction %D, %s basis\n",cagmres->s,KSPCABasisTypes[cagmres->basis]);CHKERRQ(ierr);
+    if (cagmres->emax > cagmres->emin) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates: min = %g, max = %g\n",(double)cagmres->emin,(double)cagmres->emax);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates from the first %D iterations\n",cagmres->s);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_CAGMRES(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       s,neig = 2;
+  PetscReal      eig[2];
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  ierr = KSPSetFromOptions_GMRES(PetscOptionsObject,ksp);CHKERRQ(ierr);
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step GMRES Options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_cagmres_s","Number of Krylov vectors per global reduction","KSPCAGMRESSetSteps",cagmres->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCAGMRESSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_cagmres_basis","Polynomial basis of the Krylov space","KSPCAGMRESSetBasisType",KSPCABasisTypes,(PetscEnum)cagmres->basis,(PetscEnum*)&cagmres->basis,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRealArray("-ksp_cagmres_eigenvalues","Estimates of the smallest and largest real parts of the eigenvalues of the preconditioned operator","",eig,&neig,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (neig != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_cagmres_eigenvalues: must specify emin,emax");
+    cagmres->emin = eig[0];
+    cagmres->emax = eig[1];
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESSetSteps_CAGMRES(KSP ksp,PetscInt s)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D must be positive",s);
+  if (s != cagmres->s && ksp->setupstage) {
+    ksp->setupstage = KSP_SETUP_NEW;
+    /* free the data structures, then create them again */
+    ierr = KSPReset_CAGMRES(ksp);CHKERRQ(ierr);
+  }
+  cagmres->s = s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESGetSteps_CAGMRES(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_CAGMRES*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESSetBasisType_CAGMRES(KSP ksp,KSPCABasisType basis)
+{
+  PetscFunctionBegin;
+  ((KSP_CAGMRES*)ksp->data)->basis = basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESGetBasisType_CAGMRES(KSP ksp,KSPCABasisType *basis)
+{
+  PetscFunctionBegin;
+  *basis = ((KSP_CAGMRES*)ksp->data)->basis;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESSetSteps - Sets the number of Krylov vectors KSPCAGMRES generates and orthogonalizes per global reduction
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the iterative context
+-  s - the number of steps, values larger than the restart are reduced to the restart
+
+   Options Database Key:
+.  -ksp_cagmres_s <s> - number of steps
+
+   Level: intermediate
+
+   Notes:
+   The restart is best chosen as a multiple of s. Values much larger than 10 lead to an ill-conditioned basis, in which case
+   fewer vectors are accepted per block.
+
+.seealso: KSPCAGMRES, KSPCAGMRESGetSteps(), KSPCAGMRESSetBasisType(), KSPGMRESSetRestart()
+@*/
+PetscErrorCode KSPCAGMRESSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPCAGMRESSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESGetSteps - Gets the number of Krylov vectors KSPCAGMRES generates per global reduction
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the iterative context
+
+   Output Parameter:
+.  s - the number of steps
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCAGMRESSetSteps()
+@*/
+PetscErrorCode KSPCAGMRESGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPCAGMRESGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESSetBasisType - Sets the polynomial basis KSPCAGMRES uses to generate its Krylov vectors
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the iterative context
+-  basis - the basis, one of KSP_CA_BASIS_MONOMIAL, KSP_CA_BASIS_NEWTON (default) or KSP_CA_BASIS_CHEBYSHEV
+
+   Options Database Key:
+.  -ksp_cagmres_basis <monomial,newton,chebyshev> - the basis
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCAGMRESGetBasisType(), KSPCABasisType, KSPCAGMRESSetSteps()
+@*/
+PetscErrorCode KSPCAGMRESSetBasisType(KSP ksp,KSPCABasisType basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,basis,2);
+  ierr = PetscTryMethod(ksp,"KSPCAGMRESSetBasisType_C",(KSP,KSPCABasisType),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESGetBasisType - Gets the polynomial basis KSPCAGMRES uses to generate its Krylov vectors
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the iterative context
+
+   Output Parameter:
+.  basis - the basis
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCAGMRESSetBasisType(), KSPCABasisType
+@*/
+PetscErrorCode KSPCAGMRESGetBasisType(KSP ksp,KSPCABasisType *basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(basis,2);
+  ierr = PetscUseMethod(ksp,"KSPCAGMRESGetBasisType_C",(KSP,KSPCABasisType*),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+     KSPCAGMRES - Implements an s-step (communication-avoiding) Generalized Minimal Residual method.
+
+   Options Database Keys:
++   -ksp_cagmres_s <s> - number of Krylov vectors generated and orthogonalized per global reduction (default 5), see KSPCAGMRESSetSteps()
+.   -ksp_cagmres_basis <monomial,newton,chebyshev> - polynomial basis used to generate the Krylov vectors (default newton), see KSPCAGMRESSetBasisType()
+.   -ksp_cagmres_eigenvalues <emin,emax> - estimates of the extreme real parts of the eigenvalues of the preconditioned operator used to set up the basis
+.   -ksp_gmres_restart <restart> - the number of Krylov directions to orthogonalize against
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_gmres_preallocate - preallocate all the Krylov search directions initially (otherwise groups of
+                             vectors are allocated as needed)
+-   -ksp_gmres_classicalgramschmidt, -ksp_gmres_modifiedgramschmidt - orthogonalization used in the iterations that set up the basis
+
+   Level: intermediate
+
+   Notes:
+   Every block of s iterations applies the operator s times to generate s new Krylov vectors and then orthogonalizes them against
+   the previous basis (block classical Gram-Schmidt) and against each other (Cholesky QR) with a single MPI_Allreduce(), instead of
+   the s or more reductions of KSPGMRES. The Hessenberg matrix, and hence the residual norms and the solution, are recovered from the
+   change of basis so monitoring and convergence testing happen at every iteration as in KSPGMRES.
+
+   Unless -ksp_cagmres_eigenvalues is given, the first s iterations of each solve are standard GMRES iterations and the Ritz values
+   they produce are used: as Leja ordered shifts for the Newton basis (complex conjugate pairs are handled in real arithmetic), or to
+   define the interval of the Chebyshev basis. A block whose new vectors become numerically dependent is shortened.
+
+   Developer Notes:
+    This object is subclassed off of KSPGMRES
+
+   References:
+.  1. - Mark Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, UC Berkeley, 2010.
+
+.seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPGMRES, KSPPGMRES, KSPCACG,
+           KSPCAGMRESSetSteps(), KSPCAGMRESSetBasisType(), KSPCABasisType, KSPGMRESSetRestart(), KSPGMRESSetHapTol()
+M*/
+
+PETSC_EXTERN PetscErrorCode KSPCreate_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cagmres);CHKERRQ(ierr);
+
+  ksp->data                              = (void*)cagmres;
+  ksp->ops->buildsolution                = KSPBuildSolution_CAGMRES;
+  ksp->ops->setup                        = KSPSetUp_CAGMRES;
+  ksp->ops->solve                        = KSPSolve_CAGMRES;
+  ksp->ops->reset                        = KSPReset_CAGMRES;
+  ksp->ops->destroy                      = KSPDestroy_CAGMRES;
+  ksp->ops->view                         = KSPView_CAGMRES;
+  ksp->ops->setfromoptions               = KSPSetFromOptions_CAGMRES;
+  ksp->ops->computeextremesingularvalues = KSPComputeExtremeSingularValues_GMRES;
+  ksp->ops->computeeigenvalues           = KSPComputeEigenvalues_GMRES;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_RIGHT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_RIGHT,1);CHKERRQ(ierr);
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetPreAllocateVectors_C",KSPGMRESSetPreAllocateVectors_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetOrthogonalization_C",KSPGMRESSetOrthogonalization_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetOrthogonalization_C",KSPGMRESGetOrthogonalization_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",KSPGMRESSetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetRestart_C",KSPGMRESGetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",KSPGMRESSetCGSRefinementType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",KSPGMRESGetCGSRefinementType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetSteps_C",KSPCAGMRESSetSteps_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetSteps_C",KSPCAGMRESGetSteps_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetBasisType_C",KSPCAGMRESSetBasisType_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetBasisType_C",KSPCAGMRESGetBasisType_CAGMRES);CHKERRQ(ierr);
+
+  cagmres->nextra_vecs    = 1;
+  cagmres->haptol         = 1.0e-30;
+  cagmres->q_preallocate  = 0;
+  cagmres->delta_allocate = CAGMRES_DELTA_DIRECTIONS;
+  cagmres->orthog         = KSPGMRESClassicalGramSchmidtOrthogonalization;
+  cagmres->nrs            = 0;
+  cagmres->sol_temp       = 0;
+  cagmres->max_k          = CAGMRES_DEFAULT_MAXK;
+  cagmres->Rsvd           = 0;
+  cagmres->orthogwork     = 0;
+  cagmres->cgstype        = KSP_GMRES_CGS_REFINE_NEVER;
+  cagmres->s              = 5;
+  cagmres->basis          = KSP_CA_BASIS_NEWTON;
+  PetscFunctionReturn(0);
+}
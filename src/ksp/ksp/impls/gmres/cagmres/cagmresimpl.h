@@ -0,0 +1,38 @@
+#if !defined(__CAGMRES)
+#define __CAGMRES
+
+#define KSPGMRES_NO_MACROS
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+typedef struct {
+  KSPGMRESHEADER
+
+  /* s-step data */
+  PetscInt       s;           /* number of Krylov vectors generated per global reduction */
+  KSPCABasisType basis;
+  PetscReal      emin,emax;   /* user provided eigenvalue estimates, used if emax > emin */
+  PetscBool      basisready;  /* the change of basis matrix has been set up in this solve */
+  PetscScalar    *Bs;         /* (s+1) x s change of basis matrix */
+  PetscScalar    *C;          /* (max_k+1) x s inner products of the new block with the previous basis */
+  PetscScalar    *R;          /* s x s Gram matrix of the new block, overwritten by its Cholesky factor */
+  PetscScalar    *Hb;         /* (max_k+2) x s new columns of the Hessenberg matrix */
+  PetscReal      *er,*ei;     /* Ritz values used to set up the basis */
+} KSP_CAGMRES;
+
+#define HH(a,b)  (cagmres->hh_origin + (b)*(cagmres->max_k+2)+(a))
+/* HH will be size (max_k+2)*(max_k+1)  -  think of HH as
+   being stored columnwise for access purposes. */
+#define HES(a,b) (cagmres->hes_origin + (b)*(cagmres->max_k+1)+(a))
+/* HES will be size (max_k + 1) * (max_k + 1) -
+   again, think of HES as being stored columnwise */
+#define CC(a)    (cagmres->cc_origin + (a)) /* CC will be length (max_k+1) - cosines */
+#define SS(a)    (cagmres->ss_origin + (a)) /* SS will be length (max_k+1) - sines */
+#define RS(a)    (cagmres->rs_origin + (a)) /* RS will be length (max_k+2) - rt side */
+
+/* vector names */
+#define VEC_OFFSET     2
+#define VEC_TEMP       cagmres->vecs[0]               /* work space */
+#define VEC_TEMP_MATOP cagmres->vecs[1]               /* work space */
+#define VEC_VV(i)      cagmres->vecs[VEC_OFFSET+i]    /* use to access
+                                                         othog basis vectors */
+#endif
@@ -119,6 +119,7 @@ const char *const KSPConvergedReasons_Shifted[] = {"DIVERGED_PC_FAILED","DIVERGE
                                                    "CONVERGED_HAPPY_BREAKDOWN","CONVERGED_ATOL_NORMAL","KSPConvergedReason","KSP_",0};
 const char *const*KSPConvergedReasons = KSPConvergedReasons_Shifted + 11;
 const char *const KSPFCDTruncationTypes[] = {"STANDARD","NOTAY","KSPFCDTruncationTypes","KSP_FCD_TRUNC_TYPE_",0};
+const char *const KSPCABasisTypes[] = {"MONOMIAL","NEWTON","CHEBYSHEV","KSPCABasisType","KSP_CA_BASIS_",0};
 
 static PetscBool KSPPackageInitialized = PETSC_FALSE;
 /*@C
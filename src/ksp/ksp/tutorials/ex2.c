@@ -224,6 +224,13 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: omp
+      nsize: 2
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -omp_num_threads 3 -mat_omp_threads 3 -vec_omp_threads 3
+      output_file: output/ex2_2.out
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -327,4 +334,36 @@ int main(int argc,char **args)
    test:
       suffix: pipeprcg_rcw
       args: -ksp_monitor_short -ksp_type pipeprcg -recompute_w false -m 9 -n 9
+
+   test:
+      suffix: cacg
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cacg -ksp_cacg_basis {{monomial newton chebyshev}} -m 12 -n 12
+
+   test:
+      suffix: cacg_eigenvalues
+      args: -ksp_monitor_short -ksp_type cacg -ksp_cacg_s 3 -ksp_cacg_eigenvalues 0.05,2 -pc_type jacobi -ksp_norm_type unpreconditioned -m 9 -n 9
+
+   test:
+      suffix: cagmres
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cagmres -ksp_cagmres_basis {{monomial newton chebyshev}} -ksp_gmres_restart 12 -ksp_cagmres_s 4 -m 12 -n 12
+
+   test:
+      suffix: cagmres_right
+      args: -ksp_monitor_short -ksp_type cagmres -ksp_pc_side right -ksp_cagmres_eigenvalues 0.05,2 -m 9 -n 9
+
+   test:
+      suffix: ilu_single
+      args: -ksp_monitor_short -pc_type ilu -pc_factor_levels 1 -pc_factor_mat_ordering_type rcm -pc_factor_single_precision -m 12 -n 12
+
+   test:
+      suffix: bjacobi_single
+      nsize: 2
+      args: -ksp_monitor_short -sub_pc_factor_single_precision -m 12 -n 12
+
+   test:
+      suffix: gamg_single
+      nsize: 2
+      args: -ksp_converged_reason -pc_type gamg -pc_gamg_single_precision -mg_levels_ksp_max_it 1 -m 30 -n 30
  TEST*/
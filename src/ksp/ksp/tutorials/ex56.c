@@ -974,6 +974,18 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
       nsize: 8
       args: -test_late_bs -ne 9 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -pc_gamg_reuse_interpolation true -two_solves -ksp_converged_reason -ksp_view -use_mat_nearnullspace -pc_gamg_square_graph 1 -mg_levels_ksp_max_it 1 -mg_levels_ksp_type chebyshev -mg_levels_ksp_chebyshev_esteig 0,0.2,0,1.05 -pc_gamg_esteig_ksp_type cg -pc_gamg_esteig_ksp_max_it 10 -pc_gamg_asm_use_agg true -mg_levels_sub_pc_type lu -mg_levels_pc_asm_overlap 0 -pc_gamg_threshold -0.01 -pc_gamg_coarse_eq_limit 200 -pc_gamg_process_eq_limit 30 -pc_gamg_repartition false -pc_mg_cycle_type v -pc_gamg_use_parallel_coarse_grid_solver -mg_coarse_pc_type jacobi -mg_coarse_ksp_type cg -ksp_monitor_short -ksp_view
 
+   test:
+      suffix: log_view
+      nsize: 8
+      args: -ne 9 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -use_mat_nearnullspace -pc_gamg_square_graph 1 -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 50 -pc_gamg_repartition false -ksp_converged_reason -pc_gamg_log_view
+      filter: sed -E -e "s/^( +[0-9]+  [a-z]+ +)[^ ]+ +[^ ]+ +([0-9]+) .*$/\\1 TIME FLOPS \\2 BYTES REDUCTIONS/" -e "s/^( +[0-9]+ +[0-9]+ +[^ ]+ +[^ ]+ +[0-9]+ +)[^ ]+( +[^ ]+ +)[^ ]+$/\\1 MEMORY\\2 MEMORY/"
+
+   test:
+      suffix: log_view_json
+      nsize: 8
+      args: -ne 9 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_agg_nsmooths 1 -use_mat_nearnullspace -pc_gamg_square_graph 1 -pc_gamg_coarse_eq_limit 100 -pc_gamg_process_eq_limit 50 -pc_gamg_repartition false -ksp_converged_reason -pc_gamg_log_view ::ascii_json
+      filter: sed -E "s/((time|flops|bytes|reductions|memory).: )[^,}]+/\\1X/g"
+
    test:
       suffix: ml
       nsize: 8
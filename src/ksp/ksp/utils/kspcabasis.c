@@ -0,0 +1,209 @@
+
+/*
+   Polynomial bases shared by the s-step (communication-avoiding) Krylov methods KSPCACG and KSPCAGMRES.
+
+   An s-step method generates s Krylov vectors v_1,...,v_s from v_0 at once with a three term recurrence
+   and then orthogonalizes (or forms the Gram matrix of) the whole block with a single global reduction.
+   The recurrence is described by the (s+1) x s upper Hessenberg change of basis matrix B with
+
+        A [v_0 ... v_{s-1}] = [v_0 ... v_s] B
+
+   so that v_{i+1} = (A v_i - sum_{k<=i} B(k,i) v_k) / B(i+1,i). B has at most three nonzeros per column.
+*/
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+/*
+   KSPCABasisComputeRitz_Private - eigenvalues (Ritz values) of the leading n x n block of an upper Hessenberg matrix
+
+   Input Parameters:
++  n   - the size of the block
+.  H   - the Hessenberg matrix, stored by columns
+-  ldh - the leading dimension of H
+
+   Output Parameters:
++  re - the real parts of the eigenvalues
+-  im - the imaginary parts of the eigenvalues, in real arithmetic complex conjugate pairs are adjacent
+*/
+PetscErrorCode KSPCABasisComputeRitz_Private(PetscInt n,const PetscScalar *H,PetscInt ldh,PetscReal *re,PetscReal *im)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j;
+  PetscScalar    *R,*work,sdummy = 0;
+  PetscBLASInt   bn,ilo = 1,lwork,ldz = 1,lierr;
+#if defined(PETSC_USE_COMPLEX)
+  PetscScalar    *w;
+#endif
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  lwork = bn;
+  ierr = PetscMalloc2(n*n,&R,n,&work);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    for (i=0; i<n; i++) R[i+j*n] = (i <= j+1) ? H[i+j*ldh] : 0.0;
+  }
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscMalloc1(n,&w);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&bn,&ilo,&bn,R,&bn,w,&sdummy,&ldz,work,&lwork,&lierr));
+  for (i=0; i<n; i++) {
+    re[i] = PetscRealPart(w[i]);
+    im[i] = PetscImaginaryPart(w[i]);
+  }
+  ierr = PetscFree(w);CHKERRQ(ierr);
+#else
+  PetscStackCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&bn,&ilo,&bn,R,&bn,re,im,&sdummy,&ldz,work,&lwork,&lierr));
+#endif
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (lierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine xHSEQR %d",(int)lierr);
+  ierr = PetscFree2(R,work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Reorders the shifts in place with the (modified) Leja ordering, which keeps the Newton basis well conditioned:
+   the first shift has the largest modulus and each next one maximizes the product of the distances to the
+   previous ones. In real arithmetic a shift with positive imaginary part is immediately followed by its conjugate.
+*/
+static PetscErrorCode KSPCABasisLejaOrder_Private(PetscInt n,PetscReal *re,PetscReal *im)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,m = 0,ibest;
+  PetscReal      *wr,*wi,dist,prod,best;
+  PetscBool      *used;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc3(n,&wr,n,&wi,n,&used);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {wr[i] = re[i]; wi[i] = im[i]; used[i] = PETSC_FALSE;}
+  while (m < n) {
+    ibest = -1;
+    best  = PETSC_MIN_REAL;
+    for (i=0; i<n; i++) {
+      if (used[i]) continue;
+#if !defined(PETSC_USE_COMPLEX)
+      if (wi[i] < 0.0) continue; /* added together with its conjugate */
+#endif
+      if (!m) prod = PetscSqrtReal(wr[i]*wr[i] + wi[i]*wi[i]);
+      else {
+        for (prod=0.0,k=0; k<m; k++) {
+          dist  = PetscSqrtReal((wr[i]-re[k])*(wr[i]-re[k]) + (wi[i]-im[k])*(wi[i]-im[k]));
+          prod += PetscLogReal(PetscMax(dist,PETSC_MACHINE_EPSILON));
+        }
+      }
+      if (prod > best) {best = prod; ibest = i;}
+    }
+    if (ibest < 0) break;
+    used[ibest] = PETSC_TRUE;
+    re[m] = wr[ibest]; im[m] = wi[ibest]; m++;
+#if !defined(PETSC_USE_COMPLEX)
+    if (wi[ibest] > 0.0 && m < n) {
+      for (j=0; j<n; j++) if (!used[j] && wi[j] < 0.0) break;
+      if (j < n) used[j] = PETSC_TRUE;
+      re[m] = wr[ibest]; im[m] = -wi[ibest]; m++;
+    }
+#endif
+  }
+  /* conjugates whose partner was missing */
+  for (i=0; i<n && m<n; i++) {
+    if (!used[i]) {re[m] = wr[i]; im[m] = 0.0; m++;}
+  }
+  ierr = PetscFree3(wr,wi,used);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPCABasisSetUp_Private - builds the change of basis matrix of an s-step basis
+
+   Input Parameters:
++  type   - the basis
+.  s      - the number of steps
+.  n      - the number of eigenvalue estimates in re and im, or 0 to use only the interval [emin,emax]
+.  re, im - eigenvalue estimates (Ritz values) of the operator, reordered on output
+-  emin, emax - estimates of the smallest and largest (real parts of the) eigenvalues, used when n is 0
+
+   Output Parameter:
+.  B - the (s+1) x s change of basis matrix, stored by columns with leading dimension s+1
+
+   Notes:
+   The Newton basis uses the Leja ordered Ritz values as shifts, or the Chebyshev points of [emin,emax] if no
+   Ritz values are given, and is scaled with an estimate of the capacity of the spectrum.
+   The Chebyshev basis uses the scaled and shifted Chebyshev polynomials of the first kind on the interval
+   spanned by the real parts of the eigenvalue estimates.
+*/
+PetscErrorCode KSPCABasisSetUp_Private(KSPCABasisType type,PetscInt s,PetscInt n,PetscReal *re,PetscReal *im,PetscReal emin,PetscReal emax,PetscScalar *B)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,ld = s+1;
+  PetscReal      a,b,c,d,scale,*sr,*si;
+
+  PetscFunctionBegin;
+  ierr = PetscArrayzero(B,ld*s);CHKERRQ(ierr);
+  if (n) {
+    a = b = re[0];
+    for (i=1; i<n; i++) {a = PetscMin(a,re[i]); b = PetscMax(b,re[i]);}
+  } else {
+    a = emin; b = emax;
+  }
+  switch (type) {
+  case KSP_CA_BASIS_MONOMIAL:
+    scale = PetscMax(PetscAbsReal(a),PetscAbsReal(b));
+    for (i=0; i<n; i++) scale = PetscMax(scale,PetscSqrtReal(re[i]*re[i] + im[i]*im[i]));
+    if (scale == 0.0) scale = 1.0;
+    for (i=0; i<s; i++) B[i+1+i*ld] = scale;
+    break;
+  case KSP_CA_BASIS_CHEBYSHEV:
+    c = 0.5*(a + b);
+    d = PetscMax(0.5*(b - a),0.1*PetscAbsReal(c));
+    if (d == 0.0) d = 1.0;
+    B[0] = c;
+    B[1] = d;
+    for (i=1; i<s; i++) {
+      B[i-1+i*ld] = 0.5*d;
+      B[i+i*ld]   = c;
+      B[i+1+i*ld] = 0.5*d;
+    }
+    break;
+  case KSP_CA_BASIS_NEWTON:
+    ierr = PetscMalloc2(s,&sr,s,&si);CHKERRQ(ierr);
+    if (n) {
+      ierr = KSPCABasisLejaOrder_Private(n,re,im);CHKERRQ(ierr);
+      for (i=0; i<s; i++) {sr[i] = re[i%n]; si[i] = im[i%n];}
+    } else {
+      c = 0.5*(a + b); d = 0.5*(b - a);
+      for (i=0; i<s; i++) {sr[i] = c + d*PetscCosReal(PETSC_PI*(2*i+1)/(2*s)); si[i] = 0.0;}
+      ierr = KSPCABasisLejaOrder_Private(s,sr,si);CHKERRQ(ierr);
+    }
+    for (scale=0.0,i=0; i<s; i++) {
+      for (j=0; j<i; j++) scale = PetscMax(scale,PetscSqrtReal((sr[i]-sr[j])*(sr[i]-sr[j]) + (si[i]-si[j])*(si[i]-si[j])));
+    }
+    scale *= 0.25;
+    if (scale == 0.0) {
+      for (i=0; i<s; i++) scale = PetscMax(scale,PetscSqrtReal(sr[i]*sr[i] + si[i]*si[i]));
+    }
+    if (scale == 0.0) scale = 1.0;
+    for (i=0; i<s; i++) {
+#if defined(PETSC_USE_COMPLEX)
+      B[i+i*ld]   = PetscCMPLX(sr[i],si[i]);
+      B[i+1+i*ld] = scale;
+#else
+      if (si[i] > 0.0 && i+1 < s) {
+        /* conjugate pair a +- ib: v_{i+1} = (A - a) v_i/scale, v_{i+2} = ((A - a) v_{i+1} + b^2/scale v_i)/scale */
+        B[i+i*ld]       = sr[i];
+        B[i+1+i*ld]     = scale;
+        B[i+(i+1)*ld]   = -si[i]*si[i]/scale;
+        B[i+1+(i+1)*ld] = sr[i];
+        B[i+2+(i+1)*ld] = scale;
+        i++;
+      } else {
+        B[i+i*ld]   = sr[i];
+        B[i+1+i*ld] = scale;
+      }
+#endif
+    }
+    ierr = PetscFree2(sr,si);CHKERRQ(ierr);
+    break;
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown basis type %d",(int)type);
+  }
+  PetscFunctionReturn(0);
+}
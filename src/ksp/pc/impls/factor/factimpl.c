@@ -262,6 +262,11 @@ PetscErrorCode  PCSetFromOptions_Factor(PetscOptionItems *PetscOptionsObject,PC
     ierr = PCFactorSetReuseOrdering(pc,flg);CHKERRQ(ierr);
   }
 
+  ierr = PetscOptionsBool("-pc_factor_single_precision","Apply the factors from a single precision copy","PCFactorSetUseSinglePrecision",((PC_Factor*)factor)->singleprecision,&flg,&set);CHKERRQ(ierr);
+  if (set) {
+    ierr = PCFactorSetUseSinglePrecision(pc,flg);CHKERRQ(ierr);
+  }
+
   ierr = MatGetOrderingList(&ordlist);CHKERRQ(ierr);
   ierr = PetscOptionsFList("-pc_factor_mat_ordering_type","Reordering to reduce nonzeros in factored matrix","PCFactorSetMatOrderingType",ordlist,((PC_Factor*)factor)->ordering,tname,256,&flg);CHKERRQ(ierr);
   if (flg) {
@@ -296,6 +301,7 @@ PetscErrorCode PCView_Factor(PC pc,PetscViewer viewer)
 
     if (factor->reusefill)     {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing fill from past factorization\n");CHKERRQ(ierr);}
     if (factor->reuseordering) {ierr = PetscViewerASCIIPrintf(viewer,"  Reusing reordering from past factorization\n");CHKERRQ(ierr);}
+    if (factor->singleprecision) {ierr = PetscViewerASCIIPrintf(viewer,"  factors applied in single precision\n");CHKERRQ(ierr);}
     if (factor->factortype == MAT_FACTOR_ILU || factor->factortype == MAT_FACTOR_ICC) {
       if (factor->info.dt > 0) {
         ierr = PetscViewerASCIIPrintf(viewer,"  drop tolerance %g\n",(double)factor->info.dt);CHKERRQ(ierr);
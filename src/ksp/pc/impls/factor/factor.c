@@ -19,6 +19,15 @@ static PetscErrorCode PCFactorSetReuseFill_Factor(PC pc,PetscBool flag)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCFactorSetUseSinglePrecision_Factor(PC pc,PetscBool flag)
+{
+  PC_Factor *lu = (PC_Factor*)pc->data;
+
+  PetscFunctionBegin;
+  lu->singleprecision = flag;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCFactorSetUseInPlace_Factor(PC pc,PetscBool flg)
 {
   PC_Factor *dir = (PC_Factor*)pc->data;
@@ -672,6 +681,42 @@ PetscErrorCode  PCFactorSetReuseFill(PC pc,PetscBool flag)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCFactorSetUseSinglePrecision - Applies the factors from a single precision copy of their values
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flag - PETSC_TRUE to use single precision factors, else PETSC_FALSE
+
+   Options Database Key:
+.  -pc_factor_single_precision - Activates PCFactorSetUseSinglePrecision()
+
+   Notes:
+   The factorization itself is done in PetscScalar, then the triangular solves read a float copy of the factors while
+   the vectors and the outer Krylov method remain in PetscScalar. This halves the memory traffic of each PCApply() at the
+   cost of a preconditioner that is only accurate to single precision, which is usually not noticeable in the iteration
+   count of an incomplete factorization.
+
+   Only the MATSEQAIJ factors computed by PETSc (MATSOLVERPETSC) are supported; it has no effect otherwise. Use the
+   prefix of the sub-solvers to set it for PCBJACOBI or PCASM, for example -sub_pc_factor_single_precision.
+
+   Level: intermediate
+
+.seealso: PCILU, PCLU, MatAIJSetSinglePrecision(), PCGAMGSetUseSinglePrecision()
+@*/
+PetscErrorCode PCFactorSetUseSinglePrecision(PC pc,PetscBool flag)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flag,2);
+  ierr = PetscTryMethod(pc,"PCFactorSetUseSinglePrecision_C",(PC,PetscBool),(pc,flag));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCFactorInitialize(PC pc)
 {
   PetscErrorCode ierr;
@@ -705,5 +750,6 @@ PetscErrorCode PCFactorInitialize(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorGetUseInPlace_C",PCFactorGetUseInPlace_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseOrdering_C",PCFactorSetReuseOrdering_Factor);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetReuseFill_C",PCFactorSetReuseFill_Factor);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetUseSinglePrecision_C",PCFactorSetUseSinglePrecision_Factor);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
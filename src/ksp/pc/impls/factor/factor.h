@@ -16,6 +16,7 @@ typedef struct {
   PetscBool        inplace;            /* flag indicating in-place factorization */
   PetscBool        reuseordering;      /* reuses previous reordering computed */
   PetscBool        reusefill;          /* reuse fill from previous LU */
+  PetscBool        singleprecision;    /* apply the factors from a single precision copy of their values */
 } PC_Factor;
 
 PETSC_INTERN PetscErrorCode PCFactorInitialize(PC);
@@ -169,6 +169,9 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
     if (err) { /* FactorNumeric() fails */
       pc->failedreason = (PCFailedReason)err;
     }
+    if (((PC_Factor*)ilu)->singleprecision) {
+      ierr = MatAIJSetSinglePrecision(((PC_Factor*)ilu)->fact,PETSC_TRUE);CHKERRQ(ierr);
+    }
   }
 
   ierr = PCFactorGetMatSolverType(pc,&stype);CHKERRQ(ierr);
@@ -246,6 +249,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
 .  -pc_factor_nonzeros_along_diagonal - reorder the matrix before factorization to remove zeros from the diagonal,
                                    this decreases the chance of getting a zero pivot
 .  -pc_factor_mat_ordering_type <natural,nd,1wd,rcm,qmd> - set the row/column ordering of the factored matrix
+.  -pc_factor_single_precision - apply the factors from a single precision copy of their values, see PCFactorSetUseSinglePrecision()
 -  -pc_factor_pivot_in_blocks - for block ILU(k) factorization, i.e. with BAIJ matrices with block size larger
                              than 1 the diagonal blocks are factored with partial pivoting (this increases the
                              stability of the ILU factorization
@@ -128,6 +128,9 @@ static PetscErrorCode PCSetUp_LU(PC pc)
     if (err) { /* FactorNumeric() fails */
       pc->failedreason = (PCFailedReason)err;
     }
+    if (((PC_Factor*)dir)->singleprecision) {
+      ierr = MatAIJSetSinglePrecision(((PC_Factor*)dir)->fact,PETSC_TRUE);CHKERRQ(ierr);
+    }
 
   }
 
@@ -204,6 +207,7 @@ static PetscErrorCode PCApplyTranspose_LU(PC pc,Vec x,Vec y)
 .  -pc_factor_reuse_fill - Activates PCFactorSetReuseFill()
 .  -pc_factor_fill <fill> - Sets fill amount
 .  -pc_factor_in_place - Activates in-place factorization
+.  -pc_factor_single_precision - Activates PCFactorSetUseSinglePrecision()
 .  -pc_factor_mat_ordering_type <nd,rcm,...> - Sets ordering routine
 .  -pc_factor_pivot_in_blocks <true,false> - allow pivoting within the small blocks during factorization (may increase
                                          stability of factorization.
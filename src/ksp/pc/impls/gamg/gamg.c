@@ -5,6 +5,7 @@
 #include <../src/ksp/pc/impls/gamg/gamg.h>           /*I "petscpc.h" I*/
 #include <../src/ksp/pc/impls/bjacobi/bjacobi.h> /* Hack to access same_local_solves */
 #include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h>    /*I "petscksp.h" I*/
+#include <petsctime.h>
 
 #if defined PETSC_GAMG_USE_LOG
 PetscLogEvent petsc_gamg_setup_events[NUM_SET];
@@ -28,6 +29,169 @@ static PetscLogStage gamg_stages[PETSC_MG_MAXLEVELS];
 static PetscFunctionList GAMGList = 0;
 static PetscBool PCGAMGPackageInitialized;
 
+/* ----------------------------------------------------------------------------- */
+/* -pc_gamg_log_view: counters of this process, the messages and reductions are those counted by the logging of PETSc */
+static PetscErrorCode PCGAMGLogGetCounters(PCGAMGLogCounters *c)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscTime(&c->time);CHKERRQ(ierr);
+#if defined(PETSC_USE_LOG)
+  c->flops      = petsc_TotalFlops;
+  c->messages   = petsc_isend_ct + petsc_send_ct;
+  c->bytes      = petsc_isend_len + petsc_send_len;
+  c->reductions = petsc_allreduce_ct;
+#else
+  c->flops = c->messages = c->bytes = c->reductions = 0.0;
+#endif
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGLogPhaseBegin(PC_GAMG *pc_gamg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!pc_gamg->log_viewer) PetscFunctionReturn(0);
+  if (pc_gamg->log_depth >= 2) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"GAMG setup phases are nested too deep");
+  ierr = PCGAMGLogGetCounters(&pc_gamg->log_start[pc_gamg->log_depth++]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Adds the counts since the matching PCGAMGLogPhaseBegin() to the phase of the current level, and removes them from the enclosing phase */
+static PetscErrorCode PCGAMGLogPhaseEnd(PC_GAMG *pc_gamg,PCGAMGPhase phase)
+{
+  PetscErrorCode    ierr;
+  PCGAMGLogCounters now,*start,*sum;
+
+  PetscFunctionBegin;
+  if (!pc_gamg->log_viewer) PetscFunctionReturn(0);
+  ierr  = PCGAMGLogGetCounters(&now);CHKERRQ(ierr);
+  start = &pc_gamg->log_start[--pc_gamg->log_depth];
+  now.time       -= start->time;
+  now.flops      -= start->flops;
+  now.messages   -= start->messages;
+  now.bytes      -= start->bytes;
+  now.reductions -= start->reductions;
+  sum = &pc_gamg->log_levels[pc_gamg->current_level].phase[phase];
+  sum->time       += now.time;
+  sum->flops      += now.flops;
+  sum->messages   += now.messages;
+  sum->bytes      += now.bytes;
+  sum->reductions += now.reductions;
+  if (pc_gamg->log_depth) {
+    start = &pc_gamg->log_start[pc_gamg->log_depth-1];
+    start->time       += now.time;
+    start->flops      += now.flops;
+    start->messages   += now.messages;
+    start->bytes      += now.bytes;
+    start->reductions += now.reductions;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Records the size of the operator of a level, or of the interpolation to it from the next coarser level */
+static PetscErrorCode PCGAMGLogLevel_Private(PC_GAMG *pc_gamg,PetscInt level,Mat A,Mat P,PetscMPIInt nactive)
+{
+  PetscErrorCode ierr;
+  MatInfo        info;
+  PCGAMGLogLevel *lev = &pc_gamg->log_levels[level];
+
+  PetscFunctionBegin;
+  if (!pc_gamg->log_viewer) PetscFunctionReturn(0);
+  if (A) {
+    ierr = MatGetSize(A,&lev->rows,NULL);CHKERRQ(ierr);
+    ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+    lev->nnz     = info.nz_used;
+    lev->mem     = info.memory;
+    lev->nactive = nactive;
+  }
+  if (P) {
+    ierr = MatGetInfo(P,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+    lev->pnnz = info.nz_used;
+    lev->pmem = info.memory;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Prints the tables of -pc_gamg_log_view. The times and the reductions are the maxima over the processes, the other counts are summed. */
+static PetscErrorCode PCGAMGLogView_Private(PC pc)
+{
+  PetscErrorCode    ierr;
+  PC_MG             *mg      = (PC_MG*)pc->data;
+  PC_GAMG           *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscViewer       viewer   = pc_gamg->log_viewer;
+  const PetscInt    nlevels  = pc_gamg->Nlevels,n = 5*nlevels*PCGAMG_NUM_PHASES;
+  const char *const names[]  = {"graph","coarsen","prolongator","smooth","ptap","repartition"};
+  PetscLogDouble    *loc,*lmax,*lsum,nnz = 0.0,rows = 0.0;
+  PetscInt          l,p,k;
+  PetscBool         iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscMalloc3(n,&loc,n,&lmax,n,&lsum);CHKERRQ(ierr);
+  for (l=0,k=0; l<nlevels; l++) {
+    for (p=0; p<PCGAMG_NUM_PHASES; p++) {
+      PCGAMGLogCounters *c = &pc_gamg->log_levels[l].phase[p];
+
+      loc[k++] = c->time;
+      loc[k++] = c->flops;
+      loc[k++] = c->messages;
+      loc[k++] = c->bytes;
+      loc[k++] = c->reductions;
+    }
+    nnz  += pc_gamg->log_levels[l].nnz;
+    rows += pc_gamg->log_levels[l].rows;
+  }
+  ierr = MPIU_Allreduce(loc,lmax,(PetscMPIInt)n,MPIU_PETSCLOGDOUBLE,MPI_MAX,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(loc,lsum,(PetscMPIInt)n,MPIU_PETSCLOGDOUBLE,MPI_SUM,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+  for (k=0; k<n; k+=5) {
+    lsum[k]   = lmax[k];
+    lsum[k+4] = lmax[k+4];
+  }
+  if (pc_gamg->log_format == PETSC_VIEWER_ASCII_JSON) { /* no %g, PetscViewerASCIIPrintf() would append a decimal point to integers */
+    ierr = PetscViewerASCIIPrintf(viewer,"{\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  \"operator_complexity\": %.6e,\n",nnz/pc_gamg->log_levels[0].nnz);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  \"grid_complexity\": %.6e,\n",rows/pc_gamg->log_levels[0].rows);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  \"levels\": [\n");CHKERRQ(ierr);
+    for (l=0,k=0; l<nlevels; l++) {
+      PCGAMGLogLevel *lev = &pc_gamg->log_levels[l];
+
+      ierr = PetscViewerASCIIPrintf(viewer,"    {\"level\": %D, \"rows\": %D, \"nonzeros\": %.0f, \"processes\": %d, \"memory\": %.0f",l,lev->rows,lev->nnz,lev->nactive,lev->mem);CHKERRQ(ierr);
+      if (l == nlevels-1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"}\n");CHKERRQ(ierr);
+        break;
+      }
+      ierr = PetscViewerASCIIPrintf(viewer,", \"interpolation_nonzeros\": %.0f, \"interpolation_memory\": %.0f,\n",lev->pnnz,lev->pmem);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"     \"phases\": {\n");CHKERRQ(ierr);
+      for (p=0; p<PCGAMG_NUM_PHASES; p++,k+=5) {
+        ierr = PetscViewerASCIIPrintf(viewer,"       \"%s\": {\"time\": %.6e, \"flops\": %.0f, \"messages\": %.0f, \"bytes\": %.0f, \"reductions\": %.0f}%s\n",names[p],lsum[k],lsum[k+1],lsum[k+2],lsum[k+3],lsum[k+4],p < PCGAMG_NUM_PHASES-1 ? "," : "");CHKERRQ(ierr);
+      }
+      ierr = PetscViewerASCIIPrintf(viewer,"     }},\n");CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPrintf(viewer,"  ]\n}\n");CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerASCIIPrintf(viewer,"PCGAMG setup: %D levels, operator complexity %g, grid complexity %g\n",nlevels,nnz/pc_gamg->log_levels[0].nnz,rows/pc_gamg->log_levels[0].rows);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"Level        Rows    Nonzeros  Nnz/row  Processes      Memory  P nonzeros    P memory\n");CHKERRQ(ierr);
+    for (l=0; l<nlevels; l++) {
+      PCGAMGLogLevel *lev = &pc_gamg->log_levels[l];
+
+      ierr = PetscViewerASCIIPrintf(viewer,"%5D %11D %11.5g %8.3g %10d %11.5g %11.5g %11.5g\n",l,lev->rows,lev->nnz,lev->nnz/lev->rows,lev->nactive,lev->mem,lev->pnnz,lev->pmem);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPrintf(viewer,"Setup of the interpolation from level l+1 and of its operator (time and reductions: max over processes, others: sum)\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"Level  Phase         Time (sec)       Flops    Messages       Bytes  Reductions\n");CHKERRQ(ierr);
+    for (l=0,k=0; l<nlevels-1; l++) {
+      for (p=0; p<PCGAMG_NUM_PHASES; p++,k+=5) {
+        ierr = PetscViewerASCIIPrintf(viewer,"%5D  %-12s %11.3e %11.5g %11.5g %11.5g %11.5g\n",l,names[p],lsum[k],lsum[k+1],lsum[k+2],lsum[k+3],lsum[k+4]);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscFree3(loc,lmax,lsum);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* ----------------------------------------------------------------------------- */
 PetscErrorCode PCReset_GAMG(PC pc)
 {
@@ -80,7 +244,9 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
   ierr = MatGetBlockSize(Amat_fine, &f_bs);CHKERRQ(ierr);
+  ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
   ierr = MatPtAP(Amat_fine, Pold, MAT_INITIAL_MATRIX, 2.0, &Cmat);CHKERRQ(ierr);
+  ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_PTAP);CHKERRQ(ierr);
 
   if (Pcolumnperm) *Pcolumnperm = NULL;
 
@@ -478,6 +644,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_INITIAL_MATRIX,2.0,&B);CHKERRQ(ierr);
             ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
             mglevels[level]->A = B;
+            if (pc_gamg->use_single_precision) {ierr = MatAIJSetSinglePrecision(B,PETSC_TRUE);CHKERRQ(ierr);}
           } else {
             ierr = PetscInfo2(pc,"RAP after first solve reusing matrix level %D, %D setup\n",level,pc_gamg->setup_count);CHKERRQ(ierr);
             ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B);CHKERRQ(ierr);
@@ -526,6 +693,8 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   nnz0   = info.nz_used;
   nnztot = info.nz_used;
   ierr = PetscInfo6(pc,"level %d) N=%D, n data rows=%d, n data cols=%d, nnz/row (ave)=%d, np=%d\n",0,M,pc_gamg->data_cell_rows,pc_gamg->data_cell_cols,(int)(nnz0/(PetscReal)M+0.5),size);CHKERRQ(ierr);
+  ierr = PetscArrayzero(pc_gamg->log_levels,PETSC_MG_MAXLEVELS);CHKERRQ(ierr);
+  ierr = PCGAMGLogLevel_Private(pc_gamg,0,Pmat,NULL,size);CHKERRQ(ierr);
 
   /* Get A_i and R_i */
   for (level=0, Aarr[0]=Pmat, nactivepe = size; level < (pc_gamg->Nlevels-1) && (!level || M>pc_gamg->coarse_eq_limit); level++) {
@@ -543,9 +712,15 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       PetscCoarsenData *agg_lists;
       Mat              Prol11;
 
+      ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
       ierr = pc_gamg->ops->graph(pc,Aarr[level], &Gmat);CHKERRQ(ierr);
+      ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_GRAPH);CHKERRQ(ierr);
+      ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
       ierr = pc_gamg->ops->coarsen(pc, &Gmat, &agg_lists);CHKERRQ(ierr);
+      ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_COARSEN);CHKERRQ(ierr);
+      ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
       ierr = pc_gamg->ops->prolongator(pc,Aarr[level],Gmat,agg_lists,&Prol11);CHKERRQ(ierr);
+      ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_PROL);CHKERRQ(ierr);
 
       /* could have failed to create new level */
       if (Prol11) {
@@ -554,7 +729,9 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
 
         if (pc_gamg->ops->optprolongator) {
           /* smooth */
+          ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
           ierr = pc_gamg->ops->optprolongator(pc, Aarr[level], &Prol11);CHKERRQ(ierr);
+          ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_OPTPROL);CHKERRQ(ierr);
         }
 
         if (pc_gamg->use_aggs_in_asm) {
@@ -587,7 +764,12 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (is_last) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Is last ????????");
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels-1) is_last = PETSC_TRUE;
+    /* the PtAP is a phase of its own nested in the repartitioning */
+    ierr = PCGAMGLogPhaseBegin(pc_gamg);CHKERRQ(ierr);
     ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    ierr = PCGAMGLogPhaseEnd(pc_gamg,PCGAMG_PHASE_REPART);CHKERRQ(ierr);
+    ierr = PCGAMGLogLevel_Private(pc_gamg,level1,Aarr[level1],NULL,nactivepe);CHKERRQ(ierr);
+    ierr = PCGAMGLogLevel_Private(pc_gamg,level,NULL,Parr[level1],0);CHKERRQ(ierr);
 
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
@@ -624,7 +806,11 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       ierr = KSPGetPC(smoother, &subpc);CHKERRQ(ierr);
 
       ierr = KSPSetNormType(smoother, KSP_NORM_NONE);CHKERRQ(ierr);
-      /* set ops */
+      /* set ops, the finest grid operator belongs to the user and stays in full precision */
+      if (pc_gamg->use_single_precision) {
+        if (level) {ierr = MatAIJSetSinglePrecision(Aarr[level],PETSC_TRUE);CHKERRQ(ierr);}
+        ierr = MatAIJSetSinglePrecision(Parr[level+1],PETSC_TRUE);CHKERRQ(ierr);
+      }
       ierr = KSPSetOperators(smoother, Aarr[level], Aarr[level]);CHKERRQ(ierr);
       ierr = PCMGSetInterpolation(pc, lidx, Parr[level+1]);CHKERRQ(ierr);
 
@@ -665,6 +851,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       KSP smoother,*k2; PC subpc,pc2; PetscInt ii,first;
       Mat Lmat = Aarr[(level=pc_gamg->Nlevels-1)]; lidx = 0;
       ierr = PCMGGetSmoother(pc, lidx, &smoother);CHKERRQ(ierr);
+      if (pc_gamg->use_single_precision) {ierr = MatAIJSetSinglePrecision(Lmat,PETSC_TRUE);CHKERRQ(ierr);}
       ierr = KSPSetOperators(smoother, Lmat, Lmat);CHKERRQ(ierr);
       if (!pc_gamg->use_parallel_coarse_grid_solver) {
         ierr = KSPSetNormType(smoother, KSP_NORM_NONE);CHKERRQ(ierr);
@@ -676,6 +863,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         ierr = KSPGetPC(k2[0],&pc2);CHKERRQ(ierr);
         ierr = PCSetType(pc2, PCLU);CHKERRQ(ierr);
         ierr = PCFactorSetShiftType(pc2,MAT_SHIFT_INBLOCKS);CHKERRQ(ierr);
+        ierr = PCFactorSetUseSinglePrecision(pc2,pc_gamg->use_single_precision);CHKERRQ(ierr);
         ierr = KSPSetTolerances(k2[0],PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT,1);CHKERRQ(ierr);
         ierr = KSPSetType(k2[0], KSPPREONLY);CHKERRQ(ierr);
         /* This flag gets reset by PCBJacobiGetSubKSP(), but our BJacobi really does the same algorithm everywhere (and in
@@ -733,6 +921,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     ierr = KSPSetType(smoother, KSPPREONLY);CHKERRQ(ierr);
     ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
   }
+  if (pc_gamg->log_viewer) {ierr = PCGAMGLogView_Private(pc);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -759,6 +948,7 @@ PetscErrorCode PCDestroy_GAMG(PC pc)
   }
   ierr = PetscFree(pc_gamg->ops);CHKERRQ(ierr);
   ierr = PetscFree(pc_gamg->gamg_type_name);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&pc_gamg->log_viewer);CHKERRQ(ierr);
   ierr = PetscFree(pc_gamg);CHKERRQ(ierr);
   ierr = PCDestroy_MG(pc);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1186,6 +1376,52 @@ static PetscErrorCode PCGAMGSetCpuPinCoarseGrids_GAMG(PC pc, PetscBool flg)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetUseSinglePrecision - Applies the coarse grid operators, the interpolations and the coarse grid factors
+   from single precision copies of their values
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use single precision
+
+   Options Database Key:
+.  -pc_gamg_single_precision
+
+   Notes:
+   The hierarchy is built in PetscScalar, then the smoothers, residuals, restrictions, interpolations and the
+   coarse grid solve read float copies of the values (see MatAIJSetSinglePrecision()), which roughly halves
+   the memory traffic of the coarse levels. The finest grid operator is the user's matrix and is left in full
+   precision, so is the outer Krylov method.
+
+   Only MATAIJ hierarchies on the CPU are affected.
+
+   Level: intermediate
+
+.seealso: PCGAMGSetCpuPinCoarseGrids(), PCFactorSetUseSinglePrecision(), MatAIJSetSinglePrecision()
+@*/
+PetscErrorCode PCGAMGSetUseSinglePrecision(PC pc, PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetUseSinglePrecision_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetUseSinglePrecision_GAMG(PC pc, PetscBool flg)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->use_single_precision = flg;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGSetCoarseGridLayoutType - place reduce grids on processors with natural order (compact type)
 
@@ -1492,6 +1728,9 @@ static PetscErrorCode PCView_GAMG(PC pc,PetscViewer viewer)
   if (pc_gamg->use_parallel_coarse_grid_solver) {
     ierr = PetscViewerASCIIPrintf(viewer,"      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n");CHKERRQ(ierr);
   }
+  if (pc_gamg->use_single_precision) {
+    ierr = PetscViewerASCIIPrintf(viewer,"      Using single precision coarse grid operators, interpolations and coarse grid factors\n");CHKERRQ(ierr);
+  }
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (pc_gamg->cpu_pin_coarse_grids) {
     /* ierr = PetscViewerASCIIPrintf(viewer,"      Pinning coarse grids to the CPU)\n");CHKERRQ(ierr); */
@@ -1540,6 +1779,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids","Pin coarse grids to the CPU","PCGAMGSetCpuPinCoarseGrids",pc_gamg->cpu_pin_coarse_grids,&pc_gamg->cpu_pin_coarse_grids,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_gamg_single_precision","Apply the coarse grids and interpolations in single precision","PCGAMGSetUseSinglePrecision",pc_gamg->use_single_precision,&pc_gamg->use_single_precision,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnum("-pc_gamg_coarse_grid_layout_type","compact: place reduced grids on processes in natural order; spread: distribute to whole machine for more memory bandwidth","PCGAMGSetCoarseGridLayoutType",LayoutTypes,(PetscEnum)pc_gamg->layout_type,(PetscEnum*)&pc_gamg->layout_type,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_gamg_process_eq_limit","Limit (goal) on number of equations per process on coarse grids","PCGAMGSetProcEqLim",pc_gamg->min_eq_proc,&pc_gamg->min_eq_proc,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_gamg_esteig_ksp_max_it","Number of iterations of eigen estimator","PCGAMGSetEstEigKSPMaxIt",pc_gamg->esteig_max_it,&pc_gamg->esteig_max_it,NULL);CHKERRQ(ierr);
@@ -1553,6 +1793,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
     do {pc_gamg->threshold[i] = pc_gamg->threshold[i-1]*pc_gamg->threshold_scale;} while (++i<PETSC_MG_MAXLEVELS);
   }
   ierr = PetscOptionsInt("-pc_mg_levels","Set number of MG levels","PCGAMGSetNlevels",pc_gamg->Nlevels,&pc_gamg->Nlevels,NULL);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&pc_gamg->log_viewer);CHKERRQ(ierr);
+  ierr = PetscOptionsViewer("-pc_gamg_log_view","View the time, flops and communication of each phase of the setup of each level","None",&pc_gamg->log_viewer,&pc_gamg->log_format,NULL);CHKERRQ(ierr);
   {
     PetscReal eminmax[2] = {0., 0.};
     n = 2;
@@ -1583,8 +1825,11 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
+.   -pc_gamg_single_precision <true,default=false> - apply the coarse grids, interpolations and coarse grid factors in single precision
 .   -pc_gamg_threshold[] <thresh,default=0> - Before aggregating the graph GAMG will remove small values from the graph on each level
--   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
+.   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
+-   -pc_gamg_log_view [viewer] - after each setup, print the size of each level and the time, flops, messages, bytes and reductions of each phase
+                                 of its setup (graph, coarsen, prolongator, smooth, ptap, repartition); use the format ascii_json for JSON output
 
    Options Database Keys for default Aggregation:
 +  -pc_gamg_agg_nsmooths <nsmooth, default=1> - number of smoothing steps to use with smooth aggregation
@@ -1657,6 +1902,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCpuPinCoarseGrids_C",PCGAMGSetCpuPinCoarseGrids_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseSinglePrecision_C",PCGAMGSetUseSinglePrecision_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseGridLayoutType_C",PCGAMGSetCoarseGridLayoutType_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThreshold_C",PCGAMGSetThreshold_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThresholdScale_C",PCGAMGSetThresholdScale_GAMG);CHKERRQ(ierr);
@@ -1668,6 +1914,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   pc_gamg->use_aggs_in_asm  = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids = PETSC_FALSE;
+  pc_gamg->use_single_precision = PETSC_FALSE;
   pc_gamg->layout_type      = PCGAMG_LAYOUT_SPREAD;
   pc_gamg->min_eq_proc      = 50;
   pc_gamg->coarse_eq_limit  = 50;
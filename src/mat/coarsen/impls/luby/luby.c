@@ -0,0 +1,501 @@
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+/* the state of a deleted vertex records the selected neighbor whose aggregate it joins, so the owners of the aggregates learn their members from the exchange of the states */
+#define LUBY_NOT_DONE          -2
+#define LUBY_REMOVED           -3
+#define LUBY_DELETED(parent)   (-4-(parent))
+#define LUBY_PARENT(s)         (-4-(s))
+#define LUBY_IS_SELECTED(s)    ((s) >= 0)
+#define LUBY_IS_DELETED(s)     ((s) <= -4)
+
+typedef struct {
+  PetscInt  seed;
+  PetscBool byprocess;
+  PetscInt  stats[3]; /* ghost exchanges, messages received and global reductions of the last apply on this process */
+} MatCoarsen_Luby;
+
+/* Random priority of a vertex, a function of its global index only, so the priorities of ghosts need no communication */
+PETSC_STATIC_INLINE PetscReal LubyPriority(PetscInt gid,PetscInt seed)
+{
+  unsigned long long x = (unsigned long long)gid + 0x9E3779B97F4A7C15ULL*(unsigned long long)(seed+1);
+
+  x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+  x =  x ^ (x >> 31);
+  return (PetscReal)(x >> 11)/9007199254740992.0;
+}
+
+/* a vertex known to a process: its own vertices, its ghosts and the neighbors of its ghosts */
+typedef struct {
+  PetscReal pprio,prio; /* the priority of the process of the vertex, or 0, and the priority of the vertex */
+  PetscInt  gid;
+} LubyVertex;
+
+typedef struct {
+  LubyVertex v;
+  PetscInt   e;
+} LubySortItem;
+
+/* does vertex 1 come before vertex 2, first by the priorities of their processes, then by their own priorities, ties are broken with the global index */
+#define LubyPrecedes(v1,v2) ((v1).pprio > (v2).pprio || ((v1).pprio == (v2).pprio && ((v1).prio > (v2).prio || ((v1).prio == (v2).prio && (v1).gid > (v2).gid))))
+
+static int LubyCompare(const void *a,const void *b)
+{
+  const LubyVertex *va = &((const LubySortItem*)a)->v,*vb = &((const LubySortItem*)b)->v;
+
+  return LubyPrecedes(*va,*vb) ? 1 : (LubyPrecedes(*vb,*va) ? -1 : 0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+   lubyIndSetAgg - parallel maximal independent set with random priorities and aggregates of its vertices. MatAIJ specific!!!
+
+   A vertex is selected once it precedes all of its neighbors that are not deleted, and it is deleted once one of its
+   neighbors is selected. This gives the greedy MIS in the order of the priorities, whatever the distribution of the
+   graph. The priorities are a hash of the global index, so ghost priorities need no communication, and the order is
+   total: ties of the priorities are broken with the global index. A process sweeps its vertices once in the order of
+   decreasing priority between two exchanges of the ghost states. A vertex only waits on the neighbors that precede
+   it, and these were visited before it in the sweep, so all the rounds of Luby's algorithm that do not cross processes
+   are done in that single sweep.
+
+   The first exchange also sends the neighbors of the vertices on the boundary of each process, with their states, so
+   each process then knows the neighbors of its ghosts, the distance-2 layer, and the later exchanges send the states
+   of both layers. Since the independent set only depends on the priorities, a ghost whose preceding neighbors are
+   known is decided in the sweep, as its owner decides it, and the vertices waiting on it go on without the next
+   exchange. These decisions are only used in the sweeps, the aggregates are built from the states sent by the owners.
+
+   A deleted vertex stores the global index of the selected neighbor it was deleted by, so the exchange of the states
+   also tells the owner of a selected vertex which ghosts join its aggregate. The count of undecided vertices is reduced
+   with a nonblocking reduction overlapped with the exchange: once it is zero the states just exchanged are final and
+   the loop ends, without an extra exchange for the strict aggregates.
+
+   With byprocess the vertices are first ordered by a random priority of their process, so that a vertex on the boundary
+   only waits on the neighbor processes that come first, like the ordering by rank of maxIndSetAgg() but without the
+   chains of processes that wait on each other in the order of the ranks.
+
+   Input Parameter:
+   . Gmat - global matrix of graph (data not defined)
+   . strict_aggs - flag for whether to keep strict (non overlapping) aggregates in 'llist';
+   . seed - seed of the priorities
+   . byprocess - order the vertices by the priorities of their processes first
+
+   Output Parameter:
+   . a_locals_llist - array of list of nodes rooted at selected nodes
+   . a_stats - number of ghost exchanges, messages received and global reductions on this process
+*/
+static PetscErrorCode lubyIndSetAgg(Mat Gmat,PetscBool strict_aggs,PetscInt seed,PetscBool byprocess,PetscCoarsenData **a_locals_llist,PetscInt a_stats[3])
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *matA,*matB=NULL;
+  Mat_MPIAIJ       *mpimat=NULL;
+  MPI_Comm         comm;
+  PetscInt         num_fine_ghosts=0,num_d2_ghosts=0,nranks=0,kk,k0,n,ix,j,jj,*idx,*ii,my0,Iend,nremoved=0,gid,lid,cpid,e,f,nDone=0,nselected=0,statej,parent,norder,t1,t2 = 0,maxdeg = 0,unit;
+  PetscInt         *cpcol_gid=NULL,*lid_cprowID,*state,*sim,*order,*adj_i = NULL,*adj_j = NULL,*adj_deg = NULL,*rows,*grows,*row,*d2_gid,*leaf_gid;
+  PetscReal        pprio = 0.0;
+  PetscMPIInt      rank,owner;
+  PetscBool        isMPI,isAIJ,isOK;
+  const PetscInt   nloc = Gmat->rmap->n;
+  PetscCoarsenData *agg_lists;
+  PetscLayout      layout;
+  PetscSF          sf = NULL;
+  MPI_Datatype     rowtype;
+  LubyVertex       *vtx;
+  LubySortItem     *items;
+#if defined(PETSC_HAVE_MPI_IALLREDUCE)
+  MPI_Request      request;
+#endif
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+
+  /* get submatrices */
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    /* force compressed storage of B */
+    ierr   = MatCheckCompressedRow(mpimat->B,matB->nonzerorowcnt,&matB->compressedrow,matB->i,Gmat->rmap->n,-1.0);CHKERRQ(ierr);
+  } else {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Require AIJ matrix.");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+  a_stats[0] = a_stats[1] = a_stats[2] = 0;
+  if (mpimat) {
+    ierr      = VecGetLocalSize(mpimat->lvec, &num_fine_ghosts);CHKERRQ(ierr);
+    cpcol_gid = mpimat->garray;
+    if (byprocess) {
+      ierr  = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+      pprio = LubyPriority(rank,seed+1);
+    }
+  }
+
+  /* the vertices are numbered locally: my vertices, then the ghosts nloc+cpid, then the distance-2 layer once it is known */
+  ierr = PetscMalloc4(nloc,&lid_cprowID,nloc+num_fine_ghosts,&order,num_fine_ghosts,&sim,nloc+num_fine_ghosts,&items);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nloc+num_fine_ghosts,&state);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nloc+num_fine_ghosts,&vtx);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    lid_cprowID[lid] = -1;
+    state[lid]       = LUBY_NOT_DONE;
+    vtx[lid].pprio   = pprio;
+    vtx[lid].prio    = LubyPriority(lid+my0,seed);
+    vtx[lid].gid     = lid+my0;
+  }
+  for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+    e            = nloc+cpid;
+    state[e]     = LUBY_NOT_DONE;
+    sim[cpid]    = LUBY_NOT_DONE;
+    vtx[e].pprio = 0.0;
+    vtx[e].prio  = LubyPriority(cpcol_gid[cpid],seed);
+    vtx[e].gid   = cpcol_gid[cpid];
+    if (byprocess) {
+      ierr = PetscLayoutFindOwner(layout,cpcol_gid[cpid],&owner);CHKERRQ(ierr);
+      vtx[e].pprio = LubyPriority(owner,seed+1);
+    }
+  }
+
+  /* has ghost nodes for !strict and uses local indexing (yuck) */
+  ierr = PetscCDCreate(strict_aggs ? nloc : num_fine_ghosts+nloc, &agg_lists);CHKERRQ(ierr);
+  if (a_locals_llist) *a_locals_llist = agg_lists;
+
+  /* set index into cmpressed row 'lid_cprowID' */
+  if (matB) {
+    for (ix=0; ix<matB->compressedrow.nrows; ix++) {
+      lid = matB->compressedrow.rindex[ix];
+      lid_cprowID[lid] = ix;
+    }
+  }
+  /* remove singletons, one local adj (me) and no ghost */
+  for (lid=0; lid<nloc; lid++) {
+    ii = matA->i; n = ii[lid+1] - ii[lid];
+    if (n < 2) {
+      ix = lid_cprowID[lid];
+      if (ix==-1 || !(matB->compressedrow.i[ix+1]-matB->compressedrow.i[ix])) {
+        state[lid] = LUBY_REMOVED;
+        nremoved++;
+        nDone++;
+      }
+    }
+  }
+  /* the sweeps visit my vertices and the ghosts in the order of LubyPrecedes(), the vertices that are done are dropped from order[] */
+  norder = nloc+num_fine_ghosts;
+  for (e=0; e<norder; e++) {
+    items[e].v = vtx[e];
+    items[e].e = e;
+  }
+  qsort(items,norder,sizeof(LubySortItem),LubyCompare);
+  for (kk=0; kk<norder; kk++) order[kk] = items[kk].e;
+
+  if (mpimat) {
+    ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,layout,num_fine_ghosts,NULL,PETSC_COPY_VALUES,cpcol_gid);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+    ierr = PetscSFGetRootRanks(sf,&nranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+    /* the rows of the first exchange hold the largest number of neighbors of a vertex on a boundary */
+    for (ix=0; ix<matB->compressedrow.nrows; ix++) {
+      lid    = matB->compressedrow.rindex[ix];
+      maxdeg = PetscMax(maxdeg,matA->i[lid+1]-matA->i[lid]+matB->compressedrow.i[ix+1]-matB->compressedrow.i[ix]);
+    }
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&maxdeg,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+    a_stats[2]++;
+  }
+  unit = 2+2*maxdeg;
+
+  while (PETSC_TRUE) {
+    /* one sweep in the order of decreasing priority */
+    for (kk=norder-1,k0=norder; kk>=0; kk--) {
+      e = order[kk];
+      if (e < nloc) {
+        if (state[e] != LUBY_NOT_DONE) continue;
+      } else {
+        if (state[e] != LUBY_NOT_DONE || sim[e-nloc] != LUBY_NOT_DONE) continue;
+        if (!adj_deg || adj_deg[e-nloc] < 0) {order[--k0] = e; continue;} /* the neighbors of the ghost are not known */
+      }
+      isOK   = PETSC_TRUE;
+      parent = -1;
+      /* the first selected neighbor in the order, or a neighbor that is not done and precedes me */
+      if (e < nloc) {
+        ii  = matA->i; n = ii[e+1] - ii[e];
+        idx = matA->j + ii[e];
+        jj  = lid_cprowID[e] == -1 ? 0 : matB->compressedrow.i[lid_cprowID[e]+1] - matB->compressedrow.i[lid_cprowID[e]];
+      } else {
+        n   = adj_deg[e-nloc];
+        idx = adj_j + adj_i[e-nloc];
+        jj  = 0;
+      }
+      for (j=0; j<n+jj; j++) {
+        f = j < n ? idx[j] : nloc + matB->j[matB->compressedrow.i[lid_cprowID[e]]+j-n];
+        if (f == e) continue;
+        statej = state[f];
+        if (statej == LUBY_NOT_DONE && f >= nloc && f < nloc+num_fine_ghosts) statej = sim[f-nloc];
+        if (LUBY_IS_SELECTED(statej)) {
+          if (parent == -1 || LubyPrecedes(vtx[f],vtx[parent])) parent = f;
+        } else if (statej == LUBY_NOT_DONE && LubyPrecedes(vtx[f],vtx[e])) isOK = PETSC_FALSE;
+      }
+      if (parent != -1) statej = LUBY_DELETED(vtx[parent].gid);
+      else if (isOK) statej = vtx[e].gid; /* SELECTED state encoded with global index */
+      else {
+        order[--k0] = e; /* keep the order of the vertices still to do at the end of order[] */
+        continue;
+      }
+      if (e < nloc) {
+        state[e] = statej;
+        if (isOK && parent == -1) nselected++;
+        nDone++;
+      } else sim[e-nloc] = statej;
+    }
+    norder -= k0;
+    ierr = PetscArraymove(order,order+k0,norder);CHKERRQ(ierr);
+    if (!mpimat) {
+      if (nDone < nloc) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%D of %D vertices not done",nloc-nDone,nloc);
+      break;
+    }
+    /* the exchange overlaps the reduction of the count of vertices not done, if it is zero these are the final states */
+    t1 = nloc - nDone;
+#if defined(PETSC_HAVE_MPI_IALLREDUCE)
+    ierr = MPI_Iallreduce(&t1,&t2,1,MPIU_INT,MPI_SUM,comm,&request);CHKERRQ(ierr);
+#else
+    ierr = MPIU_Allreduce(&t1,&t2,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+#endif
+    a_stats[2]++;
+    a_stats[0]++;
+    a_stats[1] += nranks;
+    if (adj_deg) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT,state,state+nloc);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT,state,state+nloc);CHKERRQ(ierr);
+    } else {
+      /* the first exchange sends for each vertex its state, and for a vertex on the boundary its neighbors and their states */
+      ierr = PetscMalloc2(nloc*unit,&rows,num_fine_ghosts*unit,&grows);CHKERRQ(ierr);
+      for (lid=0; lid<nloc; lid++) {
+        row    = rows + lid*unit;
+        row[0] = state[lid];
+        row[1] = -1;
+        if ((ix=lid_cprowID[lid]) == -1) continue;
+        ii  = matA->i; n = ii[lid+1] - ii[lid];
+        idx = matA->j + ii[lid];
+        for (j=0,jj=0; j<n; j++) {
+          if (idx[j] == lid) continue;
+          row[2+jj]        = idx[j]+my0;
+          row[2+maxdeg+jj] = state[idx[j]];
+          jj++;
+        }
+        ii  = matB->compressedrow.i; n = ii[ix+1] - ii[ix];
+        idx = matB->j + ii[ix];
+        for (j=0; j<n; j++,jj++) {
+          row[2+jj]        = cpcol_gid[idx[j]];
+          row[2+maxdeg+jj] = state[nloc+idx[j]];
+        }
+        row[1] = jj;
+      }
+      ierr = MPI_Type_contiguous(unit,MPIU_INT,&rowtype);CHKERRQ(ierr);
+      ierr = MPI_Type_commit(&rowtype);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sf,rowtype,rows,grows);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,rowtype,rows,grows);CHKERRQ(ierr);
+      ierr = MPI_Type_free(&rowtype);CHKERRQ(ierr);
+
+      /* the neighbors of the ghosts, a ghost of a process whose row is not sent (a nonsymmetric graph) is only decided by its owner */
+      ierr = PetscMalloc2(num_fine_ghosts+1,&adj_i,num_fine_ghosts,&adj_deg);CHKERRQ(ierr);
+      adj_i[0] = 0;
+      for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+        row              = grows + cpid*unit;
+        state[nloc+cpid] = row[0];
+        adj_deg[cpid]    = row[1];
+        adj_i[cpid+1]    = adj_i[cpid] + PetscMax(row[1],0);
+      }
+      ierr = PetscMalloc1(adj_i[num_fine_ghosts],&adj_j);CHKERRQ(ierr);
+      ierr = PetscMalloc1(adj_i[num_fine_ghosts],&d2_gid);CHKERRQ(ierr);
+      for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+        row = grows + cpid*unit;
+        for (j=0; j<adj_deg[cpid]; j++) {
+          gid = row[2+j];
+          if (gid >= my0 && gid < Iend) continue;
+          ierr = PetscFindInt(gid,num_fine_ghosts,cpcol_gid,&f);CHKERRQ(ierr);
+          if (f < 0) d2_gid[num_d2_ghosts++] = gid;
+        }
+      }
+      ierr = PetscSortRemoveDupsInt(&num_d2_ghosts,d2_gid);CHKERRQ(ierr);
+      ierr = PetscRealloc(sizeof(PetscInt)*(nloc+num_fine_ghosts+num_d2_ghosts),&state);CHKERRQ(ierr);
+      ierr = PetscRealloc(sizeof(LubyVertex)*(nloc+num_fine_ghosts+num_d2_ghosts),&vtx);CHKERRQ(ierr);
+      for (jj=0; jj<num_d2_ghosts; jj++) {
+        e            = nloc+num_fine_ghosts+jj;
+        state[e]     = LUBY_NOT_DONE;
+        vtx[e].pprio = 0.0;
+        vtx[e].prio  = LubyPriority(d2_gid[jj],seed);
+        vtx[e].gid   = d2_gid[jj];
+        if (byprocess) {
+          ierr = PetscLayoutFindOwner(layout,d2_gid[jj],&owner);CHKERRQ(ierr);
+          vtx[e].pprio = LubyPriority(owner,seed+1);
+        }
+      }
+      /* the neighbors in the local numbering, the states of the distance-2 layer known to the owners of the ghosts are kept */
+      for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+        row = grows + cpid*unit;
+        for (j=0; j<adj_deg[cpid]; j++) {
+          gid = row[2+j];
+          if (gid >= my0 && gid < Iend) f = gid-my0;
+          else {
+            ierr = PetscFindInt(gid,num_fine_ghosts,cpcol_gid,&f);CHKERRQ(ierr);
+            if (f >= 0) f += nloc;
+            else {
+              ierr = PetscFindInt(gid,num_d2_ghosts,d2_gid,&f);CHKERRQ(ierr);
+              f   += nloc+num_fine_ghosts;
+              if (row[2+maxdeg+j] != LUBY_NOT_DONE) state[f] = row[2+maxdeg+j];
+            }
+          }
+          adj_j[adj_i[cpid]+j] = f;
+        }
+      }
+      ierr = PetscFree2(rows,grows);CHKERRQ(ierr);
+
+      /* the later exchanges send the states of the ghosts and of the distance-2 layer */
+      ierr = PetscMalloc1(num_fine_ghosts+num_d2_ghosts,&leaf_gid);CHKERRQ(ierr);
+      ierr = PetscArraycpy(leaf_gid,cpcol_gid,num_fine_ghosts);CHKERRQ(ierr);
+      ierr = PetscArraycpy(leaf_gid+num_fine_ghosts,d2_gid,num_d2_ghosts);CHKERRQ(ierr);
+      ierr = PetscFree(d2_gid);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+      ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+      ierr = PetscSFSetGraphLayout(sf,layout,num_fine_ghosts+num_d2_ghosts,NULL,PETSC_COPY_VALUES,leaf_gid);CHKERRQ(ierr);
+      ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+      ierr = PetscFree(leaf_gid);CHKERRQ(ierr);
+      ierr = PetscSFGetRootRanks(sf,&nranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+    }
+#if defined(PETSC_HAVE_MPI_IALLREDUCE)
+    ierr = MPI_Wait(&request,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+#endif
+    if (!t2) break;
+  }
+  ierr = PetscInfo4(Gmat,"\t removed %D of %D vertices.  %D selected, %D ghost exchanges.\n",nremoved,nloc,nselected,a_stats[0]);CHKERRQ(ierr);
+
+  /* the aggregates, each selected vertex first in its list */
+  for (lid=0; lid<nloc; lid++) {
+    if (!LUBY_IS_SELECTED(state[lid])) continue;
+    ierr = PetscCDAppendID(agg_lists, lid, strict_aggs ? lid+my0 : lid);CHKERRQ(ierr);
+  }
+  for (lid=0; lid<nloc; lid++) {
+    if (!LUBY_IS_DELETED(state[lid])) continue;
+    parent = LUBY_PARENT(state[lid]);
+    if (parent >= my0 && parent < Iend) {
+      ierr = PetscCDAppendID(agg_lists, parent-my0, strict_aggs ? lid+my0 : lid);CHKERRQ(ierr);
+    } else if (!strict_aggs) { /* the list of the ghost */
+      ierr = PetscFindInt(parent,num_fine_ghosts,cpcol_gid,&cpid);CHKERRQ(ierr);
+      if (cpid < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Selected neighbor %D is not a ghost",parent);
+      ierr = PetscCDAppendID(agg_lists, nloc+cpid, lid);CHKERRQ(ierr);
+    }
+  }
+  /* the ghosts deleted by my vertices */
+  for (cpid=0; cpid<num_fine_ghosts; cpid++) {
+    if (!LUBY_IS_DELETED(state[nloc+cpid])) continue;
+    parent = LUBY_PARENT(state[nloc+cpid]);
+    if (parent >= my0 && parent < Iend) {
+      ierr = PetscCDAppendID(agg_lists, parent-my0, strict_aggs ? cpcol_gid[cpid] : nloc+cpid);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree2(adj_i,adj_deg);CHKERRQ(ierr);
+  ierr = PetscFree(adj_j);CHKERRQ(ierr);
+  ierr = PetscFree4(lid_cprowID,order,sim,items);CHKERRQ(ierr);
+  ierr = PetscFree(state);CHKERRQ(ierr);
+  ierr = PetscFree(vtx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenApply_Luby(MatCoarsen coarse)
+{
+  MatCoarsen_Luby *luby = (MatCoarsen_Luby*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = lubyIndSetAgg(coarse->graph,coarse->strict_aggs,luby->seed,luby->byprocess,&coarse->agg_lists,luby->stats);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenSetFromOptions_Luby(PetscOptionItems *PetscOptionsObject,MatCoarsen coarse)
+{
+  MatCoarsen_Luby *luby = (MatCoarsen_Luby*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"MatCoarsen Luby options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coarsen_luby_seed","Seed of the random priorities of the vertices","None",luby->seed,&luby->seed,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_coarsen_luby_by_process","Order the vertices by random priorities of their processes first","None",luby->byprocess,&luby->byprocess,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenView_Luby(MatCoarsen coarse,PetscViewer viewer)
+{
+  MatCoarsen_Luby *luby = (MatCoarsen_Luby*)coarse->subctx;
+  PetscErrorCode  ierr;
+  PetscInt        nmessages;
+  PetscBool       iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = MPIU_Allreduce(&luby->stats[1],&nmessages,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)coarse));CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  Luby aggregator with random priorities%s, seed %D\n",luby->byprocess ? " of the processes first" : "",luby->seed);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  ghost exchanges %D, messages %D, global reductions %D\n",luby->stats[0],nmessages,luby->stats[2]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenDestroy_Luby(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscFree(coarse->subctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENLUBY - Coarsens with a maximal independent set computed from random priorities, as in Luby's algorithm.
+
+   Options Database Keys:
++  -mat_coarsen_luby_seed <seed> - seed of the random priorities
+-  -mat_coarsen_luby_by_process <true> - order the vertices by random priorities of their processes first
+
+   Notes:
+   The priority of a vertex is a hash of its global index, and a vertex is selected when it precedes all of its neighbors
+   that are not deleted. The independent set is the greedy one in the order of the priorities. By default the vertices
+   are first ordered by a random priority of their process, so a vertex on the boundary of a process only waits on the
+   neighbor processes that come first. With -mat_coarsen_luby_by_process false the independent set does not depend on
+   the number of processes. The ordering set with MatCoarsenSetGreedyOrdering() is not used.
+
+   Each process selects all the vertices it can in one sweep between two exchanges of the ghost states, and the test for
+   completion uses a nonblocking reduction overlapped with the exchange. The first exchange also sends the neighbors of the
+   vertices on the boundary of each process, so a process decides the ghosts whose preceding neighbors it knows as their
+   owners do, and a vertex on the boundary does not wait for an exchange on each neighbor process that precedes it. The
+   number of exchanges still depends on the graph and the partition; MatCoarsenView() reports it together with the
+   messages and reductions.
+
+   Level: beginner
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_Luby(MatCoarsen coarse)
+{
+  PetscErrorCode  ierr;
+  MatCoarsen_Luby *luby;
+
+  PetscFunctionBegin;
+  ierr            = PetscNewLog(coarse,&luby);CHKERRQ(ierr);
+  luby->byprocess = PETSC_TRUE;
+  coarse->subctx  = (void*)luby;
+
+  coarse->ops->apply          = MatCoarsenApply_Luby;
+  coarse->ops->view           = MatCoarsenView_Luby;
+  coarse->ops->destroy        = MatCoarsenDestroy_Luby;
+  coarse->ops->setfromoptions = MatCoarsenSetFromOptions_Luby;
+  PetscFunctionReturn(0);
+}
@@ -20,14 +20,15 @@
    Output Parameter:
    . a_selected - IS of selected vertices, includes 'ghost' nodes at end with natural local indices
    . a_locals_llist - array of list of nodes rooted at selected nodes
+   . a_stats - optional, number of ghost exchanges, messages received and global reductions on this process
 */
-PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenData **a_locals_llist)
+PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenData **a_locals_llist,PetscInt a_stats[3])
 {
   PetscErrorCode   ierr;
   Mat_SeqAIJ       *matA,*matB=NULL;
   Mat_MPIAIJ       *mpimat=NULL;
   MPI_Comm         comm;
-  PetscInt         num_fine_ghosts,kk,n,ix,j,*idx,*ii,iter,Iend,my0,nremoved,gid,lid,cpid,lidj,sgid,t1,t2,slid,nDone,nselected=0,state,statej;
+  PetscInt         num_fine_ghosts,nranks=0,kk,n,ix,j,*idx,*ii,iter,Iend,my0,nremoved,gid,lid,cpid,lidj,sgid,t1,t2,slid,nDone,nselected=0,state,statej;
   PetscInt         *cpcol_gid,*cpcol_state,*lid_cprowID,*lid_gid,*cpcol_sel_gid,*icpcol_gid,*lid_state,*lid_parent_gid=NULL;
   PetscBool        *lid_removed;
   PetscBool        isMPI,isAIJ,isOK;
@@ -67,10 +68,12 @@ PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenD
     ierr = PetscSFSetGraphLayout(sf,layout,num_fine_ghosts,NULL,PETSC_COPY_VALUES,mpimat->garray);CHKERRQ(ierr);
     ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_gid,cpcol_gid);CHKERRQ(ierr);
     ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_gid,cpcol_gid);CHKERRQ(ierr);
+    ierr = PetscSFGetRootRanks(sf,&nranks,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
     for (kk=0;kk<num_fine_ghosts;kk++) {
       cpcol_state[kk]=MIS_NOT_DONE;
     }
   } else num_fine_ghosts = 0;
+  if (a_stats) a_stats[0] = a_stats[1] = a_stats[2] = 0;
 
   ierr = PetscMalloc1(nloc, &lid_cprowID);CHKERRQ(ierr);
   ierr = PetscMalloc1(nloc, &lid_removed);CHKERRQ(ierr); /* explicit array needed */
@@ -184,6 +187,7 @@ PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenD
       /* scatter states, check for done */
       ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_state,cpcol_state);CHKERRQ(ierr);
       ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_state,cpcol_state);CHKERRQ(ierr);
+      if (a_stats) {a_stats[0]++; a_stats[1] += nranks;}
       ii   = matB->compressedrow.i;
       for (ix=0; ix<matB->compressedrow.nrows; ix++) {
         lid   = matB->compressedrow.rindex[ix]; /* local boundary node */
@@ -213,6 +217,7 @@ PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenD
       /* all done? */
       t1   = nloc - nDone;
       ierr = MPIU_Allreduce(&t1, &t2, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr); /* synchronous version */
+      if (a_stats) a_stats[2]++;
       if (!t2) break;
     } else break; /* all done */
   } /* outer parallel MIS loop */
@@ -229,6 +234,7 @@ PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenD
     /* get proc of deleted ghost */
     ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_parent_gid,cpcol_sel_gid);CHKERRQ(ierr);
     ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_parent_gid,cpcol_sel_gid);CHKERRQ(ierr);
+    if (a_stats) {a_stats[0]++; a_stats[1] += nranks;}
     for (cpid=0; cpid<num_fine_ghosts; cpid++) {
       sgid = cpcol_sel_gid[cpid];
       gid  = icpcol_gid[cpid];
@@ -256,14 +262,14 @@ PetscErrorCode maxIndSetAgg(IS perm,Mat Gmat,PetscBool strict_aggs,PetscCoarsenD
 }
 
 typedef struct {
-  int dummy;
+  PetscInt stats[3]; /* ghost exchanges, messages received and global reductions of the last apply on this process */
 } MatCoarsen_MIS;
 /*
    MIS coarsen, simple greedy.
 */
 static PetscErrorCode MatCoarsenApply_MIS(MatCoarsen coarse)
 {
-  /* MatCoarsen_MIS *MIS = (MatCoarsen_MIS*)coarse->; */
+  MatCoarsen_MIS *MIS = (MatCoarsen_MIS*)coarse->subctx;
   PetscErrorCode ierr;
   Mat            mat = coarse->graph;
 
@@ -276,19 +282,20 @@ static PetscErrorCode MatCoarsenApply_MIS(MatCoarsen coarse)
     ierr = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
     ierr = MatGetLocalSize(mat, &m, &n);CHKERRQ(ierr);
     ierr = ISCreateStride(comm, m, 0, 1, &perm);CHKERRQ(ierr);
-    ierr = maxIndSetAgg(perm, mat, coarse->strict_aggs, &coarse->agg_lists);CHKERRQ(ierr);
+    ierr = maxIndSetAgg(perm, mat, coarse->strict_aggs, &coarse->agg_lists, MIS->stats);CHKERRQ(ierr);
     ierr = ISDestroy(&perm);CHKERRQ(ierr);
   } else {
-    ierr = maxIndSetAgg(coarse->perm, mat, coarse->strict_aggs,  &coarse->agg_lists);CHKERRQ(ierr);
+    ierr = maxIndSetAgg(coarse->perm, mat, coarse->strict_aggs, &coarse->agg_lists, MIS->stats);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
 
 PetscErrorCode MatCoarsenView_MIS(MatCoarsen coarse,PetscViewer viewer)
 {
-  /* MatCoarsen_MIS *MIS = (MatCoarsen_MIS*)coarse->; */
+  MatCoarsen_MIS *MIS = (MatCoarsen_MIS*)coarse->subctx;
   PetscErrorCode ierr;
   PetscMPIInt    rank;
+  PetscInt       stats[3];
   PetscBool      iascii;
 
   PetscFunctionBegin;
@@ -300,6 +307,8 @@ PetscErrorCode MatCoarsenView_MIS(MatCoarsen coarse,PetscViewer viewer)
     ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] MIS aggregator\n",rank);CHKERRQ(ierr);
     ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(MIS->stats,stats,3,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)coarse));CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  ghost exchanges %D, messages %D, global reductions %D\n",MIS->stats[0],stats[1],MIS->stats[2]);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
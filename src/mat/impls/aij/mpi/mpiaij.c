@@ -873,6 +873,8 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
     ierr = MatSetUpMultiply_MPIAIJ(mat);CHKERRQ(ierr);
   }
   ierr = MatSetOption(aij->B,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);
+  /* MatDisAssemble_MPIAIJ() and MatMPIAIJSetPreallocation() create a new B */
+  if (aij->singleprecision) {ierr = MatAIJSetSinglePrecision(aij->B,PETSC_TRUE);CHKERRQ(ierr);}
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (mat->offloadmask == PETSC_OFFLOAD_CPU && aij->B->offloadmask != PETSC_OFFLOAD_UNALLOCATED) aij->B->offloadmask = PETSC_OFFLOAD_CPU;
 #endif
@@ -1278,6 +1280,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  ierr = MatMultPowersDestroy_MPIAIJ(&aij->multpowers);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)mat,0);CHKERRQ(ierr);
@@ -1285,9 +1289,13 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatRetrieveValues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatAIJSetSinglePrecision_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMultPowers_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpibaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_ELEMENTAL)
@@ -2747,6 +2755,19 @@ PetscErrorCode  MatStoreValues_MPIAIJ(Mat mat)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatAIJSetSinglePrecision_MPIAIJ(Mat mat,PetscBool flg)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!aij->A) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatXXXSetPreallocation() or MatSetUp() first");
+  aij->singleprecision = flg;
+  ierr = MatAIJSetSinglePrecision(aij->A,flg);CHKERRQ(ierr);
+  ierr = MatAIJSetSinglePrecision(aij->B,flg);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  MatRetrieveValues_MPIAIJ(Mat mat)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -2857,6 +2878,8 @@ PetscErrorCode MatDuplicate_MPIAIJ(Mat matin,MatDuplicateOption cpvalues,Mat *ne
   a->rowindices   = NULL;
   a->rowvalues    = NULL;
   a->getrowactive = PETSC_FALSE;
+  /* the diagonal and off-diagonal blocks keep their single precision kernels through MatDuplicate() */
+  a->singleprecision = oldmat->singleprecision;
 
   ierr = PetscLayoutReference(matin->rmap,&mat->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutReference(matin->cmap,&mat->cmap);CHKERRQ(ierr);
@@ -3815,6 +3838,234 @@ PetscErrorCode MatMPIAIJSetPreallocationCSR_MPIAIJ(Mat B,const PetscInt Ii[],con
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree(mpiaij->coo_recvbuf);CHKERRQ(ierr);
+  ierr = PetscFree4(mpiaij->Ajmap1,mpiaij->Aperm1,mpiaij->Ajmap2,mpiaij->Aperm2);CHKERRQ(ierr);
+  ierr = PetscFree4(mpiaij->Bjmap1,mpiaij->Bperm1,mpiaij->Bjmap2,mpiaij->Bperm2);CHKERRQ(ierr);
+  mpiaij->coo_n     = 0;
+  mpiaij->coo_nrecv = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Entries in rows owned by other processes are shipped to their owners once, through a PetscSF whose leaves are those
+   entries in the user's array and whose roots are slots in the receive buffer of the owner. The slots are handed out
+   with a fetch-and-add on a per-process counter. MatSetValuesCOO_MPIAIJ() reuses the same PetscSF to move the values.
+
+   The owned entries (local and received) are then sorted by (row,col), the unique nonzeros define the CSR structure and
+   each of them is mapped to the entries that contribute to it, separately for the diagonal and off-diagonal blocks and
+   for the local and received entries. Since both blocks keep the columns of a row sorted, including B after its
+   columns are compacted by MatSetUpMultiply_MPIAIJ(), the k-th diagonal (off-diagonal) nonzero found here is A->a[k]
+   (B->a[k]).
+*/
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  MPI_Comm       comm;
+  PetscMPIInt    size,owner;
+  PetscSF        sf1;
+  PetscSFNode    *iremote,*iremote1;
+  PetscInt       M,N,m,rstart,rend,cstart,cend,i,k,q,r,ntot,nlocal = 0,nremote = 0,nrecv = 0,nranks = 0,nz,lastcol;
+  PetscInt       *ilocal,*owners,*sendcnt,*rankoffset,*counts,*offsets,*recv_i,*recv_j;
+  PetscInt       *rowstart,*cols,*src,*Ii,*J,*jmap;
+  PetscInt       Annz = 0,Bnnz = 0,Atot1 = 0,Atot2 = 0,Btot1 = 0,Btot2 = 0,a,b,a1,a2,b1,b2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  ierr   = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr   = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr   = MatGetSize(mat,&M,&N);CHKERRQ(ierr);
+  m      = mat->rmap->n;
+  rstart = mat->rmap->rstart;
+  rend   = mat->rmap->rend;
+  cstart = mat->cmap->rstart;
+  cend   = mat->cmap->rend;
+
+  /* find the owner of each off-process entry; entries with negative indices are ignored as in MatSetValues() */
+  ierr = PetscMalloc2(ncoo,&ilocal,ncoo,&owners);CHKERRQ(ierr);
+  ierr = PetscCalloc2(size,&sendcnt,size,&rankoffset);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= M) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has row %D, max %D",k,coo_i[k],M-1);
+    if (coo_j[k] >= N) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has column %D, max %D",k,coo_j[k],N-1);
+    if (coo_i[k] >= rstart && coo_i[k] < rend) {nlocal++; continue;}
+    ierr = PetscLayoutFindOwner(mat->rmap,coo_i[k],&owner);CHKERRQ(ierr);
+    if (!sendcnt[owner]++) nranks++;
+    ilocal[nremote]   = k;
+    owners[nremote++] = owner;
+  }
+
+  /* reserve contiguous slots on each owner with a fetch-and-add on its counter of received entries */
+  ierr = PetscMalloc3(nranks,&iremote1,nranks,&counts,nranks,&offsets);CHKERRQ(ierr);
+  for (owner=0,r=0; owner<size; owner++) {
+    if (!sendcnt[owner]) continue;
+    iremote1[r].rank  = owner;
+    iremote1[r].index = 0;
+    counts[r++]       = sendcnt[owner];
+  }
+  ierr = PetscSFCreate(comm,&sf1);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf1,1,nranks,NULL,PETSC_USE_POINTER,iremote1,PETSC_USE_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf1);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpBegin(sf1,MPIU_INT,&nrecv,counts,offsets,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpEnd(sf1,MPIU_INT,&nrecv,counts,offsets,MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf1);CHKERRQ(ierr);
+  for (r=0; r<nranks; r++) rankoffset[iremote1[r].rank] = offsets[r];
+  ierr = PetscFree3(iremote1,counts,offsets);CHKERRQ(ierr);
+
+  ierr = PetscMalloc1(nremote,&iremote);CHKERRQ(ierr);
+  for (k=0; k<nremote; k++) {
+    iremote[k].rank  = owners[k];
+    iremote[k].index = rankoffset[owners[k]]++;
+  }
+  ierr = PetscFree2(sendcnt,rankoffset);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(mpiaij->coo_sf,nrecv,nremote,ilocal,PETSC_COPY_VALUES,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree2(ilocal,owners);CHKERRQ(ierr);
+
+  ierr = PetscMalloc2(nrecv,&recv_i,nrecv,&recv_j);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(mpiaij->coo_sf,MPIU_INT,coo_i,recv_i,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(mpiaij->coo_sf,MPIU_INT,coo_i,recv_i,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(mpiaij->coo_sf,MPIU_INT,coo_j,recv_j,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(mpiaij->coo_sf,MPIU_INT,coo_j,recv_j,MPIU_REPLACE);CHKERRQ(ierr);
+
+  /* bucket the owned entries by row; src[] < ncoo refers to the user's array, src[] - ncoo to the receive buffer */
+  ntot = nlocal + nrecv;
+  ierr = PetscCalloc1(m+1,&rowstart);CHKERRQ(ierr);
+  ierr = PetscMalloc2(ntot,&cols,ntot,&src);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < rstart || coo_i[k] >= rend || coo_j[k] < 0) continue;
+    rowstart[coo_i[k]-rstart+1]++;
+  }
+  for (k=0; k<nrecv; k++) rowstart[recv_i[k]-rstart+1]++;
+  for (i=0; i<m; i++) rowstart[i+1] += rowstart[i];
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < rstart || coo_i[k] >= rend || coo_j[k] < 0) continue;
+    q       = rowstart[coo_i[k]-rstart]++;
+    cols[q] = coo_j[k];
+    src[q]  = k;
+  }
+  for (k=0; k<nrecv; k++) {
+    q       = rowstart[recv_i[k]-rstart]++;
+    cols[q] = recv_j[k];
+    src[q]  = ncoo + k;
+  }
+  for (i=m; i>0; i--) rowstart[i] = rowstart[i-1];
+  rowstart[0] = 0;
+  ierr = PetscFree2(recv_i,recv_j);CHKERRQ(ierr);
+
+  /* sort each row, collect the unique columns and count the entries landing in each block */
+  ierr  = PetscMalloc3(m+1,&Ii,ntot,&J,ntot+1,&jmap);CHKERRQ(ierr);
+  Ii[0] = 0;
+  nz    = 0;
+  for (i=0; i<m; i++) {
+    ierr    = PetscSortIntWithArray(rowstart[i+1]-rowstart[i],cols+rowstart[i],src+rowstart[i]);CHKERRQ(ierr);
+    lastcol = -1;
+    for (q=rowstart[i]; q<rowstart[i+1]; q++) {
+      PetscBool diag = (PetscBool)(cols[q] >= cstart && cols[q] < cend);
+      if (cols[q] != lastcol) {
+        lastcol  = cols[q];
+        J[nz]    = lastcol;
+        jmap[nz] = q;
+        nz++;
+        if (diag) Annz++;
+        else      Bnnz++;
+      }
+      if (src[q] < ncoo) {if (diag) Atot1++; else Btot1++;}
+      else               {if (diag) Atot2++; else Btot2++;}
+    }
+    Ii[i+1] = nz;
+  }
+  jmap[nz] = ntot;
+  ierr = PetscFree(rowstart);CHKERRQ(ierr);
+
+  ierr = MatMPIAIJSetPreallocationCSR(mat,Ii,J,NULL);CHKERRQ(ierr);
+
+  ierr = PetscMalloc4(Annz+1,&mpiaij->Ajmap1,Atot1,&mpiaij->Aperm1,Annz+1,&mpiaij->Ajmap2,Atot2,&mpiaij->Aperm2);CHKERRQ(ierr);
+  ierr = PetscMalloc4(Bnnz+1,&mpiaij->Bjmap1,Btot1,&mpiaij->Bperm1,Bnnz+1,&mpiaij->Bjmap2,Btot2,&mpiaij->Bperm2);CHKERRQ(ierr);
+  mpiaij->Ajmap1[0] = mpiaij->Ajmap2[0] = mpiaij->Bjmap1[0] = mpiaij->Bjmap2[0] = 0;
+  a = b = a1 = a2 = b1 = b2 = 0;
+  for (k=0; k<nz; k++) {
+    if (J[k] >= cstart && J[k] < cend) {
+      for (q=jmap[k]; q<jmap[k+1]; q++) {
+        if (src[q] < ncoo) mpiaij->Aperm1[a1++] = src[q];
+        else               mpiaij->Aperm2[a2++] = src[q] - ncoo;
+      }
+      mpiaij->Ajmap1[++a] = a1;
+      mpiaij->Ajmap2[a]   = a2;
+    } else {
+      for (q=jmap[k]; q<jmap[k+1]; q++) {
+        if (src[q] < ncoo) mpiaij->Bperm1[b1++] = src[q];
+        else               mpiaij->Bperm2[b2++] = src[q] - ncoo;
+      }
+      mpiaij->Bjmap1[++b] = b1;
+      mpiaij->Bjmap2[b]   = b2;
+    }
+  }
+  ierr = PetscFree3(Ii,J,jmap);CHKERRQ(ierr);
+  ierr = PetscFree2(cols,src);CHKERRQ(ierr);
+
+  ierr = PetscMalloc1(nrecv,&mpiaij->coo_recvbuf);CHKERRQ(ierr);
+  mpiaij->coo_n     = ncoo;
+  mpiaij->coo_nrecv = nrecv;
+  PetscFunctionReturn(0);
+}
+
+/* a[k] = a[k] + sum of v[perm[jmap[k]:jmap[k+1]]], where a[k] is first zeroed if insert is true */
+PETSC_STATIC_INLINE void MatSetValuesCOO_MPIAIJ_Private(PetscInt nz,const PetscInt jmap[],const PetscInt perm[],const PetscScalar v[],PetscBool insert,PetscScalar a[])
+{
+  PetscInt    i,k;
+  PetscScalar sum;
+
+  for (i=0; i<nz; i++) {
+    sum = 0.0;
+    for (k=jmap[i]; k<jmap[i+1]; k++) sum += v[perm[k]];
+    a[i] = (insert ? 0.0 : a[i]) + sum;
+  }
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  Mat            A = mpiaij->A,B = mpiaij->B;
+  PetscInt       Annz,Bnnz;
+  PetscScalar    *Aa,*Ba,*zeros = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mpiaij->coo_sf) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (!v) {
+    ierr = PetscCalloc1(mpiaij->coo_n,&zeros);CHKERRQ(ierr);
+    v    = zeros;
+  }
+  Annz = ((Mat_SeqAIJ*)A->data)->i[A->rmap->n];
+  Bnnz = ((Mat_SeqAIJ*)B->data)->i[B->rmap->n];
+
+  /* the local entries are summed while the off-process ones are in flight */
+  ierr = PetscSFReduceBegin(mpiaij->coo_sf,MPIU_SCALAR,v,mpiaij->coo_recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(B,&Ba);CHKERRQ(ierr);
+  MatSetValuesCOO_MPIAIJ_Private(Annz,mpiaij->Ajmap1,mpiaij->Aperm1,v,(PetscBool)(imode == INSERT_VALUES),Aa);
+  MatSetValuesCOO_MPIAIJ_Private(Bnnz,mpiaij->Bjmap1,mpiaij->Bperm1,v,(PetscBool)(imode == INSERT_VALUES),Ba);
+  ierr = PetscSFReduceEnd(mpiaij->coo_sf,MPIU_SCALAR,v,mpiaij->coo_recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+  MatSetValuesCOO_MPIAIJ_Private(Annz,mpiaij->Ajmap2,mpiaij->Aperm2,mpiaij->coo_recvbuf,PETSC_FALSE,Aa);
+  MatSetValuesCOO_MPIAIJ_Private(Bnnz,mpiaij->Bjmap2,mpiaij->Bperm2,mpiaij->coo_recvbuf,PETSC_FALSE,Ba);
+  ierr = MatSeqAIJRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArray(B,&Ba);CHKERRQ(ierr);
+  ierr = PetscLogFlops(1.0*(mpiaij->Ajmap1[Annz]+mpiaij->Ajmap2[Annz]+mpiaij->Bjmap1[Bnnz]+mpiaij->Bjmap2[Bnnz]));CHKERRQ(ierr);
+  ierr = PetscFree(zeros);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMPIAIJSetPreallocationCSR - Allocates memory for a sparse parallel matrix in AIJ format
    (the default parallel PETSc format).
@@ -5462,6 +5713,26 @@ PetscErrorCode MatGetBrowsOfAcols(Mat A,Mat B,MatReuse scall,IS *rowb,IS *colb,M
   PetscFunctionReturn(0);
 }
 
+/* Attached to B_oth by MatGetBrowsOfAoCols_MPIAIJ() so that MAT_REUSE_MATRIX only moves the values */
+typedef struct {
+  PetscSF          sf;           /* from the packed rows of B sent to other processes (roots) to the entries of B_oth (leaves) */
+  PetscInt         *rootidx;     /* entry of the diagonal (< nzd) or off-diagonal (>= nzd) block of B packed in each root */
+  PetscInt         nzd;          /* number of nonzeros of the diagonal block of B */
+  PetscObjectState nonzerostate; /* of B when the SF was built */
+} Mat_BrowsOfAoCols;
+
+static PetscErrorCode MatBrowsOfAoColsDestroy_Private(void *ptr)
+{
+  Mat_BrowsOfAoCols *gb = (Mat_BrowsOfAoCols*)ptr;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&gb->sf);CHKERRQ(ierr);
+  ierr = PetscFree(gb->rootidx);CHKERRQ(ierr);
+  ierr = PetscFree(gb);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     MatGetBrowsOfAoCols_MPIAIJ - Creates a SeqAIJ matrix by taking rows of B that equal to nonzero columns
     of the OFF-DIAGONAL portion of local A
@@ -5481,21 +5752,27 @@ PetscErrorCode MatGetBrowsOfAcols(Mat A,Mat B,MatReuse scall,IS *rowb,IS *colb,M
     Developer Notes: This directly accesses information inside the VecScatter associated with the matrix-vector product
      for this matrix. This is not desirable..
 
+     The communication of the values is set up once, as a PetscSF attached to B_oth, so that with MAT_REUSE_MATRIX
+     the nonzero pattern of B must not have changed and only the values are packed and moved, with persistent requests.
+
     Level: developer
 
 */
 PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A,Mat B,MatReuse scall,PetscInt **startsj_s,PetscInt **startsj_r,MatScalar **bufa_ptr,Mat *B_oth)
 {
   PetscErrorCode         ierr;
-  Mat_MPIAIJ             *a=(Mat_MPIAIJ*)A->data;
-  Mat_SeqAIJ             *b_oth;
+  Mat_MPIAIJ             *a=(Mat_MPIAIJ*)A->data,*b=(Mat_MPIAIJ*)B->data;
+  Mat_SeqAIJ             *b_oth,*bd,*bo;
+  Mat_BrowsOfAoCols      *gb = NULL;
+  PetscContainer         container;
+  PetscSFNode            *iremote;
   VecScatter             ctx;
   MPI_Comm               comm;
   const PetscMPIInt      *rprocs,*sprocs;
   const PetscInt         *srow,*rstarts,*sstarts;
   PetscInt               *rowlen,*bufj,*bufJ,ncols = 0,aBn=a->B->cmap->n,row,*b_othi,*b_othj,*rvalues=NULL,*svalues=NULL,*cols,sbs,rbs;
-  PetscInt               i,j,k=0,l,ll,nrecvs,nsends,nrows,*rstartsj = 0,*sstartsj,len;
-  PetscScalar            *b_otha,*bufa,*bufA,*vals = NULL;
+  PetscInt               i,j,k=0,l,ll,nrecvs,nsends,nrows,*rstartsj = 0,*sstartsj,len,*rootidx,*roffsets,imark,nzA,nzB,lrow;
+  PetscScalar            *b_otha,*bufa,*bufA;
   MPI_Request            *rwaits = NULL,*swaits = NULL;
   MPI_Status             rstatus;
   PetscMPIInt            jj,size,tag,rank,nsends_mpi,nrecvs_mpi;
@@ -5611,7 +5888,13 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A,Mat B,MatReuse scall,PetscInt **
       ierr  = MPI_Irecv(b_othj+rstartsj[i],nrows,MPIU_INT,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
     }
 
-    /* pack the outgoing message j-array */
+    /* pack the outgoing message j-array, and the location in B of each entry for packing the a-array */
+    ierr = PetscNew(&gb);CHKERRQ(ierr);
+    ierr = PetscMalloc1(sstartsj[nsends]+1,&gb->rootidx);CHKERRQ(ierr);
+    bd          = (Mat_SeqAIJ*)b->A->data;
+    bo          = (Mat_SeqAIJ*)b->B->data;
+    gb->nzd     = bd->i[B->rmap->n];
+    rootidx     = gb->rootidx;
     if (nsends) k = sstarts[0];
     for (i=0; i<nsends; i++) {
       nrows = sstarts[i+1]-sstarts[i]; /* num of block rows */
@@ -5624,6 +5907,13 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A,Mat B,MatReuse scall,PetscInt **
             *bufJ++ = cols[l];
           }
           ierr = MatRestoreRow_MPIAIJ(B,row+ll,&ncols,&cols,NULL);CHKERRQ(ierr);
+          /* same order as MatGetRow_MPIAIJ(): off-diagonal columns left of the diagonal block, the diagonal block, the others */
+          lrow = row + ll - B->rmap->rstart;
+          nzA  = bd->i[lrow+1] - bd->i[lrow];
+          nzB  = bo->i[lrow+1] - bo->i[lrow];
+          for (imark=0; imark<nzB && b->garray[bo->j[bo->i[lrow]+imark]] < B->cmap->rstart; imark++) *rootidx++ = gb->nzd + bo->i[lrow] + imark;
+          for (l=0; l<nzA; l++)     *rootidx++ = bd->i[lrow] + l;
+          for (l=imark; l<nzB; l++) *rootidx++ = gb->nzd + bo->i[lrow] + l;
         }
       }
       ierr = MPI_Isend(bufj+sstartsj[i],sstartsj[i+1]-sstartsj[i],MPIU_INT,sprocs[i],tag,comm,swaits+i);CHKERRQ(ierr);
@@ -5635,45 +5925,52 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A,Mat B,MatReuse scall,PetscInt **
       ierr = MPI_Waitany(nrecvs_mpi,rwaits,&jj,&rstatus);CHKERRQ(ierr);
     }
     if (nsends) {ierr = MPI_Waitall(nsends_mpi,swaits,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+
+    /* offset of each incoming message in the packed rows of the sender */
+    ierr = PetscMalloc1(nrecvs+1,&roffsets);CHKERRQ(ierr);
+    for (i=0; i<nrecvs; i++) {
+      ierr = MPI_Irecv(roffsets+i,1,MPIU_INT,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
+    }
+    for (i=0; i<nsends; i++) {
+      ierr = MPI_Isend(sstartsj+i,1,MPIU_INT,sprocs[i],tag,comm,swaits+i);CHKERRQ(ierr);
+    }
+    if (nrecvs) {ierr = MPI_Waitall(nrecvs_mpi,rwaits,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+    if (nsends) {ierr = MPI_Waitall(nsends_mpi,swaits,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+
+    ierr = PetscMalloc1(rstartsj[nrecvs],&iremote);CHKERRQ(ierr);
+    for (i=0; i<nrecvs; i++) {
+      for (j=rstartsj[i]; j<rstartsj[i+1]; j++) {
+        iremote[j].rank  = rprocs[i];
+        iremote[j].index = roffsets[i] + j - rstartsj[i];
+      }
+    }
+    ierr = PetscFree(roffsets);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm,&gb->sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(gb->sf,sstartsj[nsends],rstartsj[nrecvs],NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(gb->sf);CHKERRQ(ierr);
+    gb->nonzerostate = B->nonzerostate;
   } else if (scall == MAT_REUSE_MATRIX) {
     sstartsj = *startsj_s;
     rstartsj = *startsj_r;
     bufa     = *bufa_ptr;
     b_oth    = (Mat_SeqAIJ*)(*B_oth)->data;
     b_otha   = b_oth->a;
+    ierr     = PetscObjectQuery((PetscObject)*B_oth,"MatGetBrowsOfAoCols",(PetscObject*)&container);CHKERRQ(ierr);
+    if (!container) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"B_oth was not created by MatGetBrowsOfAoCols_MPIAIJ()");
+    ierr     = PetscContainerGetPointer(container,(void**)&gb);CHKERRQ(ierr);
+    if (gb->nonzerostate != B->nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Cannot reuse B_oth, the nonzero pattern of B has changed");
   } else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE, "Matrix P does not posses an object container");
 
   /* a-array */
   /*---------*/
-  /*  post receives of a-array */
-  for (i=0; i<nrecvs; i++) {
-    nrows = rstartsj[i+1]-rstartsj[i]; /* length of the msg received */
-    ierr  = MPI_Irecv(b_otha+rstartsj[i],nrows,MPIU_SCALAR,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
-  }
-
-  /* pack the outgoing message a-array */
-  if (nsends) k = sstarts[0];
-  for (i=0; i<nsends; i++) {
-    nrows = sstarts[i+1]-sstarts[i]; /* num of block rows */
-    bufA  = bufa+sstartsj[i];
-    for (j=0; j<nrows; j++) {
-      row = srow[k++] + B->rmap->range[rank];  /* global row idx */
-      for (ll=0; ll<sbs; ll++) {
-        ierr = MatGetRow_MPIAIJ(B,row+ll,&ncols,NULL,&vals);CHKERRQ(ierr);
-        for (l=0; l<ncols; l++) {
-          *bufA++ = vals[l];
-        }
-        ierr = MatRestoreRow_MPIAIJ(B,row+ll,&ncols,NULL,&vals);CHKERRQ(ierr);
-      }
-    }
-    ierr = MPI_Isend(bufa+sstartsj[i],sstartsj[i+1]-sstartsj[i],MPIU_SCALAR,sprocs[i],tag,comm,swaits+i);CHKERRQ(ierr);
-  }
-  /* recvs and sends of a-array are completed */
-  i = nrecvs;
-  while (i--) {
-    ierr = MPI_Waitany(nrecvs_mpi,rwaits,&jj,&rstatus);CHKERRQ(ierr);
-  }
-  if (nsends) {ierr = MPI_Waitall(nsends_mpi,swaits,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  /* pack the outgoing message a-array, then a single (persistent) exchange of the values */
+  bd      = (Mat_SeqAIJ*)b->A->data;
+  bo      = (Mat_SeqAIJ*)b->B->data;
+  rootidx = gb->rootidx;
+  bufA    = bufa;
+  for (k=0; k<sstartsj[nsends]; k++) bufA[k] = rootidx[k] < gb->nzd ? bd->a[rootidx[k]] : bo->a[rootidx[k]-gb->nzd];
+  ierr = PetscSFBcastBegin(gb->sf,MPIU_SCALAR,bufa,b_otha);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(gb->sf,MPIU_SCALAR,bufa,b_otha);CHKERRQ(ierr);
   ierr = PetscFree2(rwaits,swaits);CHKERRQ(ierr);
 
   if (scall == MAT_INITIAL_MATRIX) {
@@ -5687,10 +5984,16 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A,Mat B,MatReuse scall,PetscInt **
     b_oth->free_ij = PETSC_TRUE;
     b_oth->nonew   = 0;
 
+    ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container,gb);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container,MatBrowsOfAoColsDestroy_Private);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)*B_oth,"MatGetBrowsOfAoCols",(PetscObject)container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+
     ierr = PetscFree(bufj);CHKERRQ(ierr);
     if (!startsj_s || !bufa_ptr) {
       ierr = PetscFree2(sstartsj,rstartsj);CHKERRQ(ierr);
-      ierr = PetscFree(bufa_ptr);CHKERRQ(ierr);
+      ierr = PetscFree(bufa);CHKERRQ(ierr);
     } else {
       *startsj_s = sstartsj;
       *startsj_r = rstartsj;
@@ -5891,9 +6194,13 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatAIJSetSinglePrecision_C",MatAIJSetSinglePrecision_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMultPowers_C",MatMultPowers_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijsell_C",MatConvert_MPIAIJ_MPIAIJSELL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
@@ -39,6 +39,19 @@ typedef struct { /* used by MatPtAPXXX_MPIAIJ_MPIAIJ() and MatMatMultXXX_MPIAIJ_
   PetscErrorCode (*view)(Mat,PetscViewer);
 } Mat_APMPI;
 
+typedef struct { /* used by MatMultPowers_MPIAIJ() */
+  PetscInt         k;                  /* depth of the ghost region */
+  PetscObjectState state,nonzerostate; /* of the matrix when sub was extracted */
+  IS               rows,cols;          /* rows S_{k-1} and columns S_k of the ghost region, in global numbering */
+  Mat              *sub;               /* rows S_{k-1} and columns S_k of the matrix */
+  Vec              xk;                 /* the input vector on S_k */
+  VecScatter       scatter;            /* gathers xk from the input vector */
+  PetscInt         *nrows;             /* nrows[i] is the size of S_i, for i < k */
+  PetscInt         *perm;              /* rows of sub by level: first the rows of S_0, then those of S_1 \ S_0, ... */
+  PetscInt         *rowpos;            /* position of the rows of sub in S_k */
+  PetscScalar      *work;              /* two work arrays of length |S_k| */
+} Mat_MultPowers;
+
 typedef struct {
   Mat A,B;                             /* local submatrices: A (diag part),
                                            B (off-diag part) */
@@ -77,10 +90,22 @@ typedef struct {
   Mat_APMPI         *ap;              /* used by MatMatMult() and MatPtAP() */
   Mat_RARt          *rart;            /* used by MatRARt() */
   Mat_MatMatMatMult *matmatmatmult;   /* used by MatMatMatMult() */
+  Mat_MultPowers    *multpowers;      /* used by MatMultPowers() */
+
+  PetscBool singleprecision;       /* MatAIJSetSinglePrecision() was called, reapplied to B when it is recreated */
 
   /* Used by MPICUSP and MPICUSPARSE classes */
   void * spptr;
 
+  /* Used by MatSetPreallocationCOO() and MatSetValuesCOO() */
+  PetscSF     coo_sf;                  /* sends the values of off-process COO entries to their owners */
+  PetscInt    coo_n;                   /* number of entries passed to MatSetPreallocationCOO() */
+  PetscInt    coo_nrecv;               /* number of COO entries received from other processes */
+  PetscScalar *coo_recvbuf;            /* values of the received entries */
+  PetscInt    *Ajmap1,*Aperm1;         /* nonzero k of the diag part gets the local entries v[Aperm1[Ajmap1[k]:Ajmap1[k+1]]] */
+  PetscInt    *Ajmap2,*Aperm2;         /* ... and the received entries coo_recvbuf[Aperm2[Ajmap2[k]:Ajmap2[k+1]]] */
+  PetscInt    *Bjmap1,*Bperm1;         /* same for the off-diag part */
+  PetscInt    *Bjmap2,*Bperm2;
 } Mat_MPIAIJ;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
@@ -90,8 +115,13 @@ PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat,MatDuplicateOption,Mat*);
+PETSC_INTERN PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat,PetscInt,IS [],PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat,PetscInt,IS [],PetscInt);
+PETSC_INTERN PetscErrorCode MatMultPowers_MPIAIJ(Mat,PetscInt,Vec,Vec[]);
+PETSC_INTERN PetscErrorCode MatMultPowersDestroy_MPIAIJ(Mat_MultPowers**);
 PETSC_INTERN PetscErrorCode MatFDColoringCreate_MPIXAIJ(Mat,ISColoring,MatFDColoring);
 PETSC_INTERN PetscErrorCode MatFDColoringSetUp_MPIXAIJ(Mat,ISColoring,MatFDColoring);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrices_MPIAIJ (Mat,PetscInt,const IS[],const IS[],MatReuse,Mat *[]);
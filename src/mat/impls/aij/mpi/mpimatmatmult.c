@@ -2378,11 +2378,11 @@ static PetscErrorCode MatProductSetFromOptions_MPIAIJ_PtAP(Mat C)
   PetscBool      flg;
   PetscInt       alg=1; /* set default algorithm */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[4] = {"scalable","nonscalable","allatonce","allatonce_merged"};
-  PetscInt       nalg=4;
-#else
-  const char     *algTypes[5] = {"scalable","nonscalable","allatonce","allatonce_merged","hypre"};
+  const char     *algTypes[5] = {"scalable","nonscalable","allatonce","allatonce_merged","hash"};
   PetscInt       nalg=5;
+#else
+  const char     *algTypes[6] = {"scalable","nonscalable","allatonce","allatonce_merged","hash","hypre"};
+  PetscInt       nalg=6;
 #endif
   PetscInt       pN=P->cmap->N;
 
@@ -0,0 +1,161 @@
+/*
+  Defines the matrix powers kernel for MPIAIJ matrices
+          Y[j] = A^(j+1) x, j = 0,...,k-1
+
+  Let S_0 be the local rows and S_{i+1} be S_i plus the columns of the rows in S_i, as computed by MatIncreaseOverlap().
+  Each process gets the rows S_{k-1} of A restricted to the columns S_k, and x on S_k with a single scatter. Then
+  A^j x is computed locally on S_{k-j} for j = 1,...,k, at the price of redundant work on the ghost rows.
+*/
+#include <../src/mat/impls/aij/mpi/mpiaij.h> /*I "petscmat.h" I*/
+
+PetscErrorCode MatMultPowersDestroy_MPIAIJ(Mat_MultPowers **mp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*mp) PetscFunctionReturn(0);
+  ierr = ISDestroy(&(*mp)->rows);CHKERRQ(ierr);
+  ierr = ISDestroy(&(*mp)->cols);CHKERRQ(ierr);
+  if ((*mp)->sub) {ierr = MatDestroySubMatrices(1,&(*mp)->sub);CHKERRQ(ierr);}
+  ierr = VecDestroy(&(*mp)->xk);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&(*mp)->scatter);CHKERRQ(ierr);
+  ierr = PetscFree4((*mp)->nrows,(*mp)->perm,(*mp)->rowpos,(*mp)->work);CHKERRQ(ierr);
+  ierr = PetscFree(*mp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Builds the ghost region of depth k and the ordering of its rows by distance to the local rows */
+static PetscErrorCode MatMultPowersSetUp_MPIAIJ(Mat A,PetscInt k,Vec x,Mat_MultPowers **mpout)
+{
+  PetscErrorCode  ierr;
+  Mat_MultPowers  *mp;
+  IS              *levels;
+  const PetscInt  *rows,*cols,*idx;
+  PetscInt        i,j,p,nr,nc,n,*lev,*cnt;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&mp);CHKERRQ(ierr);
+  mp->k = k;
+
+  /* levels[i] = S_i, sorted */
+  ierr = PetscMalloc1(k+1,&levels);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,A->rmap->n,A->rmap->rstart,1,&levels[0]);CHKERRQ(ierr);
+  for (i=1; i<=k; i++) {
+    ierr = ISDuplicate(levels[i-1],&levels[i]);CHKERRQ(ierr);
+    ierr = MatIncreaseOverlap(A,1,&levels[i],1);CHKERRQ(ierr);
+    ierr = ISSort(levels[i]);CHKERRQ(ierr);
+  }
+  mp->rows = levels[k-1];
+  mp->cols = levels[k];
+  ierr = ISGetLocalSize(mp->rows,&nr);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(mp->cols,&nc);CHKERRQ(ierr);
+  ierr = ISGetIndices(mp->rows,&rows);CHKERRQ(ierr);
+  ierr = ISGetIndices(mp->cols,&cols);CHKERRQ(ierr);
+  ierr = PetscMalloc4(k,&mp->nrows,nr,&mp->perm,nr,&mp->rowpos,2*nc,&mp->work);CHKERRQ(ierr);
+
+  /* The level of a row of S_{k-1} is the smallest i such that it is in S_i. All sets are sorted, so merge them. */
+  ierr = PetscMalloc2(nr,&lev,k,&cnt);CHKERRQ(ierr);
+  for (p=0; p<nr; p++) lev[p] = k-1;
+  for (i=k-2; i>=0; i--) {
+    ierr = ISGetLocalSize(levels[i],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(levels[i],&idx);CHKERRQ(ierr);
+    for (j=0,p=0; j<n; j++) {
+      while (rows[p] < idx[j]) p++;
+      lev[p] = i;
+    }
+    ierr = ISRestoreIndices(levels[i],&idx);CHKERRQ(ierr);
+  }
+  /* Stable counting sort of the rows by level, so the local rows come first and in order */
+  ierr = PetscArrayzero(cnt,k);CHKERRQ(ierr);
+  for (p=0; p<nr; p++) cnt[lev[p]]++;
+  for (i=0,n=0; i<k; i++) {mp->nrows[i] = n + cnt[i]; cnt[i] = n; n = mp->nrows[i];}
+  for (p=0; p<nr; p++) mp->perm[cnt[lev[p]]++] = p;
+  ierr = PetscFree2(lev,cnt);CHKERRQ(ierr);
+  if (mp->nrows[0] != A->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Ghost region has %D local rows instead of %D",mp->nrows[0],A->rmap->n);
+
+  /* S_{k-1} is a subset of S_k */
+  for (p=0,j=0; p<nr; p++) {
+    while (cols[j] < rows[p]) j++;
+    mp->rowpos[p] = j;
+  }
+  ierr = ISRestoreIndices(mp->rows,&rows);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(mp->cols,&cols);CHKERRQ(ierr);
+  for (i=0; i<k-1; i++) {ierr = ISDestroy(&levels[i]);CHKERRQ(ierr);}
+  ierr = PetscFree(levels);CHKERRQ(ierr);
+
+  ierr = VecCreateSeq(PETSC_COMM_SELF,nc,&mp->xk);CHKERRQ(ierr);
+  ierr = VecScatterCreate(x,mp->cols,mp->xk,NULL,&mp->scatter);CHKERRQ(ierr);
+  *mpout = mp;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultPowers_MPIAIJ(Mat A,PetscInt k,Vec x,Vec Y[])
+{
+  PetscErrorCode    ierr;
+  Mat_MPIAIJ        *aij = (Mat_MPIAIJ*)A->data;
+  Mat_MultPowers    *mp;
+  Mat_SeqAIJ        *sub;
+  PetscObjectState  state;
+  PetscBool         congruent;
+  const PetscScalar *xk,*in;
+  PetscScalar       *out,*y,sum;
+  const PetscInt    *ai,*aj,*vj;
+  const MatScalar   *aa,*v;
+  PetscInt          i,j,p,r,m = A->rmap->n,nc,nz,nnz = 0;
+
+  PetscFunctionBegin;
+  if (k == 1 || aij->size == 1) { /* Nothing to save */
+    ierr = MatMult(A,x,Y[0]);CHKERRQ(ierr);
+    for (j=1; j<k; j++) {ierr = MatMult(A,Y[j-1],Y[j]);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+  ierr = MatHasCongruentLayouts(A,&congruent);CHKERRQ(ierr);
+  if (!congruent) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_SIZ,"MatMultPowers() requires the same row and column layouts");
+
+  /* The ghost region depends on the nonzero pattern, and its rows of the matrix on the values */
+  if (aij->multpowers && (aij->multpowers->k != k || aij->multpowers->nonzerostate != A->nonzerostate)) {
+    ierr = MatMultPowersDestroy_MPIAIJ(&aij->multpowers);CHKERRQ(ierr);
+  }
+  if (!aij->multpowers) {ierr = MatMultPowersSetUp_MPIAIJ(A,k,x,&aij->multpowers);CHKERRQ(ierr);}
+  mp   = aij->multpowers;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (!mp->sub || mp->state != state) {
+    ierr = MatCreateSubMatrices(A,1,&mp->rows,&mp->cols,mp->sub ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX,&mp->sub);CHKERRQ(ierr);
+    mp->state        = state;
+    mp->nonzerostate = A->nonzerostate;
+  }
+
+  /* The only communication */
+  ierr = VecScatterBegin(mp->scatter,x,mp->xk,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(mp->scatter,x,mp->xk,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+
+  sub  = (Mat_SeqAIJ*)mp->sub[0]->data;
+  ai   = sub->i;
+  aj   = sub->j;
+  aa   = sub->a;
+  ierr = VecGetLocalSize(mp->xk,&nc);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(mp->xk,&xk);CHKERRQ(ierr);
+  in   = xk;
+  out  = mp->work;
+  for (j=1; j<=k; j++) {
+    /* A^j x on S_{k-j} only needs A^(j-1) x on S_{k-j+1} */
+    for (i=0; i<mp->nrows[k-j]; i++) {
+      r   = mp->perm[i];
+      nz  = ai[r+1] - ai[r];
+      v   = aa + ai[r];
+      vj  = aj + ai[r];
+      sum = 0.0;
+      PetscSparseDensePlusDot(sum,in,v,vj,nz);
+      out[mp->rowpos[r]] = sum;
+      nnz += nz;
+    }
+    ierr = VecGetArray(Y[j-1],&y);CHKERRQ(ierr);
+    for (p=0; p<m; p++) y[p] = out[mp->rowpos[mp->perm[p]]];
+    ierr = VecRestoreArray(Y[j-1],&y);CHKERRQ(ierr);
+    in  = out;
+    out = (out == mp->work) ? mp->work+nc : mp->work;
+  }
+  ierr = VecRestoreArrayRead(mp->xk,&xk);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
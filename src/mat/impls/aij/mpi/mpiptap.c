@@ -42,6 +42,8 @@ PetscErrorCode MatView_MPIAIJ_PtAP(Mat A,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"using allatonce MatPtAP() implementation\n");CHKERRQ(ierr);
       } else if (ptap->algType == 3) {
         ierr = PetscViewerASCIIPrintf(viewer,"using merged allatonce MatPtAP() implementation\n");CHKERRQ(ierr);
+      } else if (ptap->algType == 4) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using hash MatPtAP() implementation\n");CHKERRQ(ierr);
       }
     }
   }
@@ -180,8 +182,13 @@ PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,Mat C)
 
   /* 3) C_loc = Rd*AP_loc, C_oth = Ro*AP_loc */
   /* Always use scalable version since we are in the MPI scalable version */
-  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Rd,AP_loc,ptap->C_loc);CHKERRQ(ierr);
-  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Ro,AP_loc,ptap->C_oth);CHKERRQ(ierr);
+  if (ptap->algType == 4) {
+    ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(ptap->Rd,AP_loc,ptap->C_loc);CHKERRQ(ierr);
+    ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(ptap->Ro,AP_loc,ptap->C_oth);CHKERRQ(ierr);
+  } else {
+    ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Rd,AP_loc,ptap->C_loc);CHKERRQ(ierr);
+    ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(ptap->Ro,AP_loc,ptap->C_oth);CHKERRQ(ierr);
+  }
 
   C_loc = ptap->C_loc;
   C_oth = ptap->C_oth;
@@ -271,6 +278,7 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
   PetscTable          ta;
   MatType             mtype;
   const char          *prefix;
+  PetscBool           hash;
 #if defined(PETSC_USE_INFO)
   PetscReal           apfill;
 #endif
@@ -282,6 +290,9 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
 
   if (size > 1) ao = (Mat_SeqAIJ*)(a->B)->data;
 
+  /* "hash" only differs in the local products Rd*AP_loc and Ro*AP_loc, done with the hash accumulator */
+  ierr = PetscStrcmp(Cmpi->product->alg,"hash",&hash);CHKERRQ(ierr);
+
   /* create symbolic parallel matrix Cmpi */
   ierr = MatGetType(A,&mtype);CHKERRQ(ierr);
   ierr = MatSetType(Cmpi,mtype);CHKERRQ(ierr);
@@ -289,7 +300,7 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
   /* create struct Mat_APMPI and attached it to C later */
   ierr        = PetscNew(&ptap);CHKERRQ(ierr);
   ptap->reuse = MAT_INITIAL_MATRIX;
-  ptap->algType = 0;
+  ptap->algType = hash ? 4 : 0;
 
   /* get P_oth by taking rows of P (= non-zero cols of local A) from other processors */
   ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_INITIAL_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&P_oth);CHKERRQ(ierr);
@@ -404,7 +415,7 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
   ierr = MatAppendOptionsPrefix(ptap->C_oth,"inner_offdiag_");CHKERRQ(ierr);
 
   ierr = MatProductSetType(ptap->C_oth,MATPRODUCT_AB);CHKERRQ(ierr);
-  ierr = MatProductSetAlgorithm(ptap->C_oth,"sorted");CHKERRQ(ierr);
+  ierr = MatProductSetAlgorithm(ptap->C_oth,hash ? "hash" : "sorted");CHKERRQ(ierr);
   ierr = MatProductSetFill(ptap->C_oth,fill);CHKERRQ(ierr);
   ierr = MatProductSetFromOptions(ptap->C_oth);CHKERRQ(ierr);
   ierr = MatProductSymbolic(ptap->C_oth);CHKERRQ(ierr);
@@ -465,7 +476,7 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
   /* ---------------------------------------- */
   ierr = MatProductCreate(ptap->Rd,ptap->AP_loc,NULL,&ptap->C_loc);CHKERRQ(ierr);
   ierr = MatProductSetType(ptap->C_loc,MATPRODUCT_AB);CHKERRQ(ierr);
-  ierr = MatProductSetAlgorithm(ptap->C_loc,"default");CHKERRQ(ierr);
+  ierr = MatProductSetAlgorithm(ptap->C_loc,hash ? "hash" : "default");CHKERRQ(ierr);
   ierr = MatProductSetFill(ptap->C_loc,fill);CHKERRQ(ierr);
 
   ierr = MatSetOptionsPrefix(ptap->C_loc,prefix);CHKERRQ(ierr);
@@ -2115,7 +2126,9 @@ PETSC_INTERN PetscErrorCode MatProductSymbolic_PtAP_MPIAIJ_MPIAIJ(Mat C)
 
   PetscFunctionBegin;
   /* scalable: do R=P^T locally, then C=R*A*P */
+  /* hash: same as scalable, with the local products R*(A*P) done with the hash accumulator */
   ierr = PetscStrcmp(alg,"scalable",&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscStrcmp(alg,"hash",&flg);CHKERRQ(ierr);}
   if (flg) {
     ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(A,P,product->fill,C);CHKERRQ(ierr);
     C->ops->productnumeric = MatProductNumeric_PtAP;
@@ -1096,6 +1096,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+  if (a->singleprecision) {ierr = MatAIJSetSinglePrecision_SeqAIJ(A,PETSC_TRUE);CHKERRQ(ierr);} /* the i-node check may have reset the ops */
   PetscFunctionReturn(0);
 }
 
@@ -1169,6 +1170,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISColoringDestroy(&a->coloring);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  ierr = PetscFree(a->omp_split);CHKERRQ(ierr);
+  ierr = PetscFree2(a->omp_nodesplit,a->omp_noderow);CHKERRQ(ierr);
+  ierr = PetscFree(a->a_single);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1198,8 +1204,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_is_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatAIJSetSinglePrecision_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_is_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_seqdense_seqaij_C",NULL);CHKERRQ(ierr);
@@ -1358,6 +1367,125 @@ PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec xx,Vec yy)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+
+/*
+   Splits the m rows with offsets ii[] into nt contiguous chunks with about the same number of nonzeros,
+   chunk t is rows split[t]:split[t+1]. Each chunk start is found by bisection on ii[], rows without any
+   nonzeros (as with an empty preallocation) are split evenly instead.
+*/
+static void MatSeqAIJSplitRows_OpenMP_Private(PetscInt m,const PetscInt *ii,PetscInt nt,PetscInt *split)
+{
+  PetscInt   t,lo,hi,mid;
+  PetscInt64 nz = ii[m] - ii[0],target;
+
+  split[0]  = 0;
+  split[nt] = m;
+  for (t=1; t<nt; t++) {
+    if (!nz) {split[t] = (PetscInt)(((PetscInt64)t*m)/nt); continue;}
+    target = ii[0] + ((PetscInt64)t*nz)/nt;
+    lo     = split[t-1];
+    hi     = m;
+    while (lo < hi) {
+      mid = lo + (hi - lo)/2;
+      if (ii[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    split[t] = lo;
+  }
+}
+
+/*
+   Returns the nonzero balanced row chunks of the rows used by MatMult(), recomputed only when the number of threads,
+   the nonzero structure, or the use of compressed rows has changed since the last call
+*/
+PetscErrorCode MatSeqAIJGetRowSplit_OpenMP_Private(Mat A,PetscInt m,const PetscInt *ii,PetscInt *nt,const PetscInt **split)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       n = PetscMax(1,PetscMin(a->omp_nthreads,m));
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a->omp_split || a->omp_nsplit != n || a->omp_nrows != m || a->omp_nonzerostate != A->nonzerostate) {
+    if (a->omp_nsplit != n) {
+      ierr = PetscFree(a->omp_split);CHKERRQ(ierr);
+      ierr = PetscMalloc1(n+1,&a->omp_split);CHKERRQ(ierr);
+    }
+    MatSeqAIJSplitRows_OpenMP_Private(m,ii,n,a->omp_split);
+    a->omp_nsplit       = n;
+    a->omp_nrows        = m;
+    a->omp_nonzerostate = A->nonzerostate;
+  }
+  *nt    = a->omp_nsplit;
+  *split = a->omp_split;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes z = A x + y (or z = A x when yy is NULL) with the rows divided among the OpenMP threads in
+   nonzero balanced chunks. The chunk given to each thread is the same from call to call, so with the
+   first touch done in MatSeqAIJSetPreallocation_SeqAIJ() each thread streams matrix memory that is local
+   to its NUMA domain.
+*/
+static PetscErrorCode MatMultAdd_SeqAIJ_OpenMP_Private(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *z;
+  const PetscScalar *x,*y = NULL;
+  const PetscInt    *ii = a->i,*ridx = NULL,*split;
+  PetscInt          m = A->rmap->n,nt;
+  PetscBool         usecprow = a->compressedrow.use;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  }
+  if (usecprow) { /* use compressed row format */
+    if (!yy) {
+      ierr = PetscArrayzero(z,m);CHKERRQ(ierr);
+    } else if (zz != yy) {
+      ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+    }
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  ierr = MatSeqAIJGetRowSplit_OpenMP_Private(A,m,ii,&nt,&split);CHKERRQ(ierr);
+#pragma omp parallel num_threads(nt) if(nt > 1)
+  {
+    const MatScalar *aa;
+    const PetscInt  *aj;
+    PetscInt        t,i,r,n;
+    PetscScalar     sum;
+
+    for (t=omp_get_thread_num(); t<nt; t+=omp_get_num_threads()) {
+      for (i=split[t]; i<split[t+1]; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        r   = ridx ? ridx[i] : i;
+        sum = y ? y[r] : 0.0;
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[r] = sum;
+      }
+    }
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
 
 PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
@@ -1378,6 +1506,12 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMultAdd_SeqAIJ_OpenMP_Private(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
@@ -1530,6 +1664,12 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscBool         usecprow=a->compressedrow.use;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    ierr = MatMultAdd_SeqAIJ_OpenMP_Private(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   if (usecprow) { /* use compressed row format */
@@ -2930,8 +3070,11 @@ PETSC_INTERN PetscErrorCode MatSeqAIJGetArray_SeqAIJ(Mat A,PetscScalar *array[])
 
 PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat A,PetscScalar *array[])
 {
+  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data;
+
   PetscFunctionBegin;
   *array = NULL;
+  if (a->a_single) a->a_single_state = -1; /* the values may have changed, copy them again at the next use */
   PetscFunctionReturn(0);
 }
 
@@ -3948,6 +4091,26 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
     for (i=1; i<B->rmap->n+1; i++) {
       b->i[i] = b->i[i-1] + b->imax[i-1];
     }
+#if defined(PETSC_HAVE_OPENMP)
+    /* first touch the values and column indices from the threads that will use them in MatMult() so the pages
+       are placed in their NUMA domains; assembly later compresses the rows by at most the unused preallocation */
+    if (b->omp_nthreads > 1) {
+      PetscInt nt = PetscMax(1,PetscMin(b->omp_nthreads,B->rmap->n)),*split;
+
+      ierr = PetscMalloc1(nt+1,&split);CHKERRQ(ierr);
+      MatSeqAIJSplitRows_OpenMP_Private(B->rmap->n,b->i,nt,split);
+#pragma omp parallel num_threads(nt) if(nt > 1)
+      {
+        PetscInt t,k;
+
+        for (t=omp_get_thread_num(); t<nt; t+=omp_get_num_threads()) {
+          for (k=b->i[split[t]]; k<b->i[split[t+1]]; k++) b->j[k] = 0;
+          if (!B->structure_only) for (k=b->i[split[t]]; k<b->i[split[t+1]]; k++) b->a[k] = 0.0;
+        }
+      }
+      ierr = PetscFree(split);CHKERRQ(ierr);
+    }
+#endif
     if (B->structure_only) {
       b->singlemalloc = PETSC_FALSE;
       b->free_a       = PETSC_FALSE;
@@ -4074,6 +4237,107 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+/*
+   The COO entries are bucketed by row with a counting sort and each row is then sorted by column, so the setup costs
+   O(n log(n/m)). Repeated (row,col) pairs collapse into one nonzero; coo_jmap[] records which of the sorted entries
+   contribute to each nonzero and coo_perm[] where they sit in the user's value array.
+*/
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *a;
+  PetscInt       m,n,i,k,q,nz,nvalid,lastcol,*rowstart,*Ai,*cols,*jmap,*perm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  m    = A->rmap->n;
+  n    = A->cmap->n;
+
+  /* count the entries of each row; entries with negative indices are ignored as in MatSetValues() */
+  ierr = PetscCalloc1(m+1,&rowstart);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= m) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has row %D, max %D",k,coo_i[k],m-1);
+    if (coo_j[k] >= n) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has column %D, max %D",k,coo_j[k],n-1);
+    rowstart[coo_i[k]+1]++;
+  }
+  for (i=0; i<m; i++) rowstart[i+1] += rowstart[i];
+  nvalid = rowstart[m];
+
+  ierr = PetscMalloc1(nvalid,&cols);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nvalid,&perm);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    q       = rowstart[coo_i[k]]++;
+    cols[q] = coo_j[k];
+    perm[q] = k;
+  }
+  /* the fill loop advanced each rowstart[i] to the start of row i+1 */
+  for (i=m; i>0; i--) rowstart[i] = rowstart[i-1];
+  rowstart[0] = 0;
+
+  /* sort each row and compress repeated columns in place */
+  ierr  = PetscMalloc1(m+1,&Ai);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(nvalid+1,&jmap);CHKERRQ(ierr);
+  Ai[0] = 0;
+  nz    = 0;
+  for (i=0; i<m; i++) {
+    ierr    = PetscSortIntWithArray(rowstart[i+1]-rowstart[i],cols+rowstart[i],perm+rowstart[i]);CHKERRQ(ierr);
+    lastcol = -1;
+    for (q=rowstart[i]; q<rowstart[i+1]; q++) {
+      if (cols[q] != lastcol) {
+        lastcol    = cols[q];
+        cols[nz]   = lastcol;
+        jmap[nz++] = q;
+      }
+    }
+    Ai[i+1] = nz;
+  }
+  jmap[nz] = nvalid;
+  ierr = PetscFree(rowstart);CHKERRQ(ierr);
+
+  /* the rows are sorted and free of duplicates, so the CSR layout of A matches cols[] entry for entry */
+  ierr = MatSeqAIJSetPreallocationCSR(A,Ai,cols,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(Ai);CHKERRQ(ierr);
+  ierr = PetscFree(cols);CHKERRQ(ierr);
+
+  a    = (Mat_SeqAIJ*)A->data;
+  ierr = PetscFree(a->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(a->coo_perm);CHKERRQ(ierr);
+  ierr = PetscRealloc(sizeof(PetscInt)*(nz+1),&jmap);CHKERRQ(ierr);
+  a->coo_n    = ncoo;
+  a->coo_jmap = jmap;
+  a->coo_perm = perm;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,k,nz;
+  const PetscInt *jmap = a->coo_jmap,*perm = a->coo_perm;
+  PetscScalar    *aa,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  nz   = a->i[A->rmap->n];
+  ierr = MatSeqAIJGetArray(A,&aa);CHKERRQ(ierr);
+  if (!v) {
+    if (imode == INSERT_VALUES) {ierr = PetscArrayzero(aa,nz);CHKERRQ(ierr);}
+  } else {
+    for (i=0; i<nz; i++) {
+      sum = 0.0;
+      for (k=jmap[i]; k<jmap[i+1]; k++) sum += v[perm[k]];
+      aa[i] = (imode == INSERT_VALUES ? 0.0 : aa[i]) + sum;
+    }
+    ierr = PetscLogFlops(1.0*jmap[nz]);CHKERRQ(ierr);
+  }
+  ierr = MatSeqAIJRestoreArray(A,&aa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4155,6 +4419,12 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat
     MatSetOptions(,MAT_STRUCTURE_ONLY,PETSC_TRUE) may be called for this matrix type. In this no
     space is allocated for the nonzero entries and any entries passed with MatSetValues() are ignored
 
+    When PETSc is configured --with-openmp, -mat_omp_threads <nt> makes MatMult() and MatMultAdd() divide the rows among nt
+    threads in chunks with the same number of nonzeros; the inode MatMult() divides the inodes the same way. The
+    preallocated matrix is first touched with the same threads so that on NUMA machines each thread reads memory local
+    to it, and -vec_omp_threads <nt> first touches new vectors with nt threads in equal chunks. The products are
+    sequential by default.
+
   Developer Notes:
     It would be nice if all matrix formats supported passing NULL in for the numerical values
 
@@ -4348,6 +4618,45 @@ PetscErrorCode  MatSeqAIJRestoreArray(Mat A,PetscScalar **array)
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatAIJSetSinglePrecision - Applies the matrix from a single precision copy of its nonzero values
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A - a MATSEQAIJ or MATMPIAIJ matrix, or a MATSEQAIJ LU or ILU factor computed by PETSc
+-  flg - PETSC_TRUE to read the single precision copy, PETSC_FALSE to go back to the PetscScalar values
+
+   Notes:
+   MatMult(), MatMultAdd(), MatMultTranspose(), MatMultTransposeAdd() and MatSOR() of an assembled matrix, or MatSolve()
+   of a factored matrix, then stream a float copy of the values that is refreshed whenever the matrix changes. The vectors
+   and all the sums remain in PetscScalar, so the memory traffic of the values is halved at the cost of rounding the
+   matrix to single precision. This is meant for preconditioners, whose application is bandwidth bound and whose accuracy
+   is not critical, while the outer Krylov method works with the full precision operator;
+   see PCFactorSetUseSinglePrecision() and PCGAMGSetUseSinglePrecision().
+
+   The PetscScalar values are kept, so all other operations are unchanged and the matrix uses 50% more memory for its values.
+
+   For a factored matrix this must be called again after each MatLUFactorNumeric(). For a MATMPIAIJ matrix it must be called
+   after the matrix has been assembled.
+
+   This has no effect on other matrix types (including those derived from MATSEQAIJ) and with complex scalars.
+
+   Level: advanced
+
+.seealso: MatCreateAIJ(), MatMult(), MatSOR(), MatSolve(), PCFactorSetUseSinglePrecision(), PCGAMGSetUseSinglePrecision()
+@*/
+PetscErrorCode MatAIJSetSinglePrecision(Mat A,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveBool(A,flg,2);
+  ierr = PetscTryMethod(A,"MatAIJSetSinglePrecision_C",(Mat,PetscBool),(A,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_CUDA)
 PETSC_EXTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJCUSPARSE(Mat);
 #endif
@@ -4426,8 +4735,11 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsHermitianTranspose_C",MatIsTranspose_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatAIJSetSinglePrecision_C",MatAIJSetSinglePrecision_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaij_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaij_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
@@ -4490,6 +4802,9 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   c->ignorezeroentries = a->ignorezeroentries;
   c->roworiented       = a->roworiented;
   c->nonew             = a->nonew;
+#if defined(PETSC_HAVE_OPENMP)
+  c->omp_nthreads      = a->omp_nthreads;
+#endif
   if (a->diag) {
     ierr = PetscMalloc1(m+1,&c->diag);CHKERRQ(ierr);
     ierr = PetscMemcpy(c->diag,a->diag,m*sizeof(PetscInt));CHKERRQ(ierr);
@@ -4525,6 +4840,8 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   C->nonzerostate  = A->nonzerostate;
 
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
+  /* after the i-node copy, which resets the ops; the single precision values are rebuilt on first use */
+  if (a->singleprecision) {ierr = MatAIJSetSinglePrecision_SeqAIJ(C,PETSC_TRUE);CHKERRQ(ierr);}
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -76,6 +76,9 @@ typedef struct {
   PetscErrorCode (*destroy)(Mat);
 } Mat_MatMatMatMult;
 
+/* type of the reduced precision copy of the nonzero values used by MatAIJSetSinglePrecision() */
+typedef float MatScalarSingle;
+
 /*
   MATSEQAIJ format - Compressed row storage (also called Yale sparse matrix
   format) or compressed sparse row (CSR).  The i[] and j[] arrays start at 0. For example,
@@ -101,6 +104,9 @@ typedef struct {
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscErrorCode MatSeqAIJGetRowSplit_OpenMP_Private(Mat,PetscInt,const PetscInt*,PetscInt*,const PetscInt**);
+#endif
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat,MatOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat,MatDuplicateOption,Mat*);
@@ -108,6 +114,8 @@ PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOpti
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatSeqAIJGetArray_SeqAIJ(Mat,PetscScalar**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat,PetscScalar**);
 
 typedef struct {
@@ -130,6 +138,25 @@ typedef struct {
   Mat_RARt            *rart;               /* used by MatRARt() */
   Mat_MatMatTransMult *abt;                /* used by MatMatTransposeMult() */
   Mat_MatTransMatMult *atb;                /* used by MatTransposeMatMult() */
+
+  PetscInt            coo_n;               /* number of entries passed to MatSetPreallocationCOO() */
+  PetscInt            *coo_jmap;           /* nonzero k is the sum of the COO entries coo_perm[coo_jmap[k]:coo_jmap[k+1]] */
+  PetscInt            *coo_perm;           /* COO entry numbers sorted by (row,col) */
+
+  PetscInt            omp_nthreads;        /* number of OpenMP threads used by MatMult(), set with -mat_omp_threads */
+  PetscInt            omp_nsplit;          /* number of nonzero balanced row chunks used by the OpenMP MatMult() */
+  PetscInt            *omp_split;          /* chunk t is rows omp_split[t]:omp_split[t+1] of the (possibly compressed) rows */
+  PetscInt            omp_nrows;           /* number of rows that were split */
+  PetscObjectState    omp_nonzerostate;    /* A->nonzerostate when omp_split[] was computed */
+  PetscInt            omp_nnodesplit;      /* number of inode chunks used by the OpenMP inode MatMult() */
+  PetscInt            *omp_nodesplit;      /* chunk t is inodes omp_nodesplit[t]:omp_nodesplit[t+1], starting at row omp_noderow[t] */
+  PetscInt            *omp_noderow;
+  PetscObjectState    omp_nodenonzerostate;
+
+  PetscBool           singleprecision;     /* products, SOR and solves read a_single[], see MatAIJSetSinglePrecision() */
+  MatScalarSingle     *a_single;           /* single precision copy of a[] */
+  PetscInt            a_single_nz;         /* length of a_single[] */
+  PetscObjectState    a_single_state;      /* object state of the matrix when a_single[] was copied */
 } Mat_SeqAIJ;
 
 /*
@@ -238,6 +265,8 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
+PETSC_INTERN PetscErrorCode MatAIJSetSinglePrecision_SeqAIJ(Mat,PetscBool);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 
@@ -295,6 +324,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscR
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat,Mat,PetscReal,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat);
 #endif
@@ -304,6 +334,7 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
@@ -0,0 +1,396 @@
+
+/*
+   Kernels of MATSEQAIJ that read a single precision copy of the nonzero values, see MatAIJSetSinglePrecision().
+   The vectors and all the sums stay in PetscScalar, only the values array streamed from memory is halved.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#if !defined(PETSC_USE_COMPLEX)
+/*
+   Returns the single precision copy of the values, copied again from a->a when the matrix (or the factorization)
+   has changed since the last call. A factored matrix stores the U part after the L part, ending at diag[0].
+*/
+static PetscErrorCode MatSeqAIJGetArraySingle_Private(Mat A,const MatScalarSingle **aa)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,m = A->rmap->n,nz;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  nz = A->factortype ? (m ? a->diag[0]+1 : 0) : a->i[m];
+  if (!a->a_single || a->a_single_nz != nz || a->a_single_state != ((PetscObject)A)->state) {
+    if (!a->a_single || a->a_single_nz != nz) {
+      ierr = PetscFree(a->a_single);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nz,&a->a_single);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)A,(nz-a->a_single_nz)*sizeof(MatScalarSingle));CHKERRQ(ierr);
+      a->a_single_nz = nz;
+    }
+    for (i=0; i<nz; i++) a->a_single[i] = (MatScalarSingle)a->a[i];
+    a->a_single_state = ((PetscObject)A)->state;
+  }
+  *aa = a->a_single;
+  PetscFunctionReturn(0);
+}
+
+/* z = A x + y, or z = A x when yy is NULL */
+static PetscErrorCode MatMultAdd_SeqAIJ_Single_Private(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *z,sum;
+  const PetscScalar     *x,*y = NULL;
+  const MatScalarSingle *aa,*v;
+  const PetscInt        *ii = a->i,*ridx = NULL,*aj;
+  PetscInt              m = A->rmap->n,i,n,r;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetArraySingle_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  }
+  if (a->compressedrow.use) {
+    if (!yy) {
+      ierr = PetscArrayzero(z,m);CHKERRQ(ierr);
+    } else if (zz != yy) {
+      ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+    }
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  for (i=0; i<m; i++) {
+    n    = ii[i+1] - ii[i];
+    aj   = a->j + ii[i];
+    v    = aa + ii[i];
+    r    = ridx ? ridx[i] : i;
+    sum  = y ? y[r] : 0.0;
+    PetscSparseDensePlusDot(sum,x,v,aj,n);
+    z[r] = sum;
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,(PetscScalar**)&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_SeqAIJ_Single(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqAIJ_Single_Private(A,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_Single(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqAIJ_Single_Private(A,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTransposeAdd_SeqAIJ_Single(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *y,alpha;
+  const PetscScalar     *x;
+  const MatScalarSingle *aa,*v;
+  const PetscInt        *ii = a->i,*ridx = NULL,*idx;
+  PetscInt              m = A->rmap->n,i,j,n;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetArraySingle_Private(A,&aa);CHKERRQ(ierr);
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  for (i=0; i<m; i++) {
+    idx   = a->j + ii[i];
+    v     = aa + ii[i];
+    n     = ii[i+1] - ii[i];
+    alpha = ridx ? x[ridx[i]] : x[i];
+    for (j=0; j<n; j++) y[idx[j]] += alpha*v[j];
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_SeqAIJ_Single(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(yy,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_SeqAIJ_Single(A,xx,yy,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Same sweeps as MatSOR_SeqAIJ(), the diagonal and its inverse are kept in PetscScalar.
+   Eisenstat's trick and SOR_APPLY_UPPER use the double precision values.
+*/
+static PetscErrorCode MatSOR_SeqAIJ_Single(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar           *x,sum,*t;
+  const PetscScalar     *b,*xb,*idiag,*mdiag;
+  const MatScalarSingle *aa,*v;
+  const PetscInt        *idx,*diag,*ai = a->i;
+  PetscInt              n,m = A->rmap->n,i;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || flag & SOR_EISENSTAT) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its = its*lits;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+  ierr = MatSeqAIJGetArraySingle_Private(A,&aa);CHKERRQ(ierr);
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n    = diag[i] - ai[i];
+        idx  = a->j + ai[i];
+        v    = aa + ai[i];
+        sum  = b[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n   = ai[i+1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        sum = xb[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n    = diag[i] - ai[i];
+        idx  = a->j + ai[i];
+        v    = aa + ai[i];
+        sum  = b[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        n    = ai[i+1] - diag[i] - 1;
+        idx  = a->j + diag[i] + 1;
+        v    = aa + diag[i] + 1;
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          n   = ai[i+1] - ai[i];
+          idx = a->j + ai[i];
+          v   = aa + ai[i];
+          PetscSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = ai[i+1] - diag[i] - 1;
+          idx = a->j + diag[i] + 1;
+          v   = aa + diag[i] + 1;
+          PetscSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(xb == b ? 2.0*a->nz : a->nz);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_Single_NaturalOrdering(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscInt              n = A->rmap->n,i,nz;
+  const PetscInt        *ai = a->i,*aj = a->j,*adiag = a->diag,*vi;
+  PetscScalar           *x,sum;
+  const PetscScalar     *b;
+  const MatScalarSingle *aa,*v;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJGetArraySingle_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  x[0] = b[0];
+  v    = aa;
+  vi   = aj;
+  for (i=1; i<n; i++) {
+    nz   = ai[i+1] - ai[i];
+    sum  = b[i];
+    PetscSparseDenseMinusDot(sum,x,v,vi,nz);
+    v   += nz;
+    vi  += nz;
+    x[i] = sum;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v    = aa + adiag[i+1] + 1;
+    vi   = aj + adiag[i+1] + 1;
+    nz   = adiag[i] - adiag[i+1] - 1;
+    sum  = x[i];
+    PetscSparseDenseMinusDot(sum,x,v,vi,nz);
+    x[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] is the inverse of the diagonal */
+  }
+
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_SeqAIJ_Single(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscInt              n = A->rmap->n,i,nz;
+  const PetscInt        *ai = a->i,*aj = a->j,*adiag = a->diag,*vi,*r,*c;
+  PetscScalar           *x,*tmp,sum;
+  const PetscScalar     *b;
+  const MatScalarSingle *aa,*v;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJGetArraySingle_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+  tmp  = a->solve_work;
+
+  /* forward solve the lower triangular */
+  tmp[0] = b[r[0]];
+  v      = aa;
+  vi     = aj;
+  for (i=1; i<n; i++) {
+    nz     = ai[i+1] - ai[i];
+    sum    = b[r[i]];
+    PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    tmp[i] = sum;
+    v     += nz; vi += nz;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v       = aa + adiag[i+1] + 1;
+    vi      = aj + adiag[i+1] + 1;
+    nz      = adiag[i] - adiag[i+1] - 1;
+    sum     = tmp[i];
+    PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+  }
+
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   Installs (or removes) the single precision kernels. Only the triangular solves of the PETSc LU and ILU factors
+   (not the in-place ones) have a single precision version; other solve routines, such as those of external
+   packages that produce a MATSEQAIJ factor, are left untouched. Removing them restores the plain kernels, the
+   i-node variants are selected again at the next assembly or factorization.
+*/
+PetscErrorCode MatAIJSetSinglePrecision_SeqAIJ(Mat A,PetscBool flg)
+{
+#if !defined(PETSC_USE_COMPLEX)
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+#endif
+  PetscBool      isseqaij;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) {
+    ierr = PetscInfo1(A,"Single precision kernels are not available for matrix type %s\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscInfo(A,"Single precision kernels are not available with complex scalars\n");CHKERRQ(ierr);
+#else
+  a->singleprecision = flg;
+  if (flg) {
+    if (A->factortype) {
+      if (A->ops->solve == MatSolve_SeqAIJ_NaturalOrdering) A->ops->solve = MatSolve_SeqAIJ_Single_NaturalOrdering;
+      else if (A->ops->solve == MatSolve_SeqAIJ || A->ops->solve == MatSolve_SeqAIJ_Inode) A->ops->solve = MatSolve_SeqAIJ_Single;
+    } else {
+      A->ops->mult             = MatMult_SeqAIJ_Single;
+      A->ops->multadd          = MatMultAdd_SeqAIJ_Single;
+      A->ops->multtranspose    = MatMultTranspose_SeqAIJ_Single;
+      A->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ_Single;
+      A->ops->sor              = MatSOR_SeqAIJ_Single;
+    }
+  } else {
+    if (A->ops->solve == MatSolve_SeqAIJ_Single_NaturalOrdering) A->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+    else if (A->ops->solve == MatSolve_SeqAIJ_Single) A->ops->solve = MatSolve_SeqAIJ;
+    if (A->ops->mult == MatMult_SeqAIJ_Single) {
+      A->ops->mult             = MatMult_SeqAIJ;
+      A->ops->multadd          = MatMultAdd_SeqAIJ;
+      A->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+      A->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+      A->ops->sor              = MatSOR_SeqAIJ;
+    }
+    ierr = PetscFree(a->a_single);CHKERRQ(ierr);
+    a->a_single_nz = 0;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
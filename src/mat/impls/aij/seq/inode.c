@@ -364,32 +364,27 @@ static PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Inode(Mat A,PetscInt oshift,Pets
 
 /* ----------------------------------------------------------- */
 
-static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
+/*
+   Computes the rows of the inodes node0:node1, the first of which is row, and returns the number of nonzero rows among
+   them, or -1 if an inode is larger than 5. It is called from OpenMP threads so it does not use the PETSc stack macros.
+*/
+static PetscInt MatMult_SeqAIJ_Inode_Nodes(const Mat_SeqAIJ *a,const PetscScalar *x,PetscScalar *y,PetscInt node0,PetscInt node1,PetscInt row)
 {
-  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
   PetscScalar       sum1,sum2,sum3,sum4,sum5,tmp0,tmp1;
-  PetscScalar       *y;
-  const PetscScalar *x;
   const MatScalar   *v1,*v2,*v3,*v4,*v5;
-  PetscErrorCode    ierr;
-  PetscInt          i1,i2,n,i,row,node_max,nsz,sz,nonzerorow=0;
-  const PetscInt    *idx,*ns,*ii;
+  PetscInt          i1,i2,n,i,nsz,sz,nonzerorow=0;
+  const PetscInt    *idx,*ns = a->inode.size,*ii;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*v1,*v2,*v3,*v4,*v5)
 #endif
 
-  PetscFunctionBegin;
-  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
-  node_max = a->inode.node_count;
-  ns       = a->inode.size;     /* Node Size array */
-  ierr     = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr     = VecGetArray(yy,&y);CHKERRQ(ierr);
-  idx      = a->j;
-  v1       = a->a;
-  ii       = a->i;
+  /* the rows of a node have the same nonzero pattern and are stored one after the other */
+  idx = a->j + a->i[row];
+  v1  = a->a + a->i[row];
+  ii  = a->i + row;
 
-  for (i = 0,row = 0; i< node_max; ++i) {
+  for (i = node0; i< node1; ++i) {
     nsz         = ns[i];
     n           = ii[1] - ii[0];
     nonzerorow += (n>0)*nsz;
@@ -544,8 +539,85 @@ static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
       idx    +=4*sz;
       break;
     default:
-      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+      return -1;
+    }
+  }
+  return nonzerorow;
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+
+/*
+   Returns the inodes split into chunks that follow the nonzero balanced row chunks of MatMult_SeqAIJ(): chunk t is the
+   inodes nodesplit[t]:nodesplit[t+1] beginning at row noderow[t], so each thread reads the part of the matrix and of the
+   vectors that it first touched. Recomputed only when the number of threads or the inodes have changed, which is when the
+   inode sizes are checked so that the threads never meet an unsupported one.
+*/
+static PetscErrorCode MatSeqAIJGetNodeSplit_OpenMP_Private(Mat A,PetscInt *nt,const PetscInt **nodesplit,const PetscInt **noderow)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  const PetscInt *split,*ns = a->inode.size;
+  PetscInt       n,t,node,row;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetRowSplit_OpenMP_Private(A,A->rmap->n,a->i,&n,&split);CHKERRQ(ierr);
+  if (!a->omp_nodesplit || a->omp_nnodesplit != n || a->omp_nodenonzerostate != A->nonzerostate) {
+    for (node=0; node<a->inode.node_count; node++) {
+      if (ns[node] > 5) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size %D not yet supported",ns[node]);
     }
+    ierr = PetscFree2(a->omp_nodesplit,a->omp_noderow);CHKERRQ(ierr);
+    ierr = PetscMalloc2(n+1,&a->omp_nodesplit,n+1,&a->omp_noderow);CHKERRQ(ierr);
+    /* chunk t begins with the first inode that does not begin before row split[t] */
+    for (t=0,node=0,row=0; t<n; t++) {
+      while (node < a->inode.node_count && row < split[t]) row += ns[node++];
+      a->omp_nodesplit[t] = node;
+      a->omp_noderow[t]   = row;
+    }
+    a->omp_nodesplit[n]     = a->inode.node_count;
+    a->omp_noderow[n]       = A->rmap->n;
+    a->omp_nnodesplit       = n;
+    a->omp_nodenonzerostate = A->nonzerostate;
+  }
+  *nt        = a->omp_nnodesplit;
+  *nodesplit = a->omp_nodesplit;
+  *noderow   = a->omp_noderow;
+  PetscFunctionReturn(0);
+}
+#endif
+
+static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          nonzerorow=0;
+
+  PetscFunctionBegin;
+  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp_nthreads > 1) {
+    const PetscInt *nodesplit,*noderow;
+    PetscInt       nt;
+
+    ierr = MatSeqAIJGetNodeSplit_OpenMP_Private(A,&nt,&nodesplit,&noderow);CHKERRQ(ierr);
+#pragma omp parallel num_threads(nt) if(nt > 1) reduction(+:nonzerorow)
+    {
+      PetscInt t;
+
+      for (t=omp_get_thread_num(); t<nt; t+=omp_get_num_threads()) {
+        nonzerorow += MatMult_SeqAIJ_Inode_Nodes(a,x,y,nodesplit[t],nodesplit[t+1],noderow[t]);
+      }
+    }
+  } else
+#endif
+  {
+    nonzerorow = MatMult_SeqAIJ_Inode_Nodes(a,x,y,0,a->inode.node_count,0);
+    if (nonzerorow < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
   }
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
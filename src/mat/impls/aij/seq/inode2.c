@@ -82,6 +82,10 @@ PetscErrorCode MatCreate_SeqAIJ_Inode(Mat B)
     ierr = PetscInfo(B,"Not using Inode routines due to -mat_no_inode\n");CHKERRQ(ierr);
   }
   ierr = PetscOptionsInt("-mat_inode_limit","Do not use inodes larger then this value",NULL,b->inode.limit,&b->inode.limit,NULL);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  b->omp_nthreads = 1;
+  ierr = PetscOptionsInt("-mat_omp_threads","Number of OpenMP threads used by MatMult()","MATSEQAIJ",b->omp_nthreads,&b->omp_nthreads,NULL);CHKERRQ(ierr);
+#endif
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
   b->inode.use = (PetscBool)(!(no_unroll || no_inode));
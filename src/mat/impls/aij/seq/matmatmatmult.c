@@ -25,13 +25,20 @@ PetscErrorCode MatMatMatMultSymbolic_SeqAIJ_SeqAIJ_SeqAIJ(Mat A,Mat B,Mat C,Pets
   Mat_SeqAIJ        *d;
   Mat_Product       *product = D->product;
   MatProductAlgorithm alg=product->alg;
+  PetscBool         hash;
 
   PetscFunctionBegin;
   if (!product) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"Data struc Mat_Product is not created, call MatProductCreate() first");
+  /* "hash" computes both products with the hash accumulator, anything else with "sorted" */
+  ierr = PetscStrcmp(alg,"hash",&hash);CHKERRQ(ierr);
   ierr = MatCreate(PETSC_COMM_SELF,&BC);CHKERRQ(ierr);
-  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(B,C,fill,BC);CHKERRQ(ierr);
+  if (hash) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(B,C,fill,BC);CHKERRQ(ierr);
+  } else {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(B,C,fill,BC);CHKERRQ(ierr);
+  }
 
-  ierr = MatProductSetAlgorithm(D,"sorted");CHKERRQ(ierr); /* set alg for D = A*BC */
+  ierr = MatProductSetAlgorithm(D,hash ? "hash" : "sorted");CHKERRQ(ierr); /* set alg for D = A*BC */
   ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ(A,BC,fill,D);CHKERRQ(ierr);
   D->product->alg = alg; /* resume original algorithm for D */
 
@@ -7,6 +7,7 @@
 #include <../src/mat/impls/aij/seq/aij.h> /*I "petscmat.h" I*/
 #include <../src/mat/utils/freespace.h>
 #include <petscbt.h>
+#include <petsc/private/hashtable.h>
 #include <petsc/private/isimpl.h>
 #include <../src/mat/impls/dense/seq/dense.h>
 
@@ -120,6 +121,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat C
     PetscFunctionReturn(0);
   }
 
+  /* hash */
+  ierr = PetscStrcmp(alg,"hash",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(A,B,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1058,6 +1066,203 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat A,Mat B,PetscReal f
   PetscFunctionReturn(0);
 }
 
+/*
+   Hash accumulator: row i of C is formed in an open addressing table with linear probing. The table of a row is the
+   smallest power of two at least twice an upper bound of the row length, min(flops of the row,bn), so that rows are
+   binned by their flop count and short rows only touch a few cache lines however wide B is.
+*/
+PETSC_STATIC_INLINE PetscInt MatMatMultHashSize_Private(PetscInt n,int *shift)
+{
+  PetscInt size = 2;
+  int      bits = 1;
+
+  while (size < 2*n) {size <<= 1; bits++;}
+  if (shift) *shift = 64 - bits;
+  return size;
+}
+
+/* Fibonacci hashing: multiplying by 2^64 over the golden ratio mixes all the bits of col into the top ones, and the top
+   log2(size) bits give the slot, so neither consecutive columns nor columns with a common stride collide */
+#define MatMatMultHash_Private(col,shift) ((PetscInt)(((PetscHash64_t)(col)*(PetscHash64_t)0x9E3779B97F4A7C15) >> (shift)))
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,PetscReal fill,Mat C)
+{
+  PetscErrorCode     ierr;
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c;
+  const PetscInt     *ai=a->i,*aj=a->j,*bi=b->i,*bj=b->j,*acol,*bcol;
+  PetscInt           *ci,*cj,*htable,*crow;
+  PetscInt           am=A->rmap->N,bn=B->cmap->N,bm=B->rmap->N;
+  PetscReal          afill;
+  PetscInt           i,j,k,col,h,mask,anzi,bnzj,cnzi,cmax,size,maxsize=0,ndouble=0;
+  int                shift;
+  PetscFreeSpaceList free_space=NULL,current_space=NULL;
+
+  PetscFunctionBegin;
+  /* Bin the rows by their flop count; the largest bin sizes the table */
+  for (i=0; i<am; i++) {
+    for (j=ai[i],cmax=0; j<ai[i+1]; j++) cmax += bi[aj[j]+1] - bi[aj[j]];
+    maxsize = PetscMax(maxsize,MatMatMultHashSize_Private(PetscMin(cmax,bn),NULL));
+  }
+  ierr = PetscMalloc1(maxsize,&htable);CHKERRQ(ierr);
+  for (h=0; h<maxsize; h++) htable[h] = -1;
+
+  ierr  = PetscMalloc1(am+2,&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+
+  /* Initial FreeSpace size is fill*(nnz(A)+nnz(B)) */
+  ierr          = PetscFreeSpaceGet(PetscRealIntMultTruncate(fill,PetscIntSumTruncate(ai[am],bi[bm])),&free_space);CHKERRQ(ierr);
+  current_space = free_space;
+
+  /* Determine ci and cj */
+  for (i=0; i<am; i++) {
+    anzi = ai[i+1] - ai[i];
+    acol = aj + ai[i];
+    for (j=0,cmax=0; j<anzi; j++) cmax += bi[acol[j]+1] - bi[acol[j]];
+    cmax = PetscMin(cmax,bn);
+    size = MatMatMultHashSize_Private(cmax,&shift);
+    mask = size - 1;
+
+    /* If free space is not available, make more free space */
+    if (current_space->local_remaining < cmax) {
+      ierr = PetscFreeSpaceGet(PetscIntSumTruncate(cmax,current_space->total_array_size),&current_space);CHKERRQ(ierr);
+      ndouble++;
+    }
+
+    /* Insert the columns of the rows of B, the new ones are appended to free space */
+    crow = current_space->array;
+    cnzi = 0;
+    for (j=0; j<anzi; j++) {
+      bnzj = bi[acol[j]+1] - bi[acol[j]];
+      bcol = bj + bi[acol[j]];
+      for (k=0; k<bnzj; k++) {
+        col = bcol[k];
+        h   = MatMatMultHash_Private(col,shift);
+        while (htable[h] >= 0 && htable[h] != col) h = (h+1) & mask;
+        if (htable[h] < 0) {
+          htable[h]    = col;
+          crow[cnzi++] = col;
+        }
+      }
+    }
+    /* Clearing the table costs no more than filling it, since size <= 4*flops */
+    for (h=0; h<size; h++) htable[h] = -1;
+    ierr = PetscSortInt(cnzi,crow);CHKERRQ(ierr);
+
+    current_space->array           += cnzi;
+    current_space->local_used      += cnzi;
+    current_space->local_remaining -= cnzi;
+
+    ci[i+1] = ci[i] + cnzi;
+  }
+  ierr = PetscFree(htable);CHKERRQ(ierr);
+
+  /* Column indices are in the list of free space */
+  /* Allocate space for cj, initialize cj, and */
+  /* destroy list of free space and other temporary array(s) */
+  ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+  ierr = PetscFreeSpaceContiguous(&free_space,cj);CHKERRQ(ierr);
+
+  /* put together the new symbolic matrix */
+  ierr = MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A),am,bn,ci,cj,NULL,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(C,A,B);CHKERRQ(ierr);
+  ierr = MatSetType(C,((PetscObject)A)->type_name);CHKERRQ(ierr);
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)(C->data);
+  c->free_a  = PETSC_FALSE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  /* scalable, the numeric product uses a hash table of the size of the longest row of C */
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/(ai[am]+bi[bm]) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                  = ci[am];
+  c->nz                     = ci[am];
+  C->info.mallocs           = ndouble;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    ierr = PetscInfo3(C,"Reallocs %D; Fill ratio: given %g needed %g.\n",ndouble,(double)fill,(double)afill);CHKERRQ(ierr);
+    ierr = PetscInfo1(C,"Use MatMatMult(A,B,MatReuse,%g,&C) for best performance.;\n",(double)afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(C,"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* The nonzero pattern of C may come from any symbolic product, as long as the columns of its rows are sorted */
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode  ierr;
+  PetscLogDouble  flops=0.0;
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c=(Mat_SeqAIJ*)C->data;
+  const PetscInt  *ai=a->i,*aj=a->j,*bi=b->i,*bj=b->j,*ci=c->i,*cj=c->j,*bcol;
+  const MatScalar *aa=a->a,*ba=b->a,*bval;
+  PetscInt        am=A->rmap->N,cm=C->rmap->N;
+  PetscInt        i,j,k,col,h,mask,anzi,bnzj,cnzi,size,maxsize,*hkey,*hpos;
+  int             shift;
+  PetscScalar     *ca=c->a,*crow,valtmp;
+
+  PetscFunctionBegin;
+  if (!ca) { /* first call of MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash, allocate ca */
+    ierr      = PetscMalloc1(ci[cm]+1,&ca);CHKERRQ(ierr);
+    c->a      = ca;
+    c->free_a = PETSC_TRUE;
+  }
+  maxsize = MatMatMultHashSize_Private(c->rmax,NULL);
+  ierr    = PetscMalloc2(maxsize,&hkey,maxsize,&hpos);CHKERRQ(ierr);
+  for (h=0; h<maxsize; h++) hkey[h] = -1;
+
+  for (i=0; i<am; i++) {
+    anzi = ai[i+1] - ai[i];
+    cnzi = ci[i+1] - ci[i];
+    crow = ca + ci[i];
+    size = MatMatMultHashSize_Private(cnzi,&shift);
+    mask = size - 1;
+
+    /* map the columns of the row of C to their position in the row */
+    for (k=0; k<cnzi; k++) {
+      col = cj[ci[i]+k];
+      h   = MatMatMultHash_Private(col,shift);
+      while (hkey[h] >= 0) h = (h+1) & mask;
+      hkey[h] = col;
+      hpos[h] = k;
+      crow[k] = 0.0;
+    }
+    for (j=0; j<anzi; j++) {
+      bnzj   = bi[aj[j]+1] - bi[aj[j]];
+      bcol   = bj + bi[aj[j]];
+      bval   = ba + bi[aj[j]];
+      valtmp = aa[j];
+      for (k=0; k<bnzj; k++) {
+        col = bcol[k];
+        h   = MatMatMultHash_Private(col,shift);
+        while (hkey[h] != col) {
+          if (hkey[h] < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Column %D of row %D of A*B is not in the nonzero pattern of C",col,i);
+          h = (h+1) & mask;
+        }
+        crow[hpos[h]] += valtmp*bval[k];
+      }
+      flops += 2*bnzj;
+    }
+    aj += anzi; aa += anzi;
+    for (h=0; h<size; h++) hkey[h] = -1;
+  }
+  ierr = PetscFree2(hkey,hpos);CHKERRQ(ierr);
+
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* concatenate unique entries and then sort */
 PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Sorted(Mat A,Mat B,PetscReal fill,Mat C)
 {
@@ -1884,11 +2089,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
-#else
-  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hypre"};
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash"};
   PetscInt       nalg = 8;
+#else
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash","hypre"};
+  PetscInt       nalg = 9;
 #endif
 
   PetscFunctionBegin;
@@ -1994,11 +2199,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool      flg = PETSC_FALSE;
   PetscInt       alg = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char      *algTypes[2] = {"scalable","rap"};
-  PetscInt        nalg = 2;
-#else
-  const char      *algTypes[3] = {"scalable","rap","hypre"};
+  const char      *algTypes[3] = {"scalable","rap","hash"};
   PetscInt        nalg = 3;
+#else
+  const char      *algTypes[4] = {"scalable","rap","hash","hypre"};
+  PetscInt        nalg = 4;
 #endif
 
   PetscFunctionBegin;
@@ -2067,8 +2272,8 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_ABC(Mat C)
   Mat_Product    *product = C->product;
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash"};
+  PetscInt       nalg = 8;
 
   PetscFunctionBegin;
   /* Set default algorithm */
@@ -1201,6 +1201,7 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   ierr = PetscFree(a->mult_work);CHKERRQ(ierr);
   ierr = PetscFree(a->sor_workt);CHKERRQ(ierr);
   ierr = PetscFree(a->sor_work);CHKERRQ(ierr);
+  ierr = PetscArenaDestroy(&a->rowarena);CHKERRQ(ierr);
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
@@ -1275,8 +1276,12 @@ PetscErrorCode MatSetOption_SeqBAIJ(Mat A,MatOption op,PetscBool flg)
   PetscFunctionReturn(0);
 }
 
-/* used for both SeqBAIJ and SeqSBAIJ matrices */
-PetscErrorCode MatGetRow_SeqBAIJ_private(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v,PetscInt *ai,PetscInt *aj,PetscScalar *aa)
+/* used for both SeqBAIJ and SeqSBAIJ matrices
+
+   The arrays are taken from an arena kept by the matrix and released by MatRestoreRow(), so a loop over the rows does
+   not call PetscMalloc() and PetscFree() for each row. Rows that are gotten together must be restored in reverse order.
+*/
+PetscErrorCode MatGetRow_SeqBAIJ_private(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v,PetscInt *ai,PetscInt *aj,PetscScalar *aa,PetscArena *arena)
 {
   PetscErrorCode ierr;
   PetscInt       itmp,i,j,k,M,bn,bp,*idx_i,bs,bs2;
@@ -1293,10 +1298,13 @@ PetscErrorCode MatGetRow_SeqBAIJ_private(Mat A,PetscInt row,PetscInt *nz,PetscIn
   M   = ai[bn+1] - ai[bn];
   *nz = bs*M;
 
+  if (!*arena) {ierr = PetscArenaCreate(0,arena);CHKERRQ(ierr);}
+  ierr = PetscArenaBegin(*arena);CHKERRQ(ierr);
+
   if (v) {
     *v = 0;
     if (*nz) {
-      ierr = PetscMalloc1(*nz,v);CHKERRQ(ierr);
+      ierr = PetscArenaGet(*arena,*nz*sizeof(PetscScalar),v);CHKERRQ(ierr);
       for (i=0; i<M; i++) { /* for each block in the block row */
         v_i  = *v + i*bs;
         aa_i = aa + bs2*(ai[bn] + i);
@@ -1308,7 +1316,7 @@ PetscErrorCode MatGetRow_SeqBAIJ_private(Mat A,PetscInt row,PetscInt *nz,PetscIn
   if (idx) {
     *idx = 0;
     if (*nz) {
-      ierr = PetscMalloc1(*nz,idx);CHKERRQ(ierr);
+      ierr = PetscArenaGet(*arena,*nz*sizeof(PetscInt),idx);CHKERRQ(ierr);
       for (i=0; i<M; i++) { /* for each block in the block row */
         idx_i = *idx + i*bs;
         itmp  = bs*aj[ai[bn] + i];
@@ -1325,17 +1333,20 @@ PetscErrorCode MatGetRow_SeqBAIJ(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MatGetRow_SeqBAIJ_private(A,row,nz,idx,v,a->i,a->j,a->a);CHKERRQ(ierr);
+  ierr = MatGetRow_SeqBAIJ_private(A,row,nz,idx,v,a->i,a->j,a->a,&a->rowarena);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 PetscErrorCode MatRestoreRow_SeqBAIJ(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v)
 {
+  Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*)A->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  if (idx) {ierr = PetscFree(*idx);CHKERRQ(ierr);}
-  if (v)   {ierr = PetscFree(*v);CHKERRQ(ierr);}
+  if (!a->rowarena) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"MatGetRow() not called");
+  ierr = PetscArenaEnd(a->rowarena);CHKERRQ(ierr);
+  if (idx) *idx = NULL;
+  if (v)   *v   = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -2809,6 +2820,7 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   b    = (Mat_SeqBAIJ*)B->data;
   ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),NULL,"Optimize options for SEQBAIJ matrix 2 ","Mat");CHKERRQ(ierr);
   ierr = PetscOptionsBool("-mat_no_unroll","Do not optimize for block size (slow)",NULL,flg,&flg,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_no_simd","Do not use the vectorized kernels for block sizes 2 to 8",NULL,b->nosimd,&b->nosimd,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
   if (!flg) {
@@ -2820,26 +2832,72 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
     case 2:
       B->ops->mult    = MatMult_SeqBAIJ_2;
       B->ops->multadd = MatMultAdd_SeqBAIJ_2;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_2_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_2_SIMD;
+      }
+#endif
       break;
     case 3:
       B->ops->mult    = MatMult_SeqBAIJ_3;
       B->ops->multadd = MatMultAdd_SeqBAIJ_3;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_3_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_3_SIMD;
+      }
+#endif
       break;
     case 4:
       B->ops->mult    = MatMult_SeqBAIJ_4;
       B->ops->multadd = MatMultAdd_SeqBAIJ_4;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_4_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_4_SIMD;
+      }
+#endif
       break;
     case 5:
       B->ops->mult    = MatMult_SeqBAIJ_5;
       B->ops->multadd = MatMultAdd_SeqBAIJ_5;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_5_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_5_SIMD;
+      }
+#endif
       break;
     case 6:
       B->ops->mult    = MatMult_SeqBAIJ_6;
       B->ops->multadd = MatMultAdd_SeqBAIJ_6;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_6_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_6_SIMD;
+      }
+#endif
       break;
     case 7:
       B->ops->mult    = MatMult_SeqBAIJ_7;
       B->ops->multadd = MatMultAdd_SeqBAIJ_7;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_7_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_7_SIMD;
+      }
+#endif
+      break;
+    case 8:
+      B->ops->mult    = MatMult_SeqBAIJ_N;
+      B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!b->nosimd) {
+        B->ops->mult    = MatMult_SeqBAIJ_8_SIMD;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_8_SIMD;
+      }
+#endif
       break;
     case 9:
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
@@ -3343,6 +3401,7 @@ PetscErrorCode MatLoad_SeqBAIJ(Mat mat,PetscViewer viewer)
    Options Database Keys:
 +   -mat_no_unroll - uses code that does not unroll the loops in the
                      block calculations (much slower)
+.   -mat_no_simd - uses the kernels that are not vectorized with AVX2 or AVX-512 for block sizes 2 to 8
 -    -mat_block_size - size of the blocks to use
 
    Level: intermediate
@@ -3397,6 +3456,7 @@ PetscErrorCode  MatCreateSeqBAIJ(MPI_Comm comm,PetscInt bs,PetscInt m,PetscInt n
    Options Database Keys:
 +   -mat_no_unroll - uses code that does not unroll the loops in the
                      block calculations (much slower)
+.   -mat_no_simd - uses the kernels that are not vectorized with AVX2 or AVX-512 for block sizes 2 to 8
 -   -mat_block_size - size of the blocks to use
 
    Level: intermediate
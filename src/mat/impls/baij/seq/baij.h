@@ -20,6 +20,7 @@
   MatScalar   *saved_values;                                                                    \
                                                                                                      \
   Mat         sbaijMat;                      /* mat in sbaij format */                                       \
+  PetscArena  rowarena;              /* arrays of MatGetRow(), released by MatRestoreRow() */        \
                                                                                                      \
                                                                                                      \
   MatScalar     *idiag;            /* inverse of block diagonal  */                                \
@@ -28,6 +29,7 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
+  PetscBool nosimd;                 /* use the kernels that are not vectorized, -mat_no_simd */
 } Mat_SeqBAIJ;
 
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz,PetscInt *nnz);
@@ -234,10 +236,38 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_7(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_9_AVX2(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_11(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_N(Mat,Vec,Vec,Vec);
+
+/* vectorized kernels for block sizes 2 through 8, see baijsimd.c */
+#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES) && !defined(PETSC_SKIP_IMMINTRIN_H_CUDAWORKAROUND)
+#define MAT_SEQBAIJ_USE_SIMD
+#endif
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_2_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_3_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_4_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_5_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_6_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_7_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_8_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_2_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_3_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_4_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_5_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_6_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_7_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_8_SIMD(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_2_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_3_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_4_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_5_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_6_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_7_NaturalOrdering_SIMD(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_8_NaturalOrdering_SIMD(Mat,Vec,Vec);
+#endif
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization_inplace(Mat,PetscBool);
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat,PetscBool);
 
-PETSC_INTERN PetscErrorCode MatGetRow_SeqBAIJ_private(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**,PetscInt*,PetscInt*,PetscScalar*);
+PETSC_INTERN PetscErrorCode MatGetRow_SeqBAIJ_private(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**,PetscInt*,PetscInt*,PetscScalar*,PetscArena*);
 PETSC_INTERN PetscErrorCode MatAXPYGetPreallocation_SeqBAIJ(Mat,Mat,PetscInt*);
 
 PETSC_INTERN PetscErrorCode MatCreateMPIMatConcatenateSeqMat_SeqBAIJ(MPI_Comm,Mat,PetscInt,MatReuse,Mat*);
@@ -230,6 +230,9 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_2_NaturalOrdering(Mat B,Mat A,const Ma
   ierr = PetscFree2(rtmp,mwork);CHKERRQ(ierr);
 
   C->ops->solve          = MatSolve_SeqBAIJ_2_NaturalOrdering;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+  if (!((Mat_SeqBAIJ*)C->data)->nosimd) C->ops->solve = MatSolve_SeqBAIJ_2_NaturalOrdering_SIMD;
+#endif
   C->ops->forwardsolve   = MatForwardSolve_SeqBAIJ_2_NaturalOrdering;
   C->ops->backwardsolve  = MatBackwardSolve_SeqBAIJ_2_NaturalOrdering;
   C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_2_NaturalOrdering;
@@ -674,6 +677,7 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqbaij_petsc(Mat A,MatFactorType ftype
   ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
   if (ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_ILU || ftype == MAT_FACTOR_ILUDT) {
     ierr = MatSetType(*B,MATSEQBAIJ);CHKERRQ(ierr);
+    ((Mat_SeqBAIJ*)(*B)->data)->nosimd = ((Mat_SeqBAIJ*)A->data)->nosimd;
 
     (*B)->ops->lufactorsymbolic  = MatLUFactorSymbolic_SeqBAIJ;
     (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqBAIJ;
@@ -456,6 +456,9 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_3_NaturalOrdering(Mat B,Mat A,const Ma
   ierr = PetscFree2(rtmp,mwork);CHKERRQ(ierr);
 
   C->ops->solve          = MatSolve_SeqBAIJ_3_NaturalOrdering;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+  if (!((Mat_SeqBAIJ*)C->data)->nosimd) C->ops->solve = MatSolve_SeqBAIJ_3_NaturalOrdering_SIMD;
+#endif
   C->ops->forwardsolve   = MatForwardSolve_SeqBAIJ_3_NaturalOrdering;
   C->ops->backwardsolve  = MatBackwardSolve_SeqBAIJ_3_NaturalOrdering;
   C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_3_NaturalOrdering;
@@ -235,6 +235,12 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_N(Mat B,Mat A,const MatFactorInfo *inf
   both_identity = (PetscBool) (row_identity && col_identity);
   if (both_identity) {
     switch (bs) {
+    case  8:
+      C->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+      if (!((Mat_SeqBAIJ*)C->data)->nosimd) C->ops->solve = MatSolve_SeqBAIJ_8_NaturalOrdering_SIMD;
+#endif
+      break;
     case  9:
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
       C->ops->solve = MatSolve_SeqBAIJ_9_NaturalOrdering;
@@ -672,6 +672,9 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_6_NaturalOrdering(Mat B,Mat A,const Ma
   ierr = PetscFree2(rtmp,mwork);CHKERRQ(ierr);
 
   C->ops->solve          = MatSolve_SeqBAIJ_6_NaturalOrdering;
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+  if (!((Mat_SeqBAIJ*)C->data)->nosimd) C->ops->solve = MatSolve_SeqBAIJ_6_NaturalOrdering_SIMD;
+#endif
   C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_6_NaturalOrdering;
   C->assembled           = PETSC_TRUE;
 
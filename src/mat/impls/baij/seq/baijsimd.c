@@ -0,0 +1,309 @@
+
+/*
+    Vectorized MatMult(), MatMultAdd() and MatSolve() (natural ordering) kernels for SeqBAIJ
+    matrices with block sizes 2 through 8.
+
+    A block column (at most 8 doubles) is held in a single AVX-512 register, or in a pair of
+    AVX2 registers; partial blocks use masked loads and stores so nothing is read or written
+    past the end of a block. Each kernel is a thin wrapper around a generic inline routine
+    called with a compile time block size so the compiler fully unrolls the column loop.
+
+    The kernels are selected at compile time, as in src/mat/impls/sell/seq/sell.c, based on
+    the instruction sets the compiler targets (for example with -march=native or -mavx512f)
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+
+#if defined(MAT_SEQBAIJ_USE_SIMD)
+#include <immintrin.h>
+
+#if defined(__AVX512F__)
+typedef struct {
+  __m512d r;
+} MatSeqBAIJ_SIMDBlock;
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDZero(void)
+{
+  MatSeqBAIJ_SIMDBlock z;
+  z.r = _mm512_setzero_pd();
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDLoad(PetscInt bs,const PetscScalar *p)
+{
+  MatSeqBAIJ_SIMDBlock z;
+  if (bs == 8) z.r = _mm512_loadu_pd(p);
+  else         z.r = _mm512_maskz_loadu_pd((__mmask8)((1<<bs)-1),p);
+  return z;
+}
+
+PETSC_STATIC_INLINE void MatSeqBAIJ_SIMDStore(PetscInt bs,PetscScalar *p,MatSeqBAIJ_SIMDBlock z)
+{
+  if (bs == 8) _mm512_storeu_pd(p,z.r);
+  else         _mm512_mask_storeu_pd(p,(__mmask8)((1<<bs)-1),z.r);
+}
+
+/* z += alpha*v or z -= alpha*v where v is a column of a block */
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDFMA(PetscInt bs,const MatScalar *v,PetscScalar alpha,MatSeqBAIJ_SIMDBlock z)
+{
+  z.r = _mm512_fmadd_pd(MatSeqBAIJ_SIMDLoad(bs,v).r,_mm512_set1_pd(alpha),z.r);
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDFNMA(PetscInt bs,const MatScalar *v,PetscScalar alpha,MatSeqBAIJ_SIMDBlock z)
+{
+  z.r = _mm512_fnmadd_pd(MatSeqBAIJ_SIMDLoad(bs,v).r,_mm512_set1_pd(alpha),z.r);
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDAdd(MatSeqBAIJ_SIMDBlock a,MatSeqBAIJ_SIMDBlock b)
+{
+  a.r = _mm512_add_pd(a.r,b.r);
+  return a;
+}
+#else
+typedef struct {
+  __m256d lo,hi;
+} MatSeqBAIJ_SIMDBlock;
+
+/* mask selecting the first k lanes of a 256 bit register, 0 < k < 4 */
+#define MatSeqBAIJ_SIMDMask(k) _mm256_set_epi64x(0LL,(k)>2 ? -1LL : 0LL,(k)>1 ? -1LL : 0LL,-1LL)
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDZero(void)
+{
+  MatSeqBAIJ_SIMDBlock z;
+  z.lo = _mm256_setzero_pd();
+  z.hi = _mm256_setzero_pd();
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDLoad(PetscInt bs,const PetscScalar *p)
+{
+  MatSeqBAIJ_SIMDBlock z;
+  if (bs >= 4) z.lo = _mm256_loadu_pd(p);
+  else         z.lo = _mm256_maskload_pd(p,MatSeqBAIJ_SIMDMask(bs));
+  if (bs == 8)     z.hi = _mm256_loadu_pd(p+4);
+  else if (bs > 4) z.hi = _mm256_maskload_pd(p+4,MatSeqBAIJ_SIMDMask(bs-4));
+  else             z.hi = _mm256_setzero_pd();
+  return z;
+}
+
+PETSC_STATIC_INLINE void MatSeqBAIJ_SIMDStore(PetscInt bs,PetscScalar *p,MatSeqBAIJ_SIMDBlock z)
+{
+  if (bs >= 4) _mm256_storeu_pd(p,z.lo);
+  else         _mm256_maskstore_pd(p,MatSeqBAIJ_SIMDMask(bs),z.lo);
+  if (bs == 8)     _mm256_storeu_pd(p+4,z.hi);
+  else if (bs > 4) _mm256_maskstore_pd(p+4,MatSeqBAIJ_SIMDMask(bs-4),z.hi);
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDFMA(PetscInt bs,const MatScalar *v,PetscScalar alpha,MatSeqBAIJ_SIMDBlock z)
+{
+  MatSeqBAIJ_SIMDBlock c = MatSeqBAIJ_SIMDLoad(bs,v);
+  __m256d              a = _mm256_set1_pd(alpha);
+
+  z.lo = _mm256_fmadd_pd(c.lo,a,z.lo);
+  if (bs > 4) z.hi = _mm256_fmadd_pd(c.hi,a,z.hi);
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDFNMA(PetscInt bs,const MatScalar *v,PetscScalar alpha,MatSeqBAIJ_SIMDBlock z)
+{
+  MatSeqBAIJ_SIMDBlock c = MatSeqBAIJ_SIMDLoad(bs,v);
+  __m256d              a = _mm256_set1_pd(alpha);
+
+  z.lo = _mm256_fnmadd_pd(c.lo,a,z.lo);
+  if (bs > 4) z.hi = _mm256_fnmadd_pd(c.hi,a,z.hi);
+  return z;
+}
+
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDAdd(MatSeqBAIJ_SIMDBlock a,MatSeqBAIJ_SIMDBlock b)
+{
+  a.lo = _mm256_add_pd(a.lo,b.lo);
+  a.hi = _mm256_add_pd(a.hi,b.hi);
+  return a;
+}
+#endif
+
+/*
+   z = z + A_ij x_j summed over the n blocks of a block row; even and odd columns of each block
+   are accumulated separately to shorten the FMA dependency chain
+*/
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDRow(PetscInt bs,PetscInt n,const PetscInt *idx,const MatScalar *v,const PetscScalar *x,MatSeqBAIJ_SIMDBlock z0)
+{
+  MatSeqBAIJ_SIMDBlock z1 = MatSeqBAIJ_SIMDZero();
+  const PetscScalar    *xb;
+  PetscInt             j,k;
+
+  for (j=0; j<n; j++) {
+    xb = x + bs*idx[j];
+    for (k=0; k<bs-1; k+=2) {
+      z0 = MatSeqBAIJ_SIMDFMA(bs,v+k*bs,xb[k],z0);
+      z1 = MatSeqBAIJ_SIMDFMA(bs,v+(k+1)*bs,xb[k+1],z1);
+    }
+    if (bs % 2) z0 = MatSeqBAIJ_SIMDFMA(bs,v+(bs-1)*bs,xb[bs-1],z0);
+    v += bs*bs;
+  }
+  return MatSeqBAIJ_SIMDAdd(z0,z1);
+}
+
+/* s = s - A_ij x_j summed over the n blocks of a row of a triangular factor */
+PETSC_STATIC_INLINE MatSeqBAIJ_SIMDBlock MatSeqBAIJ_SIMDRowSubtract(PetscInt bs,PetscInt n,const PetscInt *vi,const MatScalar *v,const PetscScalar *x,MatSeqBAIJ_SIMDBlock s)
+{
+  MatSeqBAIJ_SIMDBlock t = MatSeqBAIJ_SIMDZero();
+  const PetscScalar    *xb;
+  PetscInt             j,k;
+
+  for (j=0; j<n; j++) {
+    xb = x + bs*vi[j];
+    for (k=0; k<bs-1; k+=2) {
+      s = MatSeqBAIJ_SIMDFNMA(bs,v+k*bs,xb[k],s);
+      t = MatSeqBAIJ_SIMDFNMA(bs,v+(k+1)*bs,xb[k+1],t);
+    }
+    if (bs % 2) s = MatSeqBAIJ_SIMDFNMA(bs,v+(bs-1)*bs,xb[bs-1],s);
+    v += bs*bs;
+  }
+  return MatSeqBAIJ_SIMDAdd(s,t);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode MatMult_SeqBAIJ_SIMD_Private(Mat A,PetscInt bs,Vec xx,Vec zz)
+{
+  Mat_SeqBAIJ          *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar          *z,*zarray;
+  const PetscScalar    *x;
+  const MatScalar      *v = a->a;
+  const PetscInt       *idx = a->j,*ii,*ridx = NULL;
+  PetscInt             mbs,i,n;
+  PetscBool            usecprow = a->compressedrow.use;
+  MatSeqBAIJ_SIMDBlock sum;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&zarray);CHKERRQ(ierr);
+  if (usecprow) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    ierr = PetscArrayzero(zarray,bs*a->mbs);CHKERRQ(ierr);
+  } else {
+    mbs = a->mbs;
+    ii  = a->i;
+  }
+
+  for (i=0; i<mbs; i++) {
+    n    = ii[i+1] - ii[i];
+    z    = zarray + bs*(usecprow ? ridx[i] : i);
+    PetscPrefetchBlock(idx+n,n,0,PETSC_PREFETCH_HINT_NTA);           /* Indices for the next row (assumes same size as this one) */
+    PetscPrefetchBlock(v+bs*bs*n,bs*bs*n,0,PETSC_PREFETCH_HINT_NTA); /* Entries for the next row */
+    sum  = MatSeqBAIJ_SIMDRow(bs,n,idx,v,x,MatSeqBAIJ_SIMDZero());
+    MatSeqBAIJ_SIMDStore(bs,z,sum);
+    idx += n;
+    v   += bs*bs*n;
+  }
+
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*bs*bs*a->nz - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode MatMultAdd_SeqBAIJ_SIMD_Private(Mat A,PetscInt bs,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqBAIJ          *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar          *yarray,*zarray;
+  const PetscScalar    *x;
+  const MatScalar      *v = a->a;
+  const PetscInt       *idx = a->j,*ii,*ridx = NULL;
+  PetscInt             mbs = a->mbs,i,n,row;
+  PetscBool            usecprow = a->compressedrow.use;
+  MatSeqBAIJ_SIMDBlock sum;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
+  if (usecprow) {
+    if (zz != yy) {
+      ierr = PetscArraycpy(zarray,yarray,bs*mbs);CHKERRQ(ierr);
+    }
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else {
+    ii = a->i;
+  }
+
+  for (i=0; i<mbs; i++) {
+    n    = ii[i+1] - ii[i];
+    row  = bs*(usecprow ? ridx[i] : i);
+    PetscPrefetchBlock(idx+n,n,0,PETSC_PREFETCH_HINT_NTA);
+    PetscPrefetchBlock(v+bs*bs*n,bs*bs*n,0,PETSC_PREFETCH_HINT_NTA);
+    sum  = MatSeqBAIJ_SIMDRow(bs,n,idx,v,x,MatSeqBAIJ_SIMDLoad(bs,yarray+row));
+    MatSeqBAIJ_SIMDStore(bs,zarray+row,sum);
+    idx += n;
+    v   += bs*bs*n;
+  }
+
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*bs*bs*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Same algorithm as MatSolve_SeqBAIJ_N_NaturalOrdering(); the factor stores L by block rows,
+   U by block rows in reverse order, and the inverse of each diagonal block
+*/
+PETSC_STATIC_INLINE PetscErrorCode MatSolve_SeqBAIJ_NaturalOrdering_SIMD_Private(Mat A,PetscInt bs,Vec bb,Vec xx)
+{
+  Mat_SeqBAIJ          *a = (Mat_SeqBAIJ*)A->data;
+  const PetscInt       n = a->mbs,*ai = a->i,*aj = a->j,*adiag = a->diag,bs2 = bs*bs;
+  const MatScalar      *aa = a->a,*v;
+  PetscScalar          *x,s[8];
+  const PetscScalar    *b;
+  PetscInt             i,k,nz;
+  MatSeqBAIJ_SIMDBlock sum;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  for (i=0; i<n; i++) {
+    nz  = ai[i+1] - ai[i];
+    sum = MatSeqBAIJ_SIMDRowSubtract(bs,nz,aj+ai[i],aa+bs2*ai[i],x,MatSeqBAIJ_SIMDLoad(bs,b+bs*i));
+    MatSeqBAIJ_SIMDStore(bs,x+bs*i,sum);
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    nz  = adiag[i] - adiag[i+1] - 1;
+    v   = aa + bs2*(adiag[i+1]+1);
+    sum = MatSeqBAIJ_SIMDRowSubtract(bs,nz,aj+adiag[i+1]+1,v,x,MatSeqBAIJ_SIMDLoad(bs,x+bs*i));
+    /* x = inv_diagonal*x */
+    MatSeqBAIJ_SIMDStore(bs,s,sum);
+    v   = aa + bs2*adiag[i];
+    sum = MatSeqBAIJ_SIMDZero();
+    for (k=0; k<bs; k++) sum = MatSeqBAIJ_SIMDFMA(bs,v+k*bs,s[k],sum);
+    MatSeqBAIJ_SIMDStore(bs,x+bs*i,sum);
+  }
+
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*bs2*(a->nz) - bs*A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#define MatSeqBAIJ_SIMDKernels(bs) \
+  PetscErrorCode MatMult_SeqBAIJ_##bs##_SIMD(Mat A,Vec xx,Vec zz) {return MatMult_SeqBAIJ_SIMD_Private(A,bs,xx,zz);} \
+  PetscErrorCode MatMultAdd_SeqBAIJ_##bs##_SIMD(Mat A,Vec xx,Vec yy,Vec zz) {return MatMultAdd_SeqBAIJ_SIMD_Private(A,bs,xx,yy,zz);} \
+  PetscErrorCode MatSolve_SeqBAIJ_##bs##_NaturalOrdering_SIMD(Mat A,Vec bb,Vec xx) {return MatSolve_SeqBAIJ_NaturalOrdering_SIMD_Private(A,bs,bb,xx);}
+
+MatSeqBAIJ_SIMDKernels(2)
+MatSeqBAIJ_SIMDKernels(3)
+MatSeqBAIJ_SIMDKernels(4)
+MatSeqBAIJ_SIMDKernels(5)
+MatSeqBAIJ_SIMDKernels(6)
+MatSeqBAIJ_SIMDKernels(7)
+MatSeqBAIJ_SIMDKernels(8)
+#endif
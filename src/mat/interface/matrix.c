@@ -12,7 +12,7 @@ PetscClassId MAT_COLORING_CLASSID;
 PetscClassId MAT_FDCOLORING_CLASSID;
 PetscClassId MAT_TRANSPOSECOLORING_CLASSID;
 
-PetscLogEvent MAT_Mult, MAT_Mults, MAT_MultConstrained, MAT_MultAdd, MAT_MultTranspose;
+PetscLogEvent MAT_Mult, MAT_Mults, MAT_MultConstrained, MAT_MultAdd, MAT_MultPowers, MAT_MultTranspose;
 PetscLogEvent MAT_MultTransposeConstrained, MAT_MultTransposeAdd, MAT_Solve, MAT_Solves, MAT_SolveAdd, MAT_SolveTranspose, MAT_MatSolve,MAT_MatTrSolve;
 PetscLogEvent MAT_SolveTransposeAdd, MAT_SOR, MAT_ForwardSolve, MAT_BackwardSolve, MAT_LUFactor, MAT_LUFactorSymbolic;
 PetscLogEvent MAT_LUFactorNumeric, MAT_CholeskyFactor, MAT_CholeskyFactorSymbolic, MAT_CholeskyFactorNumeric, MAT_ILUFactor;
@@ -32,6 +32,7 @@ PetscLogEvent MAT_GetBrowsOfAocols, MAT_Getlocalmat, MAT_Getlocalmatcondensed, M
 PetscLogEvent MAT_Applypapt, MAT_Applypapt_numeric, MAT_Applypapt_symbolic, MAT_GetSequentialNonzeroStructure;
 PetscLogEvent MAT_GetMultiProcBlock;
 PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
+PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
@@ -2030,6 +2031,163 @@ PetscErrorCode MatSetValuesBatch(Mat mat, PetscInt nb, PetscInt bs, PetscInt row
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat            preallocator;
+  IS             is_coo_i,is_coo_j;
+  PetscScalar    zero = 0.0;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),&preallocator);CHKERRQ(ierr);
+  ierr = MatSetType(preallocator,MATPREALLOCATOR);CHKERRQ(ierr);
+  ierr = MatSetSizes(preallocator,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(preallocator,A,A);CHKERRQ(ierr);
+  ierr = MatSetUp(preallocator);CHKERRQ(ierr);
+  for (n = 0; n < ncoo; n++) {
+    ierr = MatSetValue(preallocator,coo_i[n],coo_j[n],zero,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatPreallocatorPreallocate(preallocator,PETSC_TRUE,A);CHKERRQ(ierr);
+  ierr = MatDestroy(&preallocator);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,ncoo,coo_i,PETSC_COPY_VALUES,&is_coo_i);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,ncoo,coo_j,PETSC_COPY_VALUES,&is_coo_j);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_coo_i",(PetscObject)is_coo_i);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_coo_j",(PetscObject)is_coo_j);CHKERRQ(ierr);
+  ierr = ISDestroy(&is_coo_i);CHKERRQ(ierr);
+  ierr = ISDestroy(&is_coo_j);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_Basic(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  IS             is_coo_i,is_coo_j;
+  const PetscInt *coo_i,*coo_j;
+  PetscInt       n,n_i,n_j;
+  PetscScalar    zero = 0.0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_coo_i",(PetscObject*)&is_coo_i);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_coo_j",(PetscObject*)&is_coo_j);CHKERRQ(ierr);
+  if (!is_coo_i || !is_coo_j) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = ISGetLocalSize(is_coo_i,&n_i);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(is_coo_j,&n_j);CHKERRQ(ierr);
+  if (n_i != n_j) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_COR,"Wrong local size %D != %D",n_i,n_j);
+  ierr = ISGetIndices(is_coo_i,&coo_i);CHKERRQ(ierr);
+  ierr = ISGetIndices(is_coo_j,&coo_j);CHKERRQ(ierr);
+  if (imode != ADD_VALUES) {
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  }
+  for (n = 0; n < n_i; n++) {
+    ierr = MatSetValue(A,coo_i[n],coo_j[n],coo_v ? coo_v[n] : zero,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(is_coo_i,&coo_i);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(is_coo_j,&coo_j);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetPreallocationCOO - set preallocation for matrices using a coordinate format of the entries
+
+   Collective on Mat
+
+   Input Parameters:
++  A - matrix being preallocated
+.  n - number of entries in the input arrays
+.  coo_i - row indices
+-  coo_j - column indices
+
+   Level: beginner
+
+   Notes:
+   The indices are global and may refer to rows owned by other processes; entries with a negative row or column
+   index are ignored. The same (row,column) pair may appear several times, the corresponding values passed to
+   MatSetValuesCOO() are summed.
+
+   The indices are not needed after this call returns, they are copied if the matrix type needs them.
+
+   For MATSEQAIJ and MATMPIAIJ the nonzero structure is built directly from the entries, together with the
+   permutation from the input ordering to the compressed row storage and, in parallel, the PetscSF that routes
+   the values of off-process entries to their owners. MatSetValuesCOO() then neither searches for the location of
+   an entry nor goes through the MatStash. Other matrix types fall back to MatSetValues().
+
+.seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatPreallocatorPreallocate()
+@*/
+PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt ncoo,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode (*f)(Mat,PetscInt,const PetscInt[],const PetscInt[]) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (ncoo) PetscValidIntPointer(coo_i,3);
+  if (ncoo) PetscValidIntPointer(coo_j,4);
+  if (ncoo < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of COO entries cannot be negative: %D",ncoo);
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetPreallocationCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetPreallocationCOO_Basic(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  A->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetValuesCOO - set values at once in a matrix preallocated using MatSetPreallocationCOO()
+
+   Collective on Mat
+
+   Input Parameters:
++  A - matrix being preallocated
+.  coo_v - the matrix values, in the same order as the indices passed to MatSetPreallocationCOO(); may be NULL to set zeros
+-  imode - the insert mode
+
+   Level: beginner
+
+   Notes:
+   Values of repeated entries are summed. With INSERT_VALUES the matrix entries are replaced by these sums, with
+   ADD_VALUES the sums are added to the current values.
+
+   The matrix is assembled when this call returns; MatAssemblyBegin() and MatAssemblyEnd() need not be called.
+
+.seealso: MatSetPreallocationCOO(), InsertMode, INSERT_VALUES, ADD_VALUES
+@*/
+PetscErrorCode MatSetValuesCOO(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode (*f)(Mat,const PetscScalar[],InsertMode) = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  MatCheckPreallocated(A,1);
+  PetscValidLogicalCollectiveEnum(A,imode,3);
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONG,"Only INSERT_VALUES and ADD_VALUES are supported");
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetValuesCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,coo_v,imode);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetValuesCOO_Basic(A,coo_v,imode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatSetLocalToGlobalMapping - Sets a local-to-global numbering for use by
    the routine MatSetValuesLocal() to allow users to insert matrix entries
@@ -2561,6 +2719,72 @@ PetscErrorCode MatMultAdd(Mat mat,Vec v1,Vec v2,Vec v3)
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatMultPowers - Computes the products of the powers A, A^2, ..., A^k of a square matrix with a vector.
+
+   Neighbor-wise Collective on Mat
+
+   Input Parameters:
++  mat - the matrix
+.  k - the highest power
+-  x - the vector
+
+   Output Parameter:
+.  y - array of k vectors, y[j] = A^(j+1) x
+
+   Notes:
+   For MATMPIAIJ, the first call gathers on each process the rows of the matrix whose distance to the local rows in
+   the graph of the matrix is less than k, as MatIncreaseOverlap() does. Then all the products are computed with a
+   single exchange of x at distance k, at the price of the redundant computation on the gathered rows. This trades
+   k-1 messages per process for some memory and flops, which pays off when MatMult() is latency-bound, for example in
+   polynomial smoothers or s-step Krylov methods on small local problems. The gathered rows are kept with the matrix
+   and their values are refreshed when the matrix changes.
+
+   Other matrix types call MatMult() k times.
+
+   Level: advanced
+
+.seealso: MatMult(), MatIncreaseOverlap()
+@*/
+PetscErrorCode MatMultPowers(Mat mat,PetscInt k,Vec x,Vec y[])
+{
+  PetscErrorCode ierr,(*f)(Mat,PetscInt,Vec,Vec[]);
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  PetscValidType(mat,1);
+  PetscValidLogicalCollectiveInt(mat,k,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  if (k < 0) SETERRQ1(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_OUTOFRANGE,"Power %D must be nonnegative",k);
+  if (!k) PetscFunctionReturn(0);
+  PetscValidPointer(y,4);
+  if (!mat->assembled) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_WRONGSTATE,"Not for unassembled matrix");
+  if (mat->factortype) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_WRONGSTATE,"Not for factored matrix");
+  if (mat->rmap->N != mat->cmap->N) SETERRQ2(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_SIZ,"Matrix must be square, %D %D",mat->rmap->N,mat->cmap->N);
+  if (mat->cmap->N != x->map->N) SETERRQ2(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_SIZ,"Mat mat,Vec x: global dim %D %D",mat->cmap->N,x->map->N);
+  for (j=0; j<k; j++) {
+    PetscValidHeaderSpecific(y[j],VEC_CLASSID,4);
+    if (y[j] == x) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_IDN,"x and y must be different vectors");
+    if (mat->rmap->n != y[j]->map->n) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Mat mat,Vec y[%D]: local dim %D %D",j,mat->rmap->n,y[j]->map->n);
+  }
+  MatCheckPreallocated(mat,1);
+
+  ierr = PetscObjectQueryFunction((PetscObject)mat,"MatMultPowers_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_MultPowers,mat,x,0,0);CHKERRQ(ierr);
+  ierr = VecLockReadPush(x);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(mat,k,x,y);CHKERRQ(ierr);
+  } else {
+    ierr = MatMult(mat,x,y[0]);CHKERRQ(ierr);
+    for (j=1; j<k; j++) {ierr = MatMult(mat,y[j-1],y[j]);CHKERRQ(ierr);}
+  }
+  ierr = VecLockReadPop(x);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_MultPowers,mat,x,0,0);CHKERRQ(ierr);
+  for (j=0; j<k; j++) {ierr = PetscObjectStateIncrease((PetscObject)y[j]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMultTransposeAdd - Computes v3 = v2 + A' * v1.
 
@@ -5415,7 +5639,8 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
         performance for very large process counts.
 -    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
-        functions, instead sending only neighbor messages.
+        functions, instead sending only neighbor messages. With -matstash_persistent these messages use MPI persistent
+        requests bound to buffers sized by the first assembly.
 
    Notes:
    Except for MAT_UNUSED_NONZERO_LOCATION_ERR and  MAT_ROW_ORIENTED all processes that share the matrix must pass the same value in flg!
@@ -0,0 +1,108 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO()\n\n";
+
+#include <petscmat.h>
+
+/* checks that A = alpha B */
+static PetscErrorCode CheckDifference(Mat A,Mat B,PetscScalar alpha,const char mode[])
+{
+  Mat            D;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatDuplicate(A,MAT_COPY_VALUES,&D);CHKERRQ(ierr);
+  ierr = MatAXPY(D,-alpha,B,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(D,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatSetValuesCOO() with %s differs from MatSetValues(): %g\n",mode,(double)norm);CHKERRQ(ierr);}
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  PetscInt       M = 12,i,k,n = 0,cnt,*coo_i,*coo_j;
+  const PetscInt cols[] = {-2,0,3,0,1};
+  PetscScalar    *coo_v;
+  PetscReal      norm;
+  PetscMPIInt    rank,size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+
+  /* the entries of row i are generated by process i % size, so most of them are off-process; columns repeat and one
+     entry per row has a negative index which must be ignored */
+  for (i=rank; i<M; i+=size) n += 7;
+  ierr = PetscMalloc3(n,&coo_i,n,&coo_j,n,&coo_v);CHKERRQ(ierr);
+  cnt = 0;
+  for (i=rank; i<M; i+=size) {
+    for (k=0; k<5; k++) {
+      coo_i[cnt]   = i;
+      coo_j[cnt]   = (i+cols[k]+M)%M;
+      coo_v[cnt++] = (PetscScalar)(i+1) + 0.01*(k+1);
+    }
+    coo_i[cnt]   = M-1-i;
+    coo_j[cnt]   = i;
+    coo_v[cnt++] = -1.0*(i+1);
+    coo_i[cnt]   = -1;
+    coo_j[cnt]   = i;
+    coo_v[cnt++] = 1000.0;
+  }
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,M,M);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetPreallocationCOO(A,n,coo_i,coo_j);CHKERRQ(ierr);
+
+  /* reference matrix assembled with MatSetValues() */
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,M,M);CHKERRQ(ierr);
+  ierr = MatSetType(B,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    ierr = MatSetValue(B,coo_i[k],coo_j[k],coo_v[k],ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Norm of the COO matrix %g\n",(double)norm);CHKERRQ(ierr);
+  ierr = CheckDifference(A,B,1.0,"INSERT_VALUES");CHKERRQ(ierr);
+
+  /* A = 2 B through ADD_VALUES, then a second INSERT_VALUES with scaled values gives 3 B */
+  ierr = MatSetValuesCOO(A,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = CheckDifference(A,B,2.0,"ADD_VALUES");CHKERRQ(ierr);
+  for (k=0; k<n; k++) coo_v[k] *= 3.0;
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = CheckDifference(A,B,3.0,"repeated INSERT_VALUES");CHKERRQ(ierr);
+
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex237_1.out
+
+   test:
+      suffix: baij
+      nsize: 2
+      args: -mat_type baij
+      output_file: output/ex237_1.out
+
+TEST*/
@@ -0,0 +1,97 @@
+static char help[] = "Tests MatMultPowers()\n\n";
+
+#include <petscmat.h>
+
+/* checks that y[j] = A^(j+1) x, computed with MatMult() */
+static PetscErrorCode CheckPowers(Mat A,PetscInt k,Vec x,Vec y[])
+{
+  Vec            z,w;
+  PetscReal      norm,nrm;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatMultPowers(A,k,x,y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecCopy(x,z);CHKERRQ(ierr);
+  for (j=0; j<k; j++) {
+    ierr = MatMult(A,z,w);CHKERRQ(ierr);
+    ierr = VecCopy(w,z);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(w,-1.0,y[j]);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_2,&norm);CHKERRQ(ierr);
+    if (norm > PETSC_SMALL*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultPowers() differs from MatMult() for power %D: %g\n",j+1,(double)(norm/nrm));CHKERRQ(ierr);}
+  }
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  Vec            x,*y;
+  PetscInt       n = 8,k = 4,i,j,Ii,J,Istart,Iend;
+  PetscScalar    v;
+  PetscRandom    rctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+
+  /* 2d convection-diffusion with upwinding in x, so the graph of the matrix is not symmetric */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (Ii=Istart; Ii<Iend; Ii++) {
+    i = Ii/n; j = Ii - i*n;
+    if (i>0)   {J = Ii - n; v = -1.0; ierr = MatSetValues(A,1,&Ii,1,&J,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i<n-1) {J = Ii + n; v = -1.0; ierr = MatSetValues(A,1,&Ii,1,&J,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j>0)   {J = Ii - 1; v = -1.5; ierr = MatSetValues(A,1,&Ii,1,&J,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = 4.5; ierr = MatSetValues(A,1,&Ii,1,&Ii,&v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatScale(A,0.25);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,k,&y);CHKERRQ(ierr);
+
+  ierr = CheckPowers(A,k,x,y);CHKERRQ(ierr);
+  /* Reuse the ghost region with new values */
+  ierr = MatShift(A,-0.5);CHKERRQ(ierr);
+  ierr = CheckPowers(A,k,x,y);CHKERRQ(ierr);
+  /* A different depth */
+  if (k > 2) {ierr = CheckPowers(A,2,x,y);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Powers of the matrix agree\n");CHKERRQ(ierr);
+
+  ierr = VecDestroyVecs(k,&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2 3}}
+      args: -k {{1 3}} -mat_type aij
+      output_file: output/ex238_1.out
+
+   test:
+      suffix: 2
+      nsize: 4
+      args: -n 12 -k 5 -mat_type aij -mat_increase_overlap_scalable
+      output_file: output/ex238_1.out
+
+TEST*/
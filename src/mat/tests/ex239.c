@@ -0,0 +1,100 @@
+static char help[] = "Compares the MIS and Luby coarseners on the graph of a 2d Laplacian.\n\n";
+
+#include <petscmat.h>
+#include <petscmatcoarsen.h>
+
+/* prints the number of aggregates and the range of their sizes, and the statistics of the coarsener */
+static PetscErrorCode TestCoarsen(Mat A,MatCoarsenType type)
+{
+  MatCoarsen       crs;
+  PetscCoarsenData *agg_lists;
+  PetscInt         lid,sz,n,N,loc[3],glob[3],sizes[2] = {PETSC_MAX_INT,0},gsizes[2];
+  PetscErrorCode   ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCoarsenCreate(PETSC_COMM_WORLD,&crs);CHKERRQ(ierr);
+  ierr = MatCoarsenSetType(crs,type);CHKERRQ(ierr);
+  ierr = MatCoarsenSetAdjacency(crs,A);CHKERRQ(ierr);
+  ierr = MatCoarsenSetStrictAggs(crs,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
+  ierr = MatCoarsenApply(crs);CHKERRQ(ierr);
+  ierr = MatCoarsenGetData(crs,&agg_lists);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&N,NULL);CHKERRQ(ierr);
+  loc[0] = loc[1] = loc[2] = 0;
+  for (lid=0; lid<n; lid++) {
+    ierr = PetscCDSizeAt(agg_lists,lid,&sz);CHKERRQ(ierr);
+    if (!sz) continue;
+    loc[0]++;
+    loc[1] += sz;
+    loc[2] += sz*sz;
+    sizes[0] = PetscMin(sizes[0],sz);
+    sizes[1] = PetscMax(sizes[1],sz);
+  }
+  ierr = MPIU_Allreduce(loc,glob,3,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  sizes[0] = -sizes[0];
+  ierr = MPIU_Allreduce(sizes,gsizes,2,MPIU_INT,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  if (glob[1] != N) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s aggregates cover %D of %D vertices\n",type,glob[1],N);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %D aggregates of size %D to %D, mean %g, mean square %g\n",type,glob[0],-gsizes[0],gsizes[1],(double)glob[1]/glob[0],(double)glob[2]/glob[0]);CHKERRQ(ierr);
+  ierr = MatCoarsenView(crs,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = PetscCDDestroy(agg_lists);CHKERRQ(ierr);
+  ierr = MatCoarsenDestroy(&crs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  PetscInt       n = 16,stride = 1,i,j,Ii,J,Istart,Iend,nb,nbrs[5];
+  PetscScalar    vals[5] = {4.0,-1.0,-1.0,-1.0,-1.0};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  /* number the vertex Ii as stride*Ii mod n^2, so that the neighbors of most vertices are on other processes */
+  ierr = PetscOptionsGetInt(NULL,NULL,"-stride",&stride,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n,5,NULL,5,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&Istart,&Iend);CHKERRQ(ierr);
+  for (Ii=Istart; Ii<Iend; Ii++) {
+    i = Ii/n; j = Ii - i*n; nb = 0;
+    nbrs[nb++] = Ii;
+    if (i>0)   nbrs[nb++] = Ii - n;
+    if (i<n-1) nbrs[nb++] = Ii + n;
+    if (j>0)   nbrs[nb++] = Ii - 1;
+    if (j<n-1) nbrs[nb++] = Ii + 1;
+    for (J=0; J<nb; J++) nbrs[J] = (stride*nbrs[J]) % (n*n);
+    ierr = MatSetValues(A,1,nbrs,nb,nbrs,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = TestCoarsen(A,MATCOARSENMIS);CHKERRQ(ierr);
+  ierr = TestCoarsen(A,MATCOARSENLUBY);CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+
+   test:
+      suffix: 2
+      nsize: 4
+      args: -n 32
+
+   test:
+      suffix: seed
+      nsize: 3
+      args: -mat_coarsen_luby_seed 7 -mat_coarsen_luby_by_process false
+
+   test:
+      suffix: stride
+      nsize: 8
+      args: -n 32 -stride 41
+
+TEST*/
@@ -0,0 +1,114 @@
+static char help[] = "Compares MatMult(), MatMultAdd() and MatSolve() of SeqBAIJ matrices with block sizes 2 to 8 with and without the vectorized kernels.\n\n";
+
+#include <petscmat.h>
+
+/* a block tridiagonal matrix, diagonally dominant so that LU without pivoting is stable */
+static PetscErrorCode CreateMatrix(PetscInt bs,PetscInt mbs,Mat *A)
+{
+  PetscScalar    *v;
+  PetscInt       i,j,k,l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,bs*mbs,bs*mbs,3,NULL,A);CHKERRQ(ierr);
+  ierr = PetscMalloc1(bs*bs,&v);CHKERRQ(ierr);
+  for (i=0; i<mbs; i++) {
+    for (j=PetscMax(i-1,0); j<=PetscMin(i+1,mbs-1); j++) {
+      for (k=0; k<bs; k++) {
+        for (l=0; l<bs; l++) v[k*bs+l] = 1.0/(1.0+k+2*l+i+3*j);
+        if (i == j) v[k*bs+k] += 4.0*bs;
+      }
+      ierr = MatSetValuesBlocked(*A,1,&i,1,&j,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* y = A x, z = y + A x and w = A^{-1} x with the LU factors in the natural ordering; returns the MatMult() and MatSolve() kernels */
+static PetscErrorCode Apply(Mat A,Vec x,Vec y,Vec z,Vec w,void (**mult)(void),void (**solve)(void))
+{
+  Mat            F;
+  IS             row,col;
+  MatFactorInfo  info;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,z);CHKERRQ(ierr);
+  ierr = MatGetOrdering(A,MATORDERINGNATURAL,&row,&col);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_LU,&F);CHKERRQ(ierr);
+  ierr = MatLUFactorSymbolic(F,A,row,col,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+  ierr = MatSolve(F,x,w);CHKERRQ(ierr);
+  ierr = MatGetOperation(A,MATOP_MULT,mult);CHKERRQ(ierr);
+  ierr = MatGetOperation(F,MATOP_SOLVE,solve);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = ISDestroy(&row);CHKERRQ(ierr);
+  ierr = ISDestroy(&col);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  Vec            x,y[2],z[2],w[2];
+  PetscInt       bs,mbs = 20,i;
+  PetscReal      ny,nz,nw,norm;
+  PetscRandom    rand;
+  void           (*mult[2])(void),(*solve[2])(void);
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mbs",&mbs,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  for (bs=2; bs<=8; bs++) {
+    ierr = VecCreateSeq(PETSC_COMM_SELF,bs*mbs,&x);CHKERRQ(ierr);
+    ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+    for (i=0; i<2; i++) {
+      ierr = VecDuplicate(x,&y[i]);CHKERRQ(ierr);
+      ierr = VecDuplicate(x,&z[i]);CHKERRQ(ierr);
+      ierr = VecDuplicate(x,&w[i]);CHKERRQ(ierr);
+      /* the second time with the kernels that are not vectorized */
+      if (i) {ierr = PetscOptionsSetValue(NULL,"-mat_no_simd",NULL);CHKERRQ(ierr);}
+      ierr = CreateMatrix(bs,mbs,&A);CHKERRQ(ierr);
+      ierr = Apply(A,x,y[i],z[i],w[i],&mult[i],&solve[i]);CHKERRQ(ierr);
+      ierr = MatDestroy(&A);CHKERRQ(ierr);
+      if (i) {ierr = PetscOptionsClearValue(NULL,"-mat_no_simd");CHKERRQ(ierr);}
+    }
+    /* the comparison below is only meaningful if the vectorized kernels were selected */
+    ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: %s MatMult(), %s MatSolve()\n",bs,mult[0] != mult[1] ? "vectorized" : "plain",solve[0] != solve[1] ? "vectorized" : "plain");CHKERRQ(ierr);
+    ierr = VecNorm(y[1],NORM_2,&ny);CHKERRQ(ierr);
+    ierr = VecNorm(z[1],NORM_2,&nz);CHKERRQ(ierr);
+    ierr = VecNorm(w[1],NORM_2,&nw);CHKERRQ(ierr);
+    ierr = VecAXPY(y[0],-1.0,y[1]);CHKERRQ(ierr);
+    ierr = VecAXPY(z[0],-1.0,z[1]);CHKERRQ(ierr);
+    ierr = VecAXPY(w[0],-1.0,w[1]);CHKERRQ(ierr);
+    ierr = VecNorm(y[0],NORM_2,&norm);CHKERRQ(ierr);
+    if (norm > 100*PETSC_MACHINE_EPSILON*ny) {ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: MatMult() differs by %g\n",bs,(double)norm);CHKERRQ(ierr);}
+    ierr = VecNorm(z[0],NORM_2,&norm);CHKERRQ(ierr);
+    if (norm > 100*PETSC_MACHINE_EPSILON*nz) {ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: MatMultAdd() differs by %g\n",bs,(double)norm);CHKERRQ(ierr);}
+    ierr = VecNorm(w[0],NORM_2,&norm);CHKERRQ(ierr);
+    if (norm > 100*PETSC_MACHINE_EPSILON*nw) {ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: MatSolve() differs by %g\n",bs,(double)norm);CHKERRQ(ierr);}
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    for (i=0; i<2; i++) {
+      ierr = VecDestroy(&y[i]);CHKERRQ(ierr);
+      ierr = VecDestroy(&z[i]);CHKERRQ(ierr);
+      ierr = VecDestroy(&w[i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      requires: double !complex !define(PETSC_USE_64BIT_INDICES) define(PETSC_HAVE_IMMINTRIN_H) define(PETSC_HAVE_AVX2_FMA)
+
+TEST*/
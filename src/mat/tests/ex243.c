@@ -0,0 +1,78 @@
+static char help[] = "Tests that MatAIJSetSinglePrecision() on a MATMPIAIJ matrix survives a new nonzero in the off-diagonal block and MatDuplicate().\n\n";
+
+#include <petscmat.h>
+
+/* a tridiagonal matrix whose off-diagonal block values are not representable in single precision */
+static PetscErrorCode CreateMatrix(PetscBool single,Mat *A)
+{
+  PetscInt       i,j,rstart,rend,N;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,6,6,PETSC_DETERMINE,PETSC_DETERMINE,3,NULL,2,NULL,A);CHKERRQ(ierr);
+  ierr = MatSetOption(*A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(*A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = MatGetSize(*A,&N,NULL);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    for (j=PetscMax(i-1,0); j<=PetscMin(i+1,N-1); j++) {
+      v    = (j >= rstart && j < rend) ? 0.5 : 1.0/(3.0+i+j);
+      ierr = MatSetValues(*A,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (single) {ierr = MatAIJSetSinglePrecision(*A,PETSC_TRUE);CHKERRQ(ierr);}
+  /* a nonzero in a new off-process column, the off-diagonal block is disassembled and created again */
+  i    = rstart;
+  j    = (rend+2)%N;
+  v    = 1.0/7.0;
+  ierr = MatSetValues(*A,1,&i,1,&j,&v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B,C;
+  Vec            x,y,z;
+  PetscReal      norm,diff;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = CreateMatrix(PETSC_FALSE,&A);CHKERRQ(ierr);
+  ierr = CreateMatrix(PETSC_TRUE,&B);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecSet(x,0.25);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&diff);CHKERRQ(ierr);
+  /* only the products with the off-diagonal block differ from the double ones, by about 1e-8 */
+  if (diff < 1.e-12*norm || diff > 1.e-5*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative difference of the single precision product %g\n",(double)(diff/norm));CHKERRQ(ierr);}
+  /* the duplicate uses the single precision values as well */
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = MatMult(C,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&diff);CHKERRQ(ierr);
+  if (diff < 1.e-12*norm || diff > 1.e-5*norm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative difference of the duplicated single precision product %g\n",(double)(diff/norm));CHKERRQ(ierr);}
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 2
+      requires: double !complex
+
+TEST*/
@@ -65,6 +65,12 @@ int main(int argc,char **argv)
   ierr = MatPtAPMultEqual(A,B,C,10,&isequal);CHKERRQ(ierr);
   if (!isequal) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_INCOMP,"MatPtAP(reuse): C != B^T*A*B");
 
+  /* New values of P with the same nonzero pattern */
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = MatPtAP(A,B,MAT_REUSE_MATRIX,fill,&C);CHKERRQ(ierr);
+  ierr = MatPtAPMultEqual(A,B,C,10,&isequal);CHKERRQ(ierr);
+  if (!isequal) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_INCOMP,"MatPtAP(reuse, new P): C != B^T*A*B");
+
   ierr = MatDestroy(&C);CHKERRQ(ierr);
   ierr = MatDestroy(&B);CHKERRQ(ierr);
 
@@ -204,6 +210,17 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via heap
       output_file: output/ex93_1.out
 
+   test:
+      suffix: hash
+      args: -matmatmult_via hash -matptap_via hash
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: hash_2
+      nsize: 2
+      args: -matptap_via hash
+      output_file: output/ex93_1.out
+
    #HYPRE PtAP is broken for complex numbers
    test:
       suffix: hypre
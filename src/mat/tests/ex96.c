@@ -208,6 +208,7 @@ int main(int argc,char **argv)
     for (i=0; i<1; i++) {
       alpha -= 0.1;
       ierr   = MatScale(A,alpha);CHKERRQ(ierr);
+      ierr   = MatScale(P,alpha);CHKERRQ(ierr); /* new values of P are moved again to the processes that need them */
       ierr   = MatPtAP(A,P,MAT_REUSE_MATRIX,fill,&C);CHKERRQ(ierr);
     }
 
@@ -328,6 +329,18 @@ int main(int argc,char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_matproduct_ab_via rowmerge -inner_offdiag_matproduct_ab_via rowmerge
      output_file: output/ex96_1.out
 
+   test:
+     suffix: seq_hash
+     nsize: 3
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_matproduct_ab_via hash -inner_offdiag_matproduct_ab_via hash
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: hash
+     nsize: {{1 3}}
+     args: -Mx 10 -My 5 -Mz 10 -matptap_via hash
+     output_file: output/ex96_1.out
+
    test:
      suffix: allatonce
      nsize: 3
@@ -79,7 +79,11 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
 
+  stash->persistent       = PETSC_FALSE;
+  stash->persistent_setup = PETSC_FALSE;
+
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_reproduce",&stash->reproduce,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_persistent",&stash->persistent,NULL);CHKERRQ(ierr);
 #if !defined(PETSC_HAVE_MPIUNI)
   flg  = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_legacy",&flg,NULL);CHKERRQ(ierr);
@@ -828,6 +832,66 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionReturn(0);
 }
 
+/*
+ * Starts the neighbor messages of a reused communication pattern with persistent requests.
+ *
+ * The requests are bound to buffers sized by the counts of the first assembly, which bound the counts of all later
+ * assemblies when MAT_SUBSET_OFF_PROC_ENTRIES is set. The receives are always posted for the full capacity and the
+ * actual count is taken from the status. A send is only reinitialized when its count differs from the previous
+ * assembly, so once the pattern is stable each assembly costs a pack into the send buffers and two MPI_Startall().
+ */
+static PetscErrorCode MatStashBTSStartPersistent_Private(MatStash *stash)
+{
+  PetscMPIInt    i;
+  size_t         b;
+  char           *sbuf;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!stash->persistent_setup) {
+    size_t nsendblocks = 0,nrecvblocks = 0;
+
+    ierr = PetscMalloc3(stash->nsendranks,&stash->psendcap,stash->nsendranks,&stash->psendcount,stash->nrecvranks,&stash->precvframes);CHKERRQ(ierr);
+    for (i=0; i<stash->nsendranks; i++) {
+      stash->psendcap[i]   = stash->sendframes[i].count; /* What the first assembly sent */
+      stash->psendcount[i] = -1;
+      stash->sendreqs[i]   = MPI_REQUEST_NULL;
+      nsendblocks         += stash->psendcap[i];
+    }
+    for (i=0; i<stash->nrecvranks; i++) nrecvblocks += stash->recvhdr[i].count;
+    ierr = PetscMalloc1(nsendblocks*stash->blocktype_size,&stash->psendbuf);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nrecvblocks*stash->blocktype_size,&stash->precvbuf);CHKERRQ(ierr);
+    for (i=0,b=0; i<stash->nrecvranks; i++) {
+      stash->precvframes[i].buffer = &stash->precvbuf[b*stash->blocktype_size];
+      stash->precvframes[i].count  = stash->recvhdr[i].count;
+      ierr = MPI_Recv_init(stash->precvframes[i].buffer,stash->recvhdr[i].count,stash->blocktype,stash->recvranks[i],stash->tag1,stash->comm,&stash->recvreqs[i]);CHKERRQ(ierr);
+      b += stash->recvhdr[i].count;
+    }
+    stash->persistent_setup = PETSC_TRUE;
+    ierr = PetscInfo2(NULL,"Stash uses persistent requests for %d sends and %d receives\n",stash->nsendranks,stash->nrecvranks);CHKERRQ(ierr);
+  }
+
+  for (i=0; i<stash->nrecvranks; i++) stash->precvframes[i].pending = 1;
+  if (stash->nrecvranks) {ierr = MPI_Startall(stash->nrecvranks,stash->recvreqs);CHKERRQ(ierr);}
+  for (i=0,sbuf=stash->psendbuf; i<stash->nsendranks; i++) {
+    PetscMPIInt count = (PetscMPIInt)stash->sendhdr[i].count;
+
+    if (PetscUnlikely(count > stash->psendcap[i])) SETERRQ3(stash->comm,PETSC_ERR_ARG_WRONG,"MAT_SUBSET_OFF_PROC_ENTRIES set, but %d blocks sent to rank %d exceed the %D of the initial assembly",count,stash->sendranks[i],stash->psendcap[i]);
+    ierr = PetscMemcpy(sbuf,stash->sendframes[i].buffer,count*stash->blocktype_size);CHKERRQ(ierr);
+    if (count != stash->psendcount[i]) {
+      if (stash->psendcount[i] >= 0) {ierr = MPI_Request_free(&stash->sendreqs[i]);CHKERRQ(ierr);}
+      ierr = MPI_Send_init(sbuf,count,stash->blocktype,stash->sendranks[i],stash->tag1,stash->comm,&stash->sendreqs[i]);CHKERRQ(ierr);
+      stash->psendcount[i] = count;
+    }
+    stash->sendframes[i].count   = count;
+    stash->sendframes[i].pending = 1;
+    sbuf += stash->psendcap[i]*stash->blocktype_size;
+  }
+  if (stash->nsendranks) {ierr = MPI_Startall(stash->nsendranks,stash->sendreqs);CHKERRQ(ierr);}
+  stash->recvframes = stash->precvframes;
+  PetscFunctionReturn(0);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -913,7 +977,10 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     }
   }
 
-  if (stash->first_assembly_done) {
+  if (stash->first_assembly_done && stash->persistent) {
+    ierr = MatStashBTSStartPersistent_Private(stash);CHKERRQ(ierr);
+    stash->use_status = PETSC_TRUE; /* Use count from message status. */
+  } else if (stash->first_assembly_done) {
     PetscMPIInt i,tag;
     ierr = PetscCommGetNewTag(stash->comm,&tag);CHKERRQ(ierr);
     for (i=0; i<stash->nrecvranks; i++) {
@@ -931,7 +998,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     stash->use_status = PETSC_FALSE; /* Use count from header instead of from message. */
   }
 
-  ierr = PetscSegBufferExtractInPlace(stash->segrecvframe,&stash->recvframes);CHKERRQ(ierr);
+  if (!stash->persistent_setup) {ierr = PetscSegBufferExtractInPlace(stash->segrecvframe,&stash->recvframes);CHKERRQ(ierr);}
   stash->recvframe_active     = NULL;
   stash->recvframe_i          = 0;
   stash->some_i               = 0;
@@ -1020,6 +1087,17 @@ PetscErrorCode MatStashScatterDestroy_BTS(MatStash *stash)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (stash->persistent_setup) {
+    PetscMPIInt i;
+    for (i=0; i<stash->nsendranks; i++) {
+      if (stash->psendcount[i] >= 0) {ierr = MPI_Request_free(&stash->sendreqs[i]);CHKERRQ(ierr);}
+    }
+    for (i=0; i<stash->nrecvranks; i++) {ierr = MPI_Request_free(&stash->recvreqs[i]);CHKERRQ(ierr);}
+    ierr = PetscFree3(stash->psendcap,stash->psendcount,stash->precvframes);CHKERRQ(ierr);
+    ierr = PetscFree(stash->psendbuf);CHKERRQ(ierr);
+    ierr = PetscFree(stash->precvbuf);CHKERRQ(ierr);
+    stash->persistent_setup = PETSC_FALSE;
+  }
   ierr = PetscSegBufferDestroy(&stash->segsendblocks);CHKERRQ(ierr);
   ierr = PetscSegBufferDestroy(&stash->segrecvframe);CHKERRQ(ierr);
   stash->recvframes = NULL;
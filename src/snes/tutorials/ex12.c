@@ -28,6 +28,7 @@ typedef struct {
   PetscInt       debug;             /* The debugging level */
   RunType        runType;           /* Whether to run tests, or solve the full problem */
   PetscBool      jacobianMF;        /* Whether to calculate the Jacobian action on the fly */
+  PetscBool      batch;             /* Whether to use the batched pointwise functions */
   PetscLogEvent  createMeshEvent;
   PetscBool      showInitial, showSolution, restart, quiet, nonzInit;
   /* Domain and mesh definition */
@@ -196,6 +197,34 @@ static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux,
   for (d = 0; d < dim; ++d) g3[d*dim+d] = 1.0;
 }
 
+/* Batched versions of f0_u, f1_u, and g3_uu, where the point index p runs fastest */
+static void f0_u_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  PetscInt p;
+  for (p = 0; p < Np; ++p) f0[p] = 4.0;
+}
+
+static void f1_u_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                       const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                       const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                       PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  PetscInt d, p;
+  for (d = 0; d < dim; ++d) for (p = 0; p < Np; ++p) f1[d*Np+p] = u_x[d*Np+p];
+}
+
+static void g3_uu_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux, PetscInt Np,
+                        const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                        const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                        PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  PetscInt d, p;
+  for (d = 0; d < dim; ++d) for (p = 0; p < Np; ++p) g3[(d*dim+d)*Np+p] = 1.0;
+}
+
 /*
   In 2D for x periodicity and y Dirichlet conditions, we use exact solution:
 
@@ -434,6 +463,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->variableCoefficient = COEFF_NONE;
   options->fieldBC             = PETSC_FALSE;
   options->jacobianMF          = PETSC_FALSE;
+  options->batch               = PETSC_FALSE;
   options->showInitial         = PETSC_FALSE;
   options->showSolution        = PETSC_FALSE;
   options->restart             = PETSC_FALSE;
@@ -475,6 +505,7 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
 
   ierr = PetscOptionsBool("-field_bc", "Use a field representation for the BC", "ex12.c", options->fieldBC, &options->fieldBC, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-jacobian_mf", "Calculate the action of the Jacobian on the fly", "ex12.c", options->jacobianMF, &options->jacobianMF, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-batch", "Use batched pointwise functions for the residual and Jacobian", "ex12.c", options->batch, &options->batch, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-show_initial", "Output the initial guess for verification", "ex12.c", options->showInitial, &options->showInitial, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-show_solution", "Output the solution for verification", "ex12.c", options->showSolution, &options->showSolution, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-restart", "Read in the mesh and solution from a file", "ex12.c", options->restart, &options->restart, NULL);CHKERRQ(ierr);
@@ -651,6 +682,10 @@ static PetscErrorCode SetupProblem(DM dm, AppCtx *user)
     } else {
       ierr = PetscDSSetResidual(prob, 0, f0_u, f1_u);CHKERRQ(ierr);
       ierr = PetscDSSetJacobian(prob, 0, 0, NULL, NULL, NULL, g3_uu);CHKERRQ(ierr);
+      if (user->batch) {
+        ierr = PetscDSSetResidualBatch(prob, 0, f0_u_batch, f1_u_batch);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobianBatch(prob, 0, 0, NULL, NULL, NULL, g3_uu_batch);CHKERRQ(ierr);
+      }
     }
     break;
   case COEFF_ANALYTIC:
@@ -946,7 +981,6 @@ int main(int argc, char **argv)
   Mat            A,J;         /* Jacobian matrix */
   MatNullSpace   nullSpace;   /* May be necessary for Neumann conditions */
   AppCtx         user;        /* user-defined work context */
-  JacActionCtx   userJ;       /* context for Jacobian MF action */
   PetscReal      error = 0.0; /* L_2 error in the solution */
   PetscBool      isFAS;
   PetscErrorCode ierr;
@@ -966,26 +1000,7 @@ int main(int argc, char **argv)
 
   ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
   if (user.jacobianMF) {
-    PetscInt M, m, N, n;
-
-    ierr = MatGetSize(J, &M, &N);CHKERRQ(ierr);
-    ierr = MatGetLocalSize(J, &m, &n);CHKERRQ(ierr);
-    ierr = MatCreate(PETSC_COMM_WORLD, &A);CHKERRQ(ierr);
-    ierr = MatSetSizes(A, m, n, M, N);CHKERRQ(ierr);
-    ierr = MatSetType(A, MATSHELL);CHKERRQ(ierr);
-    ierr = MatSetUp(A);CHKERRQ(ierr);
-#if 0
-    ierr = MatShellSetOperation(A, MATOP_MULT, (void (*)(void))FormJacobianAction);CHKERRQ(ierr);
-#endif
-
-    userJ.dm   = dm;
-    userJ.J    = J;
-    userJ.user = &user;
-
-    ierr = DMCreateLocalVector(dm, &userJ.u);CHKERRQ(ierr);
-    if (user.fieldBC) {ierr = DMProjectFieldLocal(dm, 0.0, userJ.u, user.exactFields, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    else              {ierr = DMProjectFunctionLocal(dm, 0.0, user.exactFuncs, NULL, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);}
-    ierr = MatShellSetContext(A, &userJ);CHKERRQ(ierr);
+    ierr = DMSNESCreateJacobianMF(dm, NULL, &user, &A);CHKERRQ(ierr);
   } else {
     A = J;
   }
@@ -1152,7 +1167,6 @@ int main(int argc, char **argv)
   }
 
   ierr = MatNullSpaceDestroy(&nullSpace);CHKERRQ(ierr);
-  if (user.jacobianMF) {ierr = VecDestroy(&userJ.u);CHKERRQ(ierr);}
   if (A != J) {ierr = MatDestroy(&A);CHKERRQ(ierr);}
   ierr = MatDestroy(&J);CHKERRQ(ierr);
   ierr = VecDestroy(&u);CHKERRQ(ierr);
@@ -1414,6 +1428,36 @@ int main(int argc, char **argv)
     test:
       args: -f sol.h5 -restart
 
+  # Sum factorization and matrix-free Jacobian action
+  test:
+    suffix: tensor_2d_q4
+    args: -run_type test -simplex 0 -cells 3,3 -interpolate 1 -bc_type dirichlet -variable_coefficient field -petscspace_degree 4 -petscfe_type tensor -jacobian_mf -quiet
+
+  test:
+    suffix: tensor_3d_q3
+    args: -run_type test -dim 3 -simplex 0 -cells 2,2,2 -interpolate 1 -bc_type dirichlet -variable_coefficient field -petscspace_degree 3 -petscfe_type tensor -jacobian_mf -quiet
+
+  test:
+    suffix: tensor_2d_q3_full
+    nsize: 2
+    requires: !single
+    args: -run_type full -simplex 0 -cells 4,4 -interpolate 1 -bc_type dirichlet -variable_coefficient nonlinear -nonzero_initial_guess 1 -petscspace_degree 3 -petscfe_type tensor -jacobian_mf -petscpartitioner_type simple -pc_type jacobi -ksp_type cg -ksp_rtol 1.0e-10 -snes_monitor_short -snes_converged_reason
+
+  # Batched pointwise functions
+  test:
+    suffix: batch_2d_q2
+    args: -run_type test -simplex 0 -cells 3,3 -interpolate 1 -bc_type dirichlet -petscspace_degree 2 -batch -quiet
+
+  test:
+    suffix: batch_2d_q2_tensor
+    args: -run_type test -simplex 0 -cells 3,3 -interpolate 1 -bc_type dirichlet -petscspace_degree 2 -batch -petscfe_type tensor -jacobian_mf -quiet
+    output_file: output/ex12_batch_2d_q2.out
+
+  test:
+    suffix: batch_3d_q2_full
+    nsize: 2
+    args: -run_type full -dim 3 -simplex 0 -cells 3,3,3 -interpolate 1 -bc_type dirichlet -petscspace_degree 2 -batch -petscpartitioner_type simple -pc_type jacobi -ksp_rtol 1.0e-10 -snes_monitor_short -snes_converged_reason
+
   # Periodicity
   test:
     suffix: periodic_0
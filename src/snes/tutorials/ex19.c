@@ -656,6 +656,13 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -da_refine 3 -snes_monitor_short -pc_type mg -ksp_type fgmres -pc_mg_type full
       requires: !single
 
+   test:
+      suffix: omp
+      nsize: 2
+      requires: openmp !single
+      args: -da_refine 3 -snes_monitor_short -pc_type mg -ksp_type fgmres -pc_mg_type full -omp_num_threads 3 -mat_omp_threads 3 -vec_omp_threads 3
+      output_file: output/ex19_1.out
+
    test:
       suffix: 10
       nsize: 3
@@ -1584,4 +1584,10 @@ int main(int argc,char *argv[])
       nsize: 6
       args: -M 12 -P 5 -snes_monitor_short -ksp_converged_reason -pc_type asm -pc_asm_type restrict -dm_mat_type {{aij baij sbaij}}
 
+   test:
+      suffix: 5_persistent
+      nsize: 6
+      args: -M 12 -P 5 -snes_monitor_short -ksp_converged_reason -pc_type asm -pc_asm_type restrict -dm_mat_type {{aij baij sbaij}} -matstash_persistent
+      output_file: output/ex48_5.out
+
 TEST*/
@@ -1291,6 +1291,7 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, IS cellIS, PetscReal time,
   ierr = DMPlexGetHeightStratum(dm, 1, &fStart, &fEnd);CHKERRQ(ierr);
   /* 1: Get sizes from dm and dmAux */
   ierr = DMGetLocalSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMPlexCreateClosureDofIndex(dm, section, section);CHKERRQ(ierr);
   ierr = DMGetLabel(dm, "ghost", &ghostLabel);CHKERRQ(ierr);
   ierr = DMGetCellDS(dm, cStart, &prob);CHKERRQ(ierr);
   ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
@@ -1915,6 +1916,8 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   ierr = PetscObjectTypeCompare((PetscObject) JacP, MATIS, &isMatISP);CHKERRQ(ierr);
   ierr = DMGetGlobalSection(dm, &globalSection);CHKERRQ(ierr);
   if (isMatISP) {ierr = DMPlexGetSubdomainSection(dm, &subSection);CHKERRQ(ierr);}
+  ierr = DMPlexCreateClosureDofIndex(dm, section, section);CHKERRQ(ierr);
+  if (!isMatISP) {ierr = DMPlexCreateClosureDofIndex(dm, section, globalSection);CHKERRQ(ierr);}
   ierr = ISGetLocalSize(cellIS, &numCells);CHKERRQ(ierr);
   ierr = ISGetPointRange(cellIS, &cStart, &cEnd, &cells);CHKERRQ(ierr);
   ierr = DMGetCellDS(dm, cStart, &prob);CHKERRQ(ierr);
@@ -1925,6 +1928,8 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
   /* user passed in the same matrix, avoid double contributions and
      only assemble the Jacobian */
   if (hasJac && Jac == JacP) hasPrec = PETSC_FALSE;
+  /* no Jacobian matrix to assemble, only the preconditioner */
+  if (!Jac) hasJac = PETSC_FALSE;
   ierr = PetscDSHasDynamicJacobian(prob, &hasDyn);CHKERRQ(ierr);
   hasDyn = hasDyn && (X_tShift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
   ierr = PetscObjectQuery((PetscObject) dm, "dmAux", (PetscObject *) &dmAux);CHKERRQ(ierr);
@@ -2135,11 +2140,12 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, IS cellIS, PetscReal t, Pet
 
   Note:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
+  like a GPU, or vectorize on a multicore machine. When every field is a PetscFE implementing
+  PetscFEIntegrateJacobianAction(), such as PETSCFETENSOR, the element matrices are not formed.
 
   Level: developer
 
-.seealso: FormFunctionLocal()
+.seealso: FormFunctionLocal(), DMSNESCreateJacobianMF(), PetscFEIntegrateJacobianAction()
 @*/
 PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
 {
@@ -2151,12 +2157,12 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
   PetscDS           prob, probAux = NULL;
   PetscQuadrature   quad;
   PetscSection      section, globalSection, sectionAux;
-  PetscScalar      *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z;
+  PetscScalar      *elemMat, *elemMatD, *elemVec, *u, *u_t, *a = NULL, *y, *z;
   PetscInt          Nf, fieldI, fieldJ;
   PetscInt          totDim, totDimAux = 0;
   const PetscInt   *cells;
   PetscInt          cStart, cEnd, numCells, c;
-  PetscBool         hasDyn;
+  PetscBool         hasDyn, useAction = PETSC_TRUE;
   DMField           coordField;
   PetscErrorCode    ierr;
 
@@ -2190,8 +2196,17 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
+  /* Apply the Jacobian without forming the element matrices when every discretization can */
+  for (fieldI = 0; fieldI < Nf; ++fieldI) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    ierr = PetscDSGetDiscretization(prob, fieldI, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID || !((PetscFE) obj)->ops->integratejacobianaction) useAction = PETSC_FALSE;
+  }
   ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
-  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim*totDim,&elemMat,hasDyn ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,totDim,&z);CHKERRQ(ierr);
+  ierr = PetscMalloc6(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,useAction ? 0 : numCells*totDim*totDim,&elemMat,hasDyn && !useAction ? numCells*totDim*totDim : 0, &elemMatD,numCells*totDim,&y,useAction ? numCells*totDim : totDim,&z);CHKERRQ(ierr);
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
   ierr = DMGetCoordinateField(dm, &coordField);CHKERRQ(ierr);
   for (c = cStart; c < cEnd; ++c) {
@@ -2219,8 +2234,12 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     for (i = 0; i < totDim; ++i) y[cind*totDim+i] = x[i];
     ierr = DMPlexVecRestoreClosure(dm, section, Y, cell, NULL, &x);CHKERRQ(ierr);
   }
-  ierr = PetscArrayzero(elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
-  if (hasDyn)  {ierr = PetscArrayzero(elemMatD, numCells*totDim*totDim);CHKERRQ(ierr);}
+  elemVec = z;
+  if (useAction) {ierr = PetscArrayzero(elemVec, numCells*totDim);CHKERRQ(ierr);}
+  else {
+    ierr = PetscArrayzero(elemMat, numCells*totDim*totDim);CHKERRQ(ierr);
+    if (hasDyn)  {ierr = PetscArrayzero(elemMatD, numCells*totDim*totDim);CHKERRQ(ierr);}
+  }
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscFE  fe;
     PetscInt Nb;
@@ -2253,7 +2272,11 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     offset    = numCells - Nr;
     ierr = PetscFEGeomGetChunk(cgeomFEM,0,offset,&chunkGeom);CHKERRQ(ierr);
     ierr = PetscFEGeomGetChunk(cgeomFEM,offset,numCells,&remGeom);CHKERRQ(ierr);
-    for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
+    if (useAction) {
+      ierr = PetscFEIntegrateJacobianAction(prob, fieldI, Ne, chunkGeom, u, u_t, y, probAux, a, t, X_tShift, elemVec);CHKERRQ(ierr);
+      ierr = PetscFEIntegrateJacobianAction(prob, fieldI, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, &y[offset*totDim], probAux, &a[offset*totDimAux], t, X_tShift, &elemVec[offset*totDim]);CHKERRQ(ierr);
+    }
+    for (fieldJ = 0; fieldJ < Nf && !useAction; ++fieldJ) {
       ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat);CHKERRQ(ierr);
       ierr = PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, fieldI, fieldJ, Nr, remGeom, &u[offset*totDim], u_t ? &u_t[offset*totDim] : NULL, probAux, &a[offset*totDimAux], t, X_tShift, &elemMat[offset*totDim*totDim]);CHKERRQ(ierr);
       if (hasDyn) {
@@ -2266,7 +2289,7 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     ierr = DMSNESRestoreFEGeom(coordField,cellIS,qGeom,PETSC_FALSE,&cgeomFEM);CHKERRQ(ierr);
     ierr = PetscQuadratureDestroy(&qGeom);CHKERRQ(ierr);
   }
-  if (hasDyn) {
+  if (hasDyn && !useAction) {
     for (c = 0; c < numCells*totDim*totDim; ++c) elemMat[c] += X_tShift*elemMatD[c];
   }
   for (c = cStart; c < cEnd; ++c) {
@@ -2275,6 +2298,15 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     const PetscBLASInt M = totDim, one = 1;
     const PetscScalar  a = 1.0, b = 0.0;
 
+    if (useAction) {
+      z = &elemVec[cind*totDim];
+      if (mesh->printFEM > 1) {
+        ierr = DMPrintCellVector(c, "Y",  totDim, &y[cind*totDim]);CHKERRQ(ierr);
+        ierr = DMPrintCellVector(c, "Z",  totDim, z);CHKERRQ(ierr);
+      }
+      ierr = DMPlexVecSetClosure(dm, section, Z, cell, z, ADD_VALUES);CHKERRQ(ierr);
+      continue;
+    }
     PetscStackCallBLAS("BLASgemv", BLASgemv_("N", &M, &M, &a, &elemMat[cind*totDim*totDim], &M, &y[cind*totDim], &one, &b, z, &one));
     if (mesh->printFEM > 1) {
       ierr = DMPrintCellMatrix(c, name, totDim, totDim, &elemMat[cind*totDim*totDim]);CHKERRQ(ierr);
@@ -2283,7 +2315,7 @@ PetscErrorCode DMPlexComputeJacobianAction(DM dm, IS cellIS, PetscReal t, PetscR
     }
     ierr = DMPlexVecSetClosure(dm, section, Z, cell, z, ADD_VALUES);CHKERRQ(ierr);
   }
-  ierr = PetscFree6(u,u_t,elemMat,elemMatD,y,z);CHKERRQ(ierr);
+  ierr = PetscFree6(u,u_t,elemMat,elemMatD,y,elemVec);CHKERRQ(ierr);
   if (mesh->printFEM) {
     ierr = PetscPrintf(PETSC_COMM_WORLD, "Z:\n");CHKERRQ(ierr);
     ierr = VecView(Z, NULL);CHKERRQ(ierr);
@@ -2322,9 +2354,16 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   IS             cellIS;
   PetscBool      hasJac, hasPrec;
   PetscInt       depth;
+  PetscErrorCode (*setpoint)(Mat, Vec);
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  /* A matrix from DMSNESCreateJacobianMF() only needs the new linearization point */
+  ierr = PetscObjectQueryFunction((PetscObject) Jac, "DMSNESJacobianMFSetLinearizationPoint_C", &setpoint);CHKERRQ(ierr);
+  if (setpoint) {
+    ierr = (*setpoint)(Jac, X);CHKERRQ(ierr);
+    if (Jac == JacP) PetscFunctionReturn(0);
+  }
   ierr = DMSNESConvertPlex(dm,&plex,PETSC_TRUE);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(plex, &depth);CHKERRQ(ierr);
   ierr = DMGetStratumIS(plex, "dim", depth, &cellIS);CHKERRQ(ierr);
@@ -2332,7 +2371,10 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
   ierr = PetscDSHasJacobian(prob, &hasJac);CHKERRQ(ierr);
   ierr = PetscDSHasJacobianPreconditioner(prob, &hasPrec);CHKERRQ(ierr);
-  if (hasJac && hasPrec) {ierr = MatZeroEntries(Jac);CHKERRQ(ierr);}
+  if (setpoint) {
+    /* Only assemble the preconditioner, from the preconditioner pointwise functions if there are any */
+    Jac = hasPrec ? NULL : JacP;
+  } else if (hasJac && hasPrec) {ierr = MatZeroEntries(Jac);CHKERRQ(ierr);}
   ierr = MatZeroEntries(JacP);CHKERRQ(ierr);
   ierr = DMPlexComputeJacobian_Internal(plex, cellIS, 0.0, 0.0, X, NULL, Jac, JacP, user);CHKERRQ(ierr);
   ierr = ISDestroy(&cellIS);CHKERRQ(ierr);
@@ -2340,6 +2382,110 @@ PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP,void
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatMult_DMSNESJacobianMF(Mat J, Vec Y, Vec Z)
+{
+  JacActionCtx  *ctx;
+  Vec            locY, locZ;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &ctx);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  ierr = VecSet(locY, 0.0);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(ctx->dm, Y, INSERT_VALUES, locY);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianAction(ctx->dm, NULL, 0.0, 0.0, ctx->u, NULL, locY, locZ, ctx->user);CHKERRQ(ierr);
+  ierr = VecSet(Z, 0.0);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(ctx->dm, locZ, ADD_VALUES, Z);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locY);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(ctx->dm, &locZ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMSNESJacobianMF(Mat J)
+{
+  JacActionCtx  *ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &ctx);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) J, "DMSNESJacobianMFSetLinearizationPoint_C", NULL);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->u);CHKERRQ(ierr);
+  ierr = DMDestroy(&ctx->dm);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* X is the local solution, with boundary values inserted */
+static PetscErrorCode DMSNESJacobianMFSetLinearizationPoint_Plex(Mat J, Vec X)
+{
+  JacActionCtx  *ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &ctx);CHKERRQ(ierr);
+  ierr = VecCopy(X, ctx->u);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMSNESCreateJacobianMF - Create a matrix which applies the Jacobian of the pointwise residual of a DMPlex without assembling it
+
+  Collective on dm
+
+  Input Parameters:
++ dm   - The mesh
+. X    - The global linearization point, or NULL
+- user - The user context passed to the pointwise functions
+
+  Output Parameter:
+. J - The MATSHELL applying the Jacobian
+
+  Notes:
+  The action is computed with DMPlexComputeJacobianAction(), so with the PETSCFETENSOR discretization of quadrilateral
+  and hexahedral meshes the element matrices are never formed. When J is the Jacobian given to SNESSetJacobian() with
+  DMPlexSNESComputeJacobianFEM(), usually through DMPlexSetSNESLocalFEM(), the linearization point is updated at each
+  Jacobian evaluation, and only the preconditioning matrix is assembled. Boundary Jacobian terms are not included.
+
+  Level: intermediate
+
+.seealso: DMPlexComputeJacobianAction(), DMPlexSNESComputeJacobianFEM(), DMPlexSetSNESLocalFEM(), PETSCFETENSOR
+@*/
+PetscErrorCode DMSNESCreateJacobianMF(DM dm, Vec X, void *user, Mat *J)
+{
+  JacActionCtx  *ctx;
+  Vec            g;
+  PetscInt       m, M;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (X) PetscValidHeaderSpecific(X, VEC_CLASSID, 2);
+  PetscValidPointer(J, 4);
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  ctx->dm   = dm;
+  ctx->user = user;
+  ierr = DMCreateLocalVector(dm, &ctx->u);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(g, &m);CHKERRQ(ierr);
+  ierr = VecGetSize(g, &M);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), m, m, M, M, ctx, J);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_MULT, (void (*)(void)) MatMult_DMSNESJacobianMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_DESTROY, (void (*)(void)) MatDestroy_DMSNESJacobianMF);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject) *J, "DMSNESJacobianMFSetLinearizationPoint_C", DMSNESJacobianMFSetLinearizationPoint_Plex);CHKERRQ(ierr);
+  if (X) {
+    ierr = VecSet(ctx->u, 0.0);CHKERRQ(ierr);
+    ierr = DMPlexInsertBoundaryValues(dm, PETSC_TRUE, ctx->u, 0.0, NULL, NULL, NULL);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm, X, INSERT_VALUES, ctx->u);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm, X, INSERT_VALUES, ctx->u);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
      MatComputeNeumannOverlap - Computes an unassembled (Neumann) local overlapping Mat in nonlinear context.
 
@@ -78,6 +78,7 @@
       PetscEnum, parameter :: PETSC_VIEWER_HDF5_MAT = 34
       PetscEnum, parameter :: PETSC_VIEWER_NOFORMAT = 35
       PetscEnum, parameter :: PETSC_VIEWER_LOAD_BALANCE = 36
+      PetscEnum, parameter :: PETSC_VIEWER_ASCII_JSON = 37
 !
 !  End of Fortran include file for the PetscViewer package in PETSc
 
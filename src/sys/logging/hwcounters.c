@@ -0,0 +1,183 @@
+/*
+      Hardware performance counters read with the Linux perf_event interface at the beginning and end of each event
+      and stage, so that -log_view can report cycles, instructions and cache misses next to the logged flops.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#if defined(PETSC_USE_LOG)
+
+PetscBool      PetscLogHWCounters = PETSC_FALSE;
+const char *const PetscLogHWCounterNames[] = {"cycles","instructions","llc_references","llc_misses","page_faults"};
+PetscBool      PetscLogHWCounterAvailable[PETSC_LOG_NUM_HWCOUNTERS];
+
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+static int hwFd[PETSC_LOG_NUM_HWCOUNTERS];
+static int hwLeader = -1;                            /* the file descriptor of the group, all counters are read at once */
+static int hwSlot[PETSC_LOG_NUM_HWCOUNTERS];         /* the position of each counter in the group, or -1 */
+static int hwNum    = 0;                             /* the number of counters in the group */
+
+static int PetscPerfEventOpen(int type,unsigned long long config,int group)
+{
+  struct perf_event_attr attr;
+
+  PetscMemzero(&attr,sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = type;
+  attr.config         = config;
+  attr.disabled       = group < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  /* the calling thread on any cpu; inherit is not set since a PERF_FORMAT_GROUP read of inherited counters is refused */
+  return (int)syscall(__NR_perf_event_open,&attr,0,-1,group,0);
+}
+#endif
+
+/*@
+  PetscLogHWCountersBegin - Turns on the reading of the hardware performance counters of the processor at the beginning
+  and end of each event and stage logged with PetscLogDefaultBegin() or PetscLogNestedBegin().
+
+  Not Collective
+
+  Options Database Keys:
+. -log_view_hwcounters - Activates PetscLogHWCountersBegin()
+
+  Notes:
+  The counters are the cycles, instructions, last level cache references and misses of the calling thread, counted in
+  user space only, and the number of page faults. They are read with the Linux perf_event_open() system call, counters
+  that the processor or the kernel do not provide (for example in most virtual machines or with a restrictive
+  /proc/sys/kernel/perf_event_paranoid) are reported as -1 or are left out. When none of them can be opened the
+  columns are still printed, all -1, and -info tells why.
+
+  Only the thread that calls PetscLogHWCountersBegin() is counted. Other threads, such as OpenMP worker threads, are not,
+  because the counters are read as a group and Linux cannot read a group of counters inherited by child threads. The
+  counts of an event with threaded kernels therefore only cover the work of the main thread.
+
+  The counters appear as extra columns of PetscLogView() with the PETSC_VIEWER_ASCII_CSV format and as the instructions
+  per cycle, last level cache miss ratio, estimated memory bandwidth (last level cache misses times the cache line size)
+  and page fault rate of each event with the PETSC_VIEWER_ASCII_XML format.
+
+  This must be called before the events to be measured and should be called on all processes.
+
+  Level: advanced
+
+.seealso: PetscLogDefaultBegin(), PetscLogNestedBegin(), PetscLogView()
+@*/
+PetscErrorCode PetscLogHWCountersBegin(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  const int                type[PETSC_LOG_NUM_HWCOUNTERS]   = {PERF_TYPE_HARDWARE,PERF_TYPE_HARDWARE,PERF_TYPE_HARDWARE,PERF_TYPE_HARDWARE,PERF_TYPE_SOFTWARE};
+  const unsigned long long config[PETSC_LOG_NUM_HWCOUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_REFERENCES,PERF_COUNT_HW_CACHE_MISSES,PERF_COUNT_SW_PAGE_FAULTS};
+  int                      c;
+  PetscErrorCode           ierr;
+#endif
+
+  PetscFunctionBegin;
+  if (PetscLogHWCounters) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) {
+    hwFd[c]   = PetscPerfEventOpen(type[c],config[c],hwLeader);
+    hwSlot[c] = -1;
+    PetscLogHWCounterAvailable[c] = PETSC_FALSE;
+    if (hwFd[c] < 0) {
+      ierr = PetscInfo2(NULL,"Hardware counter %s is not available: %s\n",PetscLogHWCounterNames[c],strerror(errno));CHKERRQ(ierr);
+      continue;
+    }
+    if (hwLeader < 0) hwLeader = hwFd[c];
+    hwSlot[c] = hwNum++;
+    PetscLogHWCounterAvailable[c] = PETSC_TRUE;
+  }
+  PetscLogHWCounters = PETSC_TRUE;
+  if (hwLeader < 0) {
+    /* the columns are still printed, with -1 for all the counters */
+    ierr = PetscInfo(NULL,"No hardware counter could be opened with perf_event_open()\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (ioctl(hwLeader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP) || ioctl(hwLeader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Cannot enable the hardware counters: %s",strerror(errno));
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP_SYS,"Hardware counters require the Linux perf_event interface");
+#endif
+}
+
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+/* val[0] and val[1] are the times the group was enabled and running, val[2+c] the raw count of counter c */
+static PetscErrorCode PetscLogHWCountersRead_Private(PetscLogDouble val[])
+{
+  unsigned long long buf[3+PETSC_LOG_NUM_HWCOUNTERS];
+  int                c;
+
+  PetscFunctionBegin;
+  if (read(hwLeader,buf,sizeof(buf)) < (ssize_t)((3+hwNum)*sizeof(buf[0]))) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Cannot read the hardware counters: %s",strerror(errno));
+  val[0] = (PetscLogDouble)buf[1];
+  val[1] = (PetscLogDouble)buf[2];
+  for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) val[2+c] = hwSlot[c] >= 0 ? (PetscLogDouble)buf[3+hwSlot[c]] : 0.0;
+  PetscFunctionReturn(0);
+}
+#endif
+
+/* Saves the raw counts and the times enabled and running in start[], at the beginning of an event or stage */
+PetscErrorCode PetscLogHWCountersStart(PetscLogDouble start[])
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  if (hwLeader < 0) PetscFunctionReturn(0);
+  ierr = PetscLogHWCountersRead_Private(start);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* Adds the counts since PetscLogHWCountersStart() to counters[], at the end of an event or stage */
+PetscErrorCode PetscLogHWCountersStop(const PetscLogDouble start[],PetscLogDouble counters[])
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  PetscLogDouble val[2+PETSC_LOG_NUM_HWCOUNTERS],running,multiplex;
+  int            c;
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  if (hwLeader < 0) PetscFunctionReturn(0);
+  ierr = PetscLogHWCountersRead_Private(val);CHKERRQ(ierr);
+  /* the group is counted only a fraction of the time when the processor has fewer counters than are requested, the
+     counts of this interval are scaled by the fraction of this interval, not of the whole run */
+  running   = val[1]-start[1];
+  multiplex = running > 0.0 ? (val[0]-start[0])/running : 0.0;
+  for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) {
+    if (hwSlot[c] >= 0) counters[c] += multiplex*(val[2+c]-start[2+c]);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* Closes the counters, called by PetscLogFinalize() */
+PetscErrorCode PetscLogHWCountersEnd(void)
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  int c;
+#endif
+
+  PetscFunctionBegin;
+  if (!PetscLogHWCounters) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (c=PETSC_LOG_NUM_HWCOUNTERS-1; c>=0; c--) if (hwFd[c] >= 0) close(hwFd[c]);
+  hwLeader = -1;
+  hwNum    = 0;
+#endif
+  PetscLogHWCounters = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+#endif
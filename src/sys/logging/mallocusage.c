@@ -0,0 +1,392 @@
+/*
+      Attribution of the memory allocated with PetscMalloc() to the events, stages and object classes. Each allocation
+      carries a small header recording where it is charged, so that frees and reallocs can be charged back; unlike the
+      tracing malloc in mtr.c there is no list of the allocations and no validation, so it is cheap enough for optimized builds.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+PETSC_INTERN PetscBool petscsetmallocvisited;
+PetscBool              PetscLogMallocUsage = PETSC_FALSE;
+
+#define PETSC_MALLOC_USAGE_ID        ((int) 0x0e0d0c0b)
+#define PETSC_MALLOC_USAGE_MAX_DEPTH 128
+
+typedef struct {
+  size_t size;               /* the size requested */
+  int    event,stage,oclass; /* the buckets it is charged to, shifted by one so that 0 is none, or -1 if not charged */
+  int    id;                 /* PETSC_MALLOC_USAGE_ID */
+} PetscMallocUsageHeader;
+
+#define HEADER_BYTES ((sizeof(PetscMallocUsageHeader)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+
+typedef struct {
+  size_t current; /* allocated while charged here and not yet freed */
+  size_t peak;    /* the maximum of current */
+  size_t max;     /* events only: the maximum total allocated by the process while the event was active */
+  int    oclass;  /* events only: the class of the event shifted by one, or -1 if not yet known */
+} PetscMallocUsageInfo;
+
+typedef struct {
+  PetscMallocUsageInfo *info;
+  int                  n;
+} PetscMallocUsageList;
+
+typedef struct {
+  int    event,oclass;
+  size_t max;
+} PetscMallocUsageFrame;
+
+static PetscMallocUsageList  usageEvents,usageStages,usageClasses;
+static PetscMallocUsageFrame usageStack[PETSC_MALLOC_USAGE_MAX_DEPTH];
+static int                   usageDepth = 0;
+static size_t                usageTotal = 0,usageMax = 0;
+
+static PetscErrorCode (*PetscTrMallocUsageOld)(size_t,PetscBool,int,const char[],const char[],void**) = NULL;
+static PetscErrorCode (*PetscTrReallocUsageOld)(size_t,int,const char[],const char[],void**)          = NULL;
+static PetscErrorCode (*PetscTrFreeUsageOld)(void*,int,const char[],const char[])                     = NULL;
+
+/* the lists are allocated with the system malloc() since they grow from within PetscMalloc() */
+static PetscErrorCode PetscMallocUsageListEnsureSize(PetscMallocUsageList *list,int n)
+{
+  PetscMallocUsageInfo *info;
+  int                  i,m;
+
+  PetscFunctionBegin;
+  if (n <= list->n) PetscFunctionReturn(0);
+  m    = PetscMax(n,2*list->n);
+  info = (PetscMallocUsageInfo*)realloc(list->info,m*sizeof(PetscMallocUsageInfo));
+  if (!info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to allocate %d entries for the memory usage",m);
+  for (i=list->n; i<m; i++) {
+    info[i].current = 0;
+    info[i].peak    = 0;
+    info[i].max     = 0;
+    info[i].oclass  = -1;
+  }
+  list->info = info;
+  list->n    = m;
+  PetscFunctionReturn(0);
+}
+
+static void PetscMallocUsageListDestroy(PetscMallocUsageList *list)
+{
+  free(list->info);
+  list->info = NULL;
+  list->n    = 0;
+}
+
+PETSC_STATIC_INLINE void PetscMallocUsageInfoAdd(PetscMallocUsageInfo *info,size_t size)
+{
+  info->current += size;
+  if (info->current > info->peak) info->peak = info->current;
+}
+
+static PetscErrorCode PetscMallocUsageCharge(PetscMallocUsageHeader *head,size_t size)
+{
+  const int      top = PetscMin(usageDepth,PETSC_MALLOC_USAGE_MAX_DEPTH)-1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  head->size = size;
+  head->id   = PETSC_MALLOC_USAGE_ID;
+  if (!PetscLogMallocUsage) {
+    head->event = head->stage = head->oclass = -1;
+    PetscFunctionReturn(0);
+  }
+  head->event  = top >= 0 ? usageStack[top].event : 0;
+  head->oclass = top >= 0 ? usageStack[top].oclass : 0;
+  head->stage  = petsc_stageLog ? petsc_stageLog->curStage+1 : 0;
+  if (PetscUnlikely(head->stage >= usageStages.n)) {ierr = PetscMallocUsageListEnsureSize(&usageStages,head->stage+1);CHKERRQ(ierr);}
+  /* the event and class lists were sized when the event began */
+  PetscMallocUsageInfoAdd(&usageEvents.info[head->event],size);
+  PetscMallocUsageInfoAdd(&usageStages.info[head->stage],size);
+  PetscMallocUsageInfoAdd(&usageClasses.info[head->oclass],size);
+  usageTotal += size;
+  if (usageTotal > usageMax) usageMax = usageTotal;
+  if (top >= 0 && usageTotal > usageStack[top].max) usageStack[top].max = usageTotal;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocUsageRefund(PetscMallocUsageHeader *head,int line,const char func[],const char file[])
+{
+  PetscFunctionBegin;
+  if (head->id != PETSC_MALLOC_USAGE_ID) return PetscError(PETSC_COMM_SELF,line,func,file,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Freeing memory that was not allocated after PetscLogMallocUsageBegin(), or that is corrupted");
+  if (head->event < 0 || !PetscLogMallocUsage) PetscFunctionReturn(0);
+  usageEvents.info[head->event].current   -= head->size;
+  usageStages.info[head->stage].current   -= head->size;
+  usageClasses.info[head->oclass].current -= head->size;
+  usageTotal                              -= head->size;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocUsageMalloc(size_t a,PetscBool clear,int lineno,const char function[],const char filename[],void **result)
+{
+  char           *inew;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a) {*result = NULL; PetscFunctionReturn(0);}
+  ierr = (*PetscTrMallocUsageOld)(a+HEADER_BYTES,clear,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+  ierr = PetscMallocUsageCharge((PetscMallocUsageHeader*)inew,a);CHKERRQ(ierr);
+  *result = inew+HEADER_BYTES;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocUsageFree(void *aa,int lineno,const char function[],const char filename[])
+{
+  char           *a = (char*)aa;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a) PetscFunctionReturn(0);
+  ierr = PetscMallocUsageRefund((PetscMallocUsageHeader*)(a-HEADER_BYTES),lineno,function,filename);CHKERRQ(ierr);
+  ierr = (*PetscTrFreeUsageOld)(a-HEADER_BYTES,lineno,function,filename);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocUsageRealloc(size_t len,int lineno,const char function[],const char filename[],void **result)
+{
+  char           *inew;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!len) {
+    ierr    = PetscMallocUsageFree(*result,lineno,function,filename);CHKERRQ(ierr);
+    *result = NULL;
+    PetscFunctionReturn(0);
+  }
+  if (!*result) {
+    ierr = PetscMallocUsageMalloc(len,PETSC_FALSE,lineno,function,filename,result);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* the reallocated space is charged where the realloc happens */
+  inew = (char*)*result-HEADER_BYTES;
+  ierr = PetscMallocUsageRefund((PetscMallocUsageHeader*)inew,lineno,function,filename);CHKERRQ(ierr);
+  ierr = (*PetscTrReallocUsageOld)(len+HEADER_BYTES,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+  ierr = PetscMallocUsageCharge((PetscMallocUsageHeader*)inew,len);CHKERRQ(ierr);
+  *result = inew+HEADER_BYTES;
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogEventBeginDefault(), the allocations are charged to the innermost event */
+PetscErrorCode PetscLogMallocUsageEventBegin(PetscLogEvent event)
+{
+  PetscMallocUsageInfo *info;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocUsageListEnsureSize(&usageEvents,event+2);CHKERRQ(ierr);
+  info = &usageEvents.info[event+1];
+  if (PetscUnlikely(info->oclass < 0)) {
+    PetscClassRegLog classLog = petsc_stageLog->classLog;
+    PetscClassId     classid  = petsc_stageLog->eventLog->eventInfo[event].classid;
+    int              c;
+
+    for (c=0; c<classLog->numClasses; c++) if (classLog->classInfo[c].classid == classid) break;
+    info->oclass = c < classLog->numClasses ? c+1 : 0;
+    ierr = PetscMallocUsageListEnsureSize(&usageClasses,PetscMax(info->oclass+1,classLog->numClasses+1));CHKERRQ(ierr);
+  }
+  if (usageDepth < PETSC_MALLOC_USAGE_MAX_DEPTH) {
+    usageStack[usageDepth].event  = event+1;
+    usageStack[usageDepth].oclass = info->oclass;
+    usageStack[usageDepth].max    = usageTotal;
+  }
+  usageDepth++;
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogEventEndDefault(), the events need not end in the reverse order they began */
+PetscErrorCode PetscLogMallocUsageEventEnd(PetscLogEvent event)
+{
+  const int top = PetscMin(usageDepth,PETSC_MALLOC_USAGE_MAX_DEPTH)-1;
+  int       k;
+
+  PetscFunctionBegin;
+  if (!usageDepth) PetscFunctionReturn(0);
+  for (k=top; k>=0; k--) if (usageStack[k].event == event+1) break;
+  if (k < 0) {
+    /* an event deeper than the stack, or one that took the place of a frame with no event below */
+    if (usageDepth > PETSC_MALLOC_USAGE_MAX_DEPTH) {usageDepth--; PetscFunctionReturn(0);}
+    for (k=top; k>=0; k--) if (!usageStack[k].event) break;
+    if (k < 0) PetscFunctionReturn(0); /* begun before PetscLogMallocUsageBegin() */
+  } else {
+    usageEvents.info[event+1].max = PetscMax(usageEvents.info[event+1].max,usageStack[k].max);
+  }
+  /* the peak of the nested event is also a peak of the enclosing one */
+  if (k) usageStack[k-1].max = PetscMax(usageStack[k-1].max,usageStack[k].max);
+  /* an event that ends out of order is removed from the middle of the stack */
+  for (; k<top; k++) usageStack[k] = usageStack[k+1];
+  if (usageDepth > PETSC_MALLOC_USAGE_MAX_DEPTH) {
+    /* the first event deeper than the stack now has a frame, but which one is not known, so it is charged to no event */
+    usageStack[top].event  = 0;
+    usageStack[top].oclass = 0;
+    usageStack[top].max    = usageTotal;
+  }
+  usageDepth--;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscLogMallocUsageBegin - Turns on the attribution of the memory allocated with PetscMalloc() to the events, the
+  stages and the object classes, reported by PetscLogView()
+
+  Not Collective
+
+  Options Database Keys:
+. -log_view_malloc - Activates PetscLogMallocUsageBegin(), the usage is printed with -log_view
+
+  Notes:
+  Each allocation is charged to the innermost active event, to the class the event was registered with, and to the
+  current stage. For each of them PetscLogView() prints the memory allocated and not yet freed at the time of the view
+  and the maximum of that during the run; for the events it also prints the maximum total memory allocated by the
+  process while the event was active, including in nested events, which shows the events responsible for the high
+  water mark of the run.
+
+  Each allocation is extended by a small header, but unlike -malloc_debug the allocations are not validated or kept
+  in a list, so the overhead is small and this can be used in optimized builds. The allocator is wrapped around the
+  one selected by -malloc_debug or -malloc_hbw, this is activated from the options database during PetscInitialize(),
+  because memory allocated before it cannot be freed after it.
+
+  Level: advanced
+
+.seealso: PetscLogEventGetMallocUsage(), PetscLogView(), PetscMallocSet(), PetscMallocGetMaximumUsage()
+@*/
+PetscErrorCode PetscLogMallocUsageBegin(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscTrMalloc == PetscMallocUsageMalloc) PetscFunctionReturn(0);
+  ierr = PetscMallocUsageListEnsureSize(&usageEvents,1);CHKERRQ(ierr);
+  ierr = PetscMallocUsageListEnsureSize(&usageStages,1);CHKERRQ(ierr);
+  ierr = PetscMallocUsageListEnsureSize(&usageClasses,1);CHKERRQ(ierr);
+  usageDepth = 0;
+  usageTotal = usageMax = 0;
+  PetscTrMallocUsageOld  = PetscTrMalloc;
+  PetscTrReallocUsageOld = PetscTrRealloc;
+  PetscTrFreeUsageOld    = PetscTrFree;
+  PetscTrMalloc          = PetscMallocUsageMalloc;
+  PetscTrRealloc         = PetscMallocUsageRealloc;
+  PetscTrFree            = PetscMallocUsageFree;
+  petscsetmallocvisited  = PETSC_TRUE;
+  PetscLogMallocUsage    = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscLogEventGetMallocUsage - Gets the memory allocated with PetscMalloc() while an event was the innermost active one
+
+  Not Collective
+
+  Input Parameter:
+. event - the event
+
+  Output Parameters:
++ current - the memory allocated in the event and not yet freed, in bytes
+- peak - the maximum of current during the run, in bytes
+
+  Notes:
+  The values are zero unless PetscLogMallocUsageBegin() is active
+
+  Level: advanced
+
+.seealso: PetscLogMallocUsageBegin()
+@*/
+PetscErrorCode PetscLogEventGetMallocUsage(PetscLogEvent event,PetscLogDouble *current,PetscLogDouble *peak)
+{
+  PetscFunctionBegin;
+  if (current) *current = 0;
+  if (peak)    *peak    = 0;
+  if (!PetscLogMallocUsage || event+1 >= usageEvents.n) PetscFunctionReturn(0);
+  if (current) *current = (PetscLogDouble)usageEvents.info[event+1].current;
+  if (peak)    *peak    = (PetscLogDouble)usageEvents.info[event+1].peak;
+  PetscFunctionReturn(0);
+}
+
+/* Frees the lists, called by PetscLogFinalize(); the allocator stays in place to free the remaining memory */
+PetscErrorCode PetscLogMallocUsageEnd(void)
+{
+  PetscFunctionBegin;
+  PetscLogMallocUsage = PETSC_FALSE;
+  PetscMallocUsageListDestroy(&usageEvents);
+  PetscMallocUsageListDestroy(&usageStages);
+  PetscMallocUsageListDestroy(&usageClasses);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogViewMallocUsageList(PetscViewer viewer,PetscMallocUsageList *list,int n,PetscBool withmax,const char *const names[],const char none[])
+{
+  PetscLogDouble *lmax,*gmax;
+  int            i,nv = withmax ? 3 : 2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc2(nv*(n+1),&lmax,nv*(n+1),&gmax);CHKERRQ(ierr);
+  for (i=0; i<=n && i<list->n; i++) {
+    lmax[nv*i]   = (PetscLogDouble)list->info[i].current;
+    lmax[nv*i+1] = (PetscLogDouble)list->info[i].peak;
+    if (withmax) lmax[nv*i+2] = (PetscLogDouble)list->info[i].max;
+  }
+  ierr = MPIU_Allreduce(lmax,gmax,nv*(n+1),MPIU_PETSCLOGDOUBLE,MPI_MAX,PetscObjectComm((PetscObject)viewer));CHKERRQ(ierr);
+  for (i=0; i<=n; i++) {
+    if (!gmax[nv*i+1]) continue;
+    if (withmax) {
+      ierr = PetscViewerASCIIPrintf(viewer,"%-20s %12.0f %12.0f %12.0f\n",i ? names[i-1] : none,gmax[nv*i],gmax[nv*i+1],gmax[nv*i+2]);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"%-20s %12.0f %12.0f\n",i ? names[i-1] : none,gmax[nv*i],gmax[nv*i+1]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree2(lmax,gmax);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogView() when PetscLogMallocUsageBegin() is active */
+PetscErrorCode PetscLogView_MallocUsage(PetscViewer viewer)
+{
+  MPI_Comm         comm = PetscObjectComm((PetscObject)viewer);
+  PetscStageLog    stageLog;
+  PetscLogDouble   ltotal[2],gtotal[2];
+  const char       **names;
+  int              numEvents,numStages,numClasses,n,i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&stageLog->eventLog->numEvents,&numEvents,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&stageLog->numStages,&numStages,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&stageLog->classLog->numClasses,&numClasses,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ltotal[0] = (PetscLogDouble)usageTotal;
+  ltotal[1] = (PetscLogDouble)usageMax;
+  ierr = MPIU_Allreduce(ltotal,gtotal,2,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIPrintf(viewer,"\nMemory allocated with PetscMalloc() in bytes, maximum over the processes, see PetscLogMallocUsageBegin():\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  Current: allocated in the event, the stage, or an event of the class, and not yet freed (the innermost event is charged)\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  Peak: the maximum of Current during the run\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  Process Max: the maximum total allocated by the process while the event was active, including nested events\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Total allocated by the process %.0f, maximum %.0f\n",gtotal[0],gtotal[1]);CHKERRQ(ierr);
+
+  n    = PetscMax(PetscMax(numEvents,numStages),numClasses);
+  ierr = PetscCalloc1(n,&names);CHKERRQ(ierr);
+  for (i=0; i<numEvents; i++) names[i] = i < stageLog->eventLog->numEvents ? stageLog->eventLog->eventInfo[i].name : "Unknown";
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Event                     Current         Peak  Process Max\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscLogViewMallocUsageList(viewer,&usageEvents,numEvents,PETSC_TRUE,names,"No event");CHKERRQ(ierr);
+  for (i=0; i<numStages; i++) names[i] = i < stageLog->numStages ? stageLog->stageInfo[i].name : "Unknown";
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Stage                     Current         Peak\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscLogViewMallocUsageList(viewer,&usageStages,numStages,PETSC_FALSE,names,"No stage");CHKERRQ(ierr);
+  for (i=0; i<numClasses; i++) names[i] = i < stageLog->classLog->numClasses ? stageLog->classLog->classInfo[i].name : "Unknown";
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Class                     Current         Peak\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscLogViewMallocUsageList(viewer,&usageClasses,numClasses,PETSC_FALSE,names,"No class");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscFree(names);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
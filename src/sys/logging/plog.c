@@ -145,6 +145,10 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
   ierr = PetscLogNestedEnd();CHKERRQ(ierr);
+  ierr = PetscLogTimelineEnd();CHKERRQ(ierr);
+  ierr = PetscLogSampleEnd();CHKERRQ(ierr);
+  ierr = PetscLogHWCountersEnd();CHKERRQ(ierr);
+  ierr = PetscLogMallocUsageEnd();CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
   /* Resetting phase */
@@ -454,6 +458,7 @@ PetscErrorCode  PetscLogStagePush(PetscLogStage stage)
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogPush(stageLog, stage);CHKERRQ(ierr);
+  ierr = PetscLogTimelineStage_Private(stage, PETSC_TRUE);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -491,6 +496,7 @@ PetscErrorCode  PetscLogStagePop(void)
 
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscLogTimelineStage_Private(-1, PETSC_FALSE);CHKERRQ(ierr);
   ierr = PetscStageLogPop(stageLog);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1249,6 +1255,20 @@ PetscErrorCode  PetscLogView_Detailed(PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+/* Prints the hardware counters of an event or stage, -1 for those that are not available */
+static PetscErrorCode PetscLogView_CSVHWCounters(PetscViewer viewer,PetscEventPerfInfo *info)
+{
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!PetscLogHWCounters) PetscFunctionReturn(0);
+  for (c = 0; c < PETSC_LOG_NUM_HWCOUNTERS; ++c) {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,",%g",PetscLogHWCounterAvailable[c] ? info->hwCounters[c] : -1.0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
   PetscLogView_CSV - Each process prints the times for its own events in Comma-Separated Value Format
 */
@@ -1257,7 +1277,7 @@ PetscErrorCode  PetscLogView_CSV(PetscViewer viewer)
   PetscStageLog      stageLog;
   PetscEventPerfInfo *eventInfo = NULL;
   PetscLogDouble     locTotalTime, maxMem;
-  int                numStages,numEvents,stage,event;
+  int                numStages,numEvents,stage,event,c;
   MPI_Comm           comm = PetscObjectComm((PetscObject) viewer);
   PetscMPIInt        rank,size;
   PetscErrorCode     ierr;
@@ -1272,19 +1292,26 @@ PetscErrorCode  PetscLogView_CSV(PetscViewer viewer)
   ierr = MPIU_Allreduce(&stageLog->numStages, &numStages, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
   ierr = PetscMallocGetMaximumUsage(&maxMem);CHKERRQ(ierr);
   ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
-  ierr = PetscViewerASCIIPrintf(viewer,"Stage Name,Event Name,Rank,Time,Num Messages,Message Length,Num Reductions,FLOP,dof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", size);
+  ierr = PetscViewerASCIIPrintf(viewer,"Stage Name,Event Name,Rank,Time,Num Messages,Message Length,Num Reductions,FLOP");CHKERRQ(ierr);
+  if (PetscLogHWCounters) {
+    for (c = 0; c < PETSC_LOG_NUM_HWCOUNTERS; ++c) {ierr = PetscViewerASCIIPrintf(viewer,",%s",PetscLogHWCounterNames[c]);CHKERRQ(ierr);}
+  }
+  ierr = PetscViewerASCIIPrintf(viewer,",dof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", size);CHKERRQ(ierr);
   ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
   for (stage=0; stage<numStages; stage++) {
     PetscEventPerfInfo *stageInfo = &stageLog->stageInfo[stage].perfInfo;
 
-    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s,summary,%d,%g,%g,%g,%g,%g\n",
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s,summary,%d,%g,%g,%g,%g,%g",
                                               stageLog->stageInfo[stage].name,rank,stageInfo->time,stageInfo->numMessages,stageInfo->messageLength,stageInfo->numReductions,stageInfo->flops);CHKERRQ(ierr);
+    ierr = PetscLogView_CSVHWCounters(viewer,stageInfo);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"\n");CHKERRQ(ierr);
     ierr = MPIU_Allreduce(&stageLog->stageInfo[stage].eventLog->numEvents, &numEvents, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
     for (event = 0; event < numEvents; event++) {
       eventInfo = &stageLog->stageInfo[stage].eventLog->eventInfo[event];
       ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s,%s,%d,%g,%g,%g,%g,%g",stageLog->stageInfo[stage].name,
                                                 stageLog->eventLog->eventInfo[event].name,rank,eventInfo->time,eventInfo->numMessages,
                                                 eventInfo->messageLength,eventInfo->numReductions,eventInfo->flops);CHKERRQ(ierr);
+      ierr = PetscLogView_CSVHWCounters(viewer,eventInfo);CHKERRQ(ierr);
       if (eventInfo->dof[0] >= 0.) {
         PetscInt d, e;
 
@@ -1808,6 +1835,7 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   ierr = PetscFree(stageUsed);CHKERRQ(ierr);
   ierr = PetscFree(localStageVisible);CHKERRQ(ierr);
   ierr = PetscFree(stageVisible);CHKERRQ(ierr);
+  if (PetscLogMallocUsage) {ierr = PetscLogView_MallocUsage(viewer);CHKERRQ(ierr);}
 
   /* Information unrelated to this particular run */
   ierr = PetscFPrintf(comm, fd, "========================================================================================================================\n");CHKERRQ(ierr);
@@ -1945,7 +1973,9 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
   if (!isascii) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Currently can only view logging to ASCII");
   ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
-  if (format == PETSC_VIEWER_DEFAULT || format == PETSC_VIEWER_ASCII_INFO) {
+  if (PetscLogPLB == PetscLogEventBeginSample) {
+    ierr = PetscLogView_Sample(viewer);CHKERRQ(ierr);
+  } else if (format == PETSC_VIEWER_DEFAULT || format == PETSC_VIEWER_ASCII_INFO) {
     ierr = PetscLogView_Default(viewer);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
     ierr = PetscLogView_Detailed(viewer);CHKERRQ(ierr);
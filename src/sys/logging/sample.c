@@ -0,0 +1,179 @@
+/*
+      Sampled event logging: every call of an event is counted, but only a random sample of the calls is timed, so
+      the cost of an unsampled PetscLogEventBegin()/PetscLogEventEnd() pair is an increment and a decrement in a flat array.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+typedef struct {
+  PetscInt64     count;      /* the number of calls */
+  PetscInt64     samples;    /* the number of timed calls */
+  PetscInt       next;       /* the number of calls until the next timed one */
+  int            depth;      /* only the outermost of recursive calls is counted */
+  PetscBool      sampling;   /* the current call is timed */
+  PetscLogDouble begin,flops0;
+  PetscLogDouble time,flops; /* summed over the timed calls */
+} PetscSampleInfo;
+
+static PetscSampleInfo *sampleInfo     = NULL;
+static int             sampleAllocated = 0;
+static PetscInt        samplePeriod    = 0;
+static unsigned int    sampleSeed      = 2463534242u;
+
+/* The gap to the next timed call is uniform in [1,2*period-1], so that the sample does not alias with loops calling the event periodically */
+PETSC_STATIC_INLINE PetscInt PetscLogSampleGap(void)
+{
+  sampleSeed ^= sampleSeed << 13;
+  sampleSeed ^= sampleSeed >> 17;
+  sampleSeed ^= sampleSeed << 5;
+  return samplePeriod == 1 ? 1 : 1 + (PetscInt)(sampleSeed % (unsigned int)(2*samplePeriod-1));
+}
+
+static PetscErrorCode PetscLogSampleEnsureSize(int n)
+{
+  PetscSampleInfo *info;
+  int             e;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (n <= sampleAllocated) PetscFunctionReturn(0);
+  n    = PetscMax(n,2*sampleAllocated);
+  ierr = PetscCalloc1(n,&info);CHKERRQ(ierr);
+  ierr = PetscArraycpy(info,sampleInfo,sampleAllocated);CHKERRQ(ierr);
+  for (e=sampleAllocated; e<n; e++) info[e].next = PetscLogSampleGap();
+  ierr = PetscFree(sampleInfo);CHKERRQ(ierr);
+  sampleInfo      = info;
+  sampleAllocated = n;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogEventBeginSample(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscSampleInfo *info;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(event >= sampleAllocated)) {ierr = PetscLogSampleEnsureSize(event+1);CHKERRQ(ierr);}
+  info = &sampleInfo[event];
+  if (info->depth++) PetscFunctionReturn(0);
+  info->count++;
+  if (--info->next) PetscFunctionReturn(0);
+  info->next     = PetscLogSampleGap();
+  info->sampling = PETSC_TRUE;
+  info->flops0   = petsc_TotalFlops;
+  PetscTime(&info->begin);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogEventEndSample(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscSampleInfo *info;
+  PetscLogDouble  now;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(event >= sampleAllocated)) PetscFunctionReturn(0);
+  info = &sampleInfo[event];
+  if (--info->depth > 0) PetscFunctionReturn(0);
+  else if (info->depth < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
+  if (!info->sampling) PetscFunctionReturn(0);
+  PetscTime(&now);
+  info->sampling = PETSC_FALSE;
+  info->samples++;
+  info->time    += now - info->begin;
+  info->flops   += petsc_TotalFlops - info->flops0;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscLogSampleBegin - Turns on sampled logging of events, a low overhead alternative to PetscLogDefaultBegin() for
+  production runs. Every call of an event is counted, but only a random sample of the calls is timed.
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. period - on average one of every period calls of each event is timed, or PETSC_DEFAULT for 100
+
+  Options Database Keys:
+. -log_sample <period> - Activates PetscLogSampleBegin(), the summary is printed with -log_view
+
+  Notes:
+  PetscLogView() prints, for each event, the exact number of calls and the time and flop rate estimated from the timed
+  calls. Stages, objects, messages and reductions are not logged. Use src/benchmarks/PLogEventOverhead.c to measure the cost of
+  an event with the different logging modes.
+
+  Level: advanced
+
+.seealso: PetscLogDefaultBegin(), PetscLogView(), PetscLogSet()
+@*/
+PetscErrorCode PetscLogSampleBegin(PetscInt period)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (period == PETSC_DEFAULT || period == PETSC_DECIDE) period = 100;
+  if (period < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Sampling period %D must be positive",period);
+  ierr = PetscLogSampleEnd();CHKERRQ(ierr);
+  samplePeriod = period;
+  /* the counters are allocated as events are called, since this may be called before any event is registered */
+  ierr = PetscLogSet(PetscLogEventBeginSample,PetscLogEventEndSample);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Frees the counters, called by PetscLogFinalize() */
+PetscErrorCode PetscLogSampleEnd(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(sampleInfo);CHKERRQ(ierr);
+  sampleAllocated = 0;
+  samplePeriod    = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogView() when sampled logging is active */
+PetscErrorCode PetscLogView_Sample(PetscViewer viewer)
+{
+  MPI_Comm         comm = PetscObjectComm((PetscObject)viewer);
+  PetscStageLog    stageLog;
+  PetscEventRegLog eventRegLog;
+  PetscLogDouble   total,maxtime,lmax[4],gmax[4],lsum[2],gsum[2];
+  int              numEvents,event;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscStageLogGetEventRegLog(stageLog,&eventRegLog);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&eventRegLog->numEvents,&numEvents,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  PetscTime(&total); total -= petsc_BaseTime;
+  ierr = MPIU_Allreduce(&total,&maxtime,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Sampled event log: one of every %D calls of each event is timed on average, total time %.4e sec\n",samplePeriod,maxtime);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Count: calls on each process, Time: estimated from the timed calls on each process, Mflop/s: estimated total\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"----------------------------------------------------------------------------\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Event                     Count          Samples    Time (sec)       Mflop/s\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"                            Max Ratio        Sum        Max Ratio      Total\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"----------------------------------------------------------------------------\n");CHKERRQ(ierr);
+  for (event=0; event<numEvents; event++) {
+    const PetscSampleInfo *info = event < sampleAllocated ? &sampleInfo[event] : NULL;
+
+    /* the minima are the negated maxima of the negated values */
+    lmax[0] = info ? (PetscLogDouble)info->count : 0.0;
+    lmax[1] = info && info->samples ? info->time*info->count/info->samples : 0.0;
+    lmax[2] = -lmax[0];
+    lmax[3] = -lmax[1];
+    lsum[0] = info && info->samples ? info->flops*info->count/info->samples : 0.0;
+    lsum[1] = info ? (PetscLogDouble)info->samples : 0.0;
+    ierr = MPIU_Allreduce(lmax,gmax,4,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(lsum,gsum,2,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+    /* the events registered only on other processes are not printed, as in PetscLogView_Default() */
+    if (!gmax[0] || event >= eventRegLog->numEvents) continue;
+    ierr = PetscViewerASCIIPrintf(viewer,"%-20s %10.0f %5.1f %10.0f %10.4e %5.1f %10.0f\n",eventRegLog->eventInfo[event].name,gmax[0],gmax[2] ? -gmax[0]/gmax[2] : 0.0,gsum[1],
+                                  gmax[1],gmax[3] ? -gmax[1]/gmax[3] : 0.0,gmax[1] ? 1.e-6*gsum[0]/gmax[1] : 0.0);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerASCIIPrintf(viewer,"----------------------------------------------------------------------------\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
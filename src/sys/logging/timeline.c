@@ -0,0 +1,253 @@
+/*
+      Timeline logging: every event and stage interval is recorded with its begin and end time into a per-process
+      ring buffer, which is written at the end as a Chrome trace (https://www.chromium.org/developers/how-tos/trace-event-profiling-tool)
+      that can be opened in chrome://tracing or https://ui.perfetto.dev, with one track per MPI rank.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+#define PETSC_TIMELINE_MAX_DEPTH 128
+
+typedef struct {
+  int            id;                       /* the event, or the stage for a stage interval */
+  int            stage;                    /* the stage the event began in, -1 for a stage interval */
+  PetscLogDouble begin,end;                /* seconds since PetscInitialize() */
+  PetscLogDouble flops,messages,reductions,waits;
+} PetscTimelineRecord;
+
+static PetscTimelineRecord *timelineRecords = NULL;
+static PetscInt            timelineSize     = 0;        /* the capacity of the ring buffer */
+static PetscInt            timelineCount    = 0;        /* the number of records ever added, the oldest are overwritten */
+static PetscTimelineRecord timelineEvents[PETSC_TIMELINE_MAX_DEPTH],timelineStages[PETSC_TIMELINE_MAX_DEPTH];
+static int                 timelineEventDepth = 0,timelineStageDepth = 0;
+
+PETSC_STATIC_INLINE void PetscLogTimelineCounters(PetscTimelineRecord *r)
+{
+  r->flops      = petsc_TotalFlops;
+  r->messages   = petsc_irecv_ct + petsc_isend_ct + petsc_recv_ct + petsc_send_ct;
+  r->reductions = petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  r->waits      = petsc_sum_of_waits_ct;
+}
+
+/* Fills r with what happened during the open interval, up to now */
+PETSC_STATIC_INLINE void PetscLogTimelineInterval(const PetscTimelineRecord *open,PetscLogDouble now,PetscTimelineRecord *r)
+{
+  PetscLogTimelineCounters(r);
+  r->id          = open->id;
+  r->stage       = open->stage;
+  r->begin       = open->begin;
+  r->end         = now - petsc_BaseTime;
+  r->flops      -= open->flops;
+  r->messages   -= open->messages;
+  r->reductions -= open->reductions;
+  r->waits      -= open->waits;
+}
+
+/* Adds the closed interval to the ring buffer, overwriting the oldest record once it is full */
+PETSC_STATIC_INLINE void PetscLogTimelineClose(const PetscTimelineRecord *open,PetscLogDouble now)
+{
+  PetscLogTimelineInterval(open,now,&timelineRecords[timelineCount % timelineSize]);
+  timelineCount++;
+}
+
+static PetscErrorCode PetscLogEventBeginTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscTimelineRecord *open;
+  PetscLogDouble      now;
+
+  PetscFunctionBegin;
+  /* deeper events are not recorded, but still counted to keep the stack balanced */
+  if (timelineEventDepth++ >= PETSC_TIMELINE_MAX_DEPTH) PetscFunctionReturn(0);
+  open        = &timelineEvents[timelineEventDepth-1];
+  open->id    = event;
+  open->stage = petsc_stageLog->curStage;
+  PetscLogTimelineCounters(open);
+  PetscTime(&now);
+  open->begin = now - petsc_BaseTime;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventEndTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscLogDouble now;
+  int            depth;
+
+  PetscFunctionBegin;
+  PetscTime(&now);
+  if (timelineEventDepth > PETSC_TIMELINE_MAX_DEPTH) {timelineEventDepth--; PetscFunctionReturn(0);}
+  /* an event that began in a stage that was popped before its end may have no matching end; drop such events */
+  for (depth=timelineEventDepth; depth>0; depth--) if (timelineEvents[depth-1].id == event) break;
+  if (!depth) PetscFunctionReturn(0);
+  timelineEventDepth = depth-1;
+  PetscLogTimelineClose(&timelineEvents[depth-1],now);
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscLogStagePush() and PetscLogStagePop() */
+PetscErrorCode PetscLogTimelineStage_Private(PetscLogStage stage,PetscBool push)
+{
+  PetscLogDouble now;
+
+  PetscFunctionBegin;
+  if (!timelineRecords) PetscFunctionReturn(0);
+  PetscTime(&now);
+  if (push) {
+    if (timelineStageDepth++ >= PETSC_TIMELINE_MAX_DEPTH) PetscFunctionReturn(0);
+    timelineStages[timelineStageDepth-1].id    = stage;
+    timelineStages[timelineStageDepth-1].stage = -1;
+    timelineStages[timelineStageDepth-1].begin = now - petsc_BaseTime;
+    PetscLogTimelineCounters(&timelineStages[timelineStageDepth-1]);
+  } else if (timelineStageDepth) {
+    if (timelineStageDepth-- > PETSC_TIMELINE_MAX_DEPTH) PetscFunctionReturn(0);
+    PetscLogTimelineClose(&timelineStages[timelineStageDepth],now);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscLogTimelineBegin - Turns on timeline logging: the begin and end time of every event and stage, and the flops,
+  messages, reductions and waits done during it, are recorded into a ring buffer on each process.
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. size - the number of events and stages kept on each process, or PETSC_DEFAULT for 100000. Once the buffer is full the oldest are overwritten.
+
+  Options Database Keys:
++ -log_timeline [filename] - Activates PetscLogTimelineBegin() and calls PetscLogTimelineDump() in PetscFinalize()
+- -log_timeline_size <size> - The size of the ring buffer
+
+  Notes:
+  Each record takes 56 bytes. The timeline replaces the default logging, so it cannot be used together with -log_view.
+
+  The time of an event that waits for messages from other processes, for example VecScatterEnd() or PetscSFBcastEnd(),
+  is the time spent waiting for them, so load imbalance shows up as long communication events on the faster processes.
+
+  Level: advanced
+
+.seealso: PetscLogTimelineDump(), PetscLogTraceBegin(), PetscLogDefaultBegin(), PetscLogSet()
+@*/
+PetscErrorCode PetscLogTimelineBegin(PetscInt size)
+{
+  PetscLogDouble now;
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (size == PETSC_DEFAULT || size == PETSC_DECIDE) size = 100000;
+  if (size < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Timeline size %D must be positive",size);
+  ierr = PetscFree(timelineRecords);CHKERRQ(ierr);
+  ierr = PetscMalloc1(size,&timelineRecords);CHKERRQ(ierr);
+  timelineSize       = size;
+  timelineCount      = 0;
+  timelineEventDepth = 0;
+
+  /* the stages already on the stack begin now; with -log_timeline this is called before the main stage is pushed */
+  timelineStageDepth = petsc_stageLog ? PetscMin(petsc_stageLog->stack->top+1,PETSC_TIMELINE_MAX_DEPTH) : 0;
+  PetscTime(&now);
+  for (i=0; i<timelineStageDepth; i++) {
+    timelineStages[i].id    = petsc_stageLog->stack->stack[i];
+    timelineStages[i].stage = -1;
+    timelineStages[i].begin = now - petsc_BaseTime;
+    PetscLogTimelineCounters(&timelineStages[i]);
+  }
+  ierr = PetscLogSet(PetscLogEventBeginTimeline,PetscLogEventEndTimeline);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Frees the ring buffer, called by PetscLogFinalize() */
+PetscErrorCode PetscLogTimelineEnd(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(timelineRecords);CHKERRQ(ierr);
+  timelineSize       = 0;
+  timelineCount      = 0;
+  timelineEventDepth = 0;
+  timelineStageDepth = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogTimelineRecordView(PetscViewer viewer,PetscMPIInt rank,PetscStageLog stageLog,const PetscTimelineRecord *r)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (r->stage < 0) {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"%s\", \"cat\": \"stage\", \"ph\": \"X\", \"pid\": %d, \"tid\": 1, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"flops\": %.0f, \"messages\": %.0f, \"reductions\": %.0f, \"waits\": %.0f}}",
+                                              stageLog->stageInfo[r->id].name,rank,1.e6*r->begin,1.e6*(r->end-r->begin),r->flops,r->messages,r->reductions,r->waits);CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"%s\", \"cat\": \"event\", \"ph\": \"X\", \"pid\": %d, \"tid\": 0, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"stage\": \"%s\", \"flops\": %.0f, \"messages\": %.0f, \"reductions\": %.0f, \"waits\": %.0f}}",
+                                              stageLog->eventLog->eventInfo[r->id].name,rank,1.e6*r->begin,1.e6*(r->end-r->begin),stageLog->stageInfo[r->stage].name,r->flops,r->messages,r->reductions,r->waits);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTimelineDump - Writes the timeline recorded since PetscLogTimelineBegin() as a Chrome trace, which can be
+  opened in chrome://tracing or https://ui.perfetto.dev
+
+  Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. name - the name of the file, or NULL for "petsc_timeline.json"
+
+  Notes:
+  Each MPI rank is shown as a process with two tracks, one with the events and one with the stages. The arguments of
+  each event are the stage it began in and the flops, messages, global reductions and MPI waits done by this process
+  during it, including those of the nested events. Events and stages that have not ended are not written, except for
+  the stages still on the stack, which end at the call. Times are measured from PetscInitialize(), after a barrier, on
+  the clock of each process.
+
+  Level: advanced
+
+.seealso: PetscLogTimelineBegin(), PetscLogDump(), PetscLogView()
+@*/
+PetscErrorCode PetscLogTimelineDump(const char name[])
+{
+  PetscStageLog       stageLog;
+  PetscViewer         viewer;
+  PetscMPIInt         rank;
+  PetscTimelineRecord stage;
+  PetscLogDouble      now;
+  PetscInt            i,first,dropped;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (!timelineRecords) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call PetscLogTimelineBegin() or use -log_timeline before calling this routine");
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  PetscTime(&now);
+  dropped = PetscMax(timelineCount-timelineSize,0);
+  first   = dropped % timelineSize;
+
+  ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,name ? name : "petsc_timeline.json",&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+  /* every entry but the first one starts with a comma */
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"name\": \"rank %d\"}}",rank ? ",\n" : "",rank,rank);CHKERRQ(ierr);
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"process_sort_index\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"sort_index\": %d}}",rank,rank);CHKERRQ(ierr);
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": 0, \"args\": {\"name\": \"events\"}}",rank);CHKERRQ(ierr);
+  ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": 1, \"args\": {\"name\": \"stages\"}}",rank);CHKERRQ(ierr);
+  if (dropped) {
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,",\n{\"name\": \"dropped\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"records\": %D}}",rank,dropped);CHKERRQ(ierr);
+  }
+  for (i=0; i<PetscMin(timelineCount,timelineSize); i++) {
+    ierr = PetscLogTimelineRecordView(viewer,rank,stageLog,&timelineRecords[(first+i) % timelineSize]);CHKERRQ(ierr);
+  }
+  /* the stages still on the stack end now, without adding them to the ring buffer */
+  for (i=0; i<PetscMin(timelineStageDepth,PETSC_TIMELINE_MAX_DEPTH); i++) {
+    PetscLogTimelineInterval(&timelineStages[i],now,&stage);
+    ierr = PetscLogTimelineRecordView(viewer,rank,stageLog,&stage);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"\n]}\n");CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
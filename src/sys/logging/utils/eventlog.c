@@ -131,6 +131,8 @@ PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog eventLog)
 @*/
 PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   eventInfo->id            = -1;
   eventInfo->active        = PETSC_TRUE;
@@ -163,6 +165,8 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  ierr = PetscArrayzero(eventInfo->hwCounters,PETSC_LOG_NUM_HWCOUNTERS);CHKERRQ(ierr);
+  ierr = PetscArrayzero(eventInfo->hwStart,PETSC_LOG_NUM_HWCOUNTERS+2);CHKERRQ(ierr);
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -667,6 +671,12 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
     eventLog->eventInfo[event].mallocIncrease -= usage;
     ierr = PetscMallocPushMaximumUsage((int)event);CHKERRQ(ierr);
   }
+  if (PetscLogHWCounters) {
+    ierr = PetscLogHWCountersStart(eventLog->eventInfo[event].hwStart);CHKERRQ(ierr);
+  }
+  if (PetscLogMallocUsage) {
+    ierr = PetscLogMallocUsageEventBegin(event);CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount -= petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount -= petsc_gtoc_ct;
@@ -714,6 +724,12 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
     ierr = PetscMallocGetMaximumUsage(&usage);CHKERRQ(ierr);
     eventLog->eventInfo[event].mallocIncrease += usage;
   }
+  if (PetscLogHWCounters) {
+    ierr = PetscLogHWCountersStop(eventLog->eventInfo[event].hwStart,eventLog->eventInfo[event].hwCounters);CHKERRQ(ierr);
+  }
+  if (PetscLogMallocUsage) {
+    ierr = PetscLogMallocUsageEventEnd(event);CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount += petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount += petsc_gtoc_ct;
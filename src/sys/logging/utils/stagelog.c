@@ -262,6 +262,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
       stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (PetscLogHWCounters) {ierr = PetscLogHWCountersStop(stageLog->stageInfo[curStage].perfInfo.hwStart,stageLog->stageInfo[curStage].perfInfo.hwCounters);CHKERRQ(ierr);}
     }
   }
   /* Activate the stage */
@@ -277,6 +278,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
     stageLog->stageInfo[stage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (PetscLogHWCounters) {ierr = PetscLogHWCountersStart(stageLog->stageInfo[stage].perfInfo.hwStart);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -326,6 +328,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
     stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (PetscLogHWCounters) {ierr = PetscLogHWCountersStop(stageLog->stageInfo[curStage].perfInfo.hwStart,stageLog->stageInfo[curStage].perfInfo.hwCounters);CHKERRQ(ierr);}
   }
   ierr = PetscIntStackEmpty(stageLog->stack, &empty);CHKERRQ(ierr);
   if (!empty) {
@@ -337,6 +340,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
       stageLog->stageInfo[curStage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (PetscLogHWCounters) {ierr = PetscLogHWCountersStart(stageLog->stageInfo[curStage].perfInfo.hwStart);CHKERRQ(ierr);}
     }
     stageLog->curStage = curStage;
   } else stageLog->curStage = -1;
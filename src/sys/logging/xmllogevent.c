@@ -891,6 +891,26 @@ static PetscErrorCode PetscPrintXMLNestedLinePerfResults(PetscViewer viewer,cons
   PetscFunctionReturn(0);
 }
 
+/*
+ * Prints the rates derived from the hardware counters, the memory bandwidth is estimated as one cache line read from
+ * memory for each last level cache miss. Rates of counters that are not available, or of events that are too short,
+ * are printed as zero.
+ */
+static PetscErrorCode PetscLogNestedTreePrintHWCounters(PetscViewer viewer,PetscEventPerfInfo perfInfo,PetscBool longEnough)
+{
+  const PetscLogDouble *hw = perfInfo.hwCounters;
+  const PetscBool      *av = PetscLogHWCounterAvailable;
+  PetscLogDouble       time = perfInfo.time;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscPrintXMLNestedLinePerfResults(viewer, "ipc", av[0] && av[1] && hw[0] > 0 ? hw[1]/hw[0] : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
+  ierr = PetscPrintXMLNestedLinePerfResults(viewer, "llcmissratio", av[2] && av[3] && hw[2] > 0 ? hw[3]/hw[2] : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
+  ierr = PetscPrintXMLNestedLinePerfResults(viewer, "mbpsmemory", av[3] && longEnough ? hw[3]*PETSC_LEVEL1_DCACHE_LINESIZE/(1024*1024*time) : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
+  ierr = PetscPrintXMLNestedLinePerfResults(viewer, "pagefaultsps", av[4] && longEnough ? hw[4]/time : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #define N_COMM 8
 static PetscErrorCode PetscLogNestedTreePrintLine(PetscViewer viewer,PetscEventPerfInfo perfInfo,PetscLogDouble countsPerCall,int parentCount,int depth,const char *name,PetscLogDouble totalTime,PetscBool *isPrinted)
 {
@@ -911,6 +931,9 @@ static PetscErrorCode PetscLogNestedTreePrintLine(PetscViewer viewer,PetscEventP
     ierr = PetscPrintXMLNestedLinePerfResults(viewer, "mflops", time>=timeMx*0.001 ? 1e-6*perfInfo.flops/time : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
     ierr = PetscPrintXMLNestedLinePerfResults(viewer, "mbps",time>=timeMx*0.001 ? perfInfo.messageLength/(1024*1024*time) : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
     ierr = PetscPrintXMLNestedLinePerfResults(viewer, "nreductsps", time>=timeMx*0.001 ? perfInfo.numReductions/time : 0, 0, 0.01, 1.05);CHKERRQ(ierr);
+    if (PetscLogHWCounters) {
+      ierr = PetscLogNestedTreePrintHWCounters(viewer,perfInfo,time>=timeMx*0.001);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -1028,7 +1051,7 @@ static PetscErrorCode PetscLogNestedTreePrint(PetscViewer viewer, PetscNestedEve
     countsPerCall = 0;
   } else {
   /* Set the values for a timer that was activated in this process */
-    int           i;
+    int           i,c;
     PetscLogEvent dftEvent   = tree[iStart].dftEvent;
 
     parentCount    = countParents( tree, eventPerfInfo, iStart);
@@ -1041,6 +1064,7 @@ static PetscErrorCode PetscLogNestedTreePrint(PetscViewer viewer, PetscNestedEve
     otherPerfInfo.numMessages   = 0;
     otherPerfInfo.messageLength = 0;
     otherPerfInfo.numReductions = 0;
+    for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) otherPerfInfo.hwCounters[c] = 0;
 
     for (i=0; i<nChildren; i++) {
       /* For all child counters: subtract the child values from self-timers */
@@ -1053,6 +1077,7 @@ static PetscErrorCode PetscLogNestedTreePrint(PetscViewer viewer, PetscNestedEve
       selfPerfInfo.numMessages   -= childPerfInfo.numMessages;
       selfPerfInfo.messageLength -= childPerfInfo.messageLength;
       selfPerfInfo.numReductions -= childPerfInfo.numReductions;
+      for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) selfPerfInfo.hwCounters[c] -= childPerfInfo.hwCounters[c];
 
       if ((children[i].val/totalTime) < THRESHOLD) {
         /* Add them to 'other' if the time is ignored in the output */
@@ -1061,6 +1086,7 @@ static PetscErrorCode PetscLogNestedTreePrint(PetscViewer viewer, PetscNestedEve
         otherPerfInfo.numMessages   += childPerfInfo.numMessages;
         otherPerfInfo.messageLength += childPerfInfo.messageLength;
         otherPerfInfo.numReductions += childPerfInfo.numReductions;
+        for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) otherPerfInfo.hwCounters[c] += childPerfInfo.hwCounters[c];
       }
     }
   }
@@ -1196,6 +1222,7 @@ typedef struct {
   PetscLogDouble numMessages;
   PetscLogDouble messageLength;
   PetscLogDouble numReductions;
+  PetscLogDouble hwCounters[PETSC_LOG_NUM_HWCOUNTERS];
 } PetscSelfTimer;
 
 static PetscErrorCode PetscCalcSelfTime(PetscViewer viewer, PetscSelfTimer **p_self, int *p_nstMax)
@@ -1208,7 +1235,7 @@ static PetscErrorCode PetscCalcSelfTime(PetscViewer viewer, PetscSelfTimer **p_s
   PetscSelfTimer     *selftimes;
   PetscSelfTimer     *totaltimes;
   NestedEventId      *nstEvents;
-  int                i, j, maxDefaultTimer;
+  int                i, j, c, maxDefaultTimer;
   NestedEventId      nst;
   PetscLogEvent      dft;
   int                nstMax, nstMax_local;
@@ -1250,6 +1277,7 @@ static PetscErrorCode PetscCalcSelfTime(PetscViewer viewer, PetscSelfTimer **p_s
     totaltimes[nst].numMessages   = 0;
     totaltimes[nst].messageLength = 0;
     totaltimes[nst].numReductions = 0;
+    for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) totaltimes[nst].hwCounters[c] = 0;
     totaltimes[nst].name          = NULL;
   }
 
@@ -1265,6 +1293,7 @@ static PetscErrorCode PetscCalcSelfTime(PetscViewer viewer, PetscSelfTimer **p_s
       totaltimes[nstEvent].numMessages   += eventPerfInfo[dftEvent].numMessages;
       totaltimes[nstEvent].messageLength += eventPerfInfo[dftEvent].messageLength;
       totaltimes[nstEvent].numReductions += eventPerfInfo[dftEvent].numReductions;
+      for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) totaltimes[nstEvent].hwCounters[c] += eventPerfInfo[dftEvent].hwCounters[c];
     }
     totaltimes[nstEvent].name = eventRegInfo[(PetscLogEvent)nstEvent].name;
   }
@@ -1286,6 +1315,7 @@ static PetscErrorCode PetscCalcSelfTime(PetscViewer viewer, PetscSelfTimer **p_s
         selftimes[nstParent].numMessages   -= eventPerfInfo[dftEvent].numMessages;
         selftimes[nstParent].messageLength -= eventPerfInfo[dftEvent].messageLength;
         selftimes[nstParent].numReductions -= eventPerfInfo[dftEvent].numReductions;
+        for (c=0; c<PETSC_LOG_NUM_HWCOUNTERS; c++) selftimes[nstParent].hwCounters[c] -= eventPerfInfo[dftEvent].hwCounters[c];
       }
     }
   }
@@ -1347,6 +1377,7 @@ static PetscErrorCode PetscPrintSelfTime(PetscViewer viewer, const PetscSelfTime
       selfPerfInfo.numMessages   = selftimes[nstEvent].numMessages;
       selfPerfInfo.messageLength = selftimes[nstEvent].messageLength;
       selfPerfInfo.numReductions = selftimes[nstEvent].numReductions;
+      ierr = PetscArraycpy(selfPerfInfo.hwCounters,selftimes[nstEvent].hwCounters,PETSC_LOG_NUM_HWCOUNTERS);CHKERRQ(ierr);
 
       ierr = PetscLogNestedTreePrintLine(viewer, selfPerfInfo, dum_count, dum_parentcount, dum_depth, name, totalTime, &wasPrinted);CHKERRQ(ierr);
       if (wasPrinted){
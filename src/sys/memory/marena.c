@@ -0,0 +1,260 @@
+/*
+      Scoped arenas: scratch memory taken by moving a pointer in large chunks and released all at once at the end of
+      a scope, without a PetscMalloc() and PetscFree() for each array.
+*/
+#include <petsc/private/petscimpl.h>        /*I   "petscsys.h"   I*/
+#include <petscviewer.h>
+
+#define PETSC_ARENA_MAX_DEPTH 32
+
+typedef struct _PetscArenaChunk *PetscArenaChunk;
+struct _PetscArenaChunk {
+  PetscArenaChunk next;
+  size_t          size;
+  size_t          used;
+  char            *data;
+};
+
+typedef struct {
+  PetscArenaChunk chunk;
+  size_t          used;
+  size_t          inuse;
+} PetscArenaMark;
+
+struct _n_PetscArena {
+  PetscArenaChunk head;         /* the chunks are kept after the end of a scope and reused by the next one */
+  PetscArenaChunk current;
+  size_t          chunksize;
+  PetscArenaMark  marks[PETSC_ARENA_MAX_DEPTH];
+  int             depth;
+  /* statistics */
+  size_t          inuse;        /* the bytes given out and not yet released */
+  size_t          maxinuse;
+  size_t          allocated;    /* the bytes in the chunks */
+  PetscInt64      nget;
+  PetscInt64      nchunks;
+};
+
+static PetscErrorCode PetscArenaAddChunk_Private(PetscArena arena,size_t bytes)
+{
+  PetscArenaChunk chunk;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&chunk);CHKERRQ(ierr);
+  chunk->size = PetscMax(bytes,arena->chunksize);
+  ierr = PetscMalloc(chunk->size,&chunk->data);CHKERRQ(ierr);
+  /* inserted after the current chunk, an arena of n chunks has n-1 with free space at their end at most */
+  if (arena->current) {
+    chunk->next          = arena->current->next;
+    arena->current->next = chunk;
+  } else {
+    chunk->next = arena->head;
+    arena->head = chunk;
+  }
+  arena->current    = chunk;
+  arena->allocated += chunk->size;
+  arena->nchunks++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaCreate - Creates an arena from which scratch arrays can be taken and released together
+
+   Not Collective
+
+   Input Arguments:
+.  chunksize - the number of bytes obtained with PetscMalloc() at once, or 0 for the default 64 KiB
+
+   Output Argument:
+.  arena - the arena
+
+   Notes:
+   Arrays are taken with PetscArenaGet() between PetscArenaBegin() and PetscArenaEnd(), which releases all of them.
+   The memory is not returned to the system at the end of a scope, the next scope reuses it, so a loop that needs
+   a few work arrays in each iteration calls PetscMalloc() only in its first iterations:
+.vb
+   PetscArenaCreate(0,&arena);
+   for (i=0; i<n; i++) {
+     PetscArenaBegin(arena);
+     PetscArenaGet(arena,m*sizeof(PetscScalar),&work);
+     PetscArenaGet(arena,m*sizeof(PetscInt),&idx);
+     ...
+     PetscArenaEnd(arena);
+   }
+   PetscArenaDestroy(&arena);
+.ve
+   MatGetRow() of MATSEQBAIJ and MATSEQSBAIJ matrices takes its arrays from an arena of the matrix in this way, the
+   scope ends in MatRestoreRow().
+
+   Level: developer
+
+.seealso: PetscArenaGet(), PetscArenaBegin(), PetscArenaEnd(), PetscArenaView(), PetscArenaDestroy(), PetscMallocSetPool()
+@*/
+PetscErrorCode PetscArenaCreate(size_t chunksize,PetscArena *arena)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(arena,2);
+  ierr = PetscNew(arena);CHKERRQ(ierr);
+  (*arena)->chunksize = chunksize ? chunksize : 64*1024;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaDestroy - Frees an arena and all the memory taken from it
+
+   Not Collective
+
+   Input Arguments:
+.  arena - the arena
+
+   Level: developer
+
+.seealso: PetscArenaCreate()
+@*/
+PetscErrorCode PetscArenaDestroy(PetscArena *arena)
+{
+  PetscArenaChunk chunk,next;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (!*arena) PetscFunctionReturn(0);
+  for (chunk=(*arena)->head; chunk; chunk=next) {
+    next = chunk->next;
+    ierr = PetscFree(chunk->data);CHKERRQ(ierr);
+    ierr = PetscFree(chunk);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(*arena);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaGet - Takes memory from an arena
+
+   Not Collective
+
+   Input Arguments:
++  arena - the arena
+-  bytes - the number of bytes
+
+   Output Argument:
+.  result - the address of a pointer to the memory, aligned to PETSC_MEMALIGN and valid until the PetscArenaEnd() of
+   the innermost scope, or PetscArenaDestroy() outside of any scope
+
+   Notes:
+   The memory is not cleared.
+
+   Level: developer
+
+.seealso: PetscArenaCreate(), PetscArenaBegin(), PetscArenaEnd()
+@*/
+PetscErrorCode PetscArenaGet(PetscArena arena,size_t bytes,void *result)
+{
+  PetscArenaChunk chunk = arena->current;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (!bytes) {*(void**)result = NULL; PetscFunctionReturn(0);}
+  bytes = (bytes+(PETSC_MEMALIGN-1)) & ~(size_t)(PETSC_MEMALIGN-1);
+  if (!chunk || chunk->size-chunk->used < bytes) {
+    /* the chunks released by the end of a scope come next */
+    if (chunk && chunk->next && chunk->next->size >= bytes) {
+      arena->current       = chunk->next;
+      arena->current->used = 0;
+    } else if (!chunk && arena->head && arena->head->size >= bytes) {
+      arena->current       = arena->head;
+      arena->current->used = 0;
+    } else {
+      ierr = PetscArenaAddChunk_Private(arena,bytes);CHKERRQ(ierr);
+    }
+    chunk = arena->current;
+  }
+  *(void**)result = chunk->data+chunk->used;
+  chunk->used    += bytes;
+  arena->inuse   += bytes;
+  arena->maxinuse = PetscMax(arena->maxinuse,arena->inuse);
+  arena->nget++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaBegin - Begins a scope, the memory taken from the arena after it is released by PetscArenaEnd()
+
+   Not Collective
+
+   Input Arguments:
+.  arena - the arena
+
+   Notes:
+   Scopes can be nested.
+
+   Level: developer
+
+.seealso: PetscArenaEnd(), PetscArenaGet()
+@*/
+PetscErrorCode PetscArenaBegin(PetscArena arena)
+{
+  PetscFunctionBegin;
+  if (arena->depth >= PETSC_ARENA_MAX_DEPTH) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"More than %d nested PetscArenaBegin()",PETSC_ARENA_MAX_DEPTH);
+  arena->marks[arena->depth].chunk = arena->current;
+  arena->marks[arena->depth].used  = arena->current ? arena->current->used : 0;
+  arena->marks[arena->depth].inuse = arena->inuse;
+  arena->depth++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaEnd - Ends the scope begun by the matching PetscArenaBegin(), the memory taken in it can be reused
+
+   Not Collective
+
+   Input Arguments:
+.  arena - the arena
+
+   Level: developer
+
+.seealso: PetscArenaBegin(), PetscArenaGet()
+@*/
+PetscErrorCode PetscArenaEnd(PetscArena arena)
+{
+  PetscArenaMark *mark;
+
+  PetscFunctionBegin;
+  if (!arena->depth) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"PetscArenaEnd() without PetscArenaBegin()");
+  mark           = &arena->marks[--arena->depth];
+  arena->current = mark->chunk;
+  if (mark->chunk) mark->chunk->used = mark->used;
+  arena->inuse   = mark->inuse;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscArenaView - Prints the number of arrays taken from an arena, the largest memory in use at once and the memory
+   obtained with PetscMalloc()
+
+   Not Collective
+
+   Input Arguments:
++  arena - the arena
+-  viewer - an ASCII viewer
+
+   Level: developer
+
+.seealso: PetscArenaCreate()
+@*/
+PetscErrorCode PetscArenaView(PetscArena arena,PetscViewer viewer)
+{
+  PetscBool      isascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!viewer) {ierr = PetscViewerASCIIGetStdout(PETSC_COMM_SELF,&viewer);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (!isascii) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"PetscArena: %D gets, %.0f bytes in use, at most %.0f, %D chunks with %.0f bytes\n",(PetscInt)arena->nget,(PetscLogDouble)arena->inuse,
+                                (PetscLogDouble)arena->maxinuse,(PetscInt)arena->nchunks,(PetscLogDouble)arena->allocated);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,353 @@
+/*
+      A pool allocator for PetscMalloc(): small allocations are rounded up to a power of two size class and freed blocks
+      are kept in a free list for each class, so that the work arrays allocated and freed in inner loops are reused
+      without going to the system malloc().
+*/
+#include <petsc/private/petscimpl.h>        /*I   "petscsys.h"   I*/
+#include <petsctime.h>
+#include <petscviewer.h>
+
+PETSC_INTERN PetscBool petscsetmallocvisited;
+
+#define PETSC_POOL_ID          ((int) 0x0b0c0d0e)
+#define PETSC_POOL_FREE_ID     ((int) 0x0e0d0c0b) /* the id of the blocks in the free lists */
+#define PETSC_POOL_MIN_SHIFT   4    /* the smallest class is 16 bytes */
+#define PETSC_POOL_NUM_CLASSES 13   /* the largest class is 64 KiB */
+
+typedef struct {
+  size_t size;   /* the size requested */
+  int    sclass; /* the size class, or -1 for the allocations larger than the largest class */
+  int    id;     /* PETSC_POOL_ID, or PETSC_POOL_FREE_ID while the block is in a free list */
+} PetscPoolHeader;
+
+#define HEADER_BYTES ((sizeof(PetscPoolHeader)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+
+typedef struct _n_PetscPoolBlock *PetscPoolBlock;
+struct _n_PetscPoolBlock {
+  PetscPoolBlock next;
+};
+
+typedef struct {
+  PetscPoolBlock free;    /* the blocks freed and kept for reuse */
+  PetscInt64     ncached; /* the number of blocks in the free list */
+  PetscInt64     nalloc;  /* the number of allocations in this class */
+  PetscInt64     nreused; /* the number of them served from the free list */
+} PetscPoolClass;
+
+static PetscPoolClass poolClasses[PETSC_POOL_NUM_CLASSES];
+static PetscInt64     poolLarge     = 0;              /* the number of allocations larger than the largest class */
+static PetscInt64     poolFree      = 0;              /* the number of frees */
+static size_t         poolCached    = 0;              /* the bytes in the free lists */
+static size_t         poolMaxCached = 64*1024*1024;   /* frees beyond this go to the system */
+static PetscBool      poolOn        = PETSC_FALSE;
+static PetscLogDouble poolStart     = 0.0;
+
+static PetscErrorCode (*PetscTrMallocPoolOld)(size_t,PetscBool,int,const char[],const char[],void**) = NULL;
+static PetscErrorCode (*PetscTrReallocPoolOld)(size_t,int,const char[],const char[],void**)          = NULL;
+static PetscErrorCode (*PetscTrFreePoolOld)(void*,int,const char[],const char[])                     = NULL;
+
+/* the class of a is the number of bits of a-1 beyond PETSC_POOL_MIN_SHIFT, found with a bit scan */
+PETSC_STATIC_INLINE int PetscPoolSizeClass(size_t a)
+{
+  int c;
+
+  if (a <= ((size_t)1 << PETSC_POOL_MIN_SHIFT)) return 0;
+  if (a > ((size_t)1 << (PETSC_POOL_NUM_CLASSES-1+PETSC_POOL_MIN_SHIFT))) return -1;
+#if defined(__GNUC__)
+  c = 8*(int)sizeof(unsigned long long) - __builtin_clzll((unsigned long long)(a-1));
+#else
+  for (c=0, a--; a; a >>= 1) c++;
+#endif
+  return c-PETSC_POOL_MIN_SHIFT;
+}
+
+/*
+   No PetscFunctionBegin in the allocation and the free: the reuse of a block of the free list is the common case and
+   is kept to a few instructions. The class of a block stays in its header while it is in the free list, its id is
+   changed to PETSC_POOL_FREE_ID so that a second free of it is detected.
+*/
+static PetscErrorCode PetscPoolMalloc(size_t a,PetscBool clear,int lineno,const char function[],const char filename[],void **result)
+{
+  PetscPoolHeader *head;
+  PetscPoolClass  *pclass;
+  PetscPoolBlock  block;
+  char            *inew;
+  int             c;
+  PetscErrorCode  ierr;
+
+  if (!a) {*result = NULL; return 0;}
+  c = PetscPoolSizeClass(a);
+  if (c >= 0) {
+    pclass = &poolClasses[c];
+    pclass->nalloc++;
+    if ((block = pclass->free)) {
+      pclass->free = block->next;
+      pclass->ncached--;
+      pclass->nreused++;
+      poolCached  -= (size_t)1 << (c+PETSC_POOL_MIN_SHIFT);
+      head         = (PetscPoolHeader*)((char*)block-HEADER_BYTES);
+      head->size   = a;
+      head->id     = PETSC_POOL_ID;
+      if (clear) memset(block,0,a);
+      *result = block;
+      return 0;
+    }
+    ierr = (*PetscTrMallocPoolOld)(((size_t)1 << (c+PETSC_POOL_MIN_SHIFT))+HEADER_BYTES,clear,lineno,function,filename,(void**)&inew);if (ierr) return ierr;
+  } else {
+    poolLarge++;
+    ierr = (*PetscTrMallocPoolOld)(a+HEADER_BYTES,clear,lineno,function,filename,(void**)&inew);if (ierr) return ierr;
+  }
+  head         = (PetscPoolHeader*)inew;
+  head->size   = a;
+  head->sclass = c;
+  head->id     = PETSC_POOL_ID;
+  *result      = inew+HEADER_BYTES;
+  return 0;
+}
+
+static PetscErrorCode PetscPoolFree(void *aa,int lineno,const char function[],const char filename[])
+{
+  char            *a = (char*)aa;
+  PetscPoolHeader *head;
+  PetscPoolBlock  block;
+  size_t          csize;
+
+  if (!a) return 0;
+  head = (PetscPoolHeader*)(a-HEADER_BYTES);
+  if (head->id == PETSC_POOL_FREE_ID) return PetscError(PETSC_COMM_SELF,lineno,function,filename,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Freeing memory that was already freed (double free)");
+  if (head->id != PETSC_POOL_ID) return PetscError(PETSC_COMM_SELF,lineno,function,filename,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Freeing memory that was not allocated after PetscMallocSetPool(), or that is corrupted");
+  poolFree++;
+  if (head->sclass >= 0 && poolOn) {
+    csize = (size_t)1 << (head->sclass+PETSC_POOL_MIN_SHIFT);
+    if (poolCached + csize <= poolMaxCached) {
+      head->id    = PETSC_POOL_FREE_ID;
+      block       = (PetscPoolBlock)a;
+      block->next = poolClasses[head->sclass].free;
+      poolClasses[head->sclass].free = block;
+      poolClasses[head->sclass].ncached++;
+      poolCached += csize;
+      return 0;
+    }
+  }
+  head->id = 0;
+  return (*PetscTrFreePoolOld)(head,lineno,function,filename);
+}
+
+static PetscErrorCode PetscPoolRealloc(size_t len,int lineno,const char function[],const char filename[],void **result)
+{
+  PetscPoolHeader *head;
+  char            *inew;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (!len) {
+    ierr    = PetscPoolFree(*result,lineno,function,filename);CHKERRQ(ierr);
+    *result = NULL;
+    PetscFunctionReturn(0);
+  }
+  if (!*result) {
+    ierr = PetscPoolMalloc(len,PETSC_FALSE,lineno,function,filename,result);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  head = (PetscPoolHeader*)((char*)*result-HEADER_BYTES);
+  if (head->id == PETSC_POOL_FREE_ID) return PetscError(PETSC_COMM_SELF,lineno,function,filename,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Reallocating memory that was already freed");
+  if (head->id != PETSC_POOL_ID) return PetscError(PETSC_COMM_SELF,lineno,function,filename,PETSC_ERR_MEMC,PETSC_ERROR_INITIAL,"Reallocating memory that was not allocated after PetscMallocSetPool(), or that is corrupted");
+  if (head->sclass < 0) {
+    /* a large allocation stays out of the pool */
+    inew = (char*)head;
+    ierr = (*PetscTrReallocPoolOld)(len+HEADER_BYTES,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+    ((PetscPoolHeader*)inew)->size = len;
+    *result = inew+HEADER_BYTES;
+  } else if (len <= ((size_t)1 << (head->sclass+PETSC_POOL_MIN_SHIFT))) {
+    head->size = len;
+  } else {
+    ierr = PetscPoolMalloc(len,PETSC_FALSE,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+    ierr = PetscMemcpy(inew,*result,head->size);CHKERRQ(ierr);
+    ierr = PetscPoolFree(*result,lineno,function,filename);CHKERRQ(ierr);
+    *result = inew;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocSetPool - Makes PetscMalloc() reuse the memory of freed small allocations
+
+   Not Collective
+
+   Options Database Keys:
++  -malloc_pool - Activates PetscMallocSetPool() during PetscInitialize()
+.  -malloc_pool_max_cached <bytes> - The maximum memory kept in the free lists, 64 MiB by default
+-  -malloc_pool_view - Prints the statistics of the pool with PetscMallocPoolView() during PetscFinalize()
+
+   Notes:
+   Allocations up to 64 KiB are rounded up to a power of two size class. When they are freed they are kept in a free
+   list for their class and given to the next allocation of the same class, so the work arrays that are allocated and
+   freed repeatedly, as the communication buffers of PetscSF or in the assembly of small blocks, do not go to the
+   system malloc() each time. Freeing a block a second time while it is in a free list raises PETSC_ERR_MEMC. Larger allocations, and frees beyond the cached limit, are passed to the
+   allocator selected before (for example with -malloc_debug), which this wraps. The memory in the free lists is
+   returned by PetscMallocPoolRelease() and during PetscFinalize() before -malloc_dump reports unfreed memory.
+
+   The gain is largest over the tracing allocator of -malloc_debug (the default in debug builds), which does the
+   bookkeeping of every allocation and free. Over the system malloc() of an optimized build a reused block saves
+   little more than the call, and the rounding to a size class costs memory.
+
+   The free lists are not protected by a lock, so the pool cannot be used when PETSc is configured with
+   --with-threadsafety.
+
+   Since memory allocated before cannot be freed after, this is activated with -malloc_pool during PetscInitialize().
+   For scratch memory with a known lifetime, PetscArenaCreate() provides scoped allocations that avoid PetscMalloc()
+   altogether.
+
+   Level: developer
+
+.seealso: PetscMallocPoolView(), PetscMallocPoolRelease(), PetscMallocSet(), PetscArenaCreate()
+@*/
+PetscErrorCode PetscMallocSetPool(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_THREADSAFETY)
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"The pool allocator is not thread safe, it cannot be used with --with-threadsafety");
+#endif
+  if (PetscTrMalloc == PetscPoolMalloc) PetscFunctionReturn(0);
+  ierr = PetscMemzero(poolClasses,sizeof(poolClasses));CHKERRQ(ierr);
+  poolLarge  = 0;
+  poolFree   = 0;
+  poolCached = 0;
+  PetscTrMallocPoolOld  = PetscTrMalloc;
+  PetscTrReallocPoolOld = PetscTrRealloc;
+  PetscTrFreePoolOld    = PetscTrFree;
+  PetscTrMalloc         = PetscPoolMalloc;
+  PetscTrRealloc        = PetscPoolRealloc;
+  PetscTrFree           = PetscPoolFree;
+  petscsetmallocvisited = PETSC_TRUE;
+  poolOn                = PETSC_TRUE;
+  ierr = PetscTime(&poolStart);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocPoolSetMaxCached - Sets the maximum memory kept in the free lists of the pool allocator
+
+   Not Collective
+
+   Input Parameter:
+.  max - the number of bytes, frees beyond it are returned to the system
+
+   Options Database Key:
+.  -malloc_pool_max_cached <bytes> - Sets the maximum
+
+   Level: developer
+
+.seealso: PetscMallocSetPool()
+@*/
+PetscErrorCode PetscMallocPoolSetMaxCached(size_t max)
+{
+  PetscFunctionBegin;
+  poolMaxCached = max;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocPoolRelease - Returns the memory kept in the free lists of the pool allocator to the system
+
+   Not Collective
+
+   Level: developer
+
+.seealso: PetscMallocSetPool()
+@*/
+PetscErrorCode PetscMallocPoolRelease(void)
+{
+  PetscPoolBlock block;
+  int            c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (c=0; c<PETSC_POOL_NUM_CLASSES; c++) {
+    while ((block = poolClasses[c].free)) {
+      poolClasses[c].free = block->next;
+      poolClasses[c].ncached--;
+      ((PetscPoolHeader*)((char*)block-HEADER_BYTES))->id = 0;
+      ierr = (*PetscTrFreePoolOld)((char*)block-HEADER_BYTES,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+    }
+  }
+  poolCached = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Called by PetscFinalize(), after it the frees go directly to the system */
+PETSC_INTERN PetscErrorCode PetscMallocPoolEnd(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!poolOn) PetscFunctionReturn(0);
+  ierr   = PetscMallocPoolRelease();CHKERRQ(ierr);
+  poolOn = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocPoolView - Prints the number of allocations in each size class of the pool allocator, the fraction of
+   them that reused freed memory, and the allocation rate
+
+   Collective on PetscViewer
+
+   Input Parameter:
+.  viewer - an ASCII viewer, the counts are summed over its processes
+
+   Options Database Key:
+.  -malloc_pool_view - Calls PetscMallocPoolView() during PetscFinalize()
+
+   Level: developer
+
+.seealso: PetscMallocSetPool()
+@*/
+PetscErrorCode PetscMallocPoolView(PetscViewer viewer)
+{
+  MPI_Comm       comm;
+  PetscLogDouble local[3*PETSC_POOL_NUM_CLASSES+3],global[3*PETSC_POOL_NUM_CLASSES+3],now,time,nalloc = 0,nreused = 0;
+  int            c;
+  PetscBool      isascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (!isascii) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  if (!poolOn) {
+    ierr = PetscViewerASCIIPrintf(viewer,"The pool allocator is not active, use -malloc_pool\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (c=0; c<PETSC_POOL_NUM_CLASSES; c++) {
+    local[3*c]   = (PetscLogDouble)poolClasses[c].nalloc;
+    local[3*c+1] = (PetscLogDouble)poolClasses[c].nreused;
+    local[3*c+2] = (PetscLogDouble)poolClasses[c].ncached;
+  }
+  local[3*PETSC_POOL_NUM_CLASSES]   = (PetscLogDouble)poolLarge;
+  local[3*PETSC_POOL_NUM_CLASSES+1] = (PetscLogDouble)poolFree;
+  local[3*PETSC_POOL_NUM_CLASSES+2] = (PetscLogDouble)poolCached;
+  ierr = MPIU_Allreduce(local,global,3*PETSC_POOL_NUM_CLASSES+3,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+  ierr = PetscTime(&now);CHKERRQ(ierr);
+  time = now-poolStart;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&time,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIPrintf(viewer,"PetscMalloc() pool, summed over the processes:\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Class (bytes)  Allocations  Reused (%%)     Cached\n");CHKERRQ(ierr);
+  for (c=0; c<PETSC_POOL_NUM_CLASSES; c++) {
+    if (!global[3*c]) continue;
+    nalloc  += global[3*c];
+    nreused += global[3*c+1];
+    ierr = PetscViewerASCIIPrintf(viewer,"%13.0f %12.0f %10.1f %10.0f\n",(PetscLogDouble)((size_t)1 << (c+PETSC_POOL_MIN_SHIFT)),global[3*c],100.0*global[3*c+1]/global[3*c],global[3*c+2]);CHKERRQ(ierr);
+  }
+  nalloc += global[3*PETSC_POOL_NUM_CLASSES];
+  ierr = PetscViewerASCIIPrintf(viewer,"        Large %12.0f\n",global[3*PETSC_POOL_NUM_CLASSES]);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Allocations %.0f (%.1f%% reused), frees %.0f, %g allocations per second, %.0f bytes cached\n",nalloc,nalloc ? 100.0*nreused/nalloc : 0.0,
+                                global[3*PETSC_POOL_NUM_CLASSES+1],time > 0.0 ? nalloc/time : 0.0,global[3*PETSC_POOL_NUM_CLASSES+2]);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -434,6 +434,21 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_hbw",&flg1,NULL);CHKERRQ(ierr);
   /* ignore this option if malloc is already set */
   if (flg1 && !petscsetmallocvisited) {ierr = PetscSetUseHBWMalloc_Private();CHKERRQ(ierr);}
+  /* these wrap the allocator selected above */
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_pool",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {
+    PetscReal max;
+
+    ierr = PetscOptionsGetReal(NULL,NULL,"-malloc_pool_max_cached",&max,&flg2);CHKERRQ(ierr);
+    if (flg2) {ierr = PetscMallocPoolSetMaxCached((size_t)max);CHKERRQ(ierr);}
+    ierr = PetscMallocSetPool();CHKERRQ(ierr);
+  }
+#if defined(PETSC_USE_LOG)
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_malloc",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogMallocUsageBegin();CHKERRQ(ierr);}
+#endif
 
   flg1 = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_info",&flg1,NULL);CHKERRQ(ierr);
@@ -444,6 +459,10 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   if (flg1) {
     ierr = PetscMemorySetGetMaximumUsage();CHKERRQ(ierr);
   }
+#else
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_pool",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscMallocSetPool();CHKERRQ(ierr);}
 #endif
 
 #if defined(PETSC_USE_LOG)
@@ -650,8 +669,26 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = PetscLogTraceBegin(file);CHKERRQ(ierr);
   }
 
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_timeline",&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscInt size = PETSC_DEFAULT;
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_timeline_size",&size,NULL);CHKERRQ(ierr);
+    ierr = PetscLogTimelineBegin(size);CHKERRQ(ierr);
+  }
+
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_sample",&flg2);CHKERRQ(ierr);
+  if (flg2) {
+    PetscInt period = PETSC_DEFAULT;
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_sample",&period,NULL);CHKERRQ(ierr);
+    ierr = PetscLogSampleBegin(period);CHKERRQ(ierr);
+  }
+
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_hwcounters",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogHWCountersBegin();CHKERRQ(ierr);}
+
   ierr = PetscOptionsGetViewer(comm,NULL,NULL,"-log_view",NULL,&format,&flg4);CHKERRQ(ierr);
-  if (flg4) {
+  if (flg4 && !flg2) {
     if (format == PETSC_VIEWER_ASCII_XML) {
       ierr = PetscLogNestedBegin();CHKERRQ(ierr);
     } else {
@@ -733,10 +770,18 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -shared_tmp: tmp directory is shared by all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -not_shared_tmp: each processor has separate tmp directory\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -memory_view: print memory usage at end of run\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool: reuse the memory of freed small allocations, see PetscMallocSetPool()\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool_max_cached <bytes>: the maximum memory kept for reuse by -malloc_pool\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool_view: print the allocations reused by -malloc_pool at end of run\n");CHKERRQ(ierr);
 #if defined(PETSC_USE_LOG)
     ierr = (*PetscHelpPrintf)(comm," -get_total_flops: total flops over all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_view [:filename:[format]]: logging objects and events\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_sample [period]: with -log_view, count all calls of the events but time only one of every period calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_hwcounters: with -log_view, read the hardware performance counters in each event and stage\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_malloc: with -log_view, print the memory allocated in each event, stage and object class\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_trace [filename]: prints trace of all PETSc calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline [filename]: writes the events and stages of each process as a Chrome trace\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline_size <size>: the number of events and stages kept on each process\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_exclude <list,of,classnames>: exclude given classes from logging\n");CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPE)
     ierr = (*PetscHelpPrintf)(comm," -log_mpe: Also create logfile viewable through Jumpshot\n");CHKERRQ(ierr);
@@ -688,6 +688,7 @@ PetscInt PetscNumOMPThreads;
 .  -malloc_test - like -malloc_dump -malloc_debug, but only active for debugging builds, ignored in optimized build. May want to set in PETSC_OPTIONS environmental variable
 .  -malloc_view - show a list of all allocated memory during PetscFinalize()
 .  -malloc_view_threshold <t> - only list memory allocations of size greater than t with -malloc_view
+.  -malloc_pool - reuse the memory of freed small allocations, see PetscMallocSetPool()
 .  -fp_trap - Stops on floating point exceptions
 .  -no_signal_handler - Indicates not to trap error signals
 .  -shared_tmp - indicates /tmp directory is shared by all processors
@@ -705,16 +706,20 @@ PetscInt PetscNumOMPThreads;
         hangs without running in the debugger).  See PetscLogTraceBegin().
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see PetscLogView().
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each method, see PetscLogView().
+.  -log_sample [period] - Makes -log_view count all calls of each event but time only a sample of them, see PetscLogSampleBegin().
+.  -log_view_hwcounters - Includes in the summary from -log_view the hardware performance counters of each event, see PetscLogHWCountersBegin().
+.  -log_view_malloc - Includes in the summary from -log_view the memory allocated in each event, stage and object class, see PetscLogMallocUsageBegin().
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
 .  -log_all [filename] - Logs extensive profiling information  See PetscLogDump().
 .  -log [filename] - Logs basic profiline information  See PetscLogDump().
 .  -log_mpe [filename] - Creates a logfile viewable by the utility Jumpshot (in MPICH distribution)
+.  -log_timeline [filename] - Writes the events and stages of each process as a Chrome trace, see PetscLogTimelineDump().
 .  -viewfromoptions on,off - Enable or disable XXXSetFromOptions() calls, for applications with many small solves turn this off
 -  -check_pointer_intensity 0,1,2 - if pointers are checked for validity (debug version only), using 0 will result in faster code
 
-    Only one of -log_trace, -log_view, -log_view, -log_all, -log, or -log_mpe may be used at a time
+    Only one of -log_trace, -log_view, -log_view, -log_all, -log, -log_timeline, or -log_mpe may be used at a time
 
    Options Database Keys for SAWs:
 +  -saws_port <portnumber> - port number to publish SAWs data, default is 8080
@@ -1171,6 +1176,7 @@ PetscErrorCode  PetscFreeMPIResources(void)
 .  -mpidump - Calls PetscMPIDump()
 .  -malloc_dump <optional filename> - Calls PetscMallocDump(), displays all memory allocated that has not been freed
 .  -malloc_info - Prints total memory usage
+.  -malloc_pool_view - Calls PetscMallocPoolView()
 -  -malloc_view <optional filename> - Prints list of all memory allocated and where
 
    Level: beginner
@@ -1303,6 +1309,11 @@ PetscErrorCode  PetscFinalize(void)
   if (flg2) {
     ierr = PetscMemoryView(PETSC_VIEWER_STDOUT_WORLD,"Summary of Memory Usage in PETSc\n");CHKERRQ(ierr);
   }
+  flg2 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_pool_view",&flg2,NULL);CHKERRQ(ierr);
+  if (flg2) {
+    ierr = PetscMallocPoolView(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
 #endif
 
 #if defined(PETSC_USE_LOG)
@@ -1363,6 +1374,10 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscOptionsGetString(NULL,NULL,"-log_all",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsGetString(NULL,NULL,"-log",mname,PETSC_MAX_PATH_LEN,&flg2);CHKERRQ(ierr);
   if (flg1 || flg2) {ierr = PetscLogDump(mname);CHKERRQ(ierr);}
+
+  mname[0] = 0;
+  ierr = PetscOptionsGetString(NULL,NULL,"-log_timeline",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogTimelineDump(mname[0] ? mname : NULL);CHKERRQ(ierr);}
 #endif
 
   ierr = PetscStackDestroy();CHKERRQ(ierr);
@@ -1476,6 +1491,8 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscInfoDestroy();CHKERRQ(ierr);
 
 #if !defined(PETSC_HAVE_THREADSAFETY)
+  /* the memory kept for reuse by -malloc_pool is not reported as unfreed */
+  ierr = PetscMallocPoolEnd();CHKERRQ(ierr);
   if (!(PETSC_RUNNING_ON_VALGRIND)) {
     char fname[PETSC_MAX_PATH_LEN];
     char sname[PETSC_MAX_PATH_LEN];
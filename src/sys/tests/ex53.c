@@ -0,0 +1,82 @@
+static char help[] = "Tests PetscLogTimelineBegin() and PetscLogTimelineDump().\n\n";
+
+#include <petscsys.h>
+
+/* prints, for each process, the number of records of each kind in the trace written by PetscLogTimelineDump() */
+static PetscErrorCode CountRecords(const char filename[],PetscMPIInt size)
+{
+  FILE           *fp;
+  char           line[1024],pid[32];
+  const char     *names[] = {"\"Outer\"","\"Inner\"","\"Stage 1\"","\"Main Stage\"","\"dropped\""};
+  PetscInt       i,r,count[5];
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  if (rank) PetscFunctionReturn(0);
+  for (r=0; r<size; r++) {
+    ierr = PetscSNPrintf(pid,sizeof(pid),"\"pid\": %d,",(int)r);CHKERRQ(ierr);
+    ierr = PetscArrayzero(count,5);CHKERRQ(ierr);
+    ierr = PetscFOpen(PETSC_COMM_SELF,filename,"r",&fp);CHKERRQ(ierr);
+    while (fgets(line,sizeof(line),fp)) {
+      if (!strstr(line,pid)) continue;
+      for (i=0; i<5; i++) if (strstr(line,names[i]) == line+9) count[i]++;
+      if (strstr(line,"\"dur\": -")) {ierr = PetscPrintf(PETSC_COMM_SELF,"Negative duration: %s",line);CHKERRQ(ierr);}
+    }
+    ierr = PetscFClose(PETSC_COMM_SELF,fp);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"[%d] Outer %D Inner %D Stage 1 %D Main Stage %D dropped %D\n",(int)r,count[0],count[1],count[2],count[3],count[4]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent  outer,inner;
+  PetscLogStage  stage;
+  PetscInt       i,j,n = 5,size = PETSC_DEFAULT;
+  PetscMPIInt    commsize;
+  PetscReal      x = 1.0,sum;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&commsize);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-size",&size,NULL);CHKERRQ(ierr);
+  ierr = PetscLogTimelineBegin(size);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Outer",PETSC_OBJECT_CLASSID,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Inner",PETSC_OBJECT_CLASSID,&inner);CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("Stage 1",&stage);CHKERRQ(ierr);
+
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+    for (j=0; j<2; j++) {
+      ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+      ierr = MPIU_Allreduce(&x,&sum,1,MPIU_REAL,MPIU_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+    }
+    ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  ierr = PetscLogTimelineDump("ex53_timeline.json");CHKERRQ(ierr);
+  ierr = CountRecords("ex53_timeline.json",commsize);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      suffix: 1
+      nsize: 2
+
+   test:
+      suffix: ring
+      args: -size 10
+
+TEST*/
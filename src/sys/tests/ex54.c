@@ -0,0 +1,69 @@
+static char help[] = "Tests PetscLogSampleBegin().\n\n";
+
+#include <petscsys.h>
+#include <petscviewer.h>
+
+static PetscLogEvent recursive;
+
+/* only the outermost call is counted */
+static PetscErrorCode Recurse(PetscInt depth)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscLogEventBegin(recursive,0,0,0,0);CHKERRQ(ierr);
+  if (depth) {ierr = Recurse(depth-1);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(1.0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(recursive,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent  outer,inner;
+  PetscInt       i,j,n = 1000,period = PETSC_DEFAULT;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-period",&period,NULL);CHKERRQ(ierr);
+  ierr = PetscLogSampleBegin(period);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Outer",PETSC_OBJECT_CLASSID,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Inner",PETSC_OBJECT_CLASSID,&inner);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Recursive",PETSC_OBJECT_CLASSID,&recursive);CHKERRQ(ierr);
+
+  /* the second process calls Inner twice as often */
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+    for (j=0; j<=rank; j++) {
+      ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+      ierr = PetscLogFlops(10.0);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+    }
+    ierr = Recurse(3);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogView(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      suffix: 1
+      nsize: 2
+      # the counts and the number of samples are exact, the times are not
+      filter: grep -v "total time" | cut -c 1-48
+
+   test:
+      suffix: all
+      args: -period 1 -n 10
+      filter: grep -v "total time" | cut -c 1-48
+
+TEST*/
@@ -0,0 +1,102 @@
+static char help[] = "Tests PetscLogHWCountersBegin() with the CSV output of PetscLogView().\n\n";
+
+#include <petscsys.h>
+#include <petscviewer.h>
+
+/* checks the hardware counter columns of the row of the event Touch in the file written by PetscLogView() */
+static PetscErrorCode CheckCounters(const char filename[])
+{
+  FILE           *fp;
+  char           line[4096],*field;
+  PetscToken     token;
+  const char     *names[] = {"cycles","instructions","llc_references","llc_misses","page_faults"};
+  int            column[5],col,i;
+  double         value[5];
+  PetscBool      flg;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  if (rank) PetscFunctionReturn(0);
+  ierr = PetscFOpen(PETSC_COMM_SELF,filename,"r",&fp);CHKERRQ(ierr);
+  if (!fgets(line,sizeof(line),fp)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Empty file %s",filename);
+  for (i=0; i<5; i++) column[i] = -1;
+  ierr = PetscTokenCreate(line,',',&token);CHKERRQ(ierr);
+  for (col=0; ; col++) {
+    ierr = PetscTokenFind(token,&field);CHKERRQ(ierr);
+    if (!field) break;
+    for (i=0; i<5; i++) {
+      ierr = PetscStrcmp(field,names[i],&flg);CHKERRQ(ierr);
+      if (flg) column[i] = col;
+    }
+  }
+  ierr = PetscTokenDestroy(&token);CHKERRQ(ierr);
+  for (i=0; i<5; i++) if (column[i] < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"No column %s",names[i]);
+  while (fgets(line,sizeof(line),fp)) {
+    ierr = PetscTokenCreate(line,',',&token);CHKERRQ(ierr);
+    for (col=0; ; col++) {
+      ierr = PetscTokenFind(token,&field);CHKERRQ(ierr);
+      if (!field) break;
+      if (col == 1) {
+        ierr = PetscStrcmp(field,"Touch",&flg);CHKERRQ(ierr);
+        if (!flg) break;
+      }
+      for (i=0; i<5; i++) if (col == column[i]) value[i] = atof(field);
+    }
+    ierr = PetscTokenDestroy(&token);CHKERRQ(ierr);
+    if (col < 2) continue;
+    /* the counters that cannot be read on this machine are -1, all of them when perf_event_open() is not permitted */
+    for (i=0; i<4; i++) if (value[i] != -1.0 && value[i] < 0.0) {ierr = PetscPrintf(PETSC_COMM_SELF,"Negative %s %g\n",names[i],value[i]);CHKERRQ(ierr);}
+    if (value[4] == -1.0) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"Touch: page_faults unavailable\n");CHKERRQ(ierr);
+    } else {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"Touch: page_faults %s\n",value[4] > 0.0 ? "positive" : "not positive");CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFClose(PETSC_COMM_SELF,fp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscLogEvent  touch;
+  PetscViewer    viewer;
+  PetscInt       n = 4000000;
+  PetscScalar    *a;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
+  ierr = PetscLogHWCountersBegin();CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Touch",PETSC_OBJECT_CLASSID,&touch);CHKERRQ(ierr);
+
+  /* the first write to freshly allocated pages causes page faults */
+  ierr = PetscLogEventBegin(touch,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&a);CHKERRQ(ierr);
+  ierr = PetscArrayzero(a,n);CHKERRQ(ierr);
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(touch,0,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,"ex55.csv",&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_CSV);CHKERRQ(ierr);
+  ierr = PetscLogView(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = CheckCounters("ex55.csv");CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG) define(PETSC_HAVE_LINUX_PERF_EVENT_H)
+
+   # needs perf_event_open() to be permitted, for the page fault software counter at least; otherwise it prints unavailable and fails
+   test:
+      suffix: 1
+      nsize: 2
+
+TEST*/
@@ -0,0 +1,68 @@
+static char help[] = "Tests PetscLogMallocUsageBegin() and PetscLogEventGetMallocUsage().\n\n";
+
+#include <petscsys.h>
+
+int main(int argc,char **argv)
+{
+  PetscClassId   classid;
+  PetscLogEvent  outer,inner;
+  PetscLogDouble current,peak;
+  char           *keep,*work;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  /* the memory is charged to the events logged by the default or nested handlers */
+  ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
+  ierr = PetscClassIdRegister("Test",&classid);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Outer",classid,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Inner",classid,&inner);CHKERRQ(ierr);
+
+  ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscMalloc1(1000000,&keep);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2000000,&work);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  /* charged to the innermost event only */
+  ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscMalloc1(500000,&work);CHKERRQ(ierr);
+  ierr = PetscRealloc(700000,&work);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscLogEventGetMallocUsage(outer,&current,&peak);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Outer: current %.0f peak %.0f\n",current,peak);CHKERRQ(ierr);
+  ierr = PetscLogEventGetMallocUsage(inner,&current,&peak);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Inner: current %.0f peak %.0f\n",current,peak);CHKERRQ(ierr);
+  /* frees of memory charged to an event are charged back to it outside the event */
+  ierr = PetscFree(keep);CHKERRQ(ierr);
+  ierr = PetscLogEventGetMallocUsage(outer,&current,&peak);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Outer: current %.0f peak %.0f\n",current,peak);CHKERRQ(ierr);
+  /* events that do not end in the reverse order they began, the allocation is charged to the one still active */
+  ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscMalloc1(300000,&work);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventGetMallocUsage(inner,&current,&peak);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Inner: current %.0f peak %.0f\n",current,peak);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: define(PETSC_USE_LOG)
+
+   test:
+      suffix: 1
+      args: -log_view_malloc
+
+   test:
+      suffix: log_view
+      nsize: 2
+      args: -log_view -log_view_malloc
+      filter: grep -E "^(Outer|Inner|Test) +[0-9]+ +[0-9]+( |$)" | cut -c 1-46
+
+TEST*/
@@ -0,0 +1,93 @@
+static char help[] = "Tests PetscMallocSetPool() and PetscArenaCreate().\n\n";
+
+#include <petscsys.h>
+#include <petscviewer.h>
+
+/* a block that is freed twice is detected while it is in the free list */
+static PetscErrorCode TestDoubleFree(void)
+{
+  char           *a,*b;
+  PetscErrorCode ierr,ferr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(100,&a);CHKERRQ(ierr);
+  b    = a;
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = PetscPushErrorHandler(PetscReturnErrorHandler,NULL);CHKERRQ(ierr);
+  ferr = (*PetscTrFree)(b,__LINE__,PETSC_FUNCTION_NAME,__FILE__);
+  ierr = PetscPopErrorHandler();CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Double free %s\n",ferr == PETSC_ERR_MEMC ? "detected" : "not detected");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  char           *a,*b,*c;
+  PetscInt       i,j;
+  PetscArena     arena;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+
+  /* a freed block is given to the next allocation of its size class */
+  ierr = PetscMalloc1(100,&a);CHKERRQ(ierr);
+  ierr = PetscMemzero(a,100);CHKERRQ(ierr);
+  b    = a;
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = PetscMalloc1(120,&a);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Reused %s\n",a == b ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = PetscCalloc1(128,&a);CHKERRQ(ierr);
+  for (i=0; i<128; i++) if (a[i]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PetscCalloc1() of a reused block is not cleared at %D",i);
+
+  /* reallocations within the class and to the next classes and beyond the largest class keep the content */
+  for (i=0; i<128; i++) a[i] = (char)i;
+  ierr = PetscRealloc(90,&a);CHKERRQ(ierr);
+  ierr = PetscRealloc(1000,&a);CHKERRQ(ierr);
+  ierr = PetscRealloc(200000,&a);CHKERRQ(ierr);
+  ierr = PetscRealloc(300000,&a);CHKERRQ(ierr);
+  for (i=0; i<90; i++) if (a[i] != (char)i) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PetscRealloc() lost the value at %D",i);
+  ierr = PetscMalloc2(3,&b,70000,&c);CHKERRQ(ierr);
+  ierr = PetscFree2(b,c);CHKERRQ(ierr);
+  ierr = PetscFree(a);CHKERRQ(ierr);
+
+  ierr = TestDoubleFree();CHKERRQ(ierr);
+  ierr = PetscMallocPoolRelease();CHKERRQ(ierr);
+
+  /* the work arrays of each iteration reuse the chunks of the first one */
+  ierr = PetscArenaCreate(1024,&arena);CHKERRQ(ierr);
+  for (j=0; j<10; j++) {
+    ierr = PetscArenaBegin(arena);CHKERRQ(ierr);
+    ierr = PetscArenaGet(arena,300,&b);CHKERRQ(ierr);
+    ierr = PetscArenaGet(arena,500,&c);CHKERRQ(ierr);
+    for (i=0; i<300; i++) b[i] = 1;
+    for (i=0; i<500; i++) c[i] = 2;
+    ierr = PetscArenaBegin(arena);CHKERRQ(ierr);
+    ierr = PetscArenaGet(arena,200,&a);CHKERRQ(ierr);
+    ierr = PetscMemzero(a,200);CHKERRQ(ierr);
+    ierr = PetscArenaGet(arena,2000,&a);CHKERRQ(ierr);
+    ierr = PetscMemzero(a,2000);CHKERRQ(ierr);
+    ierr = PetscArenaEnd(arena);CHKERRQ(ierr);
+    for (i=0; i<300; i++) if (b[i] != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"First array overwritten at %D",i);
+    for (i=0; i<500; i++) if (c[i] != 2) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Second array overwritten at %D",i);
+    ierr = PetscArenaEnd(arena);CHKERRQ(ierr);
+  }
+  ierr = PetscArenaView(arena,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  ierr = PetscArenaDestroy(&arena);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -malloc_pool -malloc_dump
+
+   test:
+      suffix: view
+      nsize: 2
+      args: -malloc_pool -malloc_pool_max_cached 100000 -malloc_pool_view -malloc_debug -malloc_dump
+      filter: sed -E "s/[0-9.e+]+ allocations per second/RATE allocations per second/"
+
+TEST*/
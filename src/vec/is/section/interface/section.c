@@ -66,6 +66,10 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->clSize             = 0;
   (*s)->clPerm             = NULL;
   (*s)->clInvPerm          = NULL;
+  (*s)->clDofStart         = 0;
+  (*s)->clDofEnd           = 0;
+  (*s)->clDofOff           = NULL;
+  (*s)->clDofs             = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -2141,6 +2145,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   ierr = ISDestroy(&s->perm);CHKERRQ(ierr);
   ierr = PetscFree(s->clPerm);CHKERRQ(ierr);
   ierr = PetscFree(s->clInvPerm);CHKERRQ(ierr);
+  ierr = PetscSectionResetClosureDofs_Internal(s);CHKERRQ(ierr);
   ierr = PetscSectionSymDestroy(&s->sym);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&s->clSection);CHKERRQ(ierr);
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
@@ -2782,7 +2787,11 @@ PetscErrorCode PetscSectionSetClosureIndex(PetscSection section, PetscObject obj
   PetscValidHeaderSpecific(section,PETSC_SECTION_CLASSID,1);
   PetscValidHeaderSpecific(clSection,PETSC_SECTION_CLASSID,3);
   PetscValidHeaderSpecific(clPoints,IS_CLASSID,4);
-  if (section->clObj != obj) {ierr = PetscFree(section->clPerm);CHKERRQ(ierr);ierr = PetscFree(section->clInvPerm);CHKERRQ(ierr);}
+  if (section->clObj != obj) {
+    ierr = PetscFree(section->clPerm);CHKERRQ(ierr);
+    ierr = PetscFree(section->clInvPerm);CHKERRQ(ierr);
+    ierr = PetscSectionResetClosureDofs_Internal(section);CHKERRQ(ierr);
+  }
   section->clObj     = obj;
   ierr = PetscObjectReference((PetscObject)clSection);CHKERRQ(ierr);
   ierr = PetscObjectReference((PetscObject)clPoints);CHKERRQ(ierr);
@@ -2838,6 +2847,8 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
   section->clObj  = obj;
   ierr = PetscFree(section->clPerm);CHKERRQ(ierr);
   ierr = PetscFree(section->clInvPerm);CHKERRQ(ierr);
+  /* The cached dof indices include the permutation */
+  ierr = PetscSectionResetClosureDofs_Internal(section);CHKERRQ(ierr);
   section->clSize = clSize;
   if (mode == PETSC_COPY_VALUES) {
     ierr = PetscMalloc1(clSize, &section->clPerm);CHKERRQ(ierr);
@@ -2851,6 +2862,46 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
   PetscFunctionReturn(0);
 }
 
+/* Takes ownership of the offsets and dofs arrays. A cache covering no points records that closures cannot be cached. */
+PetscErrorCode PetscSectionSetClosureDofs_Internal(PetscSection section, PetscObject obj, PetscInt pStart, PetscInt pEnd, PetscInt *offsets, PetscInt *dofs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (section->clObj != obj) {
+    ierr = PetscSectionDestroy(&section->clSection);CHKERRQ(ierr);
+    ierr = ISDestroy(&section->clPoints);CHKERRQ(ierr);
+    ierr = PetscFree(section->clPerm);CHKERRQ(ierr);
+    ierr = PetscFree(section->clInvPerm);CHKERRQ(ierr);
+  }
+  section->clObj = obj;
+  ierr = PetscSectionResetClosureDofs_Internal(section);CHKERRQ(ierr);
+  section->clDofStart = pStart;
+  section->clDofEnd   = pEnd;
+  section->clDofOff   = offsets;
+  section->clDofs     = dofs;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSectionHasClosureDofs_Internal(PetscSection section, PetscObject obj, PetscBool *has)
+{
+  PetscFunctionBegin;
+  *has = (section->clObj == obj && section->clDofOff) ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSectionResetClosureDofs_Internal(PetscSection section)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(section->clDofOff);CHKERRQ(ierr);
+  ierr = PetscFree(section->clDofs);CHKERRQ(ierr);
+  section->clDofStart = 0;
+  section->clDofEnd   = 0;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscSectionSetClosurePermutation - Get the dof permutation for the closure of each cell in the section, meaning clPerm[newIndex] = oldIndex.
 
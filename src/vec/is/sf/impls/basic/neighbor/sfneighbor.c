@@ -3,12 +3,20 @@
 
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 
+#if defined(PETSC_HAVE_MPIX_NEIGHBOR_ALLTOALLV_INIT)
+#include <mpi-ext.h>
+#define MPIU_Neighbor_alltoallv_init MPIX_Neighbor_alltoallv_init
+#elif defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+#define MPIU_Neighbor_alltoallv_init MPI_Neighbor_alltoallv_init
+#endif
+
 typedef struct {
   SFBASICHEADER;
   MPI_Comm      comms[2];       /* Communicators with distributed topology in both directions */
   PetscBool     initialized[2]; /* Are the two communicators initialized? */
   PetscMPIInt   *rootdispls,*rootcounts,*leafdispls,*leafcounts; /* displs/counts for non-distinguished ranks */
   PetscInt      rootdegree,leafdegree;
+  PetscBool     persistent;     /* Use persistent neighborhood collectives? */
 } PetscSF_Neighbor;
 
 /*===================================================================================*/
@@ -44,6 +52,41 @@ static PetscErrorCode PetscSFGetDistComm_Neighbor(PetscSF sf,PetscSFDirection di
   PetscFunctionReturn(0);
 }
 
+/* Start the neighborhood alltoallv on the remote buffers of the link. Libraries like Open MPI assign the tag of a persistent
+   collective at its initialization, so all ranks must initialize them in the same order. Hence the persistent requests are
+   bound to buffers owned by the link (see nodirectmpi) and initialized once, at the first use of the link in the direction.
+*/
+static PetscErrorCode PetscSFLinkStartNeighbor(PetscSF sf,PetscSFLink link,PetscSFDirection direction)
+{
+  PetscErrorCode    ierr;
+  PetscSF_Neighbor  *dat = (PetscSF_Neighbor*)sf->data;
+  MPI_Comm          distcomm;
+  void              *rootbuf = NULL,*leafbuf = NULL,*sendbuf,*recvbuf;
+  MPI_Request       *req = NULL;
+  PetscMPIInt       outdegree,indegree,*sendcounts,*senddispls,*recvcounts,*recvdispls;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetDistComm_Neighbor(sf,direction,&distcomm);CHKERRQ(ierr);
+  ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,direction,&rootbuf,&leafbuf,&req,NULL);CHKERRQ(ierr);
+  if (direction == PETSCSF_ROOT2LEAF) {
+    outdegree = dat->rootdegree; sendbuf = rootbuf; sendcounts = dat->rootcounts; senddispls = dat->rootdispls;
+    indegree  = dat->leafdegree; recvbuf = leafbuf; recvcounts = dat->leafcounts; recvdispls = dat->leafdispls;
+  } else {
+    outdegree = dat->leafdegree; sendbuf = leafbuf; sendcounts = dat->leafcounts; senddispls = dat->leafdispls;
+    indegree  = dat->rootdegree; recvbuf = rootbuf; recvcounts = dat->rootcounts; recvdispls = dat->rootdispls;
+  }
+#if defined(MPIU_Neighbor_alltoallv_init)
+  if (dat->nodirectmpi) { /* Persistent collectives were requested at setup */
+    if (!outdegree && !indegree) PetscFunctionReturn(0);
+    if (*req == MPI_REQUEST_NULL) {ierr = MPIU_Neighbor_alltoallv_init(sendbuf,sendcounts,senddispls,link->unit,recvbuf,recvcounts,recvdispls,link->unit,distcomm,MPI_INFO_NULL,req);CHKERRQ(ierr);}
+    ierr = MPI_Start_persistent_neighbor_alltoallv(outdegree,indegree,sendcounts,link->unit,recvcounts,link->unit,req);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = MPI_Start_ineighbor_alltoallv(outdegree,indegree,sendbuf,sendcounts,senddispls,link->unit,recvbuf,recvcounts,recvdispls,link->unit,distcomm,req);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*===================================================================================*/
 /*              Implementations of SF public APIs                                    */
 /*===================================================================================*/
@@ -60,6 +103,9 @@ static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
   ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
   /* SFNeighbor specific */
   sf->persistent  = PETSC_FALSE;
+#if defined(MPIU_Neighbor_alltoallv_init)
+  dat->nodirectmpi = dat->persistent;
+#endif
   ierr = PetscSFGetRootInfo_Basic(sf,&nrootranks,&ndrootranks,NULL,&rootoffset,NULL);CHKERRQ(ierr);
   ierr = PetscSFGetLeafInfo_Basic(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,NULL,NULL);CHKERRQ(ierr);
   dat->rootdegree = nrootranks-ndrootranks;
@@ -67,8 +113,9 @@ static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
   sf->nleafreqs   = 0;
   dat->nrootreqs  = 1;
 
-  /* Only setup MPI displs/counts for non-distinguished ranks. Distinguished ranks use shared memory */
-  ierr = PetscMalloc4(dat->rootdegree,&dat->rootdispls,dat->rootdegree,&dat->rootcounts,dat->leafdegree,&dat->leafdispls,dat->leafdegree,&dat->leafcounts);CHKERRQ(ierr);
+  /* Only setup MPI displs/counts for non-distinguished ranks. Distinguished ranks use shared memory. The arrays are never
+     empty since some MPI implementations reject NULL displs/counts in persistent collectives, even with a zero degree */
+  ierr = PetscMalloc4(PetscMax(dat->rootdegree,1),&dat->rootdispls,PetscMax(dat->rootdegree,1),&dat->rootcounts,PetscMax(dat->leafdegree,1),&dat->leafdispls,PetscMax(dat->leafdegree,1),&dat->leafcounts);CHKERRQ(ierr);
   for (i=ndrootranks,j=0; i<nrootranks; i++,j++) {
     ierr = PetscMPIIntCast(rootoffset[i]-rootoffset[ndrootranks],&m);CHKERRQ(ierr); dat->rootdispls[j] = m;
     ierr = PetscMPIIntCast(rootoffset[i+1]-rootoffset[i],        &n);CHKERRQ(ierr); dat->rootcounts[j] = n;
@@ -89,6 +136,8 @@ static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
 
   PetscFunctionBegin;
   if (dat->inuse) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
+  /* Common part first, since it frees the persistent requests of the links which use the counts and communicators */
+  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr);
   ierr = PetscFree4(dat->rootdispls,dat->rootcounts,dat->leafdispls,dat->leafcounts);CHKERRQ(ierr);
   for (i=0; i<2; i++) {
     if (dat->initialized[i]) {
@@ -96,7 +145,6 @@ static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
       dat->initialized[i] = PETSC_FALSE;
     }
   }
-  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr); /* Common part */
   PetscFunctionReturn(0);
 }
 
@@ -110,22 +158,30 @@ static PetscErrorCode PetscSFDestroy_Neighbor(PetscSF sf)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Neighbor(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscErrorCode   ierr;
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor*)sf->data;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Neighbor options");CHKERRQ(ierr);
+#if defined(MPIU_Neighbor_alltoallv_init)
+  ierr = PetscOptionsBool("-sf_neighbor_persistent","Use persistent neighborhood collectives, initialized once per communication link","PetscSFSetFromOptions",dat->persistent,&dat->persistent,NULL);CHKERRQ(ierr);
+#endif
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscSFBcastAndOpBegin_Neighbor(PetscSF sf,MPI_Datatype unit,PetscMemType rootmtype,const void *rootdata,PetscMemType leafmtype,void *leafdata,MPI_Op op)
 {
   PetscErrorCode       ierr;
   PetscSFLink          link;
-  PetscSF_Neighbor     *dat = (PetscSF_Neighbor*)sf->data;
-  MPI_Comm             distcomm;
-  void                 *rootbuf = NULL,*leafbuf = NULL;
-  MPI_Request          *req;
 
   PetscFunctionBegin;
   ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,PETSCSF_BCAST,&link);CHKERRQ(ierr);
   ierr = PetscSFLinkPackRootData(sf,link,PETSCSF_REMOTE,rootdata);CHKERRQ(ierr);
   /* Do neighborhood alltoallv for remote ranks */
-  ierr = PetscSFGetDistComm_Neighbor(sf,PETSCSF_ROOT2LEAF,&distcomm);CHKERRQ(ierr);
-  ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_ROOT2LEAF,&rootbuf,&leafbuf,&req,NULL);CHKERRQ(ierr);
-  ierr = MPI_Start_ineighbor_alltoallv(dat->rootdegree,dat->leafdegree,rootbuf,dat->rootcounts,dat->rootdispls,unit,leafbuf,dat->leafcounts,dat->leafdispls,unit,distcomm,req);CHKERRQ(ierr);
+  ierr = PetscSFLinkStartNeighbor(sf,link,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
   ierr = PetscSFLinkBcastAndOpLocal(sf,link,rootdata,leafdata,op);
   PetscFunctionReturn(0);
 }
@@ -134,18 +190,12 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFLeafToRootBegin_Neighbor(PetscSF sf,MP
 {
   PetscErrorCode       ierr;
   PetscSFLink          link;
-  PetscSF_Neighbor     *dat = (PetscSF_Neighbor*)sf->data;
-  MPI_Comm             distcomm = MPI_COMM_NULL;
-  void                 *rootbuf = NULL,*leafbuf = NULL;
-  MPI_Request          *req = NULL;
 
   PetscFunctionBegin;
   ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,sfop,&link);CHKERRQ(ierr);
   ierr = PetscSFLinkPackLeafData(sf,link,PETSCSF_REMOTE,leafdata);CHKERRQ(ierr);
   /* Do neighborhood alltoallv for remote ranks */
-  ierr = PetscSFGetDistComm_Neighbor(sf,PETSCSF_LEAF2ROOT,&distcomm);CHKERRQ(ierr);
-  ierr = PetscSFLinkGetMPIBuffersAndRequests(sf,link,PETSCSF_LEAF2ROOT,&rootbuf,&leafbuf,&req,NULL);CHKERRQ(ierr);
-  ierr = MPI_Start_ineighbor_alltoallv(dat->leafdegree,dat->rootdegree,leafbuf,dat->leafcounts,dat->leafdispls,unit,rootbuf,dat->rootcounts,dat->rootdispls,unit,distcomm,req);CHKERRQ(ierr);
+  ierr = PetscSFLinkStartNeighbor(sf,link,PETSCSF_LEAF2ROOT);CHKERRQ(ierr);
   *out = link;
   PetscFunctionReturn(0);
 }
@@ -208,6 +258,7 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
   sf->ops->View                 = PetscSFView_Basic;
 
   sf->ops->SetUp                = PetscSFSetUp_Neighbor;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Neighbor;
   sf->ops->Reset                = PetscSFReset_Neighbor;
   sf->ops->Destroy              = PetscSFDestroy_Neighbor;
   sf->ops->BcastAndOpBegin      = PetscSFBcastAndOpBegin_Neighbor;
@@ -216,6 +267,9 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
   sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Neighbor;
 
   ierr = PetscNewLog(sf,&dat);CHKERRQ(ierr);
+#if defined(MPIU_Neighbor_alltoallv_init)
+  dat->persistent = PETSC_TRUE;
+#endif
   sf->data = (void*)dat;
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,642 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+/* Index groups packed to or unpacked from shared memory.
+
+   Group g consists of blocks [boffset[g],boffset[g+1]), where block b holds the indices idx[offset[b],offset[b+1]) exchanged with
+   one remote rank. The packed data of group g lives at bufoff[g] (in units) in the window segment of rank owner[g] of the node
+   communicator. Groups [0,nintra) are exchanged with ranks on the same node and the rest go through the node leaders.
+ */
+typedef struct {
+  PetscInt       n,nintra;
+  PetscInt       *boffset;  /* [n+1] Blocks of each group */
+  PetscInt       *offset;   /* [nblocks+1] Indices of each block */
+  PetscInt       *idx;      /* Root or leaf indices */
+  PetscBool      *contig;   /* [n] Are the indices of group g contiguous? ... */
+  PetscInt       *start;    /* [n] ... and starting from start[g] */
+  PetscSFPackOpt *opt;      /* [n] Pack optimization of group g, with one entry per block. NULL for no optimization */
+  PetscMPIInt    *owner;    /* [n] Rank in the node communicator whose window segment holds the buffer of group g */
+  PetscInt       *bufoff;   /* [n] Offset of the buffer in that segment */
+} PetscSFNodeGroups;
+
+/* An operation in flight. Operations are assigned slots round-robin, which gives the same slot on all ranks of a node since
+   PetscSF communication is collective. Each slot has its own window so that pending operations do not share buffers. */
+typedef struct {
+  MPI_Win     win;          /* Shared memory window */
+  char        **base;       /* [shmsize] Base address of the window segment of each rank on the node */
+  size_t      unitbytes;    /* Size of the unit the window was allocated for, 0 if not allocated. Buffers are laid out with the unit of the link */
+  PetscMPIInt tag;          /* Tag of the inter-node messages */
+  MPI_Request *reqs;        /* Requests of the inter-node messages, only on the node leader */
+  PetscSFLink link;         /* Link of the operation using this slot, NULL if the slot is free */
+} PetscSFNodeSlot;
+
+typedef struct {
+  SFBASICHEADER;
+  PetscInt          nodesize;        /* Number of ranks per node from -sf_node_size, 0 to use the shared memory nodes */
+  PetscInt          maxpending;      /* Max number of operations in flight, from -sf_node_max_pending */
+  MPI_Comm          shmcomm;         /* Communicator of the ranks on my node. Its rank 0 is the node leader */
+  PetscMPIInt       shmrank,shmsize;
+  PetscMPIInt       node,nnodes;     /* My node and the number of nodes */
+  PetscInt          intralen;        /* Length of my buffer for roots referenced by leaves on my node */
+  PetscInt          leaderoff;       /* Offset of the inter-node buffers in the leader's segment, i.e., its intralen */
+  PetscInt          rootlen,leaflen; /* Lengths of the node buffers for roots referenced by other nodes, and leaves referencing other nodes */
+  PetscBool         hasintra;        /* Is there any intra-node traffic on my node? */
+  PetscMPIInt       nrootnodes;      /* Number of nodes referencing roots on my node, with their leaders and ... */
+  PetscMPIInt       *rootleaders;
+  PetscInt          *rootnodeoffset; /* ... offsets of the messages in the root buffer */
+  PetscMPIInt       nleafnodes;      /* Number of nodes referenced by leaves on my node, with their leaders and ... */
+  PetscMPIInt       *leafleaders;
+  PetscInt          *leafnodeoffset; /* ... offsets of the messages in the leaf buffer */
+  PetscSFNodeGroups rootgroups,leafgroups;
+  PetscInt          nops;            /* Number of operations started, which selects the slot */
+  PetscInt          nslots;          /* Number of slots, which is maxpending at setup time */
+  PetscSFNodeSlot   *slots;          /* [nslots] */
+} PetscSF_Node;
+
+/*===================================================================================*/
+/*              Internal utility routines                                            */
+/*===================================================================================*/
+
+/* Set up the contiguity and pack optimizations of the groups, once their blocks and indices are set */
+static PetscErrorCode PetscSFNodeGroupsSetUpPackOpt(PetscSFNodeGroups *grp)
+{
+  PetscErrorCode ierr;
+  PetscInt       g,i,first,last;
+
+  PetscFunctionBegin;
+  for (g=0; g<grp->n; g++) {
+    first          = grp->offset[grp->boffset[g]];
+    last           = grp->offset[grp->boffset[g+1]];
+    grp->contig[g] = PETSC_TRUE;
+    grp->start[g]  = last > first ? grp->idx[first] : 0;
+    grp->opt[g]    = NULL;
+    for (i=first; i<last; i++) {
+      if (grp->idx[i] != grp->start[g]+i-first) {grp->contig[g] = PETSC_FALSE; break;}
+    }
+    if (!grp->contig[g]) {ierr = PetscSFCreatePackOpt(grp->boffset[g+1]-grp->boffset[g],grp->offset+grp->boffset[g],grp->idx,&grp->opt[g]);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFNodeGroupsDestroy(PetscSFNodeGroups *grp)
+{
+  PetscErrorCode ierr;
+  PetscInt       g;
+
+  PetscFunctionBegin;
+  if (grp->opt) {
+    for (g=0; g<grp->n; g++) {ierr = PetscSFDestroyPackOpt(PETSC_MEMTYPE_HOST,&grp->opt[g]);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree2(grp->boffset,grp->offset);CHKERRQ(ierr);
+  ierr = PetscFree(grp->idx);CHKERRQ(ierr);
+  ierr = PetscFree5(grp->contig,grp->start,grp->opt,grp->owner,grp->bufoff);CHKERRQ(ierr);
+  grp->n = grp->nintra = 0;
+  PetscFunctionReturn(0);
+}
+
+/* Address of the buffer of group g in the window of the slot */
+PETSC_STATIC_INLINE char *PetscSFNodeGroupBuffer(PetscSFNodeSlot *slot,PetscSFNodeGroups *grp,PetscInt g)
+{
+  return slot->base[grp->owner[g]] + grp->bufoff[g]*slot->link->unitbytes;
+}
+
+/* Pack data of groups [gStart,gEnd) into their buffers in the window */
+static PetscErrorCode PetscSFNodePackGroups(PetscSF sf,PetscSFLink link,PetscSFNodeSlot *slot,PetscSFNodeGroups *grp,PetscInt gStart,PetscInt gEnd,const void *data)
+{
+  PetscErrorCode ierr;
+  PetscInt       g,first,count;
+  PetscErrorCode (*Pack)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,const void*,void*) = NULL;
+
+  PetscFunctionBegin;
+  if (gStart >= gEnd) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSFLinkGetPack(link,PETSC_MEMTYPE_HOST,&Pack);CHKERRQ(ierr);
+  for (g=gStart; g<gEnd; g++) {
+    first = grp->offset[grp->boffset[g]];
+    count = grp->offset[grp->boffset[g+1]] - first;
+    if (!count) continue;
+    ierr = (*Pack)(link,count,grp->start[g],grp->opt[g],grp->contig[g] ? NULL : grp->idx+first,data,PetscSFNodeGroupBuffer(slot,grp,g));CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(PETSCSF_Pack,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Unpack the buffers of groups [gStart,gEnd) in the window to data with op */
+static PetscErrorCode PetscSFNodeUnpackGroups(PetscSF sf,PetscSFLink link,PetscSFNodeSlot *slot,PetscSFNodeGroups *grp,PetscInt gStart,PetscInt gEnd,void *data,MPI_Op op)
+{
+  PetscErrorCode ierr;
+  PetscInt       g,i,first,count;
+  const char     *buf;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink,PetscInt,PetscInt,PetscSFPackOpt,const PetscInt*,void*,const void*) = NULL;
+
+  PetscFunctionBegin;
+  if (gStart >= gEnd) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(PETSCSF_Unpack,sf,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSFLinkGetUnpackAndOp(link,PETSC_MEMTYPE_HOST,op,PETSC_FALSE,&UnpackAndOp);CHKERRQ(ierr);
+  for (g=gStart; g<gEnd; g++) {
+    first = grp->offset[grp->boffset[g]];
+    count = grp->offset[grp->boffset[g+1]] - first;
+    if (!count) continue;
+    buf = PetscSFNodeGroupBuffer(slot,grp,g);
+    if (UnpackAndOp) {ierr = (*UnpackAndOp)(link,count,grp->start[g],grp->opt[g],grp->contig[g] ? NULL : grp->idx+first,data,buf);CHKERRQ(ierr);}
+    else {
+#if defined(PETSC_HAVE_MPI_REDUCE_LOCAL)
+      for (i=0; i<count; i++) {
+        const PetscInt j = grp->contig[g] ? grp->start[g]+i : grp->idx[first+i];
+        ierr = MPI_Reduce_local(buf+i*link->unitbytes,(char*)data+j*link->unitbytes,1,link->unit,op);CHKERRQ(ierr);
+      }
+#else
+      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No unpacking reduction operation for this MPI_Op");
+#endif
+    }
+  }
+  ierr = PetscLogEventEnd(PETSCSF_Unpack,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Make the writes of all ranks on the node to the window visible to each other */
+static PetscErrorCode PetscSFNodeSyncWindow(PetscSF sf,PetscSFNodeSlot *slot)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+
+  PetscFunctionBegin;
+  ierr = MPI_Win_sync(slot->win);CHKERRQ(ierr);
+  ierr = MPI_Barrier(dat->shmcomm);CHKERRQ(ierr);
+  ierr = MPI_Win_sync(slot->win);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Take the next slot for the operation of link, and (re)allocate its window if the unit does not fit */
+static PetscErrorCode PetscSFNodeGetSlot(PetscSF sf,PetscSFLink link,PetscSFNodeSlot **out)
+{
+  PetscErrorCode  ierr;
+  PetscSF_Node    *dat = (PetscSF_Node*)sf->data;
+  PetscSFNodeSlot *slot = &dat->slots[dat->nops % dat->nslots];
+  MPI_Aint        size;
+  MPI_Info        info;
+  PetscMPIInt     i,dispunit;
+  void            *baseptr;
+
+  PetscFunctionBegin;
+  if (slot->link) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"More than %D operations are pending on the PetscSF, use -sf_node_max_pending to allow more",dat->nslots);
+  dat->nops++;
+  if ((dat->hasintra || dat->rootlen || dat->leaflen) && slot->unitbytes < link->unitbytes) {
+    if (slot->unitbytes) {
+      ierr = MPI_Barrier(dat->shmcomm);CHKERRQ(ierr);
+      ierr = MPI_Win_unlock_all(slot->win);CHKERRQ(ierr);
+      ierr = MPI_Win_free(&slot->win);CHKERRQ(ierr);
+    }
+    size = (MPI_Aint)((dat->intralen + (dat->shmrank ? 0 : dat->rootlen + dat->leaflen))*link->unitbytes);
+    ierr = MPI_Info_create(&info);CHKERRQ(ierr);
+    ierr = MPI_Info_set(info,"alloc_shared_noncontig","true");CHKERRQ(ierr);
+    ierr = MPI_Win_allocate_shared(size,1,info,dat->shmcomm,&baseptr,&slot->win);CHKERRQ(ierr);
+    ierr = MPI_Info_free(&info);CHKERRQ(ierr);
+    for (i=0; i<dat->shmsize; i++) {ierr = MPI_Win_shared_query(slot->win,i,&size,&dispunit,&slot->base[i]);CHKERRQ(ierr);}
+    ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,slot->win);CHKERRQ(ierr);
+    slot->unitbytes = link->unitbytes;
+  }
+  slot->link = link;
+  *out       = slot;
+  PetscFunctionReturn(0);
+}
+
+/* Find the slot of a pending operation */
+static PetscErrorCode PetscSFNodeFindSlot(PetscSF sf,PetscSFLink link,PetscSFNodeSlot **out)
+{
+  PetscSF_Node *dat = (PetscSF_Node*)sf->data;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  for (i=0; i<dat->nslots; i++) if (dat->slots[i].link == link) {*out = &dat->slots[i]; PetscFunctionReturn(0);}
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Could not find the slot of the pending operation");
+  PetscFunctionReturn(0);
+}
+
+/* The node leader posts one message per node pair, between the root buffer and the leaf buffer of the nodes */
+static PetscErrorCode PetscSFNodeStartMessages(PetscSF sf,PetscSFNodeSlot *slot,PetscSFDirection direction)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+  MPI_Comm       comm;
+  MPI_Datatype   unit = slot->link->unit;
+  char           *rootbuf,*leafbuf,*sendbuf,*recvbuf;
+  PetscMPIInt    i,n,nsend,nrecv,*sendleaders,*recvleaders;
+  PetscInt       *sendoffset,*recvoffset;
+
+  PetscFunctionBegin;
+  if (dat->shmrank) PetscFunctionReturn(0);
+  ierr    = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  rootbuf = slot->base[0] + dat->leaderoff*slot->link->unitbytes;
+  leafbuf = rootbuf + dat->rootlen*slot->link->unitbytes;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    sendbuf = rootbuf; nsend = dat->nrootnodes; sendleaders = dat->rootleaders; sendoffset = dat->rootnodeoffset;
+    recvbuf = leafbuf; nrecv = dat->nleafnodes; recvleaders = dat->leafleaders; recvoffset = dat->leafnodeoffset;
+  } else {
+    sendbuf = leafbuf; nsend = dat->nleafnodes; sendleaders = dat->leafleaders; sendoffset = dat->leafnodeoffset;
+    recvbuf = rootbuf; nrecv = dat->nrootnodes; recvleaders = dat->rootleaders; recvoffset = dat->rootnodeoffset;
+  }
+  for (i=0; i<nrecv; i++) {
+    ierr = PetscMPIIntCast(recvoffset[i+1]-recvoffset[i],&n);CHKERRQ(ierr);
+    ierr = MPI_Irecv(recvbuf+recvoffset[i]*slot->link->unitbytes,n,unit,recvleaders[i],slot->tag,comm,&slot->reqs[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<nsend; i++) {
+    ierr = PetscMPIIntCast(sendoffset[i+1]-sendoffset[i],&n);CHKERRQ(ierr);
+    ierr = MPI_Isend(sendbuf+sendoffset[i]*slot->link->unitbytes,n,unit,sendleaders[i],slot->tag,comm,&slot->reqs[nrecv+i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Wait for the messages of the node leader and make the received data visible on the node */
+static PetscErrorCode PetscSFNodeWaitMessages(PetscSF sf,PetscSFNodeSlot *slot)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+
+  PetscFunctionBegin;
+  if (!dat->rootlen && !dat->leaflen) PetscFunctionReturn(0);
+  if (!dat->shmrank) {ierr = MPI_Waitall(dat->nrootnodes+dat->nleafnodes,slot->reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  ierr = PetscSFNodeSyncWindow(sf,slot);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The ranks of the node read the buffers of the leader in End, unlike the intra-node buffers read in Begin. A later operation
+   on the same slot may write them in its Begin, or receive into them, so no rank leaves End before all have read them. */
+static PetscErrorCode PetscSFNodeReleaseMessages(PetscSF sf,PetscSFNodeSlot *slot)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+
+  PetscFunctionBegin;
+  if (!dat->rootlen && !dat->leaflen) PetscFunctionReturn(0);
+  ierr = PetscSFNodeSyncWindow(sf,slot);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*===================================================================================*/
+/*              Implementations of SF public APIs                                    */
+/*===================================================================================*/
+static PetscErrorCode PetscSFSetUp_Node(PetscSF sf)
+{
+  PetscErrorCode    ierr;
+  PetscSF_Node      *dat = (PetscSF_Node*)sf->data;
+  PetscSFNodeGroups *rgrp = &dat->rootgroups,*lgrp = &dat->leafgroups;
+  MPI_Comm          comm,hwcomm,leadercomm;
+  PetscShmComm      pshmcomm;
+  PetscMPIInt       rank,hwrank,tag,info[2],*leaders = NULL,*inode;
+  PetscInt          nranks,ndranks,niranks,ndiranks,nleafranks,nrootranks,nnodes,nintra,ninter,i,j,k,g,p,q,N,len,pos;
+  PetscInt          *order,*lorder,*nodestart,*nodelen,*chunkoff,*totlen,*rinfo,*iinfo;
+  const PetscMPIInt *ranks,*iranks;
+  const PetscInt    *roffset,*rmine,*ioffset,*irootloc;
+  MPI_Request       *reqs;
+
+  PetscFunctionBegin;
+  /* SFNode inherits from Basic, which also does the self and FetchAndOp communication */
+  ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafInfo_Basic(sf,&nranks,&ndranks,&ranks,&roffset,&rmine,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetRootInfo_Basic(sf,&niranks,&ndiranks,&iranks,&ioffset,&irootloc);CHKERRQ(ierr);
+  nleafranks = nranks - ndranks;   /* Remote ranks my leaves reference */
+  nrootranks = niranks - ndiranks; /* Remote ranks referencing my roots */
+
+  /* Find the ranks on my node, its leader and its number among the nodes */
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&hwcomm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(hwcomm,&hwrank);CHKERRQ(ierr);
+  ierr = MPI_Comm_split(hwcomm,dat->nodesize > 0 ? (PetscMPIInt)(hwrank/dat->nodesize) : 0,hwrank,&dat->shmcomm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(dat->shmcomm,&dat->shmrank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(dat->shmcomm,&dat->shmsize);CHKERRQ(ierr);
+  ierr = MPI_Comm_split(comm,dat->shmrank ? MPI_UNDEFINED : 0,rank,&leadercomm);CHKERRQ(ierr);
+  if (!dat->shmrank) {
+    ierr = MPI_Comm_rank(leadercomm,&info[0]);CHKERRQ(ierr);
+    ierr = MPI_Comm_size(leadercomm,&info[1]);CHKERRQ(ierr);
+    ierr = PetscMalloc1(info[1],&leaders);CHKERRQ(ierr);
+    ierr = MPI_Allgather(&rank,1,MPI_INT,leaders,1,MPI_INT,leadercomm);CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&leadercomm);CHKERRQ(ierr);
+  }
+  ierr = MPI_Bcast(info,2,MPI_INT,0,dat->shmcomm);CHKERRQ(ierr);
+  dat->node   = info[0];
+  dat->nnodes = info[1];
+  nnodes      = dat->nnodes;
+
+  /* Leaves tell the ranks they reference which node they are on */
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&tag);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nrootranks,&inode,3*nrootranks,&iinfo,3*nleafranks,&rinfo,nrootranks+nleafranks,&reqs);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {ierr = MPI_Irecv(&inode[i],1,MPI_INT,iranks[ndiranks+i],tag,comm,&reqs[i]);CHKERRQ(ierr);}
+  for (i=0; i<nleafranks; i++) {ierr = MPI_Isend(&dat->node,1,MPI_INT,ranks[ndranks+i],tag,comm,&reqs[nrootranks+i]);CHKERRQ(ierr);}
+  ierr = MPI_Waitall(nrootranks+nleafranks,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+
+  /* Root side: one group per rank on my node, then one group per other node with a block for each of its ranks. Blocks are
+     ordered by rank within the nodes, so the chunks of the node ranks concatenated in rank order form the message to a node. */
+  ierr = PetscCalloc6(nnodes+1,&nodestart,nnodes,&nodelen,nnodes,&chunkoff,nnodes,&totlen,nrootranks,&order,nleafranks,&lorder);CHKERRQ(ierr);
+  for (i=0,nintra=0; i<nrootranks; i++) {
+    if (inode[i] == dat->node) nintra++;
+    else nodestart[inode[i]+1]++;
+  }
+  for (N=0,ninter=0; N<nnodes; N++) {
+    if (nodestart[N+1]) ninter++;
+    nodestart[N+1] += nodestart[N];
+  }
+  for (i=0,j=0; i<nrootranks; i++) {
+    if (inode[i] == dat->node) order[j++] = i;
+    else order[nintra + nodestart[inode[i]]++] = i;
+  }
+  rgrp->n      = nintra + ninter;
+  rgrp->nintra = nintra;
+  ierr = PetscMalloc2(rgrp->n+1,&rgrp->boffset,nrootranks+1,&rgrp->offset);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ioffset[niranks]-ioffset[ndiranks],&rgrp->idx);CHKERRQ(ierr);
+  ierr = PetscMalloc5(rgrp->n,&rgrp->contig,rgrp->n,&rgrp->start,rgrp->n,&rgrp->opt,rgrp->n,&rgrp->owner,rgrp->n,&rgrp->bufoff);CHKERRQ(ierr);
+  rgrp->boffset[0] = rgrp->offset[0] = 0;
+  for (k=0,g=0; k<nrootranks; k++) {
+    i   = order[k];
+    len = ioffset[ndiranks+i+1] - ioffset[ndiranks+i];
+    ierr = PetscArraycpy(rgrp->idx+rgrp->offset[k],irootloc+ioffset[ndiranks+i],len);CHKERRQ(ierr);
+    rgrp->offset[k+1] = rgrp->offset[k] + len;
+    if (k < nintra || k == nrootranks-1 || inode[order[k+1]] != inode[i]) rgrp->boffset[++g] = k+1; /* Close the group */
+    if (k >= nintra) nodelen[inode[i]] += len;
+  }
+  dat->intralen = rgrp->offset[nintra];
+
+  /* Offsets of my chunks in the messages to the other nodes, and the lengths of the messages */
+  ierr = MPI_Exscan(nodelen,chunkoff,nnodes,MPIU_INT,MPI_SUM,dat->shmcomm);CHKERRQ(ierr);
+  if (!dat->shmrank) {ierr = PetscArrayzero(chunkoff,nnodes);CHKERRQ(ierr);}
+  ierr = MPIU_Allreduce(nodelen,totlen,nnodes,MPIU_INT,MPI_SUM,dat->shmcomm);CHKERRQ(ierr);
+  for (N=0,dat->nrootnodes=0; N<nnodes; N++) if (totlen[N]) dat->nrootnodes++;
+  ierr = PetscMalloc2(dat->nrootnodes,&dat->rootleaders,dat->nrootnodes+1,&dat->rootnodeoffset);CHKERRQ(ierr);
+  dat->rootnodeoffset[0] = 0;
+  for (N=0,p=0; N<nnodes; N++) {
+    if (!totlen[N]) continue;
+    if (leaders) dat->rootleaders[p] = leaders[N];
+    dat->rootnodeoffset[p+1] = dat->rootnodeoffset[p] + totlen[N];
+    nodestart[N] = dat->rootnodeoffset[p]; /* Now the offset of the message to node N in the root buffer */
+    p++;
+  }
+  dat->rootlen   = dat->rootnodeoffset[dat->nrootnodes];
+  dat->leaderoff = dat->intralen;
+  ierr = MPI_Bcast(&dat->leaderoff,1,MPIU_INT,0,dat->shmcomm);CHKERRQ(ierr);
+
+  /* Place the groups in the window and tell the leaf ranks where to find their blocks: (node, rank in node, offset) */
+  for (g=0,k=0; g<rgrp->n; g++) {
+    if (g < nintra) {
+      rgrp->owner[g]  = dat->shmrank;
+      rgrp->bufoff[g] = rgrp->offset[rgrp->boffset[g]];
+    } else {
+      N               = inode[order[rgrp->boffset[g]]];
+      rgrp->owner[g]  = 0;
+      rgrp->bufoff[g] = dat->leaderoff + nodestart[N] + chunkoff[N];
+    }
+    for (pos=0; k<rgrp->boffset[g+1]; k++) {
+      i            = order[k];
+      iinfo[3*i]   = dat->node;
+      iinfo[3*i+1] = dat->shmrank;
+      iinfo[3*i+2] = g < nintra ? rgrp->bufoff[g] + pos : chunkoff[inode[i]] + pos;
+      pos         += rgrp->offset[k+1] - rgrp->offset[k];
+    }
+  }
+  ierr = PetscSFNodeGroupsSetUpPackOpt(rgrp);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {ierr = MPI_Irecv(&rinfo[3*i],3,MPIU_INT,ranks[ndranks+i],tag,comm,&reqs[i]);CHKERRQ(ierr);}
+  for (i=0; i<nrootranks; i++) {ierr = MPI_Isend(&iinfo[3*i],3,MPIU_INT,iranks[ndiranks+i],tag,comm,&reqs[nleafranks+i]);CHKERRQ(ierr);}
+  ierr = MPI_Waitall(nrootranks+nleafranks,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+
+  /* Leaf side: one group per referenced rank, those on my node first */
+  ierr = PetscArrayzero(nodelen,nnodes);CHKERRQ(ierr);
+  for (i=0,nintra=0; i<nleafranks; i++) if (rinfo[3*i] == dat->node) nintra++;
+  for (i=0,p=0,q=nintra; i<nleafranks; i++) lorder[rinfo[3*i] == dat->node ? p++ : q++] = i;
+  lgrp->n      = nleafranks;
+  lgrp->nintra = nintra;
+  ierr = PetscMalloc2(lgrp->n+1,&lgrp->boffset,nleafranks+1,&lgrp->offset);CHKERRQ(ierr);
+  ierr = PetscMalloc1(roffset[nranks]-roffset[ndranks],&lgrp->idx);CHKERRQ(ierr);
+  ierr = PetscMalloc5(lgrp->n,&lgrp->contig,lgrp->n,&lgrp->start,lgrp->n,&lgrp->opt,lgrp->n,&lgrp->owner,lgrp->n,&lgrp->bufoff);CHKERRQ(ierr);
+  lgrp->offset[0] = 0;
+  for (g=0; g<lgrp->n; g++) {
+    i    = lorder[g];
+    len  = roffset[ndranks+i+1] - roffset[ndranks+i];
+    ierr = PetscArraycpy(lgrp->idx+lgrp->offset[g],rmine+roffset[ndranks+i],len);CHKERRQ(ierr);
+    lgrp->boffset[g]  = g;
+    lgrp->offset[g+1] = lgrp->offset[g] + len;
+    if (g >= nintra) nodelen[rinfo[3*i]] += len;
+  }
+  lgrp->boffset[lgrp->n] = lgrp->n;
+
+  /* The leaf buffer of the node holds the messages from the other nodes in node order */
+  ierr = MPIU_Allreduce(nodelen,totlen,nnodes,MPIU_INT,MPI_SUM,dat->shmcomm);CHKERRQ(ierr);
+  for (N=0,dat->nleafnodes=0; N<nnodes; N++) if (totlen[N]) dat->nleafnodes++;
+  ierr = PetscMalloc2(dat->nleafnodes,&dat->leafleaders,dat->nleafnodes+1,&dat->leafnodeoffset);CHKERRQ(ierr);
+  dat->leafnodeoffset[0] = 0;
+  for (N=0,p=0; N<nnodes; N++) {
+    if (!totlen[N]) continue;
+    if (leaders) dat->leafleaders[p] = leaders[N];
+    dat->leafnodeoffset[p+1] = dat->leafnodeoffset[p] + totlen[N];
+    nodestart[N] = dat->leafnodeoffset[p];
+    p++;
+  }
+  dat->leaflen = dat->leafnodeoffset[dat->nleafnodes];
+  for (g=0; g<lgrp->n; g++) {
+    i = lorder[g];
+    if (g < nintra) {
+      lgrp->owner[g]  = (PetscMPIInt)rinfo[3*i+1];
+      lgrp->bufoff[g] = rinfo[3*i+2];
+    } else {
+      lgrp->owner[g]  = 0;
+      lgrp->bufoff[g] = dat->leaderoff + dat->rootlen + nodestart[rinfo[3*i]] + rinfo[3*i+2];
+    }
+  }
+  ierr = PetscSFNodeGroupsSetUpPackOpt(lgrp);CHKERRQ(ierr);
+
+  /* Windows are only needed if some rank on the node communicates through shared memory */
+  info[0] = (dat->intralen || lgrp->nintra) ? 1 : 0;
+  ierr = MPIU_Allreduce(&info[0],&info[1],1,MPI_INT,MPI_MAX,dat->shmcomm);CHKERRQ(ierr);
+  dat->hasintra = info[1] ? PETSC_TRUE : PETSC_FALSE;
+
+  dat->nslots = dat->maxpending;
+  ierr = PetscCalloc1(dat->nslots,&dat->slots);CHKERRQ(ierr);
+  for (i=0; i<dat->nslots; i++) {
+    ierr = PetscObjectGetNewTag((PetscObject)sf,&dat->slots[i].tag);CHKERRQ(ierr);
+    ierr = PetscMalloc1(dat->shmsize,&dat->slots[i].base);CHKERRQ(ierr);
+    ierr = PetscMalloc1(dat->shmrank ? 0 : dat->nrootnodes+dat->nleafnodes,&dat->slots[i].reqs);CHKERRQ(ierr);
+  }
+  ierr = PetscFree6(nodestart,nodelen,chunkoff,totlen,order,lorder);CHKERRQ(ierr);
+  ierr = PetscFree4(inode,iinfo,rinfo,reqs);CHKERRQ(ierr);
+  ierr = PetscFree(leaders);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReset_Node(PetscSF sf)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (dat->inuse) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
+  if (dat->slots) {
+    for (i=0; i<dat->nslots; i++) {
+      if (dat->slots[i].unitbytes) {
+        ierr = MPI_Win_unlock_all(dat->slots[i].win);CHKERRQ(ierr);
+        ierr = MPI_Win_free(&dat->slots[i].win);CHKERRQ(ierr);
+      }
+      ierr = PetscFree(dat->slots[i].base);CHKERRQ(ierr);
+      ierr = PetscFree(dat->slots[i].reqs);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(dat->slots);CHKERRQ(ierr);
+  }
+  ierr = PetscSFNodeGroupsDestroy(&dat->rootgroups);CHKERRQ(ierr);
+  ierr = PetscSFNodeGroupsDestroy(&dat->leafgroups);CHKERRQ(ierr);
+  ierr = PetscFree2(dat->rootleaders,dat->rootnodeoffset);CHKERRQ(ierr);
+  ierr = PetscFree2(dat->leafleaders,dat->leafnodeoffset);CHKERRQ(ierr);
+  if (dat->shmcomm != MPI_COMM_NULL) {ierr = MPI_Comm_free(&dat->shmcomm);CHKERRQ(ierr);}
+  dat->nops   = 0;
+  dat->nslots = 0;
+  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr); /* Common part */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDestroy_Node(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReset_Node(sf);CHKERRQ(ierr);
+  ierr = PetscFree(sf->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFView_Node(PetscSF sf,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscSFView_Basic(sf,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && sf->setupcalled) {ierr = PetscViewerASCIIPrintf(viewer,"  node-aware with %d nodes, at most %D pending operations\n",dat->nnodes,dat->nslots);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Node(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat = (PetscSF_Node*)sf->data;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Node options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_node_size","Number of ranks per node, to split the shared memory nodes (0 for the shared memory nodes)","PetscSFSetFromOptions",dat->nodesize,&dat->nodesize,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_node_max_pending","Maximum number of operations in flight, each with its own shared memory buffers","PetscSFSetFromOptions",dat->maxpending,&dat->maxpending,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_basic_max_links","Maximum number of cached links per data type whose persistent MPI requests are bound to user arrays","PetscSFSetFromOptions",dat->maxlinks,&dat->maxlinks,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  /* A rank may overwrite its intra-node buffers of a slot as soon as it has passed the window synchronization of the next operation,
+     which every rank on the node enters only after reading those buffers. So one slot is not enough. */
+  if (dat->maxpending < 2) SETERRQ1(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_OUTOFRANGE,"Number of pending operations %D must be at least 2",dat->maxpending);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastAndOpBegin_Node(PetscSF sf,MPI_Datatype unit,PetscMemType rootmtype,const void *rootdata,PetscMemType leafmtype,void *leafdata,MPI_Op op)
+{
+  PetscErrorCode  ierr;
+  PetscSF_Node    *dat = (PetscSF_Node*)sf->data;
+  PetscSFLink     link;
+  PetscSFNodeSlot *slot;
+
+  PetscFunctionBegin;
+  if (rootmtype != PETSC_MEMTYPE_HOST || leafmtype != PETSC_MEMTYPE_HOST) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"PETSCSFNODE only supports host memory");
+  ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,PETSCSF_BCAST,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetSlot(sf,link,&slot);CHKERRQ(ierr);
+  /* Pack roots for other ranks on the node into my segment, and roots for other nodes into the root buffer of the leader */
+  ierr = PetscSFNodePackGroups(sf,link,slot,&dat->rootgroups,0,dat->rootgroups.n,rootdata);CHKERRQ(ierr);
+  if (dat->hasintra || dat->rootlen || dat->leaflen) {ierr = PetscSFNodeSyncWindow(sf,slot);CHKERRQ(ierr);}
+  ierr = PetscSFNodeStartMessages(sf,slot,PETSCSF_ROOT2LEAF);CHKERRQ(ierr);
+  /* Self and intra-node parts overlap with the inter-node messages */
+  ierr = PetscSFLinkBcastAndOpLocal(sf,link,rootdata,leafdata,op);CHKERRQ(ierr);
+  ierr = PetscSFNodeUnpackGroups(sf,link,slot,&dat->leafgroups,0,dat->leafgroups.nintra,leafdata,op);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastAndOpEnd_Node(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata,MPI_Op op)
+{
+  PetscErrorCode  ierr;
+  PetscSF_Node    *dat = (PetscSF_Node*)sf->data;
+  PetscSFLink     link;
+  PetscSFNodeSlot *slot;
+
+  PetscFunctionBegin;
+  ierr = PetscSFLinkGetInUse(sf,unit,rootdata,leafdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeFindSlot(sf,link,&slot);CHKERRQ(ierr);
+  ierr = PetscSFNodeWaitMessages(sf,slot);CHKERRQ(ierr);
+  ierr = PetscSFNodeUnpackGroups(sf,link,slot,&dat->leafgroups,dat->leafgroups.nintra,dat->leafgroups.n,leafdata,op);CHKERRQ(ierr);
+  ierr = PetscSFNodeReleaseMessages(sf,slot);CHKERRQ(ierr);
+  slot->link = NULL;
+  ierr = PetscSFLinkReclaim(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Node(PetscSF sf,MPI_Datatype unit,PetscMemType leafmtype,const void *leafdata,PetscMemType rootmtype,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode  ierr;
+  PetscSF_Node    *dat = (PetscSF_Node*)sf->data;
+  PetscSFLink     link;
+  PetscSFNodeSlot *slot;
+
+  PetscFunctionBegin;
+  if (rootmtype != PETSC_MEMTYPE_HOST || leafmtype != PETSC_MEMTYPE_HOST) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"PETSCSFNODE only supports host memory");
+  ierr = PetscSFLinkCreate(sf,unit,rootmtype,rootdata,leafmtype,leafdata,op,PETSCSF_REDUCE,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetSlot(sf,link,&slot);CHKERRQ(ierr);
+  /* The same buffers as in Bcast, written by the leaves and read by the roots */
+  ierr = PetscSFNodePackGroups(sf,link,slot,&dat->leafgroups,0,dat->leafgroups.n,leafdata);CHKERRQ(ierr);
+  if (dat->hasintra || dat->rootlen || dat->leaflen) {ierr = PetscSFNodeSyncWindow(sf,slot);CHKERRQ(ierr);}
+  ierr = PetscSFNodeStartMessages(sf,slot,PETSCSF_LEAF2ROOT);CHKERRQ(ierr);
+  ierr = PetscSFLinkReduceLocal(sf,link,leafdata,rootdata,op);CHKERRQ(ierr);
+  ierr = PetscSFNodeUnpackGroups(sf,link,slot,&dat->rootgroups,0,dat->rootgroups.nintra,rootdata,op);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Node(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscErrorCode  ierr;
+  PetscSF_Node    *dat = (PetscSF_Node*)sf->data;
+  PetscSFLink     link;
+  PetscSFNodeSlot *slot;
+
+  PetscFunctionBegin;
+  ierr = PetscSFLinkGetInUse(sf,unit,rootdata,leafdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeFindSlot(sf,link,&slot);CHKERRQ(ierr);
+  ierr = PetscSFNodeWaitMessages(sf,slot);CHKERRQ(ierr);
+  ierr = PetscSFNodeUnpackGroups(sf,link,slot,&dat->rootgroups,dat->rootgroups.nintra,dat->rootgroups.n,rootdata,op);CHKERRQ(ierr);
+  ierr = PetscSFNodeReleaseMessages(sf,slot);CHKERRQ(ierr);
+  slot->link = NULL;
+  ierr = PetscSFLinkReclaim(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFCreate_Node(PetscSF sf)
+{
+  PetscErrorCode ierr;
+  PetscSF_Node   *dat;
+
+  PetscFunctionBegin;
+  sf->ops->CreateEmbeddedSF     = PetscSFCreateEmbeddedSF_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+
+  sf->ops->SetUp                = PetscSFSetUp_Node;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Node;
+  sf->ops->View                 = PetscSFView_Node;
+  sf->ops->Reset                = PetscSFReset_Node;
+  sf->ops->Destroy              = PetscSFDestroy_Node;
+  sf->ops->BcastAndOpBegin      = PetscSFBcastAndOpBegin_Node;
+  sf->ops->BcastAndOpEnd        = PetscSFBcastAndOpEnd_Node;
+  sf->ops->ReduceBegin          = PetscSFReduceBegin_Node;
+  sf->ops->ReduceEnd            = PetscSFReduceEnd_Node;
+
+  ierr = PetscNewLog(sf,&dat);CHKERRQ(ierr);
+  dat->maxlinks   = 4;
+  dat->maxpending = 4;
+  dat->shmcomm    = MPI_COMM_NULL;
+  sf->data        = (void*)dat;
+  PetscFunctionReturn(0);
+}
+#endif
@@ -129,6 +129,18 @@ PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Basic options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_basic_max_links","Maximum number of cached links per data type whose persistent MPI requests are bound to user arrays","PetscSFSetFromOptions",bas->maxlinks,&bas->maxlinks,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscSFBcastAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,PetscMemType rootmtype,const void *rootdata,PetscMemType leafmtype,void *leafdata,MPI_Op op)
 {
   PetscErrorCode    ierr;
@@ -221,7 +233,7 @@ PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
 {
   PetscErrorCode    ierr;
   PetscSFLink       link = NULL;
@@ -385,6 +397,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->Reset                = PetscSFReset_Basic;
   sf->ops->Destroy              = PetscSFDestroy_Basic;
   sf->ops->View                 = PetscSFView_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
   sf->ops->BcastAndOpBegin      = PetscSFBcastAndOpBegin_Basic;
   sf->ops->BcastAndOpEnd        = PetscSFBcastAndOpEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
@@ -395,6 +408,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->CreateEmbeddedSF     = PetscSFCreateEmbeddedSF_Basic;
 
   ierr = PetscNewLog(sf,&dat);CHKERRQ(ierr);
+  dat->maxlinks = 4;
   sf->data = (void*)dat;
   PetscFunctionReturn(0);
 }
@@ -20,6 +20,8 @@ typedef struct _n_PetscSFLink* PetscSFLink;
   PetscSFPackOpt   rootpackopt_d[2];/* Copy of rootpackopt[] on device if needed */                                                \
   PetscBool        rootdups[2];     /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */            \
   PetscInt         nrootreqs;       /* Number of MPI reqests */                                                                    \
+  PetscInt         maxlinks;        /* Max number of free links per unit with persistent requests bound to user data */            \
+  PetscBool        nodirectmpi;     /* Never pass root/leafdata directly to MPI, so that persistent requests stay bound to links */ \
   PetscSFLink      avail;           /* One or more entries per MPI Datatype, lazily constructed */                                 \
   PetscSFLink      inuse            /* Buffers being used for transactions that have not yet completed */
 
@@ -59,6 +61,7 @@ PETSC_INTERN PetscErrorCode PetscSFDestroy_Basic(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFBcastAndOpEnd_Basic  (PetscSF,MPI_Datatype,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFReduceEnd_Basic      (PetscSF,MPI_Datatype,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF,MPI_Datatype,PetscMemType,void*,PetscMemType,const void*,void*,MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic  (PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedSF_Basic(PetscSF,PetscInt,const PetscInt*,PetscSF*);
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
 #endif
@@ -480,7 +480,11 @@ PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype
 
    The routine also allocates buffers on CPU when one does not use gpu-aware MPI but data is on GPU.
 
-   In SFBasic, MPI requests are persistent. They are init'ed until we try to get requests from a link.
+   In SFBasic, MPI requests are persistent. They are init'ed until we try to get requests from a link. When root/leafdata
+   is directly passed to MPI, the requests are bound to that data. We then prefer a free link bound to the current data,
+   and otherwise create a new one until there are bas->maxlinks free links for the unit, so that alternating between a
+   few arrays (e.g., the vectors of a Krylov method) does not free and re-init the requests on every call. Only beyond
+   that limit is the least recently used link rebound to the new data.
 
    The routine is shared by SFBasic and SFNeighbor based on the fact they all deal with sparse graphs and
    need pack/unpack data.
@@ -489,8 +493,9 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
 {
   PetscErrorCode    ierr;
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
-  PetscInt          i,j,k,nrootreqs,nleafreqs,nreqs;
-  PetscSFLink       *p,link;
+  PetscInt          i,j,k,nrootreqs,nleafreqs,nreqs,nmatch = 0;
+  PetscMPIInt       tag;
+  PetscSFLink       *p,*lru = NULL,link;
   PetscSFDirection  direction;
   MPI_Request       *reqs = NULL;
   PetscBool         match,rootdirect[2],leafdirect[2];
@@ -513,6 +518,7 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
       leafdirect[i] = PETSC_FALSE; /* We also force allocating a separate leafbuf so that leafdata and leafupdate can share mpi requests */
     }
   }
+  if (bas->nodirectmpi) rootdirect[PETSCSF_REMOTE] = leafdirect[PETSCSF_REMOTE] = PETSC_FALSE; /* Pack remote data into link buffers */
 
   if (sf->use_gpu_aware_mpi) {
     rootmtype_mpi = rootmtype;
@@ -528,31 +534,56 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf,MPI_Datatype unit,PetscMemType rootm
   nrootreqs = bas->nrootreqs;
   nleafreqs = sf->nleafreqs;
 
-  /* Look for free links in cache */
+  /* Look for free links in cache, first for one whose persistent requests (if any) were init'ed with the current data */
   for (p=&bas->avail; (link=*p); p=&link->next) {
     ierr = MPIPetsc_Type_compare(unit,link->unit,&match);CHKERRQ(ierr);
     if (match) {
-      /* If root/leafdata will be directly passed to MPI, test if the data used to initialized the MPI requests matches with current.
-         If not, free old requests. New requests will be lazily init'ed until one calls PetscSFLinkGetMPIBuffersAndRequests().
-      */
-      if (rootdirect_mpi && sf->persistent && link->rootreqsinited[direction][rootmtype][1] && link->rootdatadirect[direction][rootmtype] != rootdata) {
-        reqs = link->rootreqs[direction][rootmtype][1]; /* Here, rootmtype = rootmtype_mpi */
-        for (i=0; i<nrootreqs; i++) {if (reqs[i] != MPI_REQUEST_NULL) {ierr = MPI_Request_free(&reqs[i]);CHKERRQ(ierr);}}
-        link->rootreqsinited[direction][rootmtype][1] = PETSC_FALSE;
-      }
-      if (leafdirect_mpi && sf->persistent && link->leafreqsinited[direction][leafmtype][1] && link->leafdatadirect[direction][leafmtype] != leafdata) {
-        reqs = link->leafreqs[direction][leafmtype][1];
-        for (i=0; i<nleafreqs; i++) {if (reqs[i] != MPI_REQUEST_NULL) {ierr = MPI_Request_free(&reqs[i]);CHKERRQ(ierr);}}
-        link->leafreqsinited[direction][leafmtype][1] = PETSC_FALSE;
+      if ((!rootdirect_mpi || !sf->persistent || !link->rootreqsinited[direction][rootmtype][1] || link->rootdatadirect[direction][rootmtype] == rootdata) &&
+          (!leafdirect_mpi || !sf->persistent || !link->leafreqsinited[direction][leafmtype][1] || link->leafdatadirect[direction][leafmtype] == leafdata)) {
+        *p = link->next; /* Remove from available list */
+        goto found;
       }
-      *p = link->next; /* Remove from available list */
-      goto found;
+      nmatch++;
+      lru = p; /* Links are reclaimed to the head of the list, so the last match is the least recently used */
+    }
+  }
+
+  if (lru && nmatch >= bas->maxlinks) {
+    /* Root/leafdata will be directly passed to MPI but do not match the data used to init the MPI requests of the
+       least recently used link. Free its old requests. New requests will be lazily init'ed until one calls
+       PetscSFLinkGetMPIBuffersAndRequests().
+    */
+    link = *lru;
+    if (rootdirect_mpi && link->rootreqsinited[direction][rootmtype][1] && link->rootdatadirect[direction][rootmtype] != rootdata) {
+      reqs = link->rootreqs[direction][rootmtype][1]; /* Here, rootmtype = rootmtype_mpi */
+      for (i=0; i<nrootreqs; i++) {if (reqs[i] != MPI_REQUEST_NULL) {ierr = MPI_Request_free(&reqs[i]);CHKERRQ(ierr);}}
+      link->rootreqsinited[direction][rootmtype][1] = PETSC_FALSE;
+    }
+    if (leafdirect_mpi && link->leafreqsinited[direction][leafmtype][1] && link->leafdatadirect[direction][leafmtype] != leafdata) {
+      reqs = link->leafreqs[direction][leafmtype][1];
+      for (i=0; i<nleafreqs; i++) {if (reqs[i] != MPI_REQUEST_NULL) {ierr = MPI_Request_free(&reqs[i]);CHKERRQ(ierr);}}
+      link->leafreqsinited[direction][leafmtype][1] = PETSC_FALSE;
     }
+    *lru = link->next; /* Remove from available list */
+    goto found;
+  }
+
+  /* Which free link is taken depends on the data, so ranks may create different numbers of links for a unit. Links of
+     the same unit therefore share a tag, taken when the first one is created, which all ranks do collectively. Messages
+     of concurrent operations on the unit are still matched correctly, since all ranks start them in the same order. */
+  for (tag=MPI_ANY_TAG,p=&bas->avail; tag==MPI_ANY_TAG && (link=*p); p=&link->next) {
+    ierr = MPIPetsc_Type_compare(unit,link->unit,&match);CHKERRQ(ierr);
+    if (match) tag = link->tag;
+  }
+  for (p=&bas->inuse; tag==MPI_ANY_TAG && (link=*p); p=&link->next) {
+    ierr = MPIPetsc_Type_compare(unit,link->unit,&match);CHKERRQ(ierr);
+    if (match) tag = link->tag;
   }
 
   ierr = PetscNew(&link);CHKERRQ(ierr);
   ierr = PetscSFLinkSetUp_Host(sf,link,unit);CHKERRQ(ierr);
-  ierr = PetscCommGetNewTag(PetscObjectComm((PetscObject)sf),&link->tag);CHKERRQ(ierr); /* One tag per link */
+  if (tag == MPI_ANY_TAG) {ierr = PetscCommGetNewTag(PetscObjectComm((PetscObject)sf),&tag);CHKERRQ(ierr);} /* One tag per unit */
+  link->tag = tag;
 
   nreqs = (nrootreqs+nleafreqs)*8;
   ierr  = PetscMalloc1(nreqs,&link->reqs);CHKERRQ(ierr);
@@ -1537,7 +1568,7 @@ PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF sf,PetscSFLink link,void *root
    Output Parameters:
   +  opt     - Pack optimizations. NULL if no optimizations.
 */
-PetscErrorCode PetscSFCreatePackOpt(PetscInt n,const PetscInt *offset,const PetscInt *idx,PetscSFPackOpt *out)
+PETSC_INTERN PetscErrorCode PetscSFCreatePackOpt(PetscInt n,const PetscInt *offset,const PetscInt *idx,PetscSFPackOpt *out)
 {
   PetscErrorCode ierr;
   PetscInt       r,p,start,i,j,k,dx,dy,dz,dydz,m,X,Y;
@@ -1614,7 +1645,7 @@ finish:
   PetscFunctionReturn(0);
 }
 
-PETSC_STATIC_INLINE PetscErrorCode PetscSFDestroyPackOpt(PetscMemType mtype,PetscSFPackOpt *out)
+PETSC_INTERN PetscErrorCode PetscSFDestroyPackOpt(PetscMemType mtype,PetscSFPackOpt *out)
 {
   PetscErrorCode ierr;
   PetscSFPackOpt opt = *out;
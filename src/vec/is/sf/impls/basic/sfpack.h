@@ -136,7 +136,7 @@ struct _n_PetscSFLink {
   PetscInt     maxResidentThreadsPerGPU;     /* It is a copy from SF for convenience */
   cudaStream_t stream;                       /* Stream to launch pack/unapck kernels if not using the default stream */
 #endif
-  PetscMPIInt  tag;                          /* Each link has a tag so we can perform multiple SF ops at the same time */
+  PetscMPIInt  tag;                          /* Links of the same unit share a tag, see PetscSFLinkCreate() */
   MPI_Datatype unit;                         /* The MPI datatype this PetscSFLink is built for */
   MPI_Datatype basicunit;                    /* unit is made of MPI builtin dataype basicunit */
   PetscBool    isbuiltin;                    /* Is unit an MPI/PETSc builtin datatype? If it is true, then bs=1 and basicunit is equivalent to unit */
@@ -204,6 +204,8 @@ PETSC_INTERN PetscErrorCode PetscSFLinkBcastAndOpLocal(PetscSF,PetscSFLink,const
 PETSC_INTERN PetscErrorCode PetscSFLinkReduceLocal(PetscSF,PetscSFLink,const void*,void*,MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF,PetscSFLink,void*,const void*,void*,MPI_Op);
 
+PETSC_INTERN PetscErrorCode PetscSFCreatePackOpt(PetscInt,const PetscInt*,const PetscInt*,PetscSFPackOpt*);
+PETSC_INTERN PetscErrorCode PetscSFDestroyPackOpt(PetscMemType,PetscSFPackOpt*);
 PETSC_INTERN PetscErrorCode PetscSFSetUpPackFields(PetscSF sf);
 PETSC_INTERN PetscErrorCode PetscSFResetPackFields(PetscSF sf);
 
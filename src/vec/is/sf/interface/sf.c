@@ -125,7 +125,8 @@ PetscErrorCode PetscSFReset(PetscSF sf)
    Notes:
    See "include/petscsf.h" for available methods (for instance)
 +    PETSCSFWINDOW - MPI-2/3 one-sided
--    PETSCSFBASIC - basic implementation using MPI-1 two-sided
+.    PETSCSFBASIC - basic implementation using MPI-1 two-sided
+-    PETSCSFNODE - two-level implementation using MPI-3 shared memory within a node and one message per pair of nodes
 
   Level: intermediate
 
@@ -270,8 +271,12 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
 .  -sf_use_default_stream - Assume callers of SF computed the input root/leafdata with the default cuda stream. SF will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between SF and its caller (default: true).
                             If true, this option only works with -use_cuda_aware_mpi 1.
--  -sf_use_stream_aware_mpi  - Assume the underlying MPI is cuda-stream aware and SF won't sync streams for send/recv buffers passed to MPI (default: false).
+.  -sf_use_stream_aware_mpi  - Assume the underlying MPI is cuda-stream aware and SF won't sync streams for send/recv buffers passed to MPI (default: false).
                                If true, this option only works with -use_cuda_aware_mpi 1.
+.  -sf_basic_max_links    - For PETSCSFBASIC, the number of communication links per data type kept with persistent MPI requests bound to user arrays
+                            (default: 4). Cycling through at most this many root or leaf arrays reuses the MPI requests instead of re-initializing them.
+-  -sf_neighbor_persistent - For PETSCSFNEIGHBOR, use persistent neighborhood collectives if MPI provides them (default: true). They are
+                            bound to buffers of PetscSF, so remote root and leaf data are always packed.
 
    Level: intermediate
 @*/
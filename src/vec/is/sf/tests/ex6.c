@@ -0,0 +1,84 @@
+static char help[]= "Test PetscSFBcast and PetscSFReduce cycling through several root and leaf arrays with the same SF\n\n";
+
+#include <petsc.h>
+#include <petscsf.h>
+
+int main(int argc, char **argv)
+{
+  PetscErrorCode ierr;
+  PetscSF        sf;
+  PetscSFNode    *iremote;
+  PetscMPIInt    rank,size;
+  PetscInt       i,k,it,n = 5,narrays = 3,nits = 4,nerrors = 0,*rootdata[8],*leafdata[8];
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-narrays",&narrays,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nits",&nits,NULL);CHKERRQ(ierr);
+  if (narrays < 1 || narrays > 8) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"-narrays must be in [1,8]");
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+
+  /* Leaves are contiguous and reference all roots of the next process, so both root and leaf data are passed to MPI directly */
+  ierr = PetscMalloc1(n,&iremote);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    iremote[i].rank  = (rank+1)%size;
+    iremote[i].index = i;
+  }
+  ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,n,n,NULL,PETSC_COPY_VALUES,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+
+  for (k=0; k<narrays; k++) {ierr = PetscMalloc2(n,&rootdata[k],n,&leafdata[k]);CHKERRQ(ierr);}
+  for (it=0; it<nits; it++) {
+    for (k=0; k<narrays; k++) {
+      for (i=0; i<n; i++) {rootdata[k][i] = 1000*it + 100*k + 10*rank + i; leafdata[k][i] = -1;}
+      ierr = PetscSFBcastBegin(sf,MPIU_INT,rootdata[k],leafdata[k]);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT,rootdata[k],leafdata[k]);CHKERRQ(ierr);
+      for (i=0; i<n; i++) if (leafdata[k][i] != 1000*it + 100*k + 10*((rank+1)%size) + i) nerrors++;
+
+      for (i=0; i<n; i++) {leafdata[k][i] = -(1000*it + 100*k + 10*rank + i); rootdata[k][i] = 0;}
+      ierr = PetscSFReduceBegin(sf,MPIU_INT,leafdata[k],rootdata[k],MPIU_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFReduceEnd(sf,MPIU_INT,leafdata[k],rootdata[k],MPIU_REPLACE);CHKERRQ(ierr);
+      for (i=0; i<n; i++) if (rootdata[k][i] != -(1000*it + 100*k + 10*((rank+size-1)%size) + i)) nerrors++;
+    }
+  }
+  ierr = MPI_Allreduce(MPI_IN_PLACE,&nerrors,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Number of wrong entries %D\n",nerrors);CHKERRQ(ierr);
+
+  for (k=0; k<narrays; k++) {ierr = PetscFree2(rootdata[k],leafdata[k]);CHKERRQ(ierr);}
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: 3
+     suffix: 1
+     args: -narrays {{1 3 6}} -sf_basic_max_links {{1 4}}
+
+   test:
+     nsize: 3
+     suffix: 1_neighbor
+     requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+     output_file: output/ex6_1.out
+     args: -narrays 3 -sf_type neighbor
+
+   test:
+     nsize: 3
+     suffix: 1_neighbor_persistent
+     requires: define(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+     output_file: output/ex6_1.out
+     args: -narrays {{1 3 6}} -sf_type neighbor -sf_neighbor_persistent {{0 1}}
+
+   test:
+     nsize: 3
+     suffix: 1_node
+     requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+     output_file: output/ex6_1.out
+     args: -narrays 3 -sf_type node -sf_node_size {{0 1}}
+
+TEST*/
@@ -0,0 +1,189 @@
+static char help[]= "Benchmarks PetscSF implementations on the halo exchange of DMDA and DMPlex meshes\n\n\
+Each PetscSF type in the comparison gets an options prefix, e.g., -neighbor_sf_neighbor_persistent.\n\n";
+
+#include <petscsf.h>
+#include <petscdmda.h>
+#include <petscdmplex.h>
+#include <petsctime.h>
+
+typedef enum {PATTERN_DA,PATTERN_PLEX} Pattern;
+static const char *const Patterns[] = {"da","plex","Pattern","PATTERN_",NULL};
+
+typedef struct {
+  const char  *name;      /* Name of the variant, also used as the options prefix */
+  PetscSFType type;
+  const char  *persistent; /* Value of -sf_neighbor_persistent unless given, NULL if not applicable */
+} Variant;
+
+/* Create a mesh of the pattern and its halo PetscSF: leaves are all local dofs, roots are the owned dofs */
+static PetscErrorCode CreateHalo(MPI_Comm comm,Pattern pattern,PetscInt dim,PetscInt n,PetscInt dof,PetscInt *nroots,PetscInt *nleaves,PetscInt **ilocal,PetscInt **gidx,PetscLayout *layout)
+{
+  DM                     dm,dmDist;
+  Vec                    g;
+  PetscLayout            map;
+  ISLocalToGlobalMapping ltog;
+  const PetscInt         *idx;
+  PetscInt               faces[3],numDof[4] = {0,0,0,0},nl,i;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBeginUser;
+  if (pattern == PATTERN_DA) {
+    if (dim == 2) {ierr = DMDACreate2d(comm,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_BOX,n,n,PETSC_DECIDE,PETSC_DECIDE,dof,1,NULL,NULL,&dm);CHKERRQ(ierr);}
+    else {ierr = DMDACreate3d(comm,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_BOX,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,1,NULL,NULL,NULL,&dm);CHKERRQ(ierr);}
+    ierr = DMSetUp(dm);CHKERRQ(ierr);
+  } else {
+    PetscSection s;
+
+    for (i=0; i<dim; i++) faces[i] = n;
+    ierr = DMPlexCreateBoxMesh(comm,dim,PETSC_FALSE,faces,NULL,NULL,NULL,PETSC_TRUE,&dm);CHKERRQ(ierr);
+    ierr = DMPlexDistribute(dm,1,NULL,&dmDist);CHKERRQ(ierr);
+    if (dmDist) {ierr = DMDestroy(&dm);CHKERRQ(ierr); dm = dmDist;}
+    numDof[0] = dof;
+    ierr = DMSetNumFields(dm,1);CHKERRQ(ierr);
+    ierr = DMPlexCreateSection(dm,NULL,&dof,numDof,0,NULL,NULL,NULL,NULL,&s);CHKERRQ(ierr);
+    ierr = DMSetLocalSection(dm,s);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  }
+  ierr = DMGetGlobalVector(dm,&g);CHKERRQ(ierr);
+  ierr = VecGetLayout(g,&map);CHKERRQ(ierr);
+  ierr = PetscLayoutReference(map,layout);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(g,nroots);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm,&g);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dm,&ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetSize(ltog,&nl);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetIndices(ltog,&idx);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nl,ilocal,nl,gidx);CHKERRQ(ierr);
+  for (i=0,*nleaves=0; i<nl; i++) {
+    if (idx[i] < 0) continue; /* Constrained or unowned dofs have no global index */
+    (*ilocal)[*nleaves] = i;
+    (*gidx)[(*nleaves)++] = idx[i];
+  }
+  ierr = ISLocalToGlobalMappingRestoreIndices(ltog,&idx);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscSF        sf;
+  PetscLayout    layout = NULL;
+  Pattern        pattern = PATTERN_DA;
+  Variant        variants[3];
+  PetscInt       dim = 2,n = 32,dof = 1,its = 100,warmup = 10,nroots,nleaves,nv = 0,nl,v,i,k,*ilocal,*gidx;
+  PetscScalar    *rootdata,*leafdata,*reference;
+  PetscLogDouble t0,t1,tbcast,treduce;
+  PetscBool      timing = PETSC_FALSE,set;
+  char           prefix[64],option[128];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"PetscSF halo benchmark","PetscSF");CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-pattern","Halo pattern","ex7.c",Patterns,(PetscEnum)pattern,(PetscEnum*)&pattern,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim","Dimension of the mesh","ex7.c",dim,&dim,NULL,2,3);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","Number of cells or grid points per direction","ex7.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","Number of dofs per grid point or vertex","ex7.c",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-its","Number of timed exchanges","ex7.c",its,&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-warmup","Number of exchanges before timing","ex7.c",warmup,&warmup,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-timing","Print the time of the exchanges","ex7.c",timing,&timing,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  variants[nv].name = "basic";      variants[nv].type = PETSCSFBASIC;    variants[nv++].persistent = NULL;
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  variants[nv].name = "neighbor";   variants[nv].type = PETSCSFNEIGHBOR; variants[nv++].persistent = "0";
+  variants[nv].name = "persistent"; variants[nv].type = PETSCSFNEIGHBOR; variants[nv++].persistent = "1";
+#else
+  variants[nv].name = "neighbor";   variants[nv].type = PETSCSFNEIGHBOR; variants[nv++].persistent = NULL;
+#endif
+#endif
+
+  ierr = CreateHalo(PETSC_COMM_WORLD,pattern,dim,n,dof,&nroots,&nleaves,&ilocal,&gidx,&layout);CHKERRQ(ierr);
+  nl   = nleaves ? ilocal[nleaves-1]+1 : 0;
+  ierr = PetscMalloc3(nroots,&rootdata,nl,&leafdata,nroots+nl,&reference);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Halo exchange of a %D^%D %s mesh with %D dofs per point\n",n,dim,Patterns[pattern],dof);CHKERRQ(ierr);
+
+  for (v=0; v<nv; v++) {
+    ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(prefix,sizeof(prefix),"%s_",variants[v].name);CHKERRQ(ierr);
+    ierr = PetscObjectSetOptionsPrefix((PetscObject)sf,prefix);CHKERRQ(ierr);
+    ierr = PetscSFSetType(sf,variants[v].type);CHKERRQ(ierr);
+    if (variants[v].persistent) {
+      ierr = PetscOptionsHasName(NULL,prefix,"-sf_neighbor_persistent",&set);CHKERRQ(ierr);
+      if (!set) {
+        ierr = PetscSNPrintf(option,sizeof(option),"-%ssf_neighbor_persistent",prefix);CHKERRQ(ierr);
+        ierr = PetscOptionsSetValue(NULL,option,variants[v].persistent);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,layout,nleaves,ilocal,PETSC_COPY_VALUES,gidx);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+
+    /* A ghost update followed by the accumulation of the ghost contributions, as in the assembly of a residual */
+    tbcast = treduce = 0.0;
+    for (k=0; k<warmup+its; k++) {
+      for (i=0; i<nroots; i++) rootdata[i] = (PetscScalar)(layout->rstart+i+k);
+      for (i=0; i<nl; i++) leafdata[i] = -1.0;
+      ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+      ierr = PetscTime(&t0);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sf,MPIU_SCALAR,rootdata,leafdata);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_SCALAR,rootdata,leafdata);CHKERRQ(ierr);
+      ierr = PetscTime(&t1);CHKERRQ(ierr);
+      if (k >= warmup) tbcast += t1-t0;
+      ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+      ierr = PetscTime(&t0);CHKERRQ(ierr);
+      ierr = PetscSFReduceBegin(sf,MPIU_SCALAR,leafdata,rootdata,MPIU_SUM);CHKERRQ(ierr);
+      ierr = PetscSFReduceEnd(sf,MPIU_SCALAR,leafdata,rootdata,MPIU_SUM);CHKERRQ(ierr);
+      ierr = PetscTime(&t1);CHKERRQ(ierr);
+      if (k >= warmup) treduce += t1-t0;
+    }
+
+    /* All variants must give the results of the first one */
+    if (!v) {
+      for (i=0; i<nroots; i++) reference[i] = rootdata[i];
+      for (i=0; i<nl; i++) reference[nroots+i] = leafdata[i];
+    } else {
+      for (i=0; i<nroots; i++) if (rootdata[i] != reference[i]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Root %D differs with %s",i,variants[v].name);
+      for (i=0; i<nl; i++) if (leafdata[i] != reference[nroots+i]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Leaf %D differs with %s",i,variants[v].name);
+    }
+    if (timing) {
+      PetscLogDouble t[2] = {tbcast,treduce},tmax[2];
+
+      ierr = MPIU_Allreduce(t,tmax,2,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"  %-10s Bcast %10.3e s  Reduce %10.3e s per exchange\n",variants[v].name,tmax[0]/PetscMax(its,1),tmax[1]/PetscMax(its,1));CHKERRQ(ierr);
+    } else {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"  %s\n",variants[v].name);CHKERRQ(ierr);
+    }
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"All PetscSF types agree\n");CHKERRQ(ierr);
+  ierr = PetscFree3(rootdata,leafdata,reference);CHKERRQ(ierr);
+  ierr = PetscFree2(ilocal,gidx);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: da
+      nsize: {{1 2 4}}
+      args: -pattern da -n 12 -dof 2 -its 3 -warmup 1
+      filter: grep -v "^  "
+      output_file: output/ex7_da.out
+
+   test:
+      suffix: da_3d
+      nsize: 4
+      args: -pattern da -dim 3 -n 6 -its 3 -warmup 1
+      filter: grep -v "^  "
+      output_file: output/ex7_da_3d.out
+
+   test:
+      suffix: plex
+      nsize: {{1 2 3}}
+      args: -pattern plex -n 6 -dof 2 -its 3 -warmup 1
+      filter: grep -v "^  "
+      output_file: output/ex7_plex.out
+
+TEST*/
@@ -599,4 +599,20 @@ int main(int argc,char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_node
+      output_file: output/ex1_10_basic.out
+      filter: sed -e "s/type: node/type: basic/" | grep -v "node-aware"
+      nsize: 4
+      args: -sf_type node -sf_node_size {{0 1 2}} -test_all -test_bcastop 0 -test_fetchandop 0
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: bcastop_node
+      output_file: output/ex1_bcastop_basic.out
+      filter: sed -e "s/type: node/type: basic/" | grep -v "node-aware"
+      nsize: 4
+      args: -test_bcastop -sf_type node -sf_node_size {{0 2}}
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
 TEST*/
@@ -288,6 +288,7 @@ PetscErrorCode VecBindToCPU_MPICUDA(Vec V,PetscBool pin)
     V->ops->axpy                   = VecAXPY_Seq;
     V->ops->axpby                  = VecAXPBY_Seq;
     V->ops->maxpy                  = VecMAXPY_Seq;
+    V->ops->maxpymdot              = VecMAXPYMDot_MPI;
     V->ops->aypx                   = VecAYPX_Seq;
     V->ops->axpbypcz               = VecAXPBYPCZ_Seq;
     V->ops->pointwisemult          = VecPointwiseMult_Seq;
@@ -320,6 +321,7 @@ PetscErrorCode VecBindToCPU_MPICUDA(Vec V,PetscBool pin)
     V->ops->axpy                   = VecAXPY_SeqCUDA;
     V->ops->axpby                  = VecAXPBY_SeqCUDA;
     V->ops->maxpy                  = VecMAXPY_SeqCUDA;
+    V->ops->maxpymdot              = NULL;
     V->ops->aypx                   = VecAYPX_SeqCUDA;
     V->ops->axpbypcz               = VecAXPBYPCZ_SeqCUDA;
     V->ops->pointwisemult          = VecPointwiseMult_SeqCUDA;
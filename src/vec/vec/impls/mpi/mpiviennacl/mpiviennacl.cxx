@@ -195,6 +195,7 @@ PETSC_EXTERN PetscErrorCode VecCreate_MPIViennaCL(Vec vv)
   vv->ops->axpy            = VecAXPY_SeqViennaCL;
   vv->ops->axpby           = VecAXPBY_SeqViennaCL;
   vv->ops->maxpy           = VecMAXPY_SeqViennaCL;
+  vv->ops->maxpymdot       = NULL;
   vv->ops->aypx            = VecAYPX_SeqViennaCL;
   vv->ops->axpbypcz        = VecAXPBYPCZ_SeqViennaCL;
   vv->ops->pointwisemult   = VecPointwiseMult_SeqViennaCL;
@@ -481,7 +481,15 @@ static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
                                 VecStrideSubSetGather_Default,
                                 VecStrideSubSetScatter_Default,
                                 0,
-                                0
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecMAXPYMDot_MPI
 };
 
 /*
@@ -510,7 +518,15 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
   s->array_allocated = 0;
   if (alloc && !array) {
     PetscInt n = v->map->n+nghost;
-    ierr               = PetscCalloc1(n,&s->array);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+    if (VecOMPThreads > 1) {
+      ierr = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+      ierr = VecFirstTouch_OpenMP_Private(n,s->array);CHKERRQ(ierr);
+    } else
+#endif
+    {
+      ierr = PetscCalloc1(n,&s->array);CHKERRQ(ierr);
+    }
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
     s->array_allocated = s->array;
   }
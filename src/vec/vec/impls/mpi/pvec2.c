@@ -39,6 +39,28 @@ PetscErrorCode VecMTDot_MPI(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode VecMAXPYMDot_MPI(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y,PetscScalar *z,PetscReal *nrm2)
+{
+  PetscScalar    awork[129],*work = awork;
+  PetscReal      lnrm2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc1(nv+1,&work);CHKERRQ(ierr);
+  }
+  /* the inner products and the norm are reduced together */
+  ierr     = VecMAXPYMDot_Seq(xin,nv,alpha,y,work,&lnrm2);CHKERRQ(ierr);
+  work[nv] = lnrm2;
+  ierr     = MPIU_Allreduce(MPI_IN_PLACE,work,nv+1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  ierr     = PetscArraycpy(z,work,nv);CHKERRQ(ierr);
+  *nrm2    = PetscRealPart(work[nv]);
+  if (nv > 128) {
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/fnorm.h>
 PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
 {
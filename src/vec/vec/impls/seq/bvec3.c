@@ -20,6 +20,25 @@ extern PetscErrorCode VecCreate_Seq_Private(Vec,const float*);
 extern PetscErrorCode VecCreate_Seq_Private(Vec,const double*);
 #endif
 
+#if defined(PETSC_HAVE_OPENMP)
+PetscInt VecOMPThreads = 1;
+
+/*
+   Zeros the n entries of a new vector from -vec_omp_threads OpenMP threads in equal chunks so each thread's part
+   of it lives in its NUMA domain; does nothing with a single thread, the caller then zeros the array itself
+*/
+PetscErrorCode VecFirstTouch_OpenMP_Private(PetscInt n,PetscScalar *array)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  if (VecOMPThreads < 2) PetscFunctionReturn(0);
+#pragma omp parallel for schedule(static) num_threads((int)VecOMPThreads)
+  for (i=0; i<n; i++) array[i] = 0.0;
+  PetscFunctionReturn(0);
+}
+#endif
+
 PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec V)
 {
   Vec_Seq        *s;
@@ -39,6 +58,9 @@ PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec V)
   s                  = (Vec_Seq*)V->data;
   s->array_allocated = array;
 
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = VecFirstTouch_OpenMP_Private(n,array);CHKERRQ(ierr);
+#endif
   ierr = VecSet(V,0.0);CHKERRQ(ierr);
 #else
   switch (((PetscObject)V)->precision) {
@@ -6,7 +6,137 @@
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
+/*
+   With many vectors the multiple vector kernels below work on blocks of VEC_SEQ_MBLOCK rows so that the block of x stays
+   in cache while it is combined with all the y vectors, instead of streaming x from memory once per group of four
+   vectors. Each entry is computed with the same operations in the same order as the unblocked kernels.
+*/
+#define VEC_SEQ_MBLOCK    512
+#define VEC_SEQ_MBLOCK_NV 8
+
+/* z[i] = y[i]'*x over the first jrem < 4 entries, in the order used by VecMDot_Seq() */
+PETSC_STATIC_INLINE void VecMDotHead_Private(PetscInt nv,const PetscScalar *const *yy,const PetscScalar *x,PetscInt jrem,PetscScalar *z)
+{
+  PetscInt i;
+
+  for (i=0; i<nv; i++) {
+    PetscScalar sum = 0.;
+    switch (jrem) {
+    case 3: sum += x[2]*PetscConj(yy[i][2]);
+    case 2: sum += x[1]*PetscConj(yy[i][1]);
+    case 1: sum += x[0]*PetscConj(yy[i][0]);
+    }
+    z[i] = sum;
+  }
+}
+
+/* z[i] += y[i]'*x over the rows [j0,j1), whose length is a multiple of four */
+PETSC_STATIC_INLINE void VecMDotBlock_Private(PetscInt nv,const PetscScalar *const *yy,const PetscScalar *x,PetscInt j0,PetscInt j1,PetscScalar *z)
+{
+  PetscInt          i,j;
+  PetscScalar       sum0,sum1,sum2,sum3,x0,x1,x2,x3;
+  const PetscScalar *yy0,*yy1,*yy2,*yy3;
+
+  for (i=0; i<nv-3; i+=4) {
+    sum0 = z[i]; sum1 = z[i+1]; sum2 = z[i+2]; sum3 = z[i+3];
+    yy0  = yy[i]; yy1 = yy[i+1]; yy2 = yy[i+2]; yy3 = yy[i+3];
+    for (j=j0; j<j1; j+=4) {
+      x0 = x[j];
+      x1 = x[j+1];
+      x2 = x[j+2];
+      x3 = x[j+3];
+
+      sum0 += x0*PetscConj(yy0[j]) + x1*PetscConj(yy0[j+1]) + x2*PetscConj(yy0[j+2]) + x3*PetscConj(yy0[j+3]);
+      sum1 += x0*PetscConj(yy1[j]) + x1*PetscConj(yy1[j+1]) + x2*PetscConj(yy1[j+2]) + x3*PetscConj(yy1[j+3]);
+      sum2 += x0*PetscConj(yy2[j]) + x1*PetscConj(yy2[j+1]) + x2*PetscConj(yy2[j+2]) + x3*PetscConj(yy2[j+3]);
+      sum3 += x0*PetscConj(yy3[j]) + x1*PetscConj(yy3[j+1]) + x2*PetscConj(yy3[j+2]) + x3*PetscConj(yy3[j+3]);
+    }
+    z[i] = sum0; z[i+1] = sum1; z[i+2] = sum2; z[i+3] = sum3;
+  }
+  for (; i<nv; i++) {
+    sum0 = z[i];
+    yy0  = yy[i];
+    for (j=j0; j<j1; j+=4) {
+      sum0 += x[j]*PetscConj(yy0[j]) + x[j+1]*PetscConj(yy0[j+1]) + x[j+2]*PetscConj(yy0[j+2]) + x[j+3]*PetscConj(yy0[j+3]);
+    }
+    z[i] = sum0;
+  }
+}
+
+/* x[j0:j1) += sum alpha[i] y[i][j0:j1), grouping the vectors as VecMAXPY_Seq() does */
+PETSC_STATIC_INLINE void VecMAXPYBlock_Private(PetscInt nv,const PetscScalar *alpha,const PetscScalar *const *yy,PetscScalar *x,PetscInt j0,PetscInt j1)
+{
+  PetscInt          i,n;
+  PetscScalar       *xx,alpha0,alpha1,alpha2,alpha3;
+  const PetscScalar *yy0,*yy1,*yy2,*yy3;
+
+  switch (i=nv&0x3) {
+  case 3:
+    xx = x+j0; n = j1-j0; yy0 = yy[0]+j0; yy1 = yy[1]+j0; yy2 = yy[2]+j0;
+    alpha0 = alpha[0]; alpha1 = alpha[1]; alpha2 = alpha[2];
+    PetscKernelAXPY3(xx,alpha0,alpha1,alpha2,yy0,yy1,yy2,n);
+    break;
+  case 2:
+    xx = x+j0; n = j1-j0; yy0 = yy[0]+j0; yy1 = yy[1]+j0;
+    alpha0 = alpha[0]; alpha1 = alpha[1];
+    PetscKernelAXPY2(xx,alpha0,alpha1,yy0,yy1,n);
+    break;
+  case 1:
+    xx = x+j0; n = j1-j0; yy0 = yy[0]+j0;
+    alpha0 = alpha[0];
+    PetscKernelAXPY(xx,alpha0,yy0,n);
+    break;
+  }
+  for (; i<nv; i+=4) {
+    xx = x+j0; n = j1-j0; yy0 = yy[i]+j0; yy1 = yy[i+1]+j0; yy2 = yy[i+2]+j0; yy3 = yy[i+3]+j0;
+    alpha0 = alpha[i]; alpha1 = alpha[i+1]; alpha2 = alpha[i+2]; alpha3 = alpha[i+3];
+    PetscKernelAXPY4(xx,alpha0,alpha1,alpha2,alpha3,yy0,yy1,yy2,yy3,n);
+  }
+}
+
+static PetscErrorCode VecGetArraysRead_Private(PetscInt nv,const Vec y[],const PetscScalar **yy)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<nv; i++) {ierr = VecGetArrayRead(y[i],&yy[i]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
 
+static PetscErrorCode VecRestoreArraysRead_Private(PetscInt nv,const Vec y[],const PetscScalar **yy)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<nv; i++) {ierr = VecRestoreArrayRead(y[i],&yy[i]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#if !defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
+/*
+   VecMDotBlocked_Private - VecMDot_Seq() for many vectors, see VEC_SEQ_MBLOCK
+*/
+static PetscErrorCode VecMDotBlocked_Private(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,jrem = n&0x3,jb;
+  const PetscScalar *awork[128],**yy = awork,*x;
+
+  PetscFunctionBegin;
+  if (nv > 128) {ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  ierr = VecGetArraysRead_Private(nv,yin,yy);CHKERRQ(ierr);
+  VecMDotHead_Private(nv,yy,x,jrem,z);
+  for (jb=jrem; jb<n; jb+=VEC_SEQ_MBLOCK) VecMDotBlock_Private(nv,yy,x,jb,PetscMin(n,jb+VEC_SEQ_MBLOCK),z);
+  ierr = VecRestoreArraysRead_Private(nv,yin,yy);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
+  if (nv > 128) {ierr = PetscFree(yy);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
 #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
@@ -100,6 +230,10 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (nv >= VEC_SEQ_MBLOCK_NV && n > VEC_SEQ_MBLOCK) {
+    ierr = VecMDotBlocked_Private(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -567,6 +701,18 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
   PetscFunctionBegin;
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+  if (nv >= VEC_SEQ_MBLOCK_NV && n > VEC_SEQ_MBLOCK) {
+    const PetscScalar *awork[128],**yy = awork;
+    PetscInt          jb;
+
+    if (nv > 128) {ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);}
+    ierr = VecGetArraysRead_Private(nv,y,yy);CHKERRQ(ierr);
+    for (jb=0; jb<n; jb+=VEC_SEQ_MBLOCK) VecMAXPYBlock_Private(nv,alpha,yy,xx,jb,PetscMin(n,jb+VEC_SEQ_MBLOCK));
+    ierr = VecRestoreArraysRead_Private(nv,y,yy);CHKERRQ(ierr);
+    if (nv > 128) {ierr = PetscFree(yy);CHKERRQ(ierr);}
+    ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   switch (j_rem=nv&0x3) {
   case 3:
     ierr   = VecGetArrayRead(y[0],&yy0);CHKERRQ(ierr);
@@ -623,6 +769,39 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
   PetscFunctionReturn(0);
 }
 
+/*
+   VecMAXPYMDot_Seq - x <- x + sum alpha[i] y[i], z[i] = y[i]'*x and nrm2 = x'*x with one pass over the vectors: each block of
+   rows is updated and then, while the blocks of the y vectors are still in cache, used for the inner products
+*/
+PetscErrorCode VecMAXPYMDot_Seq(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y,PetscScalar *z,PetscReal *nrm2)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,jrem = n&0x3,jb,je,j;
+  const PetscScalar *awork[128],**yy = awork;
+  PetscScalar       *xx;
+  PetscReal         sum = 0.0;
+
+  PetscFunctionBegin;
+  if (nv > 128) {ierr = PetscMalloc1(nv,&yy);CHKERRQ(ierr);}
+  ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArraysRead_Private(nv,y,yy);CHKERRQ(ierr);
+  VecMAXPYBlock_Private(nv,alpha,yy,xx,0,jrem);
+  VecMDotHead_Private(nv,yy,xx,jrem,z);
+  for (j=0; j<jrem; j++) sum += PetscRealPart(xx[j]*PetscConj(xx[j]));
+  for (jb=jrem; jb<n; jb=je) {
+    je = PetscMin(n,jb+VEC_SEQ_MBLOCK);
+    VecMAXPYBlock_Private(nv,alpha,yy,xx,jb,je);
+    VecMDotBlock_Private(nv,yy,xx,jb,je,z);
+    for (j=jb; j<je; j++) sum += PetscRealPart(xx[j]*PetscConj(xx[j]));
+  }
+  *nrm2 = sum;
+  ierr = VecRestoreArraysRead_Private(nv,y,yy);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  if (nv > 128) {ierr = PetscFree(yy);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(4.0*nv*n + 2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/faypx.h>
 
 PetscErrorCode VecAYPX_Seq(Vec yin,PetscScalar alpha,Vec xin)
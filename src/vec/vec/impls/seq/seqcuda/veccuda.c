@@ -357,6 +357,7 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->mdot_local             = VecMDot_Seq;
     V->ops->mtdot_local            = VecMTDot_Seq;
     V->ops->maxpy                  = VecMAXPY_Seq;
+    V->ops->maxpymdot              = VecMAXPYMDot_Seq;
     V->ops->mdot                   = VecMDot_Seq;
     V->ops->mtdot                  = VecMTDot_Seq;
     V->ops->aypx                   = VecAYPX_Seq;
@@ -391,6 +392,7 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->norm_local             = VecNorm_SeqCUDA;
     V->ops->mdot_local             = VecMDot_SeqCUDA;
     V->ops->maxpy                  = VecMAXPY_SeqCUDA;
+    V->ops->maxpymdot              = NULL;
     V->ops->mdot                   = VecMDot_SeqCUDA;
     V->ops->aypx                   = VecAYPX_SeqCUDA;
     V->ops->waxpy                  = VecWAXPY_SeqCUDA;
@@ -183,6 +183,7 @@ PetscErrorCode  VecInitializePackage(void)
   ierr = PetscLogEventRegister("VecAXPBYCZ",       VEC_CLASSID,&VEC_AXPBYPCZ);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecWAXPY",         VEC_CLASSID,&VEC_WAXPY);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecMAXPY",         VEC_CLASSID,&VEC_MAXPY);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecMAXPYMDot",     VEC_CLASSID,&VEC_MAXPYMDot);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecSwap",          VEC_CLASSID,&VEC_Swap);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecOps",           VEC_CLASSID,&VEC_Ops);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecAssemblyBegin", VEC_CLASSID,&VEC_AssemblyBegin);CHKERRQ(ierr);
@@ -237,6 +238,10 @@ PetscErrorCode  VecInitializePackage(void)
     if (pkg) {ierr = PetscLogEventExcludeClass(VEC_CLASSID);CHKERRQ(ierr);}
     if (pkg) {ierr = PetscLogEventExcludeClass(VEC_SCATTER_CLASSID);CHKERRQ(ierr);}
   }
+#if defined(PETSC_HAVE_OPENMP)
+  /* Number of OpenMP threads that first touch new vectors */
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vec_omp_threads",&VecOMPThreads,NULL);CHKERRQ(ierr);
+#endif
 
   /*
     Create the special MPI reduction operation that may be used by VecNorm/DotBegin()
@@ -1217,6 +1217,71 @@ PetscErrorCode  VecMAXPY(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[])
   PetscFunctionReturn(0);
 }
 
+/*@
+   VecMAXPYMDot - Computes y = y + sum alpha[i] x[i] and then the inner products of the new y with the x[i] and, optionally, its 2-norm
+
+   Collective on Vec
+
+   Input Parameters:
++  y - the vector that is updated
+.  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+-  x - array of vectors
+
+   Output Parameters:
++  val - array of the inner products, val[i] = x[i]'*y with y the updated vector
+-  norm - the 2-norm of the updated y, or NULL if it is not needed
+
+   Level: advanced
+
+   Notes:
+    The result is that of VecMAXPY() followed by VecMDot() and VecNorm(). For the standard vector types the x vectors are
+    read only once, each block of y being used for the inner products right after its update, and the inner products and the
+    norm are computed with a single reduction. This is used by the classical Gram-Schmidt orthogonalization of KSPGMRES
+    with iterative refinement.
+
+    y cannot be any of the x vectors
+
+.seealso:  VecMAXPY(), VecMDot(), VecNorm(), VecDotNorm2(), KSPGMRESClassicalGramSchmidtOrthogonalization()
+@*/
+PetscErrorCode  VecMAXPYMDot(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[],PetscScalar val[],PetscReal *norm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscReal      nrm2;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(y,nv,2);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors (given %D) cannot be negative",nv);
+  if (!nv) {
+    if (norm) {ierr = VecNorm(y,NORM_2,norm);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+  PetscValidScalarPointer(alpha,3);
+  PetscValidPointer(x,4);
+  PetscValidHeaderSpecific(*x,VEC_CLASSID,4);
+  PetscValidScalarPointer(val,5);
+  PetscValidType(y,1);
+  PetscValidType(*x,4);
+  PetscCheckSameTypeAndComm(y,1,*x,4);
+  VecCheckSameSize(y,1,*x,4);
+  for (i=0; i<nv; i++) PetscValidLogicalCollectiveScalar(y,alpha[i],3);
+  if (!y->ops->maxpymdot) {
+    ierr = VecMAXPY(y,nv,alpha,x);CHKERRQ(ierr);
+    ierr = VecMDot(y,nv,x,val);CHKERRQ(ierr);
+    if (norm) {ierr = VecNorm(y,NORM_2,norm);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->maxpymdot)(y,nv,alpha,x,val,&nrm2);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  if (norm) *norm = PetscSqrtReal(nrm2);
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecGetSubVector - Gets a vector representing part of another vector
 
@@ -0,0 +1,90 @@
+static char help[] = "Tests VecMAXPYMDot() against VecMAXPY(), VecMDot() and VecNorm(), and VecMDot() and VecMAXPY() against VecDot() and VecAXPY().\n\
+  -n <n> : local length of the vectors\n\
+  -k <k> : number of vectors\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  Vec            *V,x,y,z;
+  PetscInt       i,n = 2003,k = 11;
+  PetscRandom    rctx;
+  PetscScalar    *alpha,*val,*val_mdot,dot;
+  PetscReal      nrm,nrm_norm,err = 0.0,errnrm,errmaxpy;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,k,&V);CHKERRQ(ierr);
+  ierr = PetscMalloc3(k,&alpha,k,&val,k,&val_mdot);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  for (i=0; i<k; i++) {
+    ierr     = VecSetRandom(V[i],rctx);CHKERRQ(ierr);
+    alpha[i] = 1.0/(i+2) - 0.3;
+  }
+
+  /* fused update, inner products and norm */
+  ierr = VecCopy(x,y);CHKERRQ(ierr);
+  ierr = VecMAXPYMDot(y,k,alpha,V,val,&nrm);CHKERRQ(ierr);
+
+  /* separate operations */
+  ierr = VecCopy(x,z);CHKERRQ(ierr);
+  ierr = VecMAXPY(z,k,alpha,V);CHKERRQ(ierr);
+  ierr = VecMDot(z,k,V,val_mdot);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm_norm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_INFINITY,&errmaxpy);CHKERRQ(ierr);
+  for (i=0; i<k; i++) err = PetscMax(err,PetscAbsScalar(val[i]-val_mdot[i])/PetscAbsScalar(val_mdot[i]));
+  errnrm = PetscAbsReal(nrm-nrm_norm)/nrm_norm;
+  if (errmaxpy > 0.0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() and VecMAXPY() differ by %g\n",(double)errmaxpy);CHKERRQ(ierr);}
+  if (err > 0.0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() and VecMDot() differ by %g\n",(double)err);CHKERRQ(ierr);}
+  if (errnrm > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() and VecNorm() differ by %g\n",(double)errnrm);CHKERRQ(ierr);}
+
+  /* multiple vector operations against the single vector ones */
+  for (err=0.0,i=0; i<k; i++) {
+    ierr = VecDot(y,V[i],&dot);CHKERRQ(ierr);
+    err  = PetscMax(err,PetscAbsScalar(val[i]-dot)/PetscAbsScalar(dot));
+  }
+  if (err > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMDot() and VecDot() differ by %g\n",(double)err);CHKERRQ(ierr);}
+  ierr = VecCopy(x,z);CHKERRQ(ierr);
+  for (i=0; i<k; i++) {ierr = VecAXPY(z,alpha[i],V[i]);CHKERRQ(ierr);}
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_INFINITY,&errmaxpy);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  errmaxpy /= nrm;
+  if (errmaxpy > 100*PETSC_MACHINE_EPSILON) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPY() and VecAXPY() differ by %g\n",(double)errmaxpy);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Tested %D vectors of local length %D\n",k,n);CHKERRQ(ierr);
+
+  ierr = PetscFree3(alpha,val,val_mdot);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(k,&V);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2}}
+      args: -k {{3 11 130}}
+      output_file: output/ex56_1.out
+      filter: sed -e "s/Tested [0-9]* vectors/Tested vectors/g"
+
+   test:
+      suffix: 2
+      args: -n 10 -k 9
+      output_file: output/ex56_2.out
+
+TEST*/